@@ -54,28 +54,23 @@ def graph_state_from_ros(ros_graph_state):
   }
 
 
+def graph_vertex_from_ros(ros_graph_vertex):
+  return {
+      'id': ros_graph_vertex.id,
+      'neighbors': [n for n in ros_graph_vertex.neighbors],
+      'lng': ros_graph_vertex.lng,
+      'lat': ros_graph_vertex.lat,
+      'theta': ros_graph_vertex.theta,
+      'type': ros_graph_vertex.type,
+      'name': ros_graph_vertex.name
+  }
+
+
 def graph_update_from_ros(ros_graph_update):
-  vf = ros_graph_update.vertex_from
-  vt = ros_graph_update.vertex_to
   return {
-      'vertex_from': {
-          'id': vf.id,
-          'neighbors': [n for n in vf.neighbors],
-          'lng': vf.lng,
-          'lat': vf.lat,
-          'theta': vf.theta,
-          'type': vf.type,
-          'name': vf.name
-      },
-      'vertex_to': {
-          'id': vt.id,
-          'neighbors': [n for n in vt.neighbors],
-          'lng': vt.lng,
-          'lat': vt.lat,
-          'theta': vt.theta,
-          'type': vt.type,
-          'name': vt.name
-      },
+      'vertex_from': graph_vertex_from_ros(ros_graph_update.vertex_from),
+      'vertex_to': graph_vertex_from_ros(ros_graph_update.vertex_to),
+      'vertices': [graph_vertex_from_ros(v) for v in ros_graph_update.vertices],
   }
 
 
@@ -698,6 +698,12 @@ class GraphMap extends React.Component {
     if (this.graph_loaded === false) return;
     console.info("Received graph update: ", graph_update);
 
+    // vertices moved by an incremental relaxation
+    if (graph_update.vertices.length > 0) {
+      this.updateVertices(graph_update.vertices);
+      return;
+    }
+
     // from vertex
     let vf = graph_update.vertex_from;
     vf.valueOf = () => vf.id;
@@ -732,6 +738,28 @@ class GraphMap extends React.Component {
     }
   }
 
+  /** @brief Replaces the given vertices and redraws the routes going through them */
+  updateVertices(vertices) {
+    let updated = new Set();
+    vertices.forEach((v) => {
+      v.valueOf = () => v.id;
+      v.distanceTo = L.LatLng.prototype.distanceTo;
+      this.id2vertex.set(v.id, v);
+      updated.add(v.id);
+    });
+    // vertex positions changed, rebuild the kdtree
+    this.kdtree = new kdTree(Array.from(this.id2vertex.values()), (a, b) => b.distanceTo(a), ["lat", "lng"]);
+    // routes
+    [...this.fixed_routes, ...this.active_routes].forEach((route) => {
+      if (!route.ids.some((id) => updated.has(id))) return;
+      let latlngs = route.ids.map((id) => {
+        let v = this.id2vertex.get(id);
+        return [v.lat, v.lng];
+      });
+      route.polyline.setLatLngs(latlngs);
+    });
+  }
+
   /**
    * @brief Sets the type of the current goal being added.
    * @param {string} type Type of the goal being added <teach, repeat>
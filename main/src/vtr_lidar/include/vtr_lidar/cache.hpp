@@ -24,14 +24,30 @@
 #include "vtr_lidar/data_types/point.hpp"
 #include "vtr_lidar/data_types/pointmap.hpp"
 #include "vtr_tactic/cache.hpp"
+#include "vtr_tactic/object_pool.hpp"
 #include "vtr_tactic/types.hpp"
 
 namespace vtr {
 namespace lidar {
 
+/** \brief Recycled point cloud buffers of a pipeline, see ObjectPool */
+using PointCloudPool = tactic::ObjectPool<pcl::PointCloud<PointWithInfo>>;
+
 struct LidarQueryCache : virtual public tactic::QueryCache {
   PTR_TYPEDEFS(LidarQueryCache);
 
+  /**
+   * \brief Returns an empty point cloud for this frame, recycled from the
+   * point cloud pool of the pipeline if there is one.
+   */
+  std::shared_ptr<pcl::PointCloud<PointWithInfo>> createPointCloud() {
+    if (point_cloud_pool) return point_cloud_pool->acquire();
+    return std::make_shared<pcl::PointCloud<PointWithInfo>>();
+  }
+
+  // point cloud buffers, set by the pipeline
+  tactic::Cache<PointCloudPool> point_cloud_pool;
+
   // input
   tactic::Cache<const sensor_msgs::msg::PointCloud2> pointcloud_msg;  // ros
   tactic::Cache<const Eigen::MatrixXd> points;  // alternative input non-ros
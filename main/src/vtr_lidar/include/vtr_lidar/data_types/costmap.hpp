@@ -25,6 +25,7 @@
 
 #include "vtr_common/conversions/ros_lgmath.hpp"
 #include "vtr_common/utils/hash.hpp"  // for std::pair hash
+#include "vtr_tactic/obstacle_grid.hpp"
 #include "vtr_tactic/types.hpp"
 
 namespace vtr {
@@ -72,6 +73,13 @@ class BaseCostMap {
   using XY2ValueMap = std::unordered_map<std::pair<float, float>, float>;
   virtual XY2ValueMap filter(const float& threshold) const = 0;
 
+  /**
+   * \brief Returns cells with value >= threshold as a dense obstacle grid
+   * covering this cost map, cell (x, y) of the grid holds pixel key (x, y).
+   */
+  virtual tactic::ObstacleGrid::Ptr toObstacleGrid(
+      const float& threshold) const = 0;
+
  public:
   float dl() const { return dl_; }
   virtual tactic::EdgeTransform& T_vertex_this() { return T_vertex_this_; }
@@ -137,6 +145,8 @@ class DenseCostMap : public BaseCostMap {
   void update(const std::unordered_map<std::pair<float,float>, float> values);
 
   XY2ValueMap filter(const float& threshold) const override;
+  tactic::ObstacleGrid::Ptr toObstacleGrid(
+      const float& threshold) const override;
 
   /** \brief Returns content of this class as a OccupancyGrid message. */
   using CostMapMsg = nav_msgs::msg::OccupancyGrid;
@@ -182,6 +192,8 @@ class SparseCostMap : public BaseCostMap {
   DenseCostMap toDense() const;
 
   XY2ValueMap filter(const float& threshold) const override;
+  tactic::ObstacleGrid::Ptr toObstacleGrid(
+      const float& threshold) const override;
 
   /** \brief Returns content of this class as a OccupancyGrid message. */
   using CostMapMsg = nav_msgs::msg::OccupancyGrid;
@@ -20,6 +20,7 @@
 
 #include "vtr_lidar/data_types/pointmap.hpp"
 
+#include "vtr_lidar_msgs/msg/chunked_multi_exp_point_map.hpp"
 #include "vtr_lidar_msgs/msg/multi_exp_point_map.hpp"
 
 namespace vtr {
@@ -32,10 +33,17 @@ class MultiExpPointMap : public PointMap<PointT> {
   PTR_TYPEDEFS(MultiExpPointMap<PointT>);
 
   using MultiExpPointMapMsg = vtr_lidar_msgs::msg::MultiExpPointMap;
+  using ChunkedMultiExpPointMapMsg =
+      vtr_lidar_msgs::msg::ChunkedMultiExpPointMap;
   /** \brief Static function that constructs this class from ROS2 message */
-  static Ptr fromStorable(const MultiExpPointMapMsg& storable);
+  static Ptr fromStorable(const ChunkedMultiExpPointMapMsg& storable);
   /** \brief Returns the ROS2 message to be stored */
-  MultiExpPointMapMsg toStorable() const;
+  ChunkedMultiExpPointMapMsg toStorable() const;
+
+  /** \brief Message of streams created with the MultiExpPointMap type */
+  using LegacyStorable = MultiExpPointMapMsg;
+  static Ptr fromLegacyStorable(const MultiExpPointMapMsg& storable);
+  MultiExpPointMapMsg toLegacyStorable() const;
 
   MultiExpPointMap(const float& dl, const size_t& max_num_exps);
 
@@ -45,6 +53,12 @@ class MultiExpPointMap : public PointMap<PointT> {
   const std::deque<uint32_t>& exps() const { return exps_; }
 
  private:
+  /** \brief Loads from msg, with the points in chunk_file if not empty */
+  static Ptr fromMsg(const MultiExpPointMapMsg& msg,
+                     const std::string& chunk_file);
+  /** \brief Saves all but the points into msg */
+  void toMsg(MultiExpPointMapMsg& msg) const;
+
   /** \brief Maximum number of experiences */
   size_t max_num_exps_;
   /** \brief Experience Id vector */
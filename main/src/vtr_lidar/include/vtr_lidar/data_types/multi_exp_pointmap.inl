@@ -23,24 +23,59 @@
 #include "pcl_conversions/pcl_conversions.h"
 
 #include "vtr_common/conversions/ros_lgmath.hpp"
+#include "vtr_lidar/data_types/point_chunk.hpp"
 #include "vtr_logging/logging.hpp"
 
 namespace vtr {
 namespace lidar {
 
 template <class PointT>
-auto MultiExpPointMap<PointT>::fromStorable(const MultiExpPointMapMsg& storable)
-    -> Ptr {
+auto MultiExpPointMap<PointT>::fromStorable(
+    const ChunkedMultiExpPointMapMsg& storable) -> Ptr {
+  return fromMsg(storable.map, storable.chunk_file);
+}
+
+template <class PointT>
+auto MultiExpPointMap<PointT>::toStorable() const
+    -> ChunkedMultiExpPointMapMsg {
+  ChunkedMultiExpPointMapMsg storable;
+  // save point cloud data
+  PointChunkStore::store(this->point_cloud_, storable.map.point_cloud,
+                         storable.chunk_file, this->chunk_file_);
+  toMsg(storable.map);
+  return storable;
+}
+
+template <class PointT>
+auto MultiExpPointMap<PointT>::fromLegacyStorable(
+    const MultiExpPointMapMsg& storable) -> Ptr {
+  return fromMsg(storable, "");
+}
+
+template <class PointT>
+auto MultiExpPointMap<PointT>::toLegacyStorable() const
+    -> MultiExpPointMapMsg {
+  MultiExpPointMapMsg storable;
+  // save point cloud data
+  pcl::toROSMsg(this->point_cloud_, storable.point_cloud);
+  toMsg(storable);
+  return storable;
+}
+
+template <class PointT>
+auto MultiExpPointMap<PointT>::fromMsg(const MultiExpPointMapMsg& msg,
+                                       const std::string& chunk_file) -> Ptr {
   // construct with dl and version
-  auto data = std::make_shared<MultiExpPointMap<PointT>>(storable.dl,
-                                                         storable.max_num_exps);
+  auto data =
+      std::make_shared<MultiExpPointMap<PointT>>(msg.dl, msg.max_num_exps);
   // load point cloud data
-  pcl::fromROSMsg(storable.point_cloud, data->point_cloud_);
+  PointChunkStore::load(msg.point_cloud, chunk_file, data->point_cloud_,
+                        data->chunk_file_);
   // load vertex id
-  data->vertex_id_ = tactic::VertexId(storable.vertex_id);
+  data->vertex_id_ = tactic::VertexId(msg.vertex_id);
   // load transform
   using namespace vtr::common;
-  conversions::fromROSMsg(storable.t_vertex_this, data->T_vertex_this_);
+  conversions::fromROSMsg(msg.t_vertex_this, data->T_vertex_this_);
   // build voxel map
   data->samples_.clear();
   data->samples_.reserve(data->point_cloud_.size());
@@ -54,28 +89,24 @@ auto MultiExpPointMap<PointT>::fromStorable(const MultiExpPointMapMsg& storable)
     i++;
   }
   // build the experience queue
-  for (const auto& vid : storable.experiences) data->exps_.emplace_back(vid);
+  for (const auto& vid : msg.experiences) data->exps_.emplace_back(vid);
 
   return data;
 }
 
 template <class PointT>
-auto MultiExpPointMap<PointT>::toStorable() const -> MultiExpPointMapMsg {
-  MultiExpPointMapMsg storable;
-  // save point cloud data
-  pcl::toROSMsg(this->point_cloud_, storable.point_cloud);
+void MultiExpPointMap<PointT>::toMsg(MultiExpPointMapMsg& msg) const {
   // save vertex id
-  storable.vertex_id = this->vertex_id_;
+  msg.vertex_id = this->vertex_id_;
   // save transform
   using namespace vtr::common;
-  conversions::toROSMsg(this->T_vertex_this_, storable.t_vertex_this);
+  conversions::toROSMsg(this->T_vertex_this_, msg.t_vertex_this);
   // save voxel size
-  storable.dl = this->dl_;
+  msg.dl = this->dl_;
   // save max number of experiences
-  storable.max_num_exps = max_num_exps_;
+  msg.max_num_exps = max_num_exps_;
   // save experiences
-  storable.experiences = std::vector<uint32_t>(exps_.begin(), exps_.end());
-  return storable;
+  msg.experiences = std::vector<uint32_t>(exps_.begin(), exps_.end());
 }
 
 template <class PointT>
@@ -138,7 +169,7 @@ void MultiExpPointMap<PointT>::update(const PointMap<PointT>& point_map) {
       if (this->samples_.count(k) < 1)
         initSample(k, p);
       else
-        updateSample(this->samples_[k], p);
+        updateSample(*this->samples_.find(k), p);
       /// \todo point cloud maybe sparse, so probably also need to update its
       /// spatial neighbors (based on normal agreement)
     }
@@ -0,0 +1,242 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file point_chunk.hpp
+ * \brief MappedPointChunk and PointChunkStore class definition
+ */
+#pragma once
+
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+#include "pcl/point_cloud.h"
+#include "pcl_conversions/pcl_conversions.h"
+
+namespace vtr {
+namespace lidar {
+
+/**
+ * \brief A point chunk file mapped read-only into memory.
+ * \details A chunk file is a 64-byte header followed by the raw point array,
+ * so the points are 64-byte aligned in the (page aligned) mapping:
+ *   magic "VTRPTCK", format version, point size, number of points, width,
+ *   height and is_dense of the point cloud, offset of the points.
+ * Chunk files are never modified, a storable stored again with other points
+ * writes a new one.
+ */
+class MappedPointChunk {
+ public:
+  using Ptr = std::shared_ptr<MappedPointChunk>;
+  using ConstPtr = std::shared_ptr<const MappedPointChunk>;
+
+  static constexpr char magic[8] = "VTRPTCK";
+  static constexpr uint32_t format_version = 1;
+
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t point_size;
+    uint64_t num_points;
+    uint32_t width;
+    uint32_t height;
+    uint8_t is_dense;
+    uint8_t reserved[15];
+    uint64_t data_offset;
+  };
+  static_assert(sizeof(Header) <= 64, "chunk header must fit in 64 bytes");
+  static constexpr size_t header_size = 64;
+
+  /** \brief Maps a chunk file, throws if it is invalid or of another point */
+  MappedPointChunk(const std::filesystem::path &path, const size_t point_size);
+  ~MappedPointChunk();
+
+  MappedPointChunk(const MappedPointChunk &) = delete;
+  MappedPointChunk &operator=(const MappedPointChunk &) = delete;
+
+  const Header &header() const { return *static_cast<const Header *>(addr_); }
+  size_t size() const { return header().num_points; }
+  const void *data() const {
+    return static_cast<const uint8_t *>(addr_) + header().data_offset;
+  }
+
+  /**
+   * \brief Writes a chunk file atomically (write, then rename), without
+   * syncing it to disk: PointChunkStore leaves that to the data stream commit.
+   */
+  static void write(const std::filesystem::path &path, const void *data,
+                    const size_t point_size, const Header &header);
+
+ private:
+  void *addr_ = nullptr;
+  size_t length_ = 0;
+};
+
+/**
+ * \brief Chunk files a storable was loaded from or last stored to, one per
+ * data stream, so that storing it again replaces the file of that stream
+ * instead of leaving it behind, or keeps it if the points are unchanged. A
+ * storable written to several streams (e.g. pointmap and pointmap_v0) thus
+ * never replaces the file another stream refers to.
+ * \note copies start without files: a copy is stored as another message and
+ * must not replace the chunk files of the original, whereas assigning keeps the
+ * files of the storable assigned to (Message::setData).
+ */
+class PointChunkFile {
+ public:
+  PointChunkFile() = default;
+  PointChunkFile(const PointChunkFile &) {}
+  PointChunkFile &operator=(const PointChunkFile &) { return *this; }
+
+ private:
+  struct File {
+    std::string name;
+    /** \brief hash of the points stored, 0 if unknown (loaded) */
+    size_t hash = 0;
+  };
+
+  std::mutex mutex_;
+  /**
+   * \brief chunk files by data directory of the stream, the empty key outside
+   * of any (see DataStreamAccessorBase::StorableScope)
+   */
+  std::unordered_map<std::string, File> files_;
+
+  friend class PointChunkStore;
+};
+
+/**
+ * \brief Optional storage backend of point cloud storables: point arrays are
+ * written as chunk files in a directory next to the graph database, and the
+ * storable message only keeps the chunk file name. Loading maps the file and
+ * copies the points into the point cloud in one go, instead of deserializing
+ * a PointCloud2 message field by field.
+ * \details Chunk files written for a data stream are synced to disk once per
+ * commit of the stream, before the messages referring to them, and the files
+ * they replace are removed after it (see DataStreamAccessorBase::syncOnCommit).
+ * Outside of a data stream nothing refers to the file durably, so it is not
+ * synced and the replaced file is removed right away.
+ * \note configured once per process, messages that refer to chunk files can
+ * be loaded even if writing is disabled. If the directory is not configured,
+ * chunks are loaded from the default directory of the graph being read.
+ */
+class PointChunkStore {
+ public:
+  /**
+   * \param directory where chunk files are stored
+   * \param write_chunks whether storables write chunk files, otherwise they
+   * keep using PointCloud2 messages
+   */
+  static void configure(const std::filesystem::path &directory,
+                        const bool write_chunks);
+  static std::filesystem::path directory();
+  static bool writeChunks();
+
+  /** \brief Chunk directory of the graph stored at graph_path */
+  static std::filesystem::path defaultDirectory(
+      const std::filesystem::path &graph_path);
+
+  /**
+   * \brief Stores point_cloud in a chunk file if enabled, setting chunk_file
+   * to its name, otherwise converts it into msg.
+   * \param file chunk files of the storable, the one of the stream being
+   * written is kept if point_cloud is unchanged, replaced otherwise, and
+   * removed if point_cloud is converted into msg instead
+   */
+  template <class PointT>
+  static void store(const pcl::PointCloud<PointT> &point_cloud,
+                    sensor_msgs::msg::PointCloud2 &msg,
+                    std::string &chunk_file, PointChunkFile &file);
+
+  /**
+   * \brief Loads point_cloud from chunk_file if not empty, otherwise msg
+   * \param file chunk file of the stream being read set to chunk_file, so that
+   * storing to the stream replaces it
+   */
+  template <class PointT>
+  static void load(const sensor_msgs::msg::PointCloud2 &msg,
+                   const std::string &chunk_file,
+                   pcl::PointCloud<PointT> &point_cloud, PointChunkFile &file);
+
+ private:
+  /** \brief Key of the stream the calling thread converts a storable for */
+  static std::string currentStream();
+  /**
+   * \brief Writes a uniquely named chunk file replacing the one of a storable
+   * for the current stream, unless the points are unchanged, returns the name
+   */
+  static std::string write(PointChunkFile &file, const void *data,
+                           const size_t point_size,
+                           const MappedPointChunk::Header &header);
+  /** \brief Removes the chunk file of a storable for the current stream */
+  static void remove(PointChunkFile &file);
+  /** \brief Removes a replaced chunk file, once replaced in storage */
+  static void removeReplaced(const std::filesystem::path &path);
+  static MappedPointChunk::ConstPtr map(const std::string &chunk_file,
+                                        const size_t point_size);
+};
+
+template <class PointT>
+void PointChunkStore::store(const pcl::PointCloud<PointT> &point_cloud,
+                            sensor_msgs::msg::PointCloud2 &msg,
+                            std::string &chunk_file, PointChunkFile &file) {
+  static_assert(std::is_trivially_copyable_v<PointT>,
+                "points are stored as raw memory");
+  if (!writeChunks()) {
+    pcl::toROSMsg(point_cloud, msg);
+    chunk_file.clear();
+    remove(file);
+    return;
+  }
+  MappedPointChunk::Header header{};
+  header.num_points = point_cloud.size();
+  header.width = point_cloud.width;
+  header.height = point_cloud.height;
+  header.is_dense = point_cloud.is_dense;
+  chunk_file = write(file, point_cloud.points.data(), sizeof(PointT), header);
+}
+
+template <class PointT>
+void PointChunkStore::load(const sensor_msgs::msg::PointCloud2 &msg,
+                           const std::string &chunk_file,
+                           pcl::PointCloud<PointT> &point_cloud,
+                           PointChunkFile &file) {
+  {
+    const auto stream = currentStream();
+    const std::lock_guard<std::mutex> lock(file.mutex_);
+    if (chunk_file.empty())
+      file.files_.erase(stream);
+    else
+      file.files_[stream] = {chunk_file, 0};
+  }
+  if (chunk_file.empty()) {
+    pcl::fromROSMsg(msg, point_cloud);
+    return;
+  }
+  const auto chunk = map(chunk_file, sizeof(PointT));
+  point_cloud.resize(chunk->size());
+  std::memcpy(static_cast<void *>(point_cloud.points.data()), chunk->data(),
+              chunk->size() * sizeof(PointT));
+  point_cloud.width = chunk->header().width;
+  point_cloud.height = chunk->header().height;
+  point_cloud.is_dense = chunk->header().is_dense;
+}
+
+}  // namespace lidar
+}  // namespace vtr
@@ -20,7 +20,11 @@
 
 #include "vtr_common/utils/hash.hpp"
 #include "vtr_lidar/data_types/pointscan.hpp"
+#include "vtr_lidar/utils/incremental_kdtree.hpp"
+#include "vtr_lidar/utils/nanoflann_utils.hpp"
+#include "vtr_lidar/utils/voxel_hash_map.hpp"
 
+#include "vtr_lidar_msgs/msg/chunked_point_map.hpp"
 #include "vtr_lidar_msgs/msg/point_map.hpp"
 
 namespace vtr {
@@ -65,15 +69,21 @@ class PointMap : public PointScan<PointT> {
   PTR_TYPEDEFS(PointMap<PointT>);
 
   using PointMapMsg = vtr_lidar_msgs::msg::PointMap;
+  using ChunkedPointMapMsg = vtr_lidar_msgs::msg::ChunkedPointMap;
   /// constexpr of map version enum (keep in sync with the msg)
   static constexpr unsigned INITIAL = PointMapMsg::INITIAL;
   static constexpr unsigned INTRA_EXP_MERGED = PointMapMsg::INTRA_EXP_MERGED;
   static constexpr unsigned DYNAMIC_REMOVED = PointMapMsg::DYNAMIC_REMOVED;
   static constexpr unsigned INTER_EXP_MERGED = PointMapMsg::INTER_EXP_MERGED;
   /** \brief Static function that constructs this class from ROS2 message */
-  static Ptr fromStorable(const PointMapMsg& storable);
+  static Ptr fromStorable(const ChunkedPointMapMsg& storable);
   /** \brief Returns the ROS2 message to be stored */
-  PointMapMsg toStorable() const;
+  ChunkedPointMapMsg toStorable() const;
+
+  /** \brief Message of streams created with the PointMap type */
+  using LegacyStorable = PointMapMsg;
+  static Ptr fromLegacyStorable(const PointMapMsg& storable);
+  PointMapMsg toLegacyStorable() const;
 
   PointMap(const float& dl, const unsigned& version = INITIAL)
       : dl_(dl), version_(version) {}
@@ -98,7 +108,31 @@ class PointMap : public PointScan<PointT> {
   template <class Callback = DefaultFilterCb>
   void filter(const Callback& callback = DefaultFilterCb());
 
+  /**
+   * \brief Returns a kd-tree over the map points. The first call builds it,
+   * after which update and filter keep it in sync incrementally.
+   * \note update callbacks must not move existing points once it is built.
+   * \note copies of the map start without the tree.
+   */
+  const IncrementalKDTree<PointT>& kdtree();
+
+  /**
+   * \brief Returns a static kd-tree over the map points, built by the first
+   * caller and shared until the map changes. Thread safe, meant for maps that
+   * are no longer updated such as the localization submap.
+   * \note The tree refers to the points of this map, so holders must keep the
+   * map alive.
+   */
+  typename StaticKDTree<PointT>::ConstPtr staticKDTree() const {
+    return static_kdtree_.get(this->point_cloud_);
+  }
+
  protected:
+  /** \brief Loads from msg, with the points in chunk_file if not empty */
+  static Ptr fromMsg(const PointMapMsg& msg, const std::string& chunk_file);
+  /** \brief Saves all but the points into msg */
+  void toMsg(PointMapMsg& msg) const;
+
   using VoxKey = pointmap::VoxKey;
   VoxKey getKey(const PointT& p) const {
     return VoxKey((int)std::floor(p.x / dl_), (int)std::floor(p.y / dl_),
@@ -111,7 +145,11 @@ class PointMap : public PointScan<PointT> {
   /** \brief Version of the map */
   unsigned version_;
   /** \brief Sparse hashmap that contain voxels and map to point indices */
-  std::unordered_map<VoxKey, size_t> samples_;
+  VoxelHashMap<size_t> samples_;
+  /** \brief Spatial index over point_cloud_, maintained once built */
+  LazyIncrementalKDTree<PointT> kdtree_{/* leaf size */ 32};
+  /** \brief Immutable spatial index over point_cloud_, dropped on changes */
+  LazyStaticKDTree<PointT> static_kdtree_;
 };
 
 }  // namespace lidar
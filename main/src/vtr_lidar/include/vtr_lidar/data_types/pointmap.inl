@@ -23,21 +23,53 @@
 #include "pcl_conversions/pcl_conversions.h"
 
 #include "vtr_common/conversions/ros_lgmath.hpp"
+#include "vtr_lidar/data_types/point_chunk.hpp"
 
 namespace vtr {
 namespace lidar {
 
 template <class PointT>
-auto PointMap<PointT>::fromStorable(const PointMapMsg& storable) -> Ptr {
+auto PointMap<PointT>::fromStorable(const ChunkedPointMapMsg& storable) -> Ptr {
+  return fromMsg(storable.map, storable.chunk_file);
+}
+
+template <class PointT>
+auto PointMap<PointT>::toStorable() const -> ChunkedPointMapMsg {
+  ChunkedPointMapMsg storable;
+  // save point cloud data
+  PointChunkStore::store(this->point_cloud_, storable.map.point_cloud,
+                         storable.chunk_file, this->chunk_file_);
+  toMsg(storable.map);
+  return storable;
+}
+
+template <class PointT>
+auto PointMap<PointT>::fromLegacyStorable(const PointMapMsg& storable) -> Ptr {
+  return fromMsg(storable, "");
+}
+
+template <class PointT>
+auto PointMap<PointT>::toLegacyStorable() const -> PointMapMsg {
+  PointMapMsg storable;
+  // save point cloud data
+  pcl::toROSMsg(this->point_cloud_, storable.point_cloud);
+  toMsg(storable);
+  return storable;
+}
+
+template <class PointT>
+auto PointMap<PointT>::fromMsg(const PointMapMsg& msg,
+                               const std::string& chunk_file) -> Ptr {
   // construct with dl and version
-  auto data = std::make_shared<PointMap<PointT>>(storable.dl, storable.version);
+  auto data = std::make_shared<PointMap<PointT>>(msg.dl, msg.version);
   // load point cloud data
-  pcl::fromROSMsg(storable.point_cloud, data->point_cloud_);
+  PointChunkStore::load(msg.point_cloud, chunk_file, data->point_cloud_,
+                        data->chunk_file_);
   // load vertex id
-  data->vertex_id_ = tactic::VertexId(storable.vertex_id);
+  data->vertex_id_ = tactic::VertexId(msg.vertex_id);
   // load transform
   using namespace vtr::common;
-  conversions::fromROSMsg(storable.t_vertex_this, data->T_vertex_this_);
+  conversions::fromROSMsg(msg.t_vertex_this, data->T_vertex_this_);
   // build voxel map
   data->samples_.clear();
   data->samples_.reserve(data->point_cloud_.size());
@@ -54,38 +86,39 @@ auto PointMap<PointT>::fromStorable(const PointMapMsg& storable) -> Ptr {
 }
 
 template <class PointT>
-auto PointMap<PointT>::toStorable() const -> PointMapMsg {
-  PointMapMsg storable;
-  // save point cloud data
-  pcl::toROSMsg(this->point_cloud_, storable.point_cloud);
+void PointMap<PointT>::toMsg(PointMapMsg& msg) const {
   // save vertex id
-  storable.vertex_id = this->vertex_id_;
+  msg.vertex_id = this->vertex_id_;
   // save transform
   using namespace vtr::common;
-  conversions::toROSMsg(this->T_vertex_this_, storable.t_vertex_this);
+  conversions::toROSMsg(this->T_vertex_this_, msg.t_vertex_this);
   // save version
-  storable.version = this->version_;
+  msg.version = this->version_;
   // save voxel size
-  storable.dl = this->dl_;
-  return storable;
+  msg.dl = this->dl_;
 }
 
 template <class PointT>
 template <class Callback>
 void PointMap<PointT>::update(const PointCloudType& point_cloud,
                               const Callback& callback) {
-  // reserve new space if needed
-  if (samples_.empty()) samples_.reserve(10 * point_cloud.size());
-  this->point_cloud_.reserve(this->point_cloud_.size() + point_cloud.size());
+  // reserve new space if needed (the voxel table grows by rehashing later)
+  if (samples_.empty()) samples_.reserve(4 * point_cloud.size());
+  const size_t prev_size = this->point_cloud_.size();
+  this->point_cloud_.reserve(prev_size + point_cloud.size());
 
   // Update the current map
   for (auto& p : point_cloud) {
     const auto res = samples_.try_emplace(getKey(p), this->point_cloud_.size());
     if (res.second) this->point_cloud_.emplace_back(p);
     callback(/* success */ res.second,
-             /* curr_pt */ this->point_cloud_[res.first->second],
+             /* curr_pt */ this->point_cloud_[*res.first],
              /* new_pt */ p);
   }
+
+  // index the newly added points
+  static_kdtree_.reset();
+  kdtree_.insert(this->point_cloud_, prev_size, this->point_cloud_.size());
 }
 
 template <class PointT>
@@ -100,6 +133,13 @@ void PointMap<PointT>::filter(const Callback& callback) {
   // create a copy of the point cloud and apply filter
   const auto point_cloud = this->point_cloud_;
   pcl::copyPointCloud(point_cloud, indices, this->point_cloud_);
+  // point indices shifted, update the kd-tree instead of rebuilding it
+  static_kdtree_.reset();
+  if (kdtree_.built()) {
+    std::vector<int> old_to_new(point_cloud.size(), -1);
+    for (size_t i = 0; i < indices.size(); ++i) old_to_new[indices[i]] = i;
+    kdtree_.reindex(old_to_new);
+  }
   // rebuild the voxel map
   samples_.clear();
   samples_.reserve(this->point_cloud_.size());
@@ -112,5 +152,10 @@ void PointMap<PointT>::filter(const Callback& callback) {
   }
 }
 
+template <class PointT>
+const IncrementalKDTree<PointT>& PointMap<PointT>::kdtree() {
+  return kdtree_.get(this->point_cloud_);
+}
+
 }  // namespace lidar
 }  // namespace vtr
\ No newline at end of file
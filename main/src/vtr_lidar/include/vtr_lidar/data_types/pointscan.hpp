@@ -20,8 +20,10 @@
 
 #include "pcl/point_cloud.h"
 
+#include "vtr_lidar/data_types/point_chunk.hpp"
 #include "vtr_tactic/types.hpp"
 
+#include "vtr_lidar_msgs/msg/chunked_point_scan.hpp"
 #include "vtr_lidar_msgs/msg/point_scan.hpp"
 
 namespace vtr {
@@ -34,10 +36,16 @@ class PointScan {
   PTR_TYPEDEFS(PointScan<PointT>);
 
   using PointScanMsg = vtr_lidar_msgs::msg::PointScan;
+  using ChunkedPointScanMsg = vtr_lidar_msgs::msg::ChunkedPointScan;
   /** \brief Static function that constructs this class from ROS2 message */
-  static Ptr fromStorable(const PointScanMsg& storable);
+  static Ptr fromStorable(const ChunkedPointScanMsg& storable);
   /** \brief Returns the ROS2 message to be stored */
-  PointScanMsg toStorable() const;
+  ChunkedPointScanMsg toStorable() const;
+
+  /** \brief Message of streams created with the PointScan type */
+  using LegacyStorable = PointScanMsg;
+  static Ptr fromLegacyStorable(const PointScanMsg& storable);
+  PointScanMsg toLegacyStorable() const;
 
   virtual ~PointScan() = default;
 
@@ -53,11 +61,18 @@ class PointScan {
   const tactic::EdgeTransform& T_vertex_this() const { return T_vertex_this_; }
 
  protected:
+  /** \brief Loads from msg, with the points in chunk_file if not empty */
+  static Ptr fromMsg(const PointScanMsg& msg, const std::string& chunk_file);
+  /** \brief Saves all but the points into msg */
+  void toMsg(PointScanMsg& msg) const;
+
   PointCloudType point_cloud_;
   /** \brief the associated vertex id */
   tactic::VertexId vertex_id_ = tactic::VertexId::Invalid();
   /** \brief the transform from this scan/map to its associated vertex */
   tactic::EdgeTransform T_vertex_this_ = tactic::EdgeTransform(true);
+  /** \brief chunk file storing point_cloud_, replaced when stored again */
+  mutable PointChunkFile chunk_file_;
 };
 
 }  // namespace lidar
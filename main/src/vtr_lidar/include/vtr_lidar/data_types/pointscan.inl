@@ -23,35 +23,65 @@
 #include "pcl_conversions/pcl_conversions.h"
 
 #include "vtr_common/conversions/ros_lgmath.hpp"
+#include "vtr_lidar/data_types/point_chunk.hpp"
 
 namespace vtr {
 namespace lidar {
 
 template <class PointT>
-auto PointScan<PointT>::fromStorable(const PointScanMsg& storable) -> Ptr {
+auto PointScan<PointT>::fromStorable(const ChunkedPointScanMsg& storable)
+    -> Ptr {
+  return fromMsg(storable.scan, storable.chunk_file);
+}
+
+template <class PointT>
+auto PointScan<PointT>::toStorable() const -> ChunkedPointScanMsg {
+  ChunkedPointScanMsg storable;
+  // save point cloud data
+  PointChunkStore::store(this->point_cloud_, storable.scan.point_cloud,
+                         storable.chunk_file, this->chunk_file_);
+  toMsg(storable.scan);
+  return storable;
+}
+
+template <class PointT>
+auto PointScan<PointT>::fromLegacyStorable(const PointScanMsg& storable)
+    -> Ptr {
+  return fromMsg(storable, "");
+}
+
+template <class PointT>
+auto PointScan<PointT>::toLegacyStorable() const -> PointScanMsg {
+  PointScanMsg storable;
+  // save point cloud data
+  pcl::toROSMsg(this->point_cloud_, storable.point_cloud);
+  toMsg(storable);
+  return storable;
+}
+
+template <class PointT>
+auto PointScan<PointT>::fromMsg(const PointScanMsg& msg,
+                                const std::string& chunk_file) -> Ptr {
   // construct with dl
   auto data = std::make_shared<PointScan<PointT>>();
   // load point cloud data
-  pcl::fromROSMsg(storable.point_cloud, data->point_cloud_);
+  PointChunkStore::load(msg.point_cloud, chunk_file, data->point_cloud_,
+                        data->chunk_file_);
   // load vertex id
-  data->vertex_id_ = tactic::VertexId(storable.vertex_id);
+  data->vertex_id_ = tactic::VertexId(msg.vertex_id);
   // load transform
   using namespace vtr::common;
-  conversions::fromROSMsg(storable.t_vertex_this, data->T_vertex_this_);
+  conversions::fromROSMsg(msg.t_vertex_this, data->T_vertex_this_);
   return data;
 }
 
 template <class PointT>
-auto PointScan<PointT>::toStorable() const -> PointScanMsg {
-  PointScanMsg storable;
-  // save point cloud data
-  pcl::toROSMsg(this->point_cloud_, storable.point_cloud);
+void PointScan<PointT>::toMsg(PointScanMsg& msg) const {
   // save vertex id
-  storable.vertex_id = this->vertex_id_;
+  msg.vertex_id = this->vertex_id_;
   // save transform
   using namespace vtr::common;
-  conversions::toROSMsg(this->T_vertex_this_, storable.t_vertex_this);
-  return storable;
+  conversions::toROSMsg(this->T_vertex_this_, msg.t_vertex_this);
 }
 
 }  // namespace lidar
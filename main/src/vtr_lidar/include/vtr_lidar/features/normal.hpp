@@ -27,38 +27,102 @@
 namespace vtr {
 namespace lidar {
 
-template <class PointT>
-float computeNormalPCA(const pcl::PointCloud<PointT> &point_cloud,
-                       const std::vector<int> indices, PointT &query) {
-  // Safe check
-  if (indices.size() < 4) return -1.0f;
+/** \brief Principal components of a neighborhood of points */
+struct LocalPCA {
+  /** \brief Mean of the points */
+  Eigen::Vector3f centroid = Eigen::Vector3f::Zero();
+  /**
+   * \brief Eigenvalues in increasing order of the scatter matrix, i.e. the
+   * covariance not divided by the number of points, as returned by
+   * pcl::computeCovarianceMatrix
+   */
+  Eigen::Vector3f eigenvalues = Eigen::Vector3f::Zero();
+  /** \brief Eigenvectors as columns, col(0) is the surface normal */
+  Eigen::Matrix3f eigenvectors = Eigen::Matrix3f::Identity();
+};
 
-  // Get points for computation
-  const pcl::PointCloud<PointT> points(point_cloud, indices);
+/**
+ * \brief Computes the PCA of the points at size (>= 1) indices of point_cloud.
+ * \details Moments are accumulated in one pass over the indices, relative to
+ * the first point so that float sums keep their precision far from the
+ * origin, and the 3x3 scatter matrix is decomposed in closed form (in double,
+ * which is more accurate than the iterative float solver it replaces).
+ */
+template <class PointT, class IndexT>
+void computeLocalPCA(const pcl::PointCloud<PointT> &point_cloud,
+                     const IndexT *indices, const size_t size, LocalPCA &pca) {
+  const auto &origin = point_cloud[indices[0]];
+  float sx = 0, sy = 0, sz = 0;
+  float sxx = 0, sxy = 0, sxz = 0, syy = 0, syz = 0, szz = 0;
+  for (size_t i = 0; i < size; ++i) {
+    const auto &p = point_cloud[indices[i]];
+    const float x = p.x - origin.x, y = p.y - origin.y, z = p.z - origin.z;
+    sx += x, sy += y, sz += z;
+    sxx += x * x, sxy += x * y, sxz += x * z;
+    syy += y * y, syz += y * z, szz += z * z;
+  }
+  const float mx = sx / size, my = sy / size, mz = sz / size;
+
+  Eigen::Matrix3d scatter;
+  scatter(0, 0) = sxx - sx * mx;
+  scatter(1, 1) = syy - sy * my;
+  scatter(2, 2) = szz - sz * mz;
+  scatter(0, 1) = scatter(1, 0) = sxy - sx * my;
+  scatter(0, 2) = scatter(2, 0) = sxz - sx * mz;
+  scatter(1, 2) = scatter(2, 1) = syz - sy * mz;
+
+  Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> es;
+  es.computeDirect(scatter);
+
+  pca.centroid = origin.getVector3fMap() + Eigen::Vector3f(mx, my, mz);
+  // the scatter matrix is positive semi-definite, clamp rounding errors
+  pca.eigenvalues = es.eigenvalues().cwiseMax(0.0).cast<float>();
+  pca.eigenvectors = es.eigenvectors().cast<float>();
+}
 
-  // Placeholder for the 3x3 covariance matrix at each surface patch
-  Eigen::Matrix3f covariance_matrix;
-  // 16-bytes aligned placeholder for the XYZ centroid of a surface patch
-  Eigen::Vector4f xyz_centroid;
+template <class PointT, class IndexT>
+void computeLocalPCA(const pcl::PointCloud<PointT> &point_cloud,
+                     const std::vector<IndexT> &indices, LocalPCA &pca) {
+  computeLocalPCA(point_cloud, indices.data(), indices.size(), pca);
+}
 
-  // Estimate the XYZ centroid
-  pcl::compute3DCentroid(points, xyz_centroid);
+/**
+ * \brief Computes the PCA of all neighborhoods in parallel, stored as
+ * compressed rows: neighborhood i is indices[offsets[i], offsets[i + 1]).
+ * Neighborhoods of less than min_size points keep a default LocalPCA.
+ */
+template <class PointT, class IndexT>
+std::vector<LocalPCA> computeLocalPCA(
+    const pcl::PointCloud<PointT> &point_cloud,
+    const std::vector<IndexT> &indices, const std::vector<size_t> &offsets,
+    const size_t min_size, const int parallel_threads) {
+  const size_t num_queries = offsets.empty() ? 0 : offsets.size() - 1;
+  std::vector<LocalPCA> pcas(num_queries);
+#pragma omp parallel for schedule(static, 256) num_threads(parallel_threads)
+  for (size_t i = 0; i < num_queries; ++i) {
+    const size_t size = offsets[i + 1] - offsets[i];
+    if (size == 0 || size < min_size) continue;
+    computeLocalPCA(point_cloud, indices.data() + offsets[i], size, pcas[i]);
+  }
+  return pcas;
+}
 
-  // Compute the 3x3 covariance matrix
-  pcl::computeCovarianceMatrix(points, xyz_centroid, covariance_matrix);
+template <class PointT>
+float computeNormalPCA(const pcl::PointCloud<PointT> &point_cloud,
+                       const std::vector<int> &indices, PointT &query) {
+  // Safe check
+  if (indices.size() < 4) return -1.0f;
 
-  // Compute pca
-  Eigen::SelfAdjointEigenSolver<Eigen::Matrix3f> es;
-  es.compute(covariance_matrix);
+  LocalPCA pca;
+  computeLocalPCA(point_cloud, indices, pca);
 
   // Orient normal so that it always faces lidar origin
+  const Eigen::Vector3f normal = pca.eigenvectors.col(0);
   query.getNormalVector3fMap() =
-      es.eigenvectors().col(0).dot(query.getVector3fMap()) > 0
-          ? -Eigen::Vector3f(es.eigenvectors().col(0))
-          : Eigen::Vector3f(es.eigenvectors().col(0));
+      normal.dot(query.getVector3fMap()) > 0 ? Eigen::Vector3f(-normal) : normal;
 
   // Score is 1 - sphericity equivalent to planarity + linearity
-  query.normal_score = 1.f - es.eigenvalues()(0) / (es.eigenvalues()(2) + 1e-9);
+  query.normal_score = 1.f - pca.eigenvalues(0) / (pca.eigenvalues(2) + 1e-9);
 
   return query.normal_score;
 }
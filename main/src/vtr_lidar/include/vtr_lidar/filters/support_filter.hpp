@@ -0,0 +1,98 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file support_filter.hpp
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "pcl/point_cloud.h"
+
+namespace vtr {
+namespace lidar {
+
+/**
+ * \brief Support of each change point (flex23 != 0) from the other change
+ * points within radius, each weighted by flex23 * exp(-d^2 / (2 * variance)).
+ * \details Only change points give support, so they are binned into a 2D grid
+ * of radius-sized cells (counting sort) and the neighbors of a point are found
+ * in the 3x3 cells around it.
+ * \param changes indices of the change points, as returned in this order
+ * \return support of each point in changes
+ */
+template <class PointT>
+std::vector<float> supportSum(const pcl::PointCloud<PointT>& points,
+                              const std::vector<size_t>& changes,
+                              const float& radius, const float& variance,
+                              const int num_threads = 1) {
+  const float cell_size = radius;
+  float min_x = std::numeric_limits<float>::max(), min_y = min_x;
+  float max_x = std::numeric_limits<float>::lowest(), max_y = max_x;
+  for (const auto& i : changes) {
+    min_x = std::min(min_x, points[i].x), max_x = std::max(max_x, points[i].x);
+    min_y = std::min(min_y, points[i].y), max_y = std::max(max_y, points[i].y);
+  }
+  const int size_x = changes.empty() ? 0 : int((max_x - min_x) / cell_size) + 1;
+  const int size_y = changes.empty() ? 0 : int((max_y - min_y) / cell_size) + 1;
+  const auto cell_x = [&](const PointT& p) {
+    return std::min(int((p.x - min_x) / cell_size), size_x - 1);
+  };
+  const auto cell_y = [&](const PointT& p) {
+    return std::min(int((p.y - min_y) / cell_size), size_y - 1);
+  };
+
+  // counting sort of the change points by cell
+  std::vector<size_t> offsets(size_t(size_x) * size_y + 1, 0);
+  for (const auto& i : changes)
+    ++offsets[cell_x(points[i]) * size_y + cell_y(points[i]) + 1];
+  for (size_t c = 1; c < offsets.size(); c++) offsets[c] += offsets[c - 1];
+  std::vector<size_t> binned(changes.size());
+  {
+    auto next = offsets;
+    for (const auto& i : changes)
+      binned[next[cell_x(points[i]) * size_y + cell_y(points[i])]++] = i;
+  }
+
+  const float sq_radius = radius * radius;
+  std::vector<float> support(changes.size(), 0.0f);
+#pragma omp parallel for schedule(dynamic, 64) num_threads(num_threads)
+  for (size_t k = 0; k < changes.size(); k++) {
+    const auto& point = points[changes[k]];
+    const int x = cell_x(point), y = cell_y(point);
+    for (int nx = std::max(x - 1, 0); nx <= std::min(x + 1, size_x - 1); nx++) {
+      for (int ny = std::max(y - 1, 0); ny <= std::min(y + 1, size_y - 1);
+           ny++) {
+        const size_t cell = nx * size_y + ny;
+        for (size_t b = offsets[cell]; b < offsets[cell + 1]; b++) {
+          if (binned[b] == changes[k]) continue;
+          const auto& neighbor = points[binned[b]];
+          const float sq_dist =
+              (neighbor.getVector3fMap() - point.getVector3fMap())
+                  .squaredNorm();
+          if (sq_dist >= sq_radius) continue;
+          support[k] += neighbor.flex23 * std::exp(-sq_dist / (2 * variance));
+        }
+      }
+    }
+  }
+  return support;
+}
+
+}  // namespace lidar
+}  // namespace vtr
@@ -20,6 +20,8 @@
 
 #include "pcl/point_cloud.h"
 
+#include "vtr_lidar/utils/voxel_hash_map.hpp"
+
 namespace vtr {
 namespace lidar {
 
@@ -118,42 +120,29 @@ void voxelDownsample(pcl::PointCloud<PointT>& point_cloud,
   // Inverse of sample dl
   float inv_dl = 1 / sample_dl;
 
-  // Limits of the map
-  const auto minCorner = getMinPoint(point_cloud);
-  const auto maxCorner = getMaxPoint(point_cloud);
-  const auto originCorner = (minCorner * inv_dl).floor() * sample_dl;
-
-  // Dimensions of the grid
-  const auto sampleNX =
-      (size_t)std::floor((maxCorner.x - originCorner.x) * inv_dl) + 1;
-  const auto sampleNY =
-      (size_t)std::floor((maxCorner.y - originCorner.y) * inv_dl) + 1;
-
   // Create the sampled map
   // **********************
 
-  // Initialize variables
-  std::unordered_map<size_t, VoxelCenter<PointT>> samples;
-  samples.reserve(point_cloud.size());
+  // Initialize variables, voxels are kept in order of first appearance
+  VoxelHashMap<size_t> samples(point_cloud.size());
+  std::vector<VoxelCenter<PointT>> voxels;
+  voxels.reserve(point_cloud.size());
 
   size_t i = 0;
   for (const auto& p : point_cloud) {
     // Position of point in sample map
-    const auto iX = (size_t)std::floor((p.x - originCorner.x) * inv_dl);
-    const auto iY = (size_t)std::floor((p.y - originCorner.y) * inv_dl);
-    const auto iZ = (size_t)std::floor((p.z - originCorner.z) * inv_dl);
-    const auto mapIdx = iX + sampleNX * iY + sampleNX * sampleNY * iZ;
+    const auto iX = (int)std::floor(p.x * inv_dl);
+    const auto iY = (int)std::floor(p.y * inv_dl);
+    const auto iZ = (int)std::floor(p.z * inv_dl);
 
     // Fill the sample map
-    if (samples.count(mapIdx) < 1) {
-      samples.emplace(mapIdx,
-                      VoxelCenter<PointT>(
-                          i, p,
-                          Point3D(originCorner.x + (iX + 0.5) * sample_dl,
-                                  originCorner.y + (iY + 0.5) * sample_dl,
-                                  originCorner.z + (iZ + 0.5) * sample_dl)));
+    const auto res = samples.try_emplace(iX, iY, iZ, voxels.size());
+    if (res.second) {
+      voxels.emplace_back(i, p,
+                          Point3D((iX + 0.5) * sample_dl, (iY + 0.5) * sample_dl,
+                                  (iZ + 0.5) * sample_dl));
     } else {
-      samples.at(mapIdx).update(i, p);
+      voxels[*res.first].update(i, p);
     }
 
     // Increment point index
@@ -162,8 +151,8 @@ void voxelDownsample(pcl::PointCloud<PointT>& point_cloud,
 
   // Convert hmap to index vector
   std::vector<int> indices;
-  indices.reserve(samples.size());
-  for (const auto& v : samples) indices.push_back(v.second.idx);
+  indices.reserve(voxels.size());
+  for (const auto& v : voxels) indices.push_back(v.idx);
 
   // Modify the point_cloud
   point_cloud = pcl::PointCloud<PointT>(point_cloud, indices);
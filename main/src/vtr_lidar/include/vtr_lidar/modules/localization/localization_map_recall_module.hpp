@@ -21,6 +21,7 @@
 #include "sensor_msgs/msg/point_cloud2.hpp"
 
 #include "vtr_lidar/cache.hpp"
+#include "vtr_tactic/instrumentation.hpp"
 #include "vtr_tactic/modules/base_module.hpp"
 #include "vtr_tactic/task_queue.hpp"
 
@@ -40,25 +41,93 @@ class LocalizationMapRecallModule : public tactic::BaseModule {
 
     std::string map_version = "multi_exp_point_map";
 
+    /// submap prefetching along the localization chain
+    /// number of upcoming submaps loaded ahead of the robot, 0 to disable
+    int prefetch_num_submaps = 0;
+    /// look ahead max(min_distance [m], speed [m/s] * horizon [s]) on the chain
+    double prefetch_min_distance = 10.0;
+    double prefetch_horizon = 5.0;
+    /// memory of prefetched submaps that are not in use [MB]
+    double prefetch_memory_budget = 512.0;
+
     bool visualize = false;
 
     static ConstPtr fromROS(const rclcpp::Node::SharedPtr &node,
                             const std::string &param_prefix);
   };
 
+  /** \brief Submap prefetching statistics, counted on every submap change */
+  struct PrefetchStatistics {
+    /** \brief Submaps loaded by prefetching before they were needed */
+    size_t hits = 0;
+    /** \brief Submaps still being prefetched when they were needed */
+    size_t late = 0;
+    /** \brief Submaps not prefetched */
+    size_t misses = 0;
+    /** \brief Prefetched submaps unloaded before they were needed */
+    size_t evictions = 0;
+    /** \brief Memory of prefetched submaps that are not in use [bytes] */
+    size_t bytes = 0;
+  };
+
   LocalizationMapRecallModule(
       const Config::ConstPtr &config,
       const std::shared_ptr<tactic::ModuleFactory> &module_factory = nullptr,
       const std::string &name = static_name)
-      : tactic::BaseModule{module_factory, name}, config_(config) {}
+      : tactic::BaseModule{module_factory, name},
+        config_(config),
+        load_latency_{tactic::LatencyRegistry::instance().get(
+            "module." + name + ".submap_load")} {}
+
+  void reset() override;
+
+  PrefetchStatistics prefetchStatistics() const;
 
  private:
   void run_(tactic::QueryCache &qdata, tactic::OutputCache &output,
             const tactic::Graph::Ptr &graph,
             const tactic::TaskExecutor::Ptr &executor) override;
 
+  /** \brief Loads the submaps of the vertices ahead on the chain */
+  void runAsync_(tactic::QueryCache &qdata, tactic::OutputCache &output,
+                 const tactic::Graph::Ptr &graph,
+                 const tactic::TaskExecutor::Ptr &executor,
+                 const tactic::Task::Priority &priority,
+                 const tactic::Task::DepId &dep_id) override;
+
+  /** \brief Requests prefetching of the submaps ahead of the trunk */
+  void prefetch(LidarQueryCache &qdata, const tactic::OutputCache &output,
+                const tactic::TaskExecutor::Ptr &executor);
+
   Config::ConstPtr config_;
 
+  /** \brief Time to load a submap that is not in memory */
+  const tactic::LatencyHistogram::Ptr load_latency_;
+
+  struct PrefetchedSubmap {
+    /** \brief False while being loaded */
+    bool loaded = false;
+    size_t bytes = 0;
+    /** \brief Copy of the submap with its kd-tree built, ready to be used */
+    std::shared_ptr<const PointMap<PointWithInfo>> submap;
+  };
+
+  /** \brief Protects all prefetching members below */
+  mutable std::mutex prefetch_mutex_;
+  /** \brief Trunk vertex of the last request */
+  tactic::VertexId prefetch_vid_ = tactic::VertexId::Invalid();
+  /**
+   * \brief Vertices ahead of the trunk in chain order, the latest request.
+   * \note passed to the async task here instead of through the query cache so
+   * that a task queued behind a newer request prefetches for the newer one.
+   */
+  std::vector<tactic::VertexId> prefetch_request_;
+  /** \brief Submap in use by localization, never evicted */
+  tactic::VertexId current_map_vid_ = tactic::VertexId::Invalid();
+  /** \brief Prefetched submaps that have not been used, by map vertex id */
+  std::unordered_map<tactic::VertexId, PrefetchedSubmap> prefetched_;
+  PrefetchStatistics prefetch_stats_;
+
   /** \brief for visualization only */
   bool publisher_initialized_ = false;
   rclcpp::Publisher<PointCloudMsg>::SharedPtr map_pub_;
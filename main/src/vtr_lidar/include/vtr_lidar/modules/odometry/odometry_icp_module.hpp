@@ -49,6 +49,9 @@ class OdometryICPModule : public tactic::BaseModule {
     bool traj_lock_prev_vel = false;
     Eigen::Matrix<double, 6, 1> traj_qc_diag =
         Eigen::Matrix<double, 6, 1>::Ones();
+    // points are grouped by timestamp rounded to this resolution [s] and each
+    // group shares one interpolated pose, 0 to group identical timestamps only
+    double traj_interp_resolution = 0.0;
 
     /// ICP parameters
     // number of threads for nearest neighbor search
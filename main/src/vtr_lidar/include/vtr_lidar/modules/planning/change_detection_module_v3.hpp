@@ -66,6 +66,7 @@ class ChangeDetectionModuleV3 : public tactic::BaseModule {
     float minimum_distance = 0.5;
 
     //
+    int num_threads = 4;
     bool visualize = false;
 
     static ConstPtr fromROS(const rclcpp::Node::SharedPtr &node,
@@ -85,6 +86,26 @@ class ChangeDetectionModuleV3 : public tactic::BaseModule {
 
   Config::ConstPtr config_;
 
+  /** \brief Local plane of the submap around one of its points */
+  struct PlaneStats {
+    /**
+     * \brief Map points within the search radius, 0 if too few for a plane
+     * and negative until computed
+     */
+    float num_measurements = -1.0f;
+    /** \brief Smallest eigenvalue of the scatter matrix */
+    float roughness = 0.0f;
+    Eigen::Vector3f centroid = Eigen::Vector3f::Zero();
+    Eigen::Vector3f normal = Eigen::Vector3f::UnitZ();
+  };
+  /**
+   * \brief Plane statistics of every point of the localization submap,
+   * computed when a scan point first matches that map point and kept until the
+   * submap is swapped.
+   */
+  std::weak_ptr<const PointMap<PointWithInfo>> plane_stats_submap_;
+  std::vector<PlaneStats> plane_stats_;
+
   /** \brief for visualization only */
   bool publisher_initialized_ = false;
   rclcpp::Publisher<PointCloudMsg>::SharedPtr scan_pub_;
@@ -60,6 +60,7 @@ class GroundExtractionModule : public tactic::BaseModule {
     float bin_size_small = 3.0;
     size_t num_bins_large = 30;
     float bin_size_large = 3.0;
+    int num_threads = 1;
 
     // ogm
     float resolution = 1.0;
@@ -47,6 +47,13 @@ class LidarPipeline : public tactic::BasePipeline {
     bool save_raw_point_cloud = false;
     bool save_nn_point_cloud = false;
 
+    /** \brief store point clouds as memory mapped chunk files */
+    bool mmap_point_storage = false;
+
+    /** \brief number of recycled query caches and point clouds, 0 disables */
+    int query_cache_pool_size = 8;
+    int point_cloud_pool_size = 16;
+
     static ConstPtr fromROS(const rclcpp::Node::SharedPtr &node,
                             const std::string &param_prefix);
   };
@@ -60,8 +67,22 @@ class LidarPipeline : public tactic::BasePipeline {
 
   tactic::OutputCache::Ptr createOutputCache() const override;
 
+  /** \brief Returns a recycled query cache that uses the point cloud pool */
+  tactic::QueryCache::Ptr createQueryCache() override;
+
+  tactic::ObjectPool<LidarQueryCache>::Statistics queryCachePoolStatistics()
+      const {
+    return query_cache_pool_->statistics();
+  }
+  PointCloudPool::Statistics pointCloudPoolStatistics() const {
+    return point_cloud_pool_->statistics();
+  }
+
   void reset() override;
 
+  void initialize_(const tactic::OutputCache::Ptr &output,
+                   const tactic::Graph::Ptr &graph) override;
+
   void preprocess_(
       const tactic::QueryCache::Ptr &qdata,
       const tactic::OutputCache::Ptr &output, const tactic::Graph::Ptr &graph,
@@ -90,6 +111,10 @@ class LidarPipeline : public tactic::BasePipeline {
   std::vector<tactic::BaseModule::Ptr> odometry_;
   std::vector<tactic::BaseModule::Ptr> localization_;
 
+  /// recycled per-frame data
+  tactic::ObjectPool<LidarQueryCache>::Ptr query_cache_pool_;
+  PointCloudPool::Ptr point_cloud_pool_;
+
   /// odometry cached data
   /** \brief current sliding map for odometry */
   std::shared_ptr<PointMap<PointWithInfo>> sliding_map_odo_;
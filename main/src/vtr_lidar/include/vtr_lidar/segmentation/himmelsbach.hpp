@@ -20,6 +20,7 @@
 
 #include "pcl/point_cloud.h"
 
+#include "vtr_lidar/utils/point_conversions.hpp"
 #include "vtr_logging/logging.hpp"
 
 namespace vtr {
@@ -27,6 +28,11 @@ namespace lidar {
 
 /**
  * \brief Himmelsbach's algorithm for ground extraction.
+ * \details Points are sorted into angular segments and radial bins with one
+ * counting sort pass into flat arrays, and segments are fitted independently
+ * in parallel. The azimuth and horizontal range of the points are either
+ * computed from their cartesian coordinates or, if use_polar is set, taken
+ * from their precomputed polar coordinates (rho, theta, phi).
  * \note this algorithms assumes that close to the sensor origin must be ground,
  * since the slope of the first fitted line determines slope of subsequent
  * fitted lines due to its smmooth transition requirement. We partially address
@@ -42,13 +48,11 @@ class Himmelsbach {
  private:
   struct Line {
    public:
-    Line(const PointCloud& points, const std::vector<size_t>& line_pts,
+    Line(const std::vector<float>& ranges, const std::vector<size_t>& line_pts,
          const float& m0, const float& b0)
         : m(m0), b(b0) {
-      const auto ps = points[line_pts.front()];
-      xs = std::sqrt(ps.x * ps.x + ps.y * ps.y);
-      const auto pe = points[line_pts.back()];
-      xe = std::sqrt(pe.x * pe.x + pe.y * pe.y);
+      xs = ranges[line_pts.front()];
+      xe = ranges[line_pts.back()];
     }
     float m;
     float b;
@@ -56,19 +60,31 @@ class Himmelsbach {
     float xe;
   };
 
+  /** \brief Points sorted by segment, and lowest point of every bin */
+  struct Partition {
+    /** \brief horizontal range of every point */
+    std::vector<float> ranges;
+    /** \brief points of segment s are points[offsets[s], offsets[s + 1]) */
+    std::vector<size_t> offsets;
+    std::vector<size_t> points;
+    /** \brief lowest point of bin b of segment s at s * num_bins + b, or -1 */
+    std::vector<int> bins;
+  };
+
  private:
-  /** \brief */
-  std::vector<std::vector<size_t>> sortPointsSegments(
-      const PointCloud& points) const;
-  /** \brief */
-  std::vector<int> sortPointsBins(const PointCloud& points,
-                                  const std::vector<size_t>& segment) const;
-  /** \brief */
+  /** \brief Sorts points into segments and bins in one counting sort pass */
+  Partition partition(const PointCloud& points) const;
+  /** \brief Fits lines to the bins of a segment and flags its ground points */
+  void segmentGround(const PointCloud& points, const Partition& partition,
+                     const size_t& segment, std::vector<char>& ground) const;
+  /** \brief Least squares line through line_set and extra (if >= 0) */
   using FitLineRval = std::tuple<float, float, float>; /* [m, b, rmse] */
-  FitLineRval fitLine(const PointCloud& points,
-                      const std::vector<size_t>& line_set) const;
+  FitLineRval fitLine(const PointCloud& points, const std::vector<float>& ranges,
+                      const std::vector<size_t>& line_set,
+                      const int extra = -1) const;
   /** \brief */
-  float distPointLine(const PointT& point, const Line& line) const;
+  float distPointLine(const PointT& point, const float& range,
+                      const Line& line) const;
 
  public:
   float z_offset = 2.13f;
@@ -86,169 +102,209 @@ class Himmelsbach {
   float bin_size_small = 3.0;
   size_t num_bins_large = 30;
   float bin_size_large = 3.0;
+
+  /** \brief Use the polar coordinates of the points instead of x, y */
+  bool use_polar = false;
+  /** \brief Number of threads fitting segments in parallel */
+  int num_threads = 1;
 };
 
 template <class PointT>
 std::vector<size_t> Himmelsbach<PointT>::operator()(
     const PointCloud& points) const {
+  const auto partition = this->partition(points);
+  const size_t num_segments = partition.offsets.size() - 1;
+
+  std::vector<char> ground(points.size(), 0);
+#pragma omp parallel for schedule(dynamic, 4) num_threads(num_threads)
+  for (size_t s = 0; s < num_segments; ++s)
+    segmentGround(points, partition, s, ground);
+
+  // ground points ordered by segment then index
   std::vector<size_t> ground_idx;
-  // sort points into segments
-  const auto segments = sortPointsSegments(points);
-  // Sort points into bins
-  for (const auto& segment : segments) {
-    if (segment.empty()) continue;
-    //
-    const auto bins = sortPointsBins(points, segment);
-    //
-    std::vector<Line> lines;       // extracted lines
-    std::vector<size_t> line_set;  // current set of point index forming a line
-    size_t i = 0;                  // current bin index
-    while (i < bins.size() - 1) {
-      const auto& idx = bins[i];
-      if (idx < 0) {
-        ++i;
-        continue;
-      } else if (line_set.size() >= 2) {
-        std::vector<size_t> tmp(line_set);
-        tmp.emplace_back(idx);
-        const auto [m, b, rmse] = fitLine(points, tmp);
-        if (std::abs(m) <= Tm &&
-            (std::abs(m) > Tm_small || std::abs(b + z_offset) <= Tb) &&
-            rmse <= Trmse) {
-          line_set.emplace_back(idx);
-          ++i;
-        } else {
-          const auto [m, b, rmse] = fitLine(points, line_set);
-          lines.emplace_back(points, line_set, m, b);
-          line_set.clear();
-        }
-      } else {
-        // this mprev condition prevents initialization issues, especially when
-        // first first two representative points are not both on the ground
-        const auto mprev = lines.empty() ? 0 : std::abs(lines.back().m);
-        const auto dprev =
-            lines.empty() ? -1 : distPointLine(points[idx], lines.back());
-        if (mprev > Tm || dprev <= Tdprev || lines.empty() || !line_set.empty())
-          line_set.emplace_back(idx);
-        ++i;
-      }
-    }
-    ///
-    if (line_set.size() >= 2) {
-      const auto [m, b, rmse] = fitLine(points, line_set);
-      lines.emplace_back(points, line_set, m, b);
-      line_set.clear();
-    }
-    // assign points as inliers if they are within a threshold of the ground
-    // model
-    for (const auto& idx : segment) {
-      const auto& point = points[idx];
-      const auto& r = std::sqrt(point.x * point.x + point.y * point.y);
-      // get line that's closest to the candidate point based on distance to
-      // endpoints
-      int closest = -1;
-      float dmin = std::numeric_limits<float>::max();
-      for (size_t i = 0; i < lines.size(); ++i) {
-        const auto& line = lines[i];
-        const auto ds = std::abs(line.xs - r);
-        const auto de = std::abs(line.xe - r);
-        const auto d = std::min(ds, de);
-        if (d < dmin && std::abs(line.m) < Tm) {
-          dmin = d;
-          closest = i;
-        }
-      }
-      if (closest >= 0) {
-        const auto e = distPointLine(point, lines[closest]);
-        if (e < tolerance) ground_idx.emplace_back(idx);
-      }
-    }
-  }
+  for (const auto& idx : partition.points)
+    if (ground[idx]) ground_idx.emplace_back(idx);
   return ground_idx;
 }
 
 template <class PointT>
-std::vector<std::vector<size_t>> Himmelsbach<PointT>::sortPointsSegments(
-    const PointCloud& points) const {
-  std::vector<std::vector<size_t>> segments;
-  segments.resize(static_cast<size_t>(std::ceil(2 * M_PI / alpha)));
+auto Himmelsbach<PointT>::partition(const PointCloud& points) const
+    -> Partition {
+  const size_t num_segments = std::ceil(2 * M_PI / alpha);
+  const size_t num_bins = num_bins_small + num_bins_large;
+  const auto rsmall = rmin + bin_size_small * num_bins_small;
+  const auto rlarge = rsmall + bin_size_large * num_bins_large;
+
+  Partition partition;
+  auto& ranges = partition.ranges;
+  ranges.resize(points.size());
+  std::vector<float> angles(points.size());
+  std::vector<uint32_t> segments(points.size());
+
+  // azimuth and horizontal range of every point
+  if (use_polar) {
+    for (size_t i = 0; i < points.size(); ++i) {
+      const auto& point = points[i];
+      ranges[i] = point.rho * std::sin(point.theta);
+      angles[i] = std::fmod(point.phi, float(2 * M_PI));
+    }
+  } else {
+#pragma omp simd
+    for (size_t i = 0; i < points.size(); ++i) {
+      const auto& point = points[i];
+      ranges[i] = std::sqrt(point.x * point.x + point.y * point.y);
+      angles[i] = conversions::fastAtan2(point.y, point.x);
+    }
+  }
+  const float inv_alpha = 1.0f / alpha;
+#pragma omp simd
   for (size_t i = 0; i < points.size(); ++i) {
-    const auto& point = points[i];
-    auto angle = std::atan2(point.y, point.x);
-    if (angle < 0) angle += 2 * M_PI;
-    size_t idx = std::floor(angle / alpha);
-    segments[idx].push_back(i);
+    const float angle = angles[i] < 0 ? angles[i] + float(2 * M_PI) : angles[i];
+    segments[i] = std::min<uint32_t>(angle * inv_alpha, num_segments - 1);
   }
-  return segments;
-}
 
-template <class PointT>
-std::vector<int> Himmelsbach<PointT>::sortPointsBins(
-    const PointCloud& points, const std::vector<size_t>& segment) const {
-  const auto num_bins = num_bins_small + num_bins_large;
-  const auto rsmall = rmin + bin_size_small * num_bins_small;
-  const auto rlarge = rsmall + bin_size_large * num_bins_large;
-  //
-  std::vector<std::vector<size_t>> bins;
-  bins.resize(num_bins);
-  for (const auto& idx : segment) {
-    const auto& point = points[idx];
-    const auto& r = std::sqrt(point.x * point.x + point.y * point.y);
+  // counting sort into segments, keeping the order of points in a segment
+  partition.offsets.assign(num_segments + 1, 0);
+  for (const auto& segment : segments) ++partition.offsets[segment + 1];
+  for (size_t s = 0; s < num_segments; ++s)
+    partition.offsets[s + 1] += partition.offsets[s];
+  partition.points.resize(points.size());
+  std::vector<size_t> next(partition.offsets.begin(),
+                           partition.offsets.end() - 1);
+  for (size_t i = 0; i < points.size(); ++i)
+    partition.points[next[segments[i]]++] = i;
+
+  // The point with the lowest z-coordinate in each bin becomes the
+  // representative point
+  partition.bins.assign(num_segments * num_bins, -1);
+  for (size_t i = 0; i < points.size(); ++i) {
+    const auto& r = ranges[i];
     int bin = -1;
     if (rmin <= r && r < rsmall)
       bin = (r - rmin) / bin_size_small;
     else if (rsmall <= r && r < rlarge)
       bin = num_bins_small + (r - rsmall) / bin_size_large;
-    //
-    if (bin >= 0) bins[(size_t)bin].push_back(idx);
+    if (bin < 0) continue;
+    auto& lowest = partition.bins[segments[i] * num_bins + bin];
+    if (lowest < 0 || points[i].z < points[lowest].z) lowest = i;
   }
-  // The point with the lowest z-coordinate in each bin becomes the
-  // representative point
-  std::vector<int> bins_out;
-  bins_out.resize(num_bins, -1);
-  for (size_t i = 0; i < num_bins; ++i) {
-    const auto& bin_pts = bins[i];
-    float zmin = std::numeric_limits<float>::max();
-    int lowest = -1;
-    for (const auto& idx : bin_pts) {
-      const auto& point = points[idx];
-      if (point.z < zmin) {
-        zmin = point.z;
-        lowest = idx;
+
+  return partition;
+}
+
+template <class PointT>
+void Himmelsbach<PointT>::segmentGround(const PointCloud& points,
+                                        const Partition& partition,
+                                        const size_t& segment,
+                                        std::vector<char>& ground) const {
+  const auto begin = partition.offsets[segment];
+  const auto end = partition.offsets[segment + 1];
+  if (begin == end) return;
+
+  const size_t num_bins = num_bins_small + num_bins_large;
+  const int* bins = partition.bins.data() + segment * num_bins;
+  const auto& ranges = partition.ranges;
+
+  std::vector<Line> lines;       // extracted lines
+  std::vector<size_t> line_set;  // current set of point index forming a line
+  size_t i = 0;                  // current bin index
+  while (i < num_bins - 1) {
+    const auto& idx = bins[i];
+    if (idx < 0) {
+      ++i;
+      continue;
+    } else if (line_set.size() >= 2) {
+      const auto [m, b, rmse] = fitLine(points, ranges, line_set, idx);
+      if (std::abs(m) <= Tm &&
+          (std::abs(m) > Tm_small || std::abs(b + z_offset) <= Tb) &&
+          rmse <= Trmse) {
+        line_set.emplace_back(idx);
+        ++i;
+      } else {
+        const auto [m, b, rmse] = fitLine(points, ranges, line_set);
+        lines.emplace_back(ranges, line_set, m, b);
+        line_set.clear();
       }
+    } else {
+      // this mprev condition prevents initialization issues, especially when
+      // first first two representative points are not both on the ground
+      const auto mprev = lines.empty() ? 0 : std::abs(lines.back().m);
+      const auto dprev =
+          lines.empty()
+              ? -1
+              : distPointLine(points[idx], ranges[idx], lines.back());
+      if (mprev > Tm || dprev <= Tdprev || lines.empty() || !line_set.empty())
+        line_set.emplace_back(idx);
+      ++i;
+    }
+  }
+  ///
+  if (line_set.size() >= 2) {
+    const auto [m, b, rmse] = fitLine(points, ranges, line_set);
+    lines.emplace_back(ranges, line_set, m, b);
+    line_set.clear();
+  }
+  // assign points as inliers if they are within a threshold of the ground
+  // model
+  for (size_t k = begin; k < end; ++k) {
+    const auto& idx = partition.points[k];
+    const auto& r = ranges[idx];
+    // get line that's closest to the candidate point based on distance to
+    // endpoints
+    int closest = -1;
+    float dmin = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < lines.size(); ++i) {
+      const auto& line = lines[i];
+      const auto ds = std::abs(line.xs - r);
+      const auto de = std::abs(line.xe - r);
+      const auto d = std::min(ds, de);
+      if (d < dmin && std::abs(line.m) < Tm) {
+        dmin = d;
+        closest = i;
+      }
+    }
+    if (closest >= 0) {
+      const auto e = distPointLine(points[idx], r, lines[closest]);
+      if (e < tolerance) ground[idx] = 1;
     }
-    bins_out[i] = lowest;
   }
-
-  return bins_out;
 }
 
 template <class PointT>
 auto Himmelsbach<PointT>::fitLine(const PointCloud& points,
-                                  const std::vector<size_t>& line_set) const
-    -> FitLineRval {
-  Eigen::MatrixXf A(line_set.size(), 2);
-  Eigen::VectorXf b(line_set.size());
-  for (size_t i = 0; i < line_set.size(); ++i) {
-    const auto& point = points[line_set[i]];
-    A(i, 0) = std::sqrt(point.x * point.x + point.y * point.y);
-    A(i, 1) = 1;
-    b(i) = point.z;
-  }
-  const auto soln = (A.transpose() * A).ldlt().solve(A.transpose() * b).eval();
-  const auto err = A * soln - b;
-  const auto mse = ((err.transpose() * err) / (float)line_set.size()).value();
-  const auto rmse = std::sqrt(mse);
-  return std::make_tuple(soln(0), soln(1), rmse);
+                                  const std::vector<float>& ranges,
+                                  const std::vector<size_t>& line_set,
+                                  const int extra) const -> FitLineRval {
+  // normal equations of z = m * r + b, solved in closed form
+  double n = 0, sr = 0, srr = 0, sz = 0, srz = 0;
+  const auto accumulate = [&](const size_t idx) {
+    const double r = ranges[idx], z = points[idx].z;
+    n += 1, sr += r, srr += r * r, sz += z, srz += r * z;
+  };
+  for (const auto& idx : line_set) accumulate(idx);
+  if (extra >= 0) accumulate(extra);
+  const double det = n * srr - sr * sr;
+  const float m = (n * srz - sr * sz) / det;
+  const float b = (srr * sz - sr * srz) / det;
+
+  float sse = 0;
+  const auto error = [&](const size_t idx) {
+    const float e = m * ranges[idx] + b - points[idx].z;
+    sse += e * e;
+  };
+  for (const auto& idx : line_set) error(idx);
+  if (extra >= 0) error(extra);
+  const auto rmse = std::sqrt(sse / (float)n);
+  return std::make_tuple(m, b, rmse);
 }
 
 template <class PointT>
 float Himmelsbach<PointT>::distPointLine(const PointT& point,
+                                         const float& range,
                                          const Line& line) const {
-  const auto r = std::sqrt(point.x * point.x + point.y * point.y);
-  const auto line_z = line.m * r + line.b;
+  const auto line_z = line.m * range + line.b;
   return std::abs(line_z - point.z) / std::sqrt(line.m * line.m + 1);
 }
 
 }  // namespace lidar
-}  // namespace vtr
\ No newline at end of file
+}  // namespace vtr
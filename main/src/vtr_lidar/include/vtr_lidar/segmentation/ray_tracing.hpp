@@ -19,6 +19,7 @@
 #pragma once
 
 #include "vtr_lidar/data_types/point.hpp"
+#include "vtr_lidar/utils/point_conversions.hpp"
 
 namespace vtr {
 namespace lidar {
@@ -42,15 +43,6 @@ inline PixKey operator-(const PixKey A, const PixKey B) {
   return PixKey(A.x - B.x, A.y - B.y);
 }
 
-template <class PointT>
-void cart2pol(pcl::PointCloud<PointT>& point_cloud) {
-  for (auto& p : point_cloud) {
-    p.rho = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
-    p.theta = std::atan2(std::sqrt(p.x * p.x + p.y * p.y), p.z);
-    p.phi = std::atan2(p.y, p.x);
-  }
-}
-
 }  // namespace ray_tracing
 }  // namespace lidar
 }  // namespace vtr
@@ -121,7 +113,7 @@ void detectDynamicObjects(
   // transform to the local frame of this vertex
   points_mat = T_ref_qry_mat * points_mat;
   normal_mat = T_ref_qry_mat * normal_mat;
-  ray_tracing::cart2pol(query_tmp);
+  conversions::cart2pol(query_tmp);
 
   // for honeycomb fov specifically
 #if false
@@ -0,0 +1,603 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file incremental_kdtree.hpp
+ * \brief Incremental 3D kd-tree supporting point insertion and removal.
+ *
+ * Points live in small leaf buckets, like in the nanoflann static tree, so
+ * queries cost about the same. Insertions split full leaves at their median,
+ * removals take points out of their leaf directly, and any subtree that
+ * becomes unbalanced (scapegoat criterion) or has lost too many points since
+ * it was built is rebuilt on its own. Points are referred to by their index in
+ * the owning point cloud; reindex() keeps those indices valid after the point
+ * cloud has been compacted, so the tree never has to be rebuilt from scratch.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "pcl/point_cloud.h"
+
+namespace vtr {
+namespace lidar {
+
+template <class PointT>
+class IncrementalKDTree {
+ public:
+  /**
+   * \param leaf_size number of points in a leaf before it gets split
+   * \param balance_ratio a subtree is rebuilt when one of its children holds
+   * more than this fraction of its points
+   * \param removed_ratio a subtree is rebuilt when it has lost more than this
+   * fraction of its points since it was built (shrinks bounding boxes)
+   */
+  IncrementalKDTree(const size_t leaf_size = 16,
+                    const float balance_ratio = 0.75,
+                    const float removed_ratio = 0.5)
+      : leaf_size_(leaf_size),
+        balance_ratio_(balance_ratio),
+        removed_ratio_(removed_ratio) {}
+
+  /** \brief Number of points in the tree */
+  size_t size() const { return root_ < 0 ? 0 : nodes_[root_].size; }
+  bool empty() const { return size() == 0; }
+
+  void clear() {
+    nodes_.clear();
+    free_nodes_.clear();
+    entries_.clear();
+    leaf_nodes_.clear();
+    free_leaves_.clear();
+    location_.clear();
+    root_ = -1;
+  }
+
+  /** \brief Builds a balanced tree over all points of the point cloud. */
+  void build(const pcl::PointCloud<PointT>& points) {
+    clear();
+    std::vector<Entry> entries;
+    entries.reserve(points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+      entries.emplace_back(makeEntry(i, points[i]));
+    location_.assign(points.size(), Location());
+    root_ = buildSubtree(entries, 0, entries.size(), -1);
+  }
+
+  /**
+   * \brief Inserts points [first, last) of the point cloud.
+   * \note Points are inserted in random order and the tree is rebalanced once
+   * at the end, since scans arrive sorted by azimuth and inserting them in
+   * that order would trigger a rebuild every few points.
+   */
+  void insert(const pcl::PointCloud<PointT>& points, const size_t first,
+              const size_t last) {
+    if (first >= last) return;
+    if (last > location_.size()) location_.resize(last, Location());
+    std::vector<size_t> order(last - first);
+    for (size_t i = 0; i < order.size(); ++i) order[i] = first + i;
+    std::shuffle(order.begin(), order.end(), std::minstd_rand(last));
+    for (const auto& i : order) {
+      remove(i);
+      insertEntry(makeEntry(i, points[i]));
+    }
+    root_ = balanceDirty(root_);
+  }
+
+  /** \brief Inserts the point stored at the given index of the point cloud. */
+  void insert(const size_t index, const PointT& point) {
+    if (index >= location_.size()) location_.resize(index + 1, Location());
+    remove(index);
+    rebalanceFrom(insertEntry(makeEntry(index, point)));
+  }
+
+  /** \brief Removes the point stored at the given index of the point cloud. */
+  void remove(const size_t index) {
+    if (index >= location_.size() || location_[index].leaf < 0) return;
+    const int node = leaf_nodes_[location_[index].leaf];
+    eraseEntry(location_[index]);
+    for (int curr = node; curr >= 0; curr = nodes_[curr].parent) {
+      --nodes_[curr].size;
+      ++nodes_[curr].removed;
+    }
+    rebalanceFrom(node);
+  }
+
+  /**
+   * \brief Updates point indices after the point cloud has been compacted.
+   * \param old_to_new new index of every previously indexed point, negative if
+   * the point has been removed from the point cloud.
+   */
+  void reindex(const std::vector<int>& old_to_new) {
+    size_t new_size = 0;
+    for (const auto& idx : old_to_new)
+      if (idx >= 0) new_size = std::max(new_size, (size_t)idx + 1);
+    location_.assign(new_size, Location());
+    if (root_ < 0) return;
+    reindexSubtree(root_, old_to_new);
+    root_ = balanceSubtree(root_);
+    relayout();
+  }
+
+  /**
+   * \brief Finds neighbors of the query point, compatible with the nanoflann
+   * result sets (KNNResultSet, NanoFLANNRadiusResultSet) used in vtr_lidar.
+   */
+  template <class ResultSet>
+  void findNeighbors(ResultSet& result, const float* query) const {
+    if (root_ >= 0) searchSubtree(root_, result, query);
+  }
+
+ private:
+  struct Entry {
+    float pt[3];
+    uint32_t index;
+  };
+
+  struct Node {
+    /** \brief bounding box of the subtree, conservative after removals */
+    float lo[3];
+    float hi[3];
+    int parent = -1;
+    /** \brief points with pt[axis] >= split go to child[1] */
+    int child[2] = {-1, -1};
+    float split = 0;
+    uint8_t axis = 0;
+    /** \brief whether insertions reached this node since last balancing */
+    bool dirty = false;
+    /** \brief leaf bucket of this node, -1 for internal nodes */
+    int leaf = -1;
+    /** \brief number of points in this subtree (or in the leaf bucket) */
+    uint32_t size = 0;
+    /** \brief number of points removed from this subtree since it was built */
+    uint32_t removed = 0;
+  };
+
+  struct Location {
+    int leaf = -1;
+    int slot = -1;
+  };
+
+  static Entry makeEntry(const size_t index, const PointT& point) {
+    return Entry{{point.x, point.y, point.z}, (uint32_t)index};
+  }
+
+  static void expandBox(Node& node, const float* pt) {
+    for (int d = 0; d < 3; ++d) {
+      node.lo[d] = std::min(node.lo[d], pt[d]);
+      node.hi[d] = std::max(node.hi[d], pt[d]);
+    }
+  }
+
+  int newNode(const int parent) {
+    int id;
+    if (free_nodes_.empty()) {
+      id = (int)nodes_.size();
+      nodes_.emplace_back();
+    } else {
+      id = free_nodes_.back();
+      free_nodes_.pop_back();
+      nodes_[id] = Node();
+    }
+    nodes_[id].parent = parent;
+    return id;
+  }
+
+  Entry* leafEntries(const int leaf) { return &entries_[leaf * leafCapacity()]; }
+  const Entry* leafEntries(const int leaf) const {
+    return &entries_[leaf * leafCapacity()];
+  }
+  /** \brief a leaf holds one point more than leaf_size_ before being split */
+  size_t leafCapacity() const { return leaf_size_ + 1; }
+
+  /** \brief Creates a leaf node holding entries [first, last) */
+  int newLeafNode(const std::vector<Entry>& entries, const size_t first,
+                  const size_t last, const int parent) {
+    const int id = newNode(parent);
+    int leaf;
+    if (free_leaves_.empty()) {
+      leaf = (int)leaf_nodes_.size();
+      leaf_nodes_.emplace_back();
+      entries_.resize(entries_.size() + leafCapacity());
+    } else {
+      leaf = free_leaves_.back();
+      free_leaves_.pop_back();
+    }
+    leaf_nodes_[leaf] = id;
+    auto& node = nodes_[id];
+    node.leaf = leaf;
+    node.size = last - first;
+    for (int d = 0; d < 3; ++d) {
+      node.lo[d] = std::numeric_limits<float>::max();
+      node.hi[d] = std::numeric_limits<float>::lowest();
+    }
+    auto leaf_entries = leafEntries(leaf);
+    for (size_t i = first; i < last; ++i) {
+      expandBox(node, entries[i].pt);
+      location_[entries[i].index] = Location{leaf, int(i - first)};
+      leaf_entries[i - first] = entries[i];
+    }
+    return id;
+  }
+
+  void eraseEntry(const Location loc) {
+    auto& node = nodes_[leaf_nodes_[loc.leaf]];
+    auto leaf_entries = leafEntries(loc.leaf);
+    location_[leaf_entries[loc.slot].index] = Location();
+    const int last = (int)node.size - 1;
+    if (loc.slot < last) {
+      leaf_entries[loc.slot] = leaf_entries[last];
+      location_[leaf_entries[loc.slot].index].slot = loc.slot;
+    }
+    /// \note the caller decrements node.size along with the ancestors
+  }
+
+  /** \brief Inserts without rebalancing, returns the node receiving it */
+  int insertEntry(const Entry& entry) {
+    if (root_ < 0) {
+      root_ = newLeafNode({entry}, 0, 1, -1);
+      return root_;
+    }
+    int curr = root_;
+    while (nodes_[curr].leaf < 0) {
+      auto& node = nodes_[curr];
+      ++node.size;
+      node.dirty = true;
+      expandBox(node, entry.pt);
+      curr = node.child[entry.pt[node.axis] >= node.split];
+    }
+    auto& node = nodes_[curr];
+    expandBox(node, entry.pt);
+    location_[entry.index] = Location{node.leaf, (int)node.size};
+    leafEntries(node.leaf)[node.size++] = entry;
+    if (node.size > leaf_size_) splitLeaf(curr);
+    return curr;
+  }
+
+  /** \brief Turns a full leaf node into an internal node with two leaves */
+  void splitLeaf(const int id) {
+    const int leaf = nodes_[id].leaf;
+    const auto leaf_entries = leafEntries(leaf);
+    scratch_.assign(leaf_entries, leaf_entries + nodes_[id].size);
+    const size_t split = partition(scratch_, 0, scratch_.size(), id);
+    free_leaves_.push_back(leaf);
+    const int left = newLeafNode(scratch_, 0, split, id);
+    const int right = newLeafNode(scratch_, split, scratch_.size(), id);
+    auto& node = nodes_[id];
+    node.leaf = -1;
+    node.child[0] = left;
+    node.child[1] = right;
+    node.dirty = true;
+  }
+
+  /**
+   * \brief Chooses the split of node id over entries [first, last) and
+   * partitions them accordingly.
+   * \return the first entry of the upper half
+   * \note queries only prune with bounding boxes, so any partition consistent
+   * with the bounding boxes is correct; the split value only guides insertion.
+   */
+  size_t partition(std::vector<Entry>& entries, const size_t first,
+                   const size_t last, const int id) {
+    // split along the dimension with the largest extent
+    float lo[3], hi[3];
+    for (int d = 0; d < 3; ++d) lo[d] = hi[d] = entries[first].pt[d];
+    for (size_t i = first + 1; i < last; ++i) {
+      for (int d = 0; d < 3; ++d) {
+        lo[d] = std::min(lo[d], entries[i].pt[d]);
+        hi[d] = std::max(hi[d], entries[i].pt[d]);
+      }
+    }
+    uint8_t axis = 0;
+    for (uint8_t d = 1; d < 3; ++d)
+      if (hi[d] - lo[d] > hi[axis] - lo[axis]) axis = d;
+
+    const auto begin = entries.begin() + first;
+    const auto end = entries.begin() + last;
+    auto mid = begin + (last - first) / 2;
+    std::nth_element(begin, mid, end, [axis](const Entry& a, const Entry& b) {
+      return a.pt[axis] < b.pt[axis];
+    });
+    nodes_[id].axis = axis;
+    nodes_[id].split = mid->pt[axis];
+    // move points equal to the median to the upper half unless that empties
+    // the lower one (i.e. the median is also the minimum)
+    if (mid->pt[axis] > lo[axis])
+      mid = std::partition(begin, mid, [axis, split = mid->pt[axis]](
+                                           const Entry& e) {
+        return e.pt[axis] < split;
+      });
+    return first + (mid - begin);
+  }
+
+  int buildSubtree(std::vector<Entry>& entries, const size_t first,
+                   const size_t last, const int parent) {
+    if (last - first <= leaf_size_)
+      return newLeafNode(entries, first, last, parent);
+    const int id = newNode(parent);
+    const size_t split = partition(entries, first, last, id);
+    const int left = buildSubtree(entries, first, split, id);
+    const int right = buildSubtree(entries, split, last, id);
+    auto& node = nodes_[id];
+    node.child[0] = left;
+    node.child[1] = right;
+    node.size = last - first;
+    for (int d = 0; d < 3; ++d) {
+      node.lo[d] = std::min(nodes_[left].lo[d], nodes_[right].lo[d]);
+      node.hi[d] = std::max(nodes_[left].hi[d], nodes_[right].hi[d]);
+    }
+    return id;
+  }
+
+  bool needsRebuild(const int id) const {
+    const auto& node = nodes_[id];
+    if (node.leaf >= 0) return false;
+    const uint32_t total = node.size + node.removed;
+    if (total < 4 * leaf_size_) return false;
+    const uint32_t lsize = nodes_[node.child[0]].size;
+    const uint32_t rsize = nodes_[node.child[1]].size;
+    return (float)std::max(lsize, rsize) > balance_ratio_ * node.size ||
+           (float)node.removed > removed_ratio_ * total;
+  }
+
+  /** \brief Rebuilds the highest unbalanced ancestor of the node, if any */
+  void rebalanceFrom(const int id) {
+    int scapegoat = -1;
+    for (int curr = id; curr >= 0; curr = nodes_[curr].parent)
+      if (needsRebuild(curr)) scapegoat = curr;
+    if (scapegoat >= 0) rebuildSubtree(scapegoat);
+  }
+
+  /** \brief Collects entries and releases all nodes of the subtree */
+  void collectSubtree(const int id, std::vector<Entry>& entries) {
+    const auto& node = nodes_[id];
+    if (node.leaf >= 0) {
+      const auto leaf_entries = leafEntries(node.leaf);
+      entries.insert(entries.end(), leaf_entries, leaf_entries + node.size);
+      free_leaves_.push_back(node.leaf);
+    } else {
+      collectSubtree(node.child[0], entries);
+      collectSubtree(node.child[1], entries);
+    }
+    free_nodes_.push_back(id);
+  }
+
+  int rebuildSubtree(const int id) {
+    const int parent = nodes_[id].parent;
+    const int side = parent >= 0 && nodes_[parent].child[1] == id;
+    const uint32_t removed = nodes_[id].removed;
+
+    std::vector<Entry> entries;
+    entries.reserve(nodes_[id].size);
+    collectSubtree(id, entries);
+    const int new_id = buildSubtree(entries, 0, entries.size(), parent);
+    if (parent < 0) {
+      root_ = new_id;
+      return new_id;
+    }
+    nodes_[parent].child[side] = new_id;
+    for (int curr = parent; curr >= 0; curr = nodes_[curr].parent)
+      nodes_[curr].removed -= removed;
+    return new_id;
+  }
+
+  /** \brief Rebuilds every maximal unbalanced subtree touched by insertions */
+  int balanceDirty(const int id) {
+    if (id < 0 || !nodes_[id].dirty) return id;
+    nodes_[id].dirty = false;
+    if (needsRebuild(id)) return rebuildSubtree(id);
+    if (nodes_[id].leaf < 0) {
+      balanceDirty(nodes_[id].child[0]);
+      balanceDirty(nodes_[id].child[1]);
+    }
+    return id;
+  }
+
+  void reindexSubtree(const int id, const std::vector<int>& old_to_new) {
+    auto& node = nodes_[id];
+    if (node.leaf >= 0) {
+      const auto entries = leafEntries(node.leaf);
+      size_t kept = 0;
+      for (size_t i = 0; i < node.size; ++i) {
+        const auto index = entries[i].index;
+        const int new_index = index < old_to_new.size() ? old_to_new[index] : -1;
+        if (new_index < 0) continue;
+        entries[kept] = entries[i];
+        entries[kept].index = (uint32_t)new_index;
+        ++kept;
+      }
+      node.removed += node.size - kept;
+      node.size = kept;
+      // tighten the bounding box while the entries are in cache
+      for (int d = 0; d < 3; ++d) {
+        node.lo[d] = std::numeric_limits<float>::max();
+        node.hi[d] = std::numeric_limits<float>::lowest();
+      }
+      for (size_t i = 0; i < kept; ++i) expandBox(node, entries[i].pt);
+      return;
+    }
+    reindexSubtree(node.child[0], old_to_new);
+    reindexSubtree(node.child[1], old_to_new);
+    const auto& left = nodes_[node.child[0]];
+    const auto& right = nodes_[node.child[1]];
+    node.size = left.size + right.size;
+    node.removed = left.removed + right.removed;
+    for (int d = 0; d < 3; ++d) {
+      node.lo[d] = std::min(left.lo[d], right.lo[d]);
+      node.hi[d] = std::max(left.hi[d], right.hi[d]);
+    }
+  }
+
+  /** \brief Rebuilds every maximal unbalanced subtree, top-down */
+  int balanceSubtree(const int id) {
+    if (needsRebuild(id)) return rebuildSubtree(id);
+    if (nodes_[id].leaf < 0) {
+      balanceSubtree(nodes_[id].child[0]);
+      balanceSubtree(nodes_[id].child[1]);
+    }
+    return id;
+  }
+
+  /**
+   * \brief Stores nodes and leaf buckets in depth-first order. Incremental
+   * updates scatter them over the pools, which costs more in cache misses
+   * during queries than this O(n) copy.
+   */
+  void relayout() {
+    nodes_buffer_.clear();
+    entries_buffer_.clear();
+    leaf_nodes_buffer_.clear();
+    relayoutSubtree(root_, -1);
+    nodes_.swap(nodes_buffer_);
+    entries_.swap(entries_buffer_);
+    leaf_nodes_.swap(leaf_nodes_buffer_);
+    free_nodes_.clear();
+    free_leaves_.clear();
+    root_ = 0;
+  }
+
+  int relayoutSubtree(const int id, const int parent) {
+    const int new_id = (int)nodes_buffer_.size();
+    nodes_buffer_.emplace_back(nodes_[id]);
+    nodes_buffer_[new_id].parent = parent;
+    const auto& node = nodes_[id];
+    if (node.leaf >= 0) {
+      const int new_leaf = (int)leaf_nodes_buffer_.size();
+      leaf_nodes_buffer_.emplace_back(new_id);
+      const auto leaf_entries = leafEntries(node.leaf);
+      entries_buffer_.insert(entries_buffer_.end(), leaf_entries,
+                             leaf_entries + leafCapacity());
+      for (int i = 0; i < (int)node.size; ++i)
+        location_[leaf_entries[i].index] = Location{new_leaf, i};
+      nodes_buffer_[new_id].leaf = new_leaf;
+      return new_id;
+    }
+    const int left = relayoutSubtree(node.child[0], new_id);
+    const int right = relayoutSubtree(node.child[1], new_id);
+    nodes_buffer_[new_id].child[0] = left;
+    nodes_buffer_[new_id].child[1] = right;
+    return new_id;
+  }
+
+  template <class ResultSet>
+  void searchSubtree(const int id, ResultSet& result,
+                     const float* query) const {
+    const auto& node = nodes_[id];
+    // squared distance from the query to the bounding box of the subtree
+    float box_dist = 0;
+    for (int d = 0; d < 3; ++d) {
+      const float diff = query[d] < node.lo[d]   ? node.lo[d] - query[d]
+                         : query[d] > node.hi[d] ? query[d] - node.hi[d]
+                                                 : 0.0f;
+      box_dist += diff * diff;
+    }
+    if (box_dist > result.worstDist()) return;
+
+    if (node.leaf >= 0) {
+      const auto entries = leafEntries(node.leaf);
+      for (size_t i = 0; i < node.size; ++i) {
+        const auto& entry = entries[i];
+        const float dx = query[0] - entry.pt[0];
+        const float dy = query[1] - entry.pt[1];
+        const float dz = query[2] - entry.pt[2];
+        const float dist = dx * dx + dy * dy + dz * dz;
+        if (dist < result.worstDist()) result.addPoint(dist, entry.index);
+      }
+      return;
+    }
+
+    // visit the side containing the query first
+    const int near = query[node.axis] >= node.split;
+    searchSubtree(node.child[near], result, query);
+    searchSubtree(node.child[1 - near], result, query);
+  }
+
+ private:
+  size_t leaf_size_;
+  float balance_ratio_;
+  float removed_ratio_;
+
+  std::vector<Node> nodes_;
+  std::vector<int> free_nodes_;
+  /** \brief leaf buckets stored back to back, leafCapacity() entries each */
+  std::vector<Entry> entries_;
+  std::vector<int> leaf_nodes_;
+  std::vector<int> free_leaves_;
+  /** \brief leaf bucket and slot of every point index, -1 if not inserted */
+  std::vector<Location> location_;
+  /** \brief reused buffers for leaf splits and relayout */
+  std::vector<Entry> scratch_;
+  std::vector<Node> nodes_buffer_;
+  std::vector<Entry> entries_buffer_;
+  std::vector<int> leaf_nodes_buffer_;
+  int root_ = -1;
+};
+
+/**
+ * \brief IncrementalKDTree over a point cloud, built on first use and then
+ * kept in sync by its owner. Copies start without a tree, like
+ * LazyStaticKDTree, so copying the point cloud does not copy its index.
+ */
+template <class PointT>
+class LazyIncrementalKDTree {
+ public:
+  LazyIncrementalKDTree(const size_t leaf_size = 16)
+      : leaf_size_(leaf_size), kdtree_(leaf_size) {}
+  LazyIncrementalKDTree(const LazyIncrementalKDTree& other)
+      : leaf_size_(other.leaf_size_), kdtree_(other.leaf_size_) {}
+  LazyIncrementalKDTree& operator=(const LazyIncrementalKDTree&) {
+    reset();
+    return *this;
+  }
+
+  /** \brief Returns the tree over points, building it if not built yet */
+  const IncrementalKDTree<PointT>& get(const pcl::PointCloud<PointT>& points) {
+    if (!built_) {
+      kdtree_.build(points);
+      built_ = true;
+    }
+    return kdtree_;
+  }
+
+  bool built() const { return built_; }
+
+  /** \brief Indexes points [first, last) if the tree is built */
+  void insert(const pcl::PointCloud<PointT>& points, const size_t first,
+              const size_t last) {
+    if (built_) kdtree_.insert(points, first, last);
+  }
+
+  /** \brief See IncrementalKDTree::reindex, no-op if the tree is not built */
+  void reindex(const std::vector<int>& old_to_new) {
+    if (built_) kdtree_.reindex(old_to_new);
+  }
+
+  /** \brief Drops the tree */
+  void reset() {
+    kdtree_.clear();
+    built_ = false;
+  }
+
+ private:
+  size_t leaf_size_;
+  bool built_ = false;
+  IncrementalKDTree<PointT> kdtree_;
+};
+
+}  // namespace lidar
+}  // namespace vtr
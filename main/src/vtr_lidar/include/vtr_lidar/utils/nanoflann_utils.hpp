@@ -18,6 +18,9 @@
  */
 #pragma once
 
+#include <memory>
+#include <mutex>
+
 #include "vtr_lidar/data_types/point.hpp"
 #include "vtr_lidar/utils/nanoflann.hpp"
 
@@ -115,5 +118,84 @@ using DynamicKDTree = nanoflann::KDTreeSingleIndexDynamicAdaptor<
     nanoflann::L2_Simple_Adaptor<float, NanoFLANNAdapter<PointT>>,
     NanoFLANNAdapter<PointT>>;
 
+/**
+ * \brief Static kd-tree that owns its adapter, so that it can be shared. The
+ * indexed point cloud must outlive the tree and must not be modified.
+ */
+template <class PointT>
+class StaticKDTree {
+ public:
+  using Ptr = std::shared_ptr<StaticKDTree<PointT>>;
+  using ConstPtr = std::shared_ptr<const StaticKDTree<PointT>>;
+
+  StaticKDTree(const pcl::PointCloud<PointT>& points,
+               const KDTreeParams& params = KDTreeParams(10 /* max leaf */))
+      : adapter_(points), kdtree_(3, adapter_, params) {
+    kdtree_.buildIndex();
+  }
+
+  StaticKDTree(const StaticKDTree&) = delete;
+  StaticKDTree& operator=(const StaticKDTree&) = delete;
+
+  size_t size() const { return adapter_.kdtree_get_point_count(); }
+
+  template <typename ResultSet>
+  bool findNeighbors(ResultSet& result, const float* query,
+                     const KDTreeSearchParams& params) const {
+    return kdtree_.findNeighbors(result, query, params);
+  }
+
+  template <typename ResultSet>
+  size_t radiusSearchCustomCallback(const float* query, ResultSet& result,
+                                    const KDTreeSearchParams& params) const {
+    return kdtree_.radiusSearchCustomCallback(query, result, params);
+  }
+
+ private:
+  NanoFLANNAdapter<PointT> adapter_;
+  KDTree<PointT> kdtree_;
+};
+
+/**
+ * \brief Holds a StaticKDTree that is built by the first caller of get and
+ * shared by all later ones. Thread safe.
+ * \note Copies start empty, since the tree refers to the original points.
+ */
+template <class PointT>
+class LazyStaticKDTree {
+ public:
+  LazyStaticKDTree() = default;
+  LazyStaticKDTree(const LazyStaticKDTree&) {}
+  LazyStaticKDTree& operator=(const LazyStaticKDTree&) {
+    reset();
+    return *this;
+  }
+
+  /** \brief Returns the tree over points, building it if not built yet */
+  typename StaticKDTree<PointT>::ConstPtr get(
+      const pcl::PointCloud<PointT>& points) const {
+    // concurrent callers wait for the tree instead of building their own
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (kdtree_ == nullptr)
+      kdtree_ = std::make_shared<const StaticKDTree<PointT>>(points);
+    return kdtree_;
+  }
+
+  bool built() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return kdtree_ != nullptr;
+  }
+
+  /** \brief Drops the tree, must be called when the points change */
+  void reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    kdtree_.reset();
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  mutable typename StaticKDTree<PointT>::ConstPtr kdtree_;
+};
+
 }  // namespace lidar
 }  // namespace vtr
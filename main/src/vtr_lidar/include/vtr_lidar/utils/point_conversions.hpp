@@ -0,0 +1,169 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file point_conversions.hpp
+ * \brief Point cloud conversion kernels shared by the lidar conversion
+ * modules: PointCloud2 field decoding, polar coordinates and timestamps.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "pcl/point_cloud.h"
+#include "sensor_msgs/msg/point_cloud2.hpp"
+
+namespace vtr {
+namespace lidar {
+
+namespace conversions {
+
+/**
+ * \brief Branch free atan2 approximation, so that loops calling it vectorize.
+ * \details Odd minimax polynomial of atan on [0, 1], with the octant restored
+ * by selects; the absolute error is below 2e-6 rad on the whole plane.
+ * atan2(0, 0) is 0.
+ */
+inline float fastAtan2(const float y, const float x) {
+  const float ax = std::fabs(x), ay = std::fabs(y);
+  const float mx = std::max(ax, ay), mn = std::min(ax, ay);
+  const float a = mx > 0.f ? mn / mx : 0.f;
+  const float s = a * a;
+  // clang-format off
+  float r = ((((-0.01172120f * s + 0.05265332f) * s - 0.11643287f) * s
+              + 0.19354346f) * s - 0.33262347f) * s * a + 0.99997726f * a;
+  // clang-format on
+  r = ay > ax ? 1.57079637f - r : r;
+  r = x < 0.f ? 3.14159274f - r : r;
+  return y < 0.f ? -r : r;
+}
+
+/** \brief Number of points converted at once, the SoA scratch fits in L1 */
+constexpr size_t block_size = 256;
+
+/**
+ * \brief Computes polar coordinates (rho, theta, phi) of all points from their
+ * cartesian coordinates.
+ * \details Points are gathered into SoA blocks, converted in a vectorized
+ * loop and scattered back.
+ * \param[in] phi_offset added to the azimuth of every point
+ * \param[in] unwrap_phi whether to add or subtract 2pi to the azimuth of a
+ * point whenever it jumps by more than 1.5pi from the previous point, so that
+ * a spinning lidar scan crossing +-pi has a continuous azimuth
+ */
+template <class PointT>
+void cart2pol(pcl::PointCloud<PointT> &point_cloud, const float phi_offset = 0,
+              const bool unwrap_phi = false) {
+  alignas(64) float x[block_size], y[block_size], z[block_size];
+  alignas(64) float rho[block_size], theta[block_size], phi[block_size];
+  const size_t size = point_cloud.size();
+  float prev_phi = 0;
+  for (size_t begin = 0; begin < size; begin += block_size) {
+    const size_t n = std::min(block_size, size - begin);
+    for (size_t i = 0; i < n; ++i) {
+      const auto &p = point_cloud[begin + i];
+      x[i] = p.x, y[i] = p.y, z[i] = p.z;
+    }
+#pragma omp simd
+    for (size_t i = 0; i < n; ++i) {
+      const float rxy2 = x[i] * x[i] + y[i] * y[i];
+      rho[i] = std::sqrt(rxy2 + z[i] * z[i]);
+      theta[i] = fastAtan2(std::sqrt(rxy2), z[i]);
+      phi[i] = fastAtan2(y[i], x[i]) + phi_offset;
+    }
+    // unwrapping depends on the previous point, done while scattering back
+    for (size_t i = 0; i < n; ++i) {
+      auto &p = point_cloud[begin + i];
+      p.rho = rho[i], p.theta = theta[i], p.phi = phi[i];
+      if (unwrap_phi && begin + i > 0) {
+        if ((p.phi - prev_phi) > 1.5 * M_PI)
+          p.phi -= 2 * M_PI;
+        else if ((p.phi - prev_phi) < -1.5 * M_PI)
+          p.phi += 2 * M_PI;
+      }
+      prev_phi = p.phi;
+    }
+  }
+}
+
+/**
+ * \brief Estimates point timestamps from the azimuth, for lidars spinning at a
+ * constant angular velocity [rad/s] starting at time_offset [ns].
+ */
+template <class PointT>
+void estimateTime(pcl::PointCloud<PointT> &point_cloud,
+                  const int64_t time_offset, const double angular_vel) {
+  for (auto &p : point_cloud)
+    p.timestamp =
+        time_offset + static_cast<int64_t>(p.phi / angular_vel * 1e9);
+}
+
+/**
+ * \brief Reads one field of PointCloud2 points at its byte offset, instead of
+ * going through a PointCloud2ConstIterator per field.
+ */
+template <typename T>
+class PointCloud2Field {
+ public:
+  /** \throws std::runtime_error if msg has no (large enough) field name */
+  PointCloud2Field(const sensor_msgs::msg::PointCloud2 &msg,
+                   const std::string &name) {
+    const auto field = std::find_if(
+        msg.fields.begin(), msg.fields.end(),
+        [&name](const auto &field) { return field.name == name; });
+    if (field == msg.fields.end())
+      throw std::runtime_error("Field " + name + " does not exist");
+    if (field->offset + sizeof(T) > msg.point_step)
+      throw std::runtime_error("Field " + name + " exceeds the point step");
+    offset_ = field->offset;
+  }
+
+  T operator()(const uint8_t *point) const {
+    T value;
+    std::memcpy(&value, point + offset_, sizeof(T));
+    return value;
+  }
+
+ private:
+  size_t offset_;
+};
+
+/**
+ * \brief Calls f(index, point) for every point of msg in storage order, with
+ * point pointing to the raw bytes of the point.
+ * \throws std::runtime_error if msg holds less data than its dimensions
+ */
+template <typename F>
+void forEachPoint(const sensor_msgs::msg::PointCloud2 &msg, F &&f) {
+  if (msg.height == 0 || msg.width == 0) return;
+  if (msg.data.size() < (size_t)(msg.height - 1) * msg.row_step +
+                            (size_t)msg.width * msg.point_step)
+    throw std::runtime_error("PointCloud2 data is smaller than its size");
+  size_t idx = 0;
+  for (uint32_t row = 0; row < msg.height; ++row) {
+    const uint8_t *point = msg.data.data() + (size_t)row * msg.row_step;
+    for (uint32_t col = 0; col < msg.width; ++col, ++idx)
+      f(idx, point + (size_t)col * msg.point_step);
+  }
+}
+
+}  // namespace conversions
+
+}  // namespace lidar
+}  // namespace vtr
@@ -0,0 +1,135 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file pose_interpolation_cache.hpp
+ * \brief PoseInterpolationCache class definition
+ */
+#pragma once
+
+#include <algorithm>
+#include <functional>
+
+#include "steam.hpp"
+
+#include "vtr_lidar/data_types/point.hpp"
+
+namespace vtr {
+namespace lidar {
+
+/**
+ * \brief Groups points by timestamp, quantized to a time resolution, so that
+ * a continuous-time trajectory is interpolated once per group of points
+ * instead of once per point.
+ * \details Lidar points are fired in a small number of time slots, so the
+ * groups are few. Each group owns one pose evaluable; evaluate() computes all
+ * group poses for the current state and transform() applies them to the
+ * points, one matrix product per contiguous range of point indices.
+ */
+class PoseInterpolationCache {
+ public:
+  using PoseEvaluable = steam::Evaluable<lgmath::se3::Transformation>;
+  using MakeEvaluable = std::function<PoseEvaluable::ConstPtr(int64_t)>;
+
+  /**
+   * \param points points to group, by their timestamp field [ns]
+   * \param resolution timestamps are rounded to the nearest multiple of it
+   * [ns], no rounding if not positive (points of identical timestamps are
+   * still grouped)
+   * \param make_evaluable creates the pose evaluable of a (rounded) timestamp
+   */
+  template <class PointT>
+  PoseInterpolationCache(const pcl::PointCloud<PointT> &points,
+                         const int64_t resolution,
+                         const MakeEvaluable &make_evaluable) {
+    const auto quantize = [&resolution](const int64_t time) -> int64_t {
+      if (resolution <= 0) return time;
+      const int64_t rem = ((time % resolution) + resolution) % resolution;
+      return time - rem + (2 * rem >= resolution ? resolution : 0);
+    };
+
+    std::vector<std::pair<int64_t, size_t>> time_inds(points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+      time_inds[i] = {quantize(points[i].timestamp), i};
+    std::sort(time_inds.begin(), time_inds.end());
+
+    order_.resize(points.size());
+    group_of_.resize(points.size());
+    for (size_t j = 0; j < time_inds.size(); ++j) {
+      if (j == 0 || time_inds[j].first != time_inds[j - 1].first) {
+        offsets_.push_back(j);
+        evals_.emplace_back(make_evaluable(time_inds[j].first));
+      }
+      order_[j] = time_inds[j].second;
+      group_of_[time_inds[j].second] = evals_.size() - 1;
+    }
+    offsets_.push_back(points.size());
+    poses_.resize(evals_.size());
+  }
+
+  /** \brief Number of groups */
+  size_t size() const { return evals_.size(); }
+
+  /** \brief Group of the i-th point */
+  size_t group(const size_t i) const { return group_of_[i]; }
+
+  /** \brief Point indices sorted by group */
+  const std::vector<size_t> &order() const { return order_; }
+
+  /** \brief Pose evaluable of each group */
+  const std::vector<PoseEvaluable::ConstPtr> &evaluables() const {
+    return evals_;
+  }
+
+  /** \brief Evaluates the pose of every group at the current state */
+  void evaluate(const int num_threads = 1) {
+#pragma omp parallel for schedule(static) num_threads(num_threads)
+    for (size_t g = 0; g < evals_.size(); ++g)
+      poses_[g] = evals_[g]->evaluate().matrix().cast<float>();
+  }
+
+  /**
+   * \brief Applies the pose of its group to each column of in, as of the
+   * last call to evaluate().
+   * \param in 4xN matrix of homogeneous points/normals
+   * \param out 4xN output matrix, must not alias in
+   */
+  template <class InMatrix, class OutMatrix>
+  void transform(const InMatrix &in, OutMatrix &out,
+                 const int num_threads = 1) const {
+#pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads)
+    for (size_t g = 0; g < evals_.size(); ++g) {
+      const auto &T = poses_[g];
+      for (size_t j = offsets_[g]; j < offsets_[g + 1];) {
+        // indices of a group are sorted, transform consecutive ones at once
+        size_t k = j + 1;
+        while (k < offsets_[g + 1] && order_[k] == order_[k - 1] + 1) ++k;
+        out.middleCols(order_[j], k - j).noalias() =
+            T * in.middleCols(order_[j], k - j);
+        j = k;
+      }
+    }
+  }
+
+ private:
+  std::vector<size_t> order_;
+  std::vector<size_t> offsets_;
+  std::vector<size_t> group_of_;
+  std::vector<PoseEvaluable::ConstPtr> evals_;
+  std::vector<Eigen::Matrix4f, Eigen::aligned_allocator<Eigen::Matrix4f>>
+      poses_;
+};
+
+}  // namespace lidar
+}  // namespace vtr
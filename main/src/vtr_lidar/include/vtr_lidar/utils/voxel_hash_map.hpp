@@ -0,0 +1,210 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file voxel_hash_map.hpp
+ * \brief VoxelHashMap class definition
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace vtr {
+namespace lidar {
+
+namespace voxel_hash_map {
+
+/** \brief Interleaves the lower 21 bits of x with two zero bits each */
+inline uint64_t spreadBits(uint64_t x) {
+  x &= 0x1fffff;
+  x = (x | x << 32) & 0x1f00000000ffff;
+  x = (x | x << 16) & 0x1f0000ff0000ff;
+  x = (x | x << 8) & 0x100f00f00f00f00f;
+  x = (x | x << 4) & 0x10c30c30c30c30c3;
+  x = (x | x << 2) & 0x1249249249249249;
+  return x;
+}
+
+constexpr int64_t morton_offset = int64_t(1) << 20;
+
+/** \brief Whether all coordinates are within [-2^20, 2^20 - 1] */
+inline bool inMortonRange(const int x, const int y, const int z) {
+  constexpr auto range = uint64_t(2 * morton_offset);
+  return uint64_t(x + morton_offset) < range &&
+         uint64_t(y + morton_offset) < range &&
+         uint64_t(z + morton_offset) < range;
+}
+
+/**
+ * \brief Morton code of a voxel, coordinates are offset to be non-negative
+ * and must be within [-2^20, 2^20 - 1], see inMortonRange.
+ */
+inline uint64_t mortonCode(const int x, const int y, const int z) {
+  constexpr int64_t offset = morton_offset;
+  return spreadBits(uint64_t(x + offset)) |
+         spreadBits(uint64_t(y + offset)) << 1 |
+         spreadBits(uint64_t(z + offset)) << 2;
+}
+
+}  // namespace voxel_hash_map
+
+/**
+ * \brief Open-addressing hash map from voxel coordinates to Value.
+ * \details Keys are stored as 64-bit Morton codes next to their values in a
+ * flat power-of-two table (linear probing, at most half full), so lookups
+ * touch one or two cache lines and there is no per-entry allocation. clear()
+ * keeps the table, and reserve() sizes it up front to avoid rehashing.
+ * Entries cannot be erased individually.
+ * \note voxels out of the Morton code range (e.g. beyond about 10 km with 1 cm
+ * voxels) would alias, so they are kept in a std::map on the side instead.
+ */
+template <class Value>
+class VoxelHashMap {
+ public:
+  VoxelHashMap(const size_t capacity = 0) { reserve(capacity); }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  /** \brief Removes all entries, keeping the allocated table */
+  void clear() {
+    if (size_ == 0) return;
+    for (auto& entry : table_) entry.key = empty_key;
+    overflow_.clear();
+    size_ = 0;
+  }
+
+  /** \brief Makes room for num_entries entries without rehashing */
+  void reserve(const size_t num_entries) {
+    size_t capacity = 16;
+    while (capacity < 2 * num_entries) capacity <<= 1;
+    if (capacity > table_.size()) rehash(capacity);
+  }
+
+  /**
+   * \brief Inserts value at key if key is not present, returns a pointer to
+   * the value at key and whether the insertion took place.
+   * \note the pointer is invalidated by the next insertion.
+   */
+  std::pair<Value*, bool> try_emplace(const int x, const int y, const int z,
+                                      const Value& value) {
+    if (!voxel_hash_map::inMortonRange(x, y, z)) {
+      const auto res = overflow_.try_emplace({x, y, z}, value);
+      if (res.second) ++size_;
+      return {&res.first->second, res.second};
+    }
+    if (2 * (size_ + 1) > table_.size()) rehash(2 * table_.size());
+    const auto key = voxel_hash_map::mortonCode(x, y, z);
+    auto slot = index(key);
+    while (true) {
+      auto& entry = table_[slot];
+      if (entry.key == key) return {&entry.value, false};
+      if (entry.key == empty_key) {
+        entry.key = key;
+        entry.value = value;
+        ++size_;
+        return {&entry.value, true};
+      }
+      slot = (slot + 1) & mask_;
+    }
+  }
+
+  template <class Key>
+  std::pair<Value*, bool> try_emplace(const Key& k, const Value& value) {
+    return try_emplace(k.x, k.y, k.z, value);
+  }
+
+  template <class Key>
+  std::pair<Value*, bool> emplace(const Key& k, const Value& value) {
+    return try_emplace(k.x, k.y, k.z, value);
+  }
+
+  /** \brief Returns a pointer to the value at key, or nullptr */
+  const Value* find(const int x, const int y, const int z) const {
+    if (size_ == 0) return nullptr;
+    if (!voxel_hash_map::inMortonRange(x, y, z)) {
+      const auto itr = overflow_.find({x, y, z});
+      return itr == overflow_.end() ? nullptr : &itr->second;
+    }
+    const auto key = voxel_hash_map::mortonCode(x, y, z);
+    for (auto slot = index(key);; slot = (slot + 1) & mask_) {
+      const auto& entry = table_[slot];
+      if (entry.key == key) return &entry.value;
+      if (entry.key == empty_key) return nullptr;
+    }
+  }
+
+  Value* find(const int x, const int y, const int z) {
+    return const_cast<Value*>(
+        static_cast<const VoxelHashMap*>(this)->find(x, y, z));
+  }
+
+  template <class Key>
+  const Value* find(const Key& k) const {
+    return find(k.x, k.y, k.z);
+  }
+
+  template <class Key>
+  Value* find(const Key& k) {
+    return find(k.x, k.y, k.z);
+  }
+
+  template <class Key>
+  size_t count(const Key& k) const {
+    return find(k) == nullptr ? 0 : 1;
+  }
+
+ private:
+  /** \brief Never a valid Morton code given the coordinate range */
+  static constexpr uint64_t empty_key = ~uint64_t(0);
+
+  struct Entry {
+    uint64_t key = empty_key;
+    Value value;
+  };
+
+  /** \brief Fibonacci hashing of the Morton code to a table slot */
+  size_t index(const uint64_t key) const {
+    return size_t((key * 0x9e3779b97f4a7c15) >> shift_);
+  }
+
+  void rehash(const size_t capacity) {
+    std::vector<Entry> table(capacity);
+    std::swap(table, table_);
+    mask_ = capacity - 1;
+    shift_ = 64;
+    for (size_t c = capacity; c > 1; c >>= 1) --shift_;
+    for (const auto& entry : table) {
+      if (entry.key == empty_key) continue;
+      auto slot = index(entry.key);
+      while (table_[slot].key != empty_key) slot = (slot + 1) & mask_;
+      table_[slot] = entry;
+    }
+  }
+
+  std::vector<Entry> table_;
+  /** \brief voxels out of the Morton code range */
+  std::map<std::tuple<int, int, int>, Value> overflow_;
+  size_t mask_ = 0;
+  unsigned shift_ = 64;
+  size_t size_ = 0;
+};
+
+}  // namespace lidar
+}  // namespace vtr
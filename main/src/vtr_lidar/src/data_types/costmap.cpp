@@ -150,6 +150,18 @@ auto DenseCostMap::filter(const float& threshold) const -> XY2ValueMap {
   return filtered;
 }
 
+auto DenseCostMap::toObstacleGrid(const float& threshold) const
+    -> tactic::ObstacleGrid::Ptr {
+  auto grid = std::make_shared<tactic::ObstacleGrid>(dl_, width_, height_,
+                                                     origin_.x, origin_.y);
+  for (int x = 0; x < width_; ++x)
+    for (int y = 0; y < height_; ++y) {
+      if (values_(x, y) < threshold) continue;
+      grid->set(x + origin_.x, y + origin_.y, values_(x, y));
+    }
+  return grid;
+}
+
 float DenseCostMap::at(const costmap::PixKey& k) const {
   if (!contains(k)) return default_value_;
   const auto shifted_k = k - origin_;
@@ -181,6 +193,17 @@ auto SparseCostMap::filter(const float& threshold) const -> XY2ValueMap {
   return filtered;
 }
 
+auto SparseCostMap::toObstacleGrid(const float& threshold) const
+    -> tactic::ObstacleGrid::Ptr {
+  auto grid = std::make_shared<tactic::ObstacleGrid>(dl_, width_, height_,
+                                                     origin_.x, origin_.y);
+  for (const auto& val : values_) {
+    if (val.second < threshold) continue;
+    grid->set(val.first.x, val.first.y, val.second);
+  }
+  return grid;
+}
+
 auto SparseCostMap::toCostMapMsg() const -> CostMapMsg {
   CostMapMsg costmap_msg;
 
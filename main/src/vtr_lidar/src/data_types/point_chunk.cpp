@@ -0,0 +1,247 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file point_chunk.cpp
+ */
+#include "vtr_lidar/data_types/point_chunk.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <mutex>
+#include <string_view>
+
+#include "vtr_common/utils/hash.hpp"
+#include "vtr_logging/logging.hpp"
+#include "vtr_storage/stream/data_stream_accessor.hpp"
+
+namespace fs = std::filesystem;
+
+namespace vtr {
+namespace lidar {
+
+MappedPointChunk::MappedPointChunk(const fs::path &path,
+                                   const size_t point_size) {
+  const auto error = [&path](const std::string &what) {
+    std::string err{"Point chunk " + path.string() + ": " + what};
+    CLOG(ERROR, "lidar.point_chunk") << err;
+    throw std::runtime_error{err};
+  };
+
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) error("cannot be opened.");
+  struct stat st;
+  if (::fstat(fd, &st) != 0 || (size_t)st.st_size < header_size) {
+    ::close(fd);
+    error("is truncated.");
+  }
+  length_ = st.st_size;
+  addr_ = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);  // the mapping keeps the file open
+  if (addr_ == MAP_FAILED) {
+    addr_ = nullptr;
+    error("cannot be mapped.");
+  }
+
+  const auto &h = header();
+  std::string what;
+  if (std::memcmp(h.magic, magic, sizeof(magic)) != 0)
+    what = "is not a point chunk file.";
+  else if (h.version != format_version)
+    what = "has unsupported version " + std::to_string(h.version) + ".";
+  else if (h.point_size != point_size)
+    what = "stores points of size " + std::to_string(h.point_size) +
+           ", expected " + std::to_string(point_size) + ".";
+  else if (h.data_offset < sizeof(Header) ||
+           length_ < h.data_offset + h.num_points * h.point_size)
+    what = "is truncated.";
+  if (!what.empty()) {
+    ::munmap(addr_, length_);
+    addr_ = nullptr;
+    error(what);
+  }
+  // points are copied out sequentially
+  ::madvise(addr_, length_, MADV_SEQUENTIAL);
+}
+
+MappedPointChunk::~MappedPointChunk() {
+  if (addr_ != nullptr) ::munmap(addr_, length_);
+}
+
+void MappedPointChunk::write(const fs::path &path, const void *data,
+                             const size_t point_size, const Header &header) {
+  Header h = header;
+  std::memcpy(h.magic, magic, sizeof(magic));
+  h.version = format_version;
+  h.point_size = point_size;
+  h.data_offset = header_size;
+  char padded[header_size] = {};
+  std::memcpy(padded, &h, sizeof(Header));
+
+  const auto error = [&path](const std::string &what) {
+    std::string err{"Point chunk " + path.string() + ": " + what};
+    CLOG(ERROR, "lidar.point_chunk") << err;
+    throw std::runtime_error{err};
+  };
+  const auto write_all = [](const int fd, const void *buf, size_t size) {
+    const auto *p = static_cast<const char *>(buf);
+    while (size > 0) {
+      const auto n = ::write(fd, p, size);
+      if (n < 0 && errno == EINTR) continue;
+      if (n <= 0) return false;
+      p += n;
+      size -= n;
+    }
+    return true;
+  };
+
+  // unique temporary file, the same chunk may be stored concurrently
+  static std::atomic<uint64_t> counter{0};
+  auto tmp_path = path;
+  tmp_path += "." + std::to_string(counter++) + ".tmp";
+  const int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) error("cannot be created.");
+  const bool written = write_all(fd, padded, header_size) &&
+                       write_all(fd, data, h.num_points * point_size);
+  ::close(fd);
+  if (!written) {
+    fs::remove(tmp_path);
+    error("failed to write.");
+  }
+  // readers never see a partially written chunk
+  fs::rename(tmp_path, path);
+}
+
+namespace {
+
+std::mutex store_mutex;
+fs::path store_directory;
+bool store_write_chunks = false;
+
+}  // namespace
+
+void PointChunkStore::configure(const fs::path &directory,
+                                const bool write_chunks) {
+  const std::lock_guard<std::mutex> lock(store_mutex);
+  if (write_chunks) fs::create_directories(directory);
+  store_directory = directory;
+  store_write_chunks = write_chunks;
+  CLOG(INFO, "lidar.point_chunk")
+      << "Point chunk directory set to " << directory << ", writing chunks "
+      << (write_chunks ? "enabled" : "disabled");
+}
+
+fs::path PointChunkStore::directory() {
+  const std::lock_guard<std::mutex> lock(store_mutex);
+  return store_directory;
+}
+
+bool PointChunkStore::writeChunks() {
+  const std::lock_guard<std::mutex> lock(store_mutex);
+  return store_write_chunks;
+}
+
+fs::path PointChunkStore::defaultDirectory(const fs::path &graph_path) {
+  return graph_path / "data" / "point_chunks";
+}
+
+std::string PointChunkStore::currentStream() {
+  using storage::DataStreamAccessorBase;
+  const auto scope = DataStreamAccessorBase::StorableScope::current();
+  return scope == nullptr ? std::string{}
+                          : scope->accessor().dataDirectory().string();
+}
+
+std::string PointChunkStore::write(PointChunkFile &file, const void *data,
+                                   const size_t point_size,
+                                   const MappedPointChunk::Header &header) {
+  // hash of everything written, 0 is reserved for loaded files
+  size_t hash = std::hash<std::string_view>{}(std::string_view(
+      static_cast<const char *>(data), header.num_points * point_size));
+  common::hash_combine(hash, point_size, header.width, header.height,
+                       header.is_dense);
+  if (hash == 0) hash = 1;
+
+  const auto stream = currentStream();
+  const std::lock_guard<std::mutex> lock(file.mutex_);
+  auto &chunk = file.files_[stream];
+  if (!chunk.name.empty() && chunk.hash == hash) return chunk.name;
+
+  // a new file every time, the replaced one stays valid until the message
+  // referring to the new one is committed (and mapped readers keep it anyway)
+  static std::atomic<uint64_t> counter{0};
+  const auto now = std::chrono::system_clock::now().time_since_epoch();
+  const auto name = std::to_string(std::chrono::nanoseconds(now).count()) +
+                    "_" + std::to_string(counter++) + ".pts";
+  const auto dir = directory();
+  MappedPointChunk::write(dir / name, data, point_size, header);
+
+  using storage::DataStreamAccessorBase;
+  const auto scope = DataStreamAccessorBase::StorableScope::current();
+  if (scope != nullptr && scope->serializing())
+    scope->accessor().syncOnCommit(dir / name);
+  if (!chunk.name.empty()) removeReplaced(dir / chunk.name);
+  chunk = {name, hash};
+  return name;
+}
+
+void PointChunkStore::remove(PointChunkFile &file) {
+  const auto stream = currentStream();
+  const std::lock_guard<std::mutex> lock(file.mutex_);
+  const auto chunk = file.files_.find(stream);
+  if (chunk == file.files_.end()) return;
+  const auto dir = directory();
+  if (!dir.empty()) removeReplaced(dir / chunk->second.name);
+  file.files_.erase(chunk);
+}
+
+void PointChunkStore::removeReplaced(const fs::path &path) {
+  using storage::DataStreamAccessorBase;
+  const auto scope = DataStreamAccessorBase::StorableScope::current();
+  if (scope != nullptr && scope->serializing()) {
+    scope->accessor().removeOnCommit(path);
+    return;
+  }
+  std::error_code ec;
+  fs::remove(path, ec);
+}
+
+MappedPointChunk::ConstPtr PointChunkStore::map(const std::string &chunk_file,
+                                                const size_t point_size) {
+  auto dir = directory();
+  // not configured in this process, e.g. by tools that only read the graph
+  if (dir.empty()) {
+    using storage::DataStreamAccessorBase;
+    const auto scope = DataStreamAccessorBase::StorableScope::current();
+    if (scope != nullptr)
+      dir = defaultDirectory(scope->accessor().baseDirectory().parent_path());
+  }
+  if (dir.empty()) {
+    std::string err{"Point chunk " + chunk_file +
+                    " cannot be loaded: chunk directory not configured."};
+    CLOG(ERROR, "lidar.point_chunk") << err;
+    throw std::runtime_error{err};
+  }
+  return std::make_shared<const MappedPointChunk>(dir / chunk_file,
+                                                  point_size);
+}
+
+}  // namespace lidar
+}  // namespace vtr
@@ -19,6 +19,7 @@
 #include "vtr_lidar/modules/localization/localization_icp_module.hpp"
 
 #include "vtr_lidar/utils/nanoflann_utils.hpp"
+#include "vtr_tactic/icp_cost_term.hpp"
 
 namespace vtr {
 namespace lidar {
@@ -103,6 +104,17 @@ void LocalizationICPModule::run_(QueryCache &qdata0, OutputCache &,
   /// compound transform for alignment (sensor to point map transform)
   const auto T_m_s_eval = inverse(compose(T_s_r_var, compose(T_r_v_var, T_v_m_var)));
 
+  /// optimization problem, reused across iterations with the point matches
+  /// refilled every iteration
+  // matches are accumulated in parallel inside the icp cost term, so the
+  // problem itself is single threaded
+  OptimizationProblem problem(1);
+  problem.addStateVariable(T_r_v_var);
+  if (config_->use_pose_prior) problem.addCostTerm(prior_cost_term);
+  const auto icp_cost_term = ICPCostTerm::MakeShared({T_m_s_eval}, L2LossFunc::MakeShared(), config_->num_threads);
+  icp_cost_term->reserve(query_points.size());
+  problem.addCostTerm(icp_cost_term);
+
   /// Initialize aligned points for matching (Deep copy of targets)
   pcl::PointCloud<PointWithInfo> aligned_points(query_points);
 
@@ -114,12 +126,9 @@ void LocalizationICPModule::run_(QueryCache &qdata0, OutputCache &,
   auto aligned_mat = aligned_points.getMatrixXfMap(4, PointWithInfo::size(), PointWithInfo::cartesian_offset());
   auto aligned_norms_mat = aligned_points.getMatrixXfMap(4, PointWithInfo::size(), PointWithInfo::normal_offset());
 
-  /// create kd-tree of the map
-  CLOG(DEBUG, "lidar.localization_icp") << "Start building a kd-tree of the map.";
-  NanoFLANNAdapter<PointWithInfo> adapter(point_map);
-  KDTreeParams tree_params(/* max leaf */ 10);
-  auto kdtree = std::make_unique<KDTree<PointWithInfo>>(3, adapter, tree_params);
-  kdtree->buildIndex();
+  /// kd-tree of the map, shared with other modules until the submap changes
+  CLOG(DEBUG, "lidar.localization_icp") << "Retrieving the kd-tree of the map.";
+  const auto kdtree = qdata.submap_loc->staticKDTree();
 
   /// perform initial alignment
   {
@@ -198,37 +207,19 @@ void LocalizationICPModule::run_(QueryCache &qdata0, OutputCache &,
     /// point to plane optimization
     timer[3]->start();
 
-    // initialize problem
-    OptimizationProblem problem(config_->num_threads);
-
-    // add variables
-    problem.addStateVariable(T_r_v_var);
-
-    // add prior cost terms
-    if (config_->use_pose_prior) problem.addCostTerm(prior_cost_term);
-
-    // shared loss function
-    auto loss_func = L2LossFunc::MakeShared();
-    // cost terms and noise model
-#pragma omp parallel for schedule(dynamic, 10) num_threads(config_->num_threads)
+    // refill the icp cost term with the current matches
+    icp_cost_term->clear();
     for (const auto &ind : filtered_sample_inds) {
       // noise model W = n * n.T (information matrix)
       if (point_map[ind.second].normal_score <= 0.0) continue;
       Eigen::Vector3d nrm = map_normals_mat.block<3, 1>(0, ind.second).cast<double>();
       Eigen::Matrix3d W(point_map[ind.second].normal_score * (nrm * nrm.transpose()) + 1e-5 * Eigen::Matrix3d::Identity());
-      auto noise_model = StaticNoiseModel<3>::MakeShared(W, NoiseType::INFORMATION);
 
       // query and reference point
       const auto qry_pt = query_mat.block<3, 1>(0, ind.first).cast<double>();
       const auto ref_pt = map_mat.block<3, 1>(0, ind.second).cast<double>();
 
-      const auto error_func = p2p::p2pError(T_m_s_eval, ref_pt, qry_pt);
-
-      // create cost term and add to problem
-      auto cost = WeightedLeastSqCostTerm<3>::MakeShared(error_func, noise_model, loss_func);
-
-#pragma omp critical(loc_icp_add_p2p_error_cost)
-      problem.addCostTerm(cost);
+      icp_cost_term->add(qry_pt, ref_pt, W);
     }
 
     // optimize
@@ -18,6 +18,9 @@
  */
 #include "vtr_lidar/modules/localization/localization_map_recall_module.hpp"
 
+#include <algorithm>
+#include <chrono>
+
 #include "pcl_conversions/pcl_conversions.h"
 
 #include "vtr_lidar/data_types/pointmap_pointer.hpp"
@@ -33,14 +36,33 @@ auto LocalizationMapRecallModule::Config::fromROS(
   auto config = std::make_shared<Config>();
   // clang-format off
   config->map_version = node->declare_parameter<std::string>(param_prefix + ".map_version", config->map_version);
+  config->prefetch_num_submaps = node->declare_parameter<int>(param_prefix + ".prefetch.num_submaps", config->prefetch_num_submaps);
+  config->prefetch_min_distance = node->declare_parameter<double>(param_prefix + ".prefetch.min_distance", config->prefetch_min_distance);
+  config->prefetch_horizon = node->declare_parameter<double>(param_prefix + ".prefetch.horizon", config->prefetch_horizon);
+  config->prefetch_memory_budget = node->declare_parameter<double>(param_prefix + ".prefetch.memory_budget", config->prefetch_memory_budget);
   config->visualize = node->declare_parameter<bool>(param_prefix + ".visualize", config->visualize);
   // clang-format on
   return config;
 }
 
-void LocalizationMapRecallModule::run_(QueryCache &qdata0, OutputCache &,
+void LocalizationMapRecallModule::reset() {
+  std::lock_guard<std::mutex> lock(prefetch_mutex_);
+  prefetch_vid_ = VertexId::Invalid();
+  prefetch_request_.clear();
+  current_map_vid_ = VertexId::Invalid();
+  prefetched_.clear();
+  prefetch_stats_.bytes = 0;
+}
+
+auto LocalizationMapRecallModule::prefetchStatistics() const
+    -> PrefetchStatistics {
+  std::lock_guard<std::mutex> lock(prefetch_mutex_);
+  return prefetch_stats_;
+}
+
+void LocalizationMapRecallModule::run_(QueryCache &qdata0, OutputCache &output,
                                        const Graph::Ptr &graph,
-                                       const TaskExecutor::Ptr &) {
+                                       const TaskExecutor::Ptr &executor) {
   auto &qdata = dynamic_cast<LidarQueryCache &>(qdata0);
 
   /// Create a node for visualization if necessary
@@ -84,25 +106,64 @@ void LocalizationMapRecallModule::run_(QueryCache &qdata0, OutputCache &,
     // signal that loc map did not change
     qdata.submap_loc_changed.emplace(false);
   } else {
-    auto vertex = graph->at(pointmap_ptr.map_vid);
-    CLOG(INFO, "lidar.localization_map_recall")
-        << "Loading map " << config_->map_version << " from vertex " << vid_loc;
-    const auto specified_map_msg = vertex->retrieve<PointMap<PointWithInfo>>(
-        config_->map_version, "vtr_lidar_msgs/msg/PointMap");
-    if (specified_map_msg == nullptr) {
-      CLOG(ERROR, "lidar.localization_map_recall")
-          << "Could not find map " << config_->map_version << " at vertex "
+    // the submap and its kd-tree are ready if it has been prefetched
+    std::shared_ptr<const PointMap<PointWithInfo>> submap = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(prefetch_mutex_);
+      const auto prefetched = prefetched_.find(pointmap_ptr.map_vid);
+      if (prefetched == prefetched_.end()) {
+        ++prefetch_stats_.misses;
+      } else if (prefetched->second.loaded) {
+        ++prefetch_stats_.hits;
+        prefetch_stats_.bytes -= prefetched->second.bytes;
+        submap = prefetched->second.submap;
+        prefetched_.erase(prefetched);
+      } else {
+        // the prefetching task removes it once loaded
+        ++prefetch_stats_.late;
+      }
+      current_map_vid_ = pointmap_ptr.map_vid;
+      CLOG(DEBUG, "lidar.localization_map_recall")
+          << "Submap prefetching hits: " << prefetch_stats_.hits
+          << ", late: " << prefetch_stats_.late
+          << ", misses: " << prefetch_stats_.misses
+          << ", evictions: " << prefetch_stats_.evictions;
+    }
+
+    const auto load_start = std::chrono::steady_clock::now();
+    if (submap == nullptr) {
+      auto vertex = graph->at(pointmap_ptr.map_vid);
+      CLOG(INFO, "lidar.localization_map_recall")
+          << "Loading map " << config_->map_version << " from vertex "
           << vid_loc;
-      throw std::runtime_error("Could not find map " + config_->map_version +
-                               " at vertex " + std::to_string(vid_loc));
+      const auto specified_map_msg = vertex->retrieve<PointMap<PointWithInfo>>(
+          config_->map_version, "vtr_lidar_msgs/msg/ChunkedPointMap");
+      if (specified_map_msg == nullptr) {
+        CLOG(ERROR, "lidar.localization_map_recall")
+            << "Could not find map " << config_->map_version << " at vertex "
+            << vid_loc;
+        throw std::runtime_error("Could not find map " + config_->map_version +
+                                 " at vertex " + std::to_string(vid_loc));
+      }
+      auto locked_specified_map_msg = specified_map_msg->sharedLocked();
+      // the kd-tree is built lazily by the first module that needs it
+      submap = std::make_shared<PointMap<PointWithInfo>>(
+          locked_specified_map_msg.get().getData());
+    } else {
+      CLOG(INFO, "lidar.localization_map_recall")
+          << "Using prefetched map " << config_->map_version << " of vertex "
+          << pointmap_ptr.map_vid;
     }
-    auto locked_specified_map_msg = specified_map_msg->sharedLocked();
-    qdata.submap_loc = std::make_shared<PointMap<PointWithInfo>>(
-        locked_specified_map_msg.get().getData());
+    qdata.submap_loc = submap;
+    load_latency_->record(
+        (std::chrono::steady_clock::now() - load_start).count());
     // signal that loc map did change
     qdata.submap_loc_changed.emplace(true);
   }
 
+  /// load the submaps ahead in the background
+  if (config_->prefetch_num_submaps > 0) prefetch(qdata, output, executor);
+
   /// update the submap to vertex transformation
   qdata.T_v_m_loc.emplace(pointmap_ptr.T_v_this_map *
                           qdata.submap_loc->T_vertex_this());
@@ -128,5 +189,140 @@ void LocalizationMapRecallModule::run_(QueryCache &qdata0, OutputCache &,
   }
 }
 
+void LocalizationMapRecallModule::prefetch(LidarQueryCache &qdata,
+                                           const OutputCache &output,
+                                           const TaskExecutor::Ptr &executor) {
+  if (executor == nullptr || !output.chain.valid() || !qdata.sid_loc.valid())
+    return;
+
+  const auto &vid_loc = *qdata.vid_loc;
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    if (vid_loc == prefetch_vid_) return;
+  }
+
+  /// vertices ahead of the trunk within the look ahead distance, which grows
+  /// with the speed so that submaps are loaded a horizon before they are needed
+  std::vector<VertexId> vertices;
+  {
+    const auto &chain = *output.chain;
+    const auto chain_lock = chain.guard();
+    const auto &sid_loc = *qdata.sid_loc;
+    if (sid_loc >= chain.size()) return;
+    const double speed = chain.leaf_velocity().head<3>().norm();
+    const double distance = std::max(config_->prefetch_min_distance,
+                                      speed * config_->prefetch_horizon);
+    const double dist_loc = chain.dist(sid_loc);
+    for (auto it = chain.begin(sid_loc + 1);
+         it != chain.end() && chain.dist(it) - dist_loc <= distance; ++it)
+      vertices.push_back(it->to());
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    prefetch_vid_ = vid_loc;
+    prefetch_request_ = std::move(vertices);
+  }
+
+  executor->dispatch(std::make_shared<Task>(
+      shared_from_this(), qdata.shared_from_this(), 0, Task::DepIdSet{},
+      Task::DepId{}, "Submap Prefetch", vid_loc));
+}
+
+void LocalizationMapRecallModule::runAsync_(QueryCache &, OutputCache &,
+                                            const Graph::Ptr &graph,
+                                            const TaskExecutor::Ptr &,
+                                            const Task::Priority &,
+                                            const Task::DepId &) {
+  std::vector<VertexId> vertices;
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    vertices = prefetch_request_;
+  }
+
+  /// the next submaps in chain order, from the (small) pointmap pointers
+  std::vector<VertexId> map_vids;
+  for (const auto &vid : vertices) {
+    if (map_vids.size() >= (size_t)config_->prefetch_num_submaps) break;
+    const auto msg = graph->at(vid)->retrieve<PointMapPointer>(
+        "pointmap_ptr", "vtr_lidar_msgs/msg/PointMapPointer");
+    if (msg == nullptr) continue;
+    const auto map_vid = msg->sharedLocked().get().getData().map_vid;
+    {
+      std::lock_guard<std::mutex> lock(prefetch_mutex_);
+      if (map_vid == current_map_vid_) continue;
+    }
+    if (std::find(map_vids.begin(), map_vids.end(), map_vid) == map_vids.end())
+      map_vids.push_back(map_vid);
+  }
+
+  /// evict prefetched submaps that are no longer ahead (e.g. after slowing
+  /// down or a new path), keep the ones in progress
+  std::vector<VertexId> to_evict;
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    for (auto it = prefetched_.begin(); it != prefetched_.end();) {
+      if (it->second.loaded &&
+          std::find(map_vids.begin(), map_vids.end(), it->first) ==
+              map_vids.end()) {
+        to_evict.push_back(it->first);
+        prefetch_stats_.bytes -= it->second.bytes;
+        ++prefetch_stats_.evictions;
+        it = prefetched_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (const auto &map_vid : to_evict) graph->at(map_vid)->unload();
+
+  /// load the submaps in order until the memory budget is used up
+  const auto budget = (size_t)(config_->prefetch_memory_budget * 1024 * 1024);
+  for (const auto &map_vid : map_vids) {
+    {
+      std::lock_guard<std::mutex> lock(prefetch_mutex_);
+      if (map_vid == current_map_vid_ || prefetched_.count(map_vid)) continue;
+      if (prefetch_stats_.bytes >= budget) {
+        CLOG(DEBUG, "lidar.localization_map_recall")
+            << "Submap prefetching memory budget used up before vertex "
+            << map_vid;
+        break;
+      }
+      prefetched_.emplace(map_vid, PrefetchedSubmap{});
+    }
+
+    const auto map_msg = graph->at(map_vid)->retrieve<PointMap<PointWithInfo>>(
+        config_->map_version, "vtr_lidar_msgs/msg/ChunkedPointMap");
+    /// copy the submap and build its kd-tree here, so that localization can
+    /// use it right away when it gets there
+    std::shared_ptr<const PointMap<PointWithInfo>> submap = nullptr;
+    if (map_msg != nullptr) {
+      submap = std::make_shared<PointMap<PointWithInfo>>(
+          map_msg->sharedLocked().get().getData());
+      submap->staticKDTree();
+    }
+    // vertex data and the copy, ignoring the (smaller) kd-tree
+    const size_t bytes =
+        submap == nullptr ? 0 : 2 * submap->size() * sizeof(PointWithInfo);
+
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    const auto prefetched = prefetched_.find(map_vid);
+    if (prefetched == prefetched_.end()) continue;  // reset meanwhile
+    // not found, or needed by localization before it was loaded
+    if (map_msg == nullptr || map_vid == current_map_vid_) {
+      prefetched_.erase(prefetched);
+      continue;
+    }
+    prefetched->second.loaded = true;
+    prefetched->second.bytes = bytes;
+    prefetched->second.submap = submap;
+    prefetch_stats_.bytes += bytes;
+    CLOG(DEBUG, "lidar.localization_map_recall")
+        << "Prefetched submap " << config_->map_version
+        << " and its kd-tree at vertex " << map_vid << " (" << bytes / 1024
+        << " kB)";
+  }
+}
+
 }  // namespace lidar
 }  // namespace vtr
\ No newline at end of file
@@ -19,24 +19,15 @@
 #include "vtr_lidar/modules/odometry/odometry_icp_module.hpp"
 
 #include "vtr_lidar/utils/nanoflann_utils.hpp"
+#include "vtr_lidar/utils/point_conversions.hpp"
+#include "vtr_lidar/utils/pose_interpolation_cache.hpp"
+#include "vtr_tactic/icp_cost_term.hpp"
 
 namespace vtr {
 namespace lidar {
 
-namespace {
-
-template <class PointT>
-void cart2pol(pcl::PointCloud<PointT> &point_cloud) {
-  for (auto &p : point_cloud) {
-    p.rho = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
-    p.theta = std::atan2(std::sqrt(p.x * p.x + p.y * p.y), p.z);
-    p.phi = std::atan2(p.y, p.x);
-  }
-}
-
-}  // namespace
-
 using namespace tactic;
+using namespace conversions;
 using namespace steam;
 using namespace steam::se3;
 using namespace steam::traj;
@@ -59,6 +50,7 @@ auto OdometryICPModule::Config::fromROS(const rclcpp::Node::SharedPtr &node,
     throw std::invalid_argument{err};
   }
   config->traj_qc_diag << qcd[0], qcd[1], qcd[2], qcd[3], qcd[4], qcd[5];
+  config->traj_interp_resolution = node->declare_parameter<double>(param_prefix + ".traj_interp_resolution", config->traj_interp_resolution);
 
   // icp params
   config->num_threads = node->declare_parameter<int>(param_prefix + ".num_threads", config->num_threads);
@@ -96,7 +88,8 @@ void OdometryICPModule::run_(QueryCache &qdata0, OutputCache &,
     qdata.undistorted_raw_point_cloud = undistorted_raw_point_cloud;
 #endif
     // undistorted preprocessed point cloud
-    auto undistorted_point_cloud = std::make_shared<pcl::PointCloud<PointWithInfo>>(*qdata.preprocessed_point_cloud);
+    auto undistorted_point_cloud = qdata.createPointCloud();
+    *undistorted_point_cloud = *qdata.preprocessed_point_cloud;
     cart2pol(*undistorted_point_cloud);
     qdata.undistorted_point_cloud = undistorted_point_cloud;
     //
@@ -128,7 +121,6 @@ void OdometryICPModule::run_(QueryCache &qdata0, OutputCache &,
   float max_pair_d = config_->initial_max_pairing_dist;
   float max_planar_d = config_->initial_max_planar_dist;
   float max_pair_d2 = max_pair_d * max_pair_d;
-  KDTreeSearchParams search_params;
 
   // clang-format off
   /// Create robot to sensor transform variable, fixed.
@@ -198,7 +190,9 @@ void OdometryICPModule::run_(QueryCache &qdata0, OutputCache &,
   const auto T_m_s_eval = inverse(compose(T_s_r_var, T_r_m_eval));
 
   /// Initialize aligned points for matching (Deep copy of targets)
-  pcl::PointCloud<PointWithInfo> aligned_points(query_points);
+  const auto aligned_point_cloud = qdata.createPointCloud();
+  *aligned_point_cloud = query_points;
+  auto &aligned_points = *aligned_point_cloud;
 
   /// Eigen matrix of original data (only shallow copy of ref clouds)
   const auto map_mat = point_map.getMatrixXfMap(4, PointWithInfo::size(), PointWithInfo::cartesian_offset());
@@ -208,25 +202,46 @@ void OdometryICPModule::run_(QueryCache &qdata0, OutputCache &,
   auto aligned_mat = aligned_points.getMatrixXfMap(4, PointWithInfo::size(), PointWithInfo::cartesian_offset());
   auto aligned_norms_mat = aligned_points.getMatrixXfMap(4, PointWithInfo::size(), PointWithInfo::normal_offset());
 
-  /// create kd-tree of the map
-  CLOG(DEBUG, "lidar.odometry_icp") << "Start building a kd-tree of the map.";
-  NanoFLANNAdapter<PointWithInfo> adapter(point_map);
-  KDTreeParams tree_params(10 /* max leaf */);
-  auto kdtree = std::make_unique<KDTree<PointWithInfo>>(3, adapter, tree_params);
-  kdtree->buildIndex();
+  /// kd-tree of the map, maintained incrementally by the sliding map
+  const auto &kdtree = sliding_map_odo.kdtree();
+
+  /// sensor to map transform of query points, interpolated once per group of
+  /// (quantized) timestamps, created once and re-evaluated as the state
+  /// variables are updated
+  std::unique_ptr<PoseInterpolationCache> T_m_s_intp_cache = nullptr;
+  std::vector<Evaluable<lgmath::se3::Transformation>::ConstPtr> T_m_s_evals;
+  if (config_->use_trajectory_estimation) {
+    const auto make_T_m_s_intp_eval = [&](const int64_t qry_time) -> Evaluable<lgmath::se3::Transformation>::ConstPtr {
+      const auto T_r_m_intp_eval = trajectory->getPoseInterpolator(Time(qry_time));
+      return inverse(compose(T_s_r_var, T_r_m_intp_eval));
+    };
+    const auto resolution = static_cast<int64_t>(config_->traj_interp_resolution * 1e9);
+    T_m_s_intp_cache = std::make_unique<PoseInterpolationCache>(query_points, resolution, make_T_m_s_intp_eval);
+    T_m_s_evals = T_m_s_intp_cache->evaluables();
+    CLOG(DEBUG, "lidar.odometry_icp") << "Interpolating " << query_points.size() << " points with " << T_m_s_intp_cache->size() << " poses.";
+  } else {
+    T_m_s_evals.emplace_back(T_m_s_eval);
+  }
+
+  /// optimization problem, reused across iterations with the point matches
+  /// refilled every iteration
+  // matches are accumulated in parallel inside the icp cost term, so the
+  // problem itself is single threaded
+  OptimizationProblem problem(1);
+  for (const auto &var : state_vars)
+    problem.addStateVariable(var);
+  if (config_->use_trajectory_estimation)
+    trajectory->addPriorCostTerms(problem);
+  const auto icp_cost_term = ICPCostTerm::MakeShared(T_m_s_evals, L2LossFunc::MakeShared(), config_->num_threads);
+  icp_cost_term->reserve(query_points.size());
+  problem.addCostTerm(icp_cost_term);
 
   /// perform initial alignment
   CLOG(DEBUG, "lidar.odometry_icp") << "Start initial alignment.";
   if (config_->use_trajectory_estimation) {
-#pragma omp parallel for schedule(dynamic, 10) num_threads(config_->num_threads)
-    for (unsigned i = 0; i < query_points.size(); i++) {
-      const auto &qry_time = query_points[i].timestamp;
-      const auto T_r_m_intp_eval = trajectory->getPoseInterpolator(Time(qry_time));
-      const auto T_m_s_intp_eval = inverse(compose(T_s_r_var, T_r_m_intp_eval));
-      const auto T_m_s = T_m_s_intp_eval->evaluate().matrix().cast<float>();
-      aligned_mat.block<4, 1>(0, i) = T_m_s * query_mat.block<4, 1>(0, i);
-      aligned_norms_mat.block<4, 1>(0, i) = T_m_s * query_norms_mat.block<4, 1>(0, i);
-    }
+    T_m_s_intp_cache->evaluate(config_->num_threads);
+    T_m_s_intp_cache->transform(query_mat, aligned_mat, config_->num_threads);
+    T_m_s_intp_cache->transform(query_norms_mat, aligned_norms_mat, config_->num_threads);
   } else {
     const auto T_m_s = T_m_s_eval->evaluate().matrix().cast<float>();
     aligned_mat = T_m_s * query_mat;
@@ -262,30 +277,40 @@ void OdometryICPModule::run_(QueryCache &qdata0, OutputCache &,
   bool refinement_stage = false;
   int refinement_step = 0;
 
+  // per-iteration buffers
+  std::vector<std::pair<size_t, size_t>> sample_inds;
+  std::vector<float> nn_dists;
+  std::vector<std::pair<size_t, size_t>> filtered_sample_inds;
+
   CLOG(DEBUG, "lidar.odometry_icp") << "Start the ICP optimization loop.";
   for (int step = 0;; step++) {
     /// sample points
     timer[0]->start();
-    std::vector<std::pair<size_t, size_t>> sample_inds;
     sample_inds.resize(query_points.size());
-    // pick queries (for now just use all of them)
-    for (size_t i = 0; i < query_points.size(); i++) sample_inds[i].first = i;
+    // pick queries (for now just use all of them), grouped by interpolated
+    // pose so that matches sharing a pose are added to the cost term together
+    if (config_->use_trajectory_estimation) {
+      const auto &order = T_m_s_intp_cache->order();
+      for (size_t i = 0; i < query_points.size(); i++) sample_inds[i].first = order[i];
+    } else {
+      for (size_t i = 0; i < query_points.size(); i++) sample_inds[i].first = i;
+    }
     timer[0]->stop();
 
     /// find nearest neigbors and distances
     timer[1]->start();
-    std::vector<float> nn_dists(sample_inds.size());
+    nn_dists.resize(sample_inds.size());
 #pragma omp parallel for schedule(dynamic, 10) num_threads(config_->num_threads)
     for (size_t i = 0; i < sample_inds.size(); i++) {
       KDTreeResultSet result_set(1);
       result_set.init(&sample_inds[i].second, &nn_dists[i]);
-      kdtree->findNeighbors(result_set, aligned_points[sample_inds[i].first].data, search_params);
+      kdtree.findNeighbors(result_set, aligned_points[sample_inds[i].first].data);
     }
     timer[1]->stop();
 
     /// filtering based on distances metrics
     timer[2]->start();
-    std::vector<std::pair<size_t, size_t>> filtered_sample_inds;
+    filtered_sample_inds.clear();
     filtered_sample_inds.reserve(sample_inds.size());
     for (size_t i = 0; i < sample_inds.size(); i++) {
       if (nn_dists[i] < max_pair_d2) {
@@ -304,48 +329,19 @@ void OdometryICPModule::run_(QueryCache &qdata0, OutputCache &,
     /// point to plane optimization
     timer[3]->start();
 
-    // initialize problem
-    OptimizationProblem problem(config_->num_threads);
-
-    // add variables
-    for (const auto &var : state_vars)
-      problem.addStateVariable(var);
-
-    // add prior cost terms
-    if (config_->use_trajectory_estimation)
-      trajectory->addPriorCostTerms(problem);
-
-    // shared loss function
-    auto loss_func = L2LossFunc::MakeShared();
-    // cost terms and noise model
-#pragma omp parallel for schedule(dynamic, 10) num_threads(config_->num_threads)
+    // refill the icp cost term with the current matches
+    icp_cost_term->clear();
     for (const auto &ind : filtered_sample_inds) {
       // noise model W = n * n.T (information matrix)
       if (point_map[ind.second].normal_score <= 0.0) continue;
       Eigen::Vector3d nrm = map_normals_mat.block<3, 1>(0, ind.second).cast<double>();
       Eigen::Matrix3d W(point_map[ind.second].normal_score * (nrm * nrm.transpose()) + 1e-5 * Eigen::Matrix3d::Identity());
-      auto noise_model = StaticNoiseModel<3>::MakeShared(W, NoiseType::INFORMATION);
 
       // query and reference point
       const auto qry_pt = query_mat.block<3, 1>(0, ind.first).cast<double>();
       const auto ref_pt = map_mat.block<3, 1>(0, ind.second).cast<double>();
 
-      auto error_func = [&]() -> Evaluable<Eigen::Matrix<double, 3, 1>>::Ptr {
-        if (config_->use_trajectory_estimation) {
-          const auto &qry_time = query_points[ind.first].timestamp;
-          const auto T_r_m_intp_eval = trajectory->getPoseInterpolator(Time(qry_time));
-          const auto T_m_s_intp_eval = inverse(compose(T_s_r_var, T_r_m_intp_eval));
-          return p2p::p2pError(T_m_s_intp_eval, ref_pt, qry_pt);
-        } else {
-          return p2p::p2pError(T_m_s_eval, ref_pt, qry_pt);
-        }
-      }();
-
-      // create cost term and add to problem
-      auto cost = WeightedLeastSqCostTerm<3>::MakeShared(error_func, noise_model, loss_func);
-
-#pragma omp critical(odo_icp_add_p2p_error_cost)
-      problem.addCostTerm(cost);
+      icp_cost_term->add(qry_pt, ref_pt, W, config_->use_trajectory_estimation ? T_m_s_intp_cache->group(ind.first) : 0);
     }
 
     // optimize
@@ -366,15 +362,9 @@ void OdometryICPModule::run_(QueryCache &qdata0, OutputCache &,
     /// Alignment
     timer[4]->start();
     if (config_->use_trajectory_estimation) {
-#pragma omp parallel for schedule(dynamic, 10) num_threads(config_->num_threads)
-      for (unsigned i = 0; i < query_points.size(); i++) {
-        const auto &qry_time = query_points[i].timestamp;
-        const auto T_r_m_intp_eval = trajectory->getPoseInterpolator(Time(qry_time));
-        const auto T_m_s_intp_eval = inverse(compose(T_s_r_var, T_r_m_intp_eval));
-        const auto T_m_s = T_m_s_intp_eval->evaluate().matrix().cast<float>();
-        aligned_mat.block<4, 1>(0, i) = T_m_s * query_mat.block<4, 1>(0, i);
-        aligned_norms_mat.block<4, 1>(0, i) = T_m_s * query_norms_mat.block<4, 1>(0, i);
-      }
+      T_m_s_intp_cache->evaluate(config_->num_threads);
+      T_m_s_intp_cache->transform(query_mat, aligned_mat, config_->num_threads);
+      T_m_s_intp_cache->transform(query_norms_mat, aligned_norms_mat, config_->num_threads);
     } else {
       const auto T_m_s = T_m_s_eval->evaluate().matrix().cast<float>();
       aligned_mat = T_m_s * query_mat;
@@ -479,9 +469,9 @@ void OdometryICPModule::run_(QueryCache &qdata0, OutputCache &,
     aligned_mat = T_s_m * aligned_mat;
     aligned_norms_mat = T_s_m * aligned_norms_mat;
 
-    auto undistorted_point_cloud = std::make_shared<pcl::PointCloud<PointWithInfo>>(aligned_points);
-    cart2pol(*undistorted_point_cloud);  // correct polar coordinates.
-    qdata.undistorted_point_cloud = undistorted_point_cloud;
+    // aligned points are not used anymore, no need to copy them
+    cart2pol(aligned_points);  // correct polar coordinates.
+    qdata.undistorted_point_cloud = aligned_point_cloud;
 #if false
     // store undistorted raw point cloud
     auto undistorted_raw_point_cloud = std::make_shared<pcl::PointCloud<PointWithInfo>>(*qdata.raw_point_cloud);
@@ -537,7 +527,8 @@ void OdometryICPModule::run_(QueryCache &qdata0, OutputCache &,
         << "Matched points ratio " << matched_points_ratio
         << " is below the threshold. ICP is considered failed.";
     // do not undistort the pointcloud
-    auto undistorted_point_cloud = std::make_shared<pcl::PointCloud<PointWithInfo>>(query_points);
+    auto undistorted_point_cloud = qdata.createPointCloud();
+    *undistorted_point_cloud = query_points;
     cart2pol(*undistorted_point_cloud);
     qdata.undistorted_point_cloud = undistorted_point_cloud;
 #if false
@@ -18,9 +18,9 @@
  */
 #include "vtr_lidar/modules/odometry/odometry_map_maintenance_module_v2.hpp"
 
-#include "pcl/features/normal_3d.h"
 #include "pcl_conversions/pcl_conversions.h"
 
+#include "vtr_lidar/features/normal.hpp"
 #include "vtr_lidar/utils/nanoflann_utils.hpp"
 
 namespace vtr {
@@ -98,41 +98,25 @@ void OdometryMapMaintenanceModuleV2::run_(QueryCache &qdata0, OutputCache &,
   };
   sliding_map_odo.update(points, update_cb);
 
-  // update normal vector
-  NanoFLANNAdapter<PointWithInfo> adapter(sliding_map_odo.point_cloud());
-  KDTreeSearchParams search_param;
-  KDTreeParams tree_param(/* max_leaf */ 10);
-  auto kdtree = std::make_unique<KDTree<PointWithInfo>>(3, adapter, tree_param);
-  kdtree->buildIndex();
+  // update normal vector (the kd-tree already contains the new points)
+  const auto &kdtree = sliding_map_odo.kdtree();
   const auto search_radius = sliding_map_odo.dl() * 3.0;
   const auto sq_radius = search_radius * search_radius;
   auto update_normal_cb = [&point_cloud = sliding_map_odo.point_cloud(),
-                           &kdtree, &sq_radius,
-                           &search_param](bool, PointWithInfo &curr_pt,
-                                          const PointWithInfo &) {
+                           &kdtree, &sq_radius](bool, PointWithInfo &curr_pt,
+                                                const PointWithInfo &) {
     std::vector<float> dists;
     std::vector<int> indices;
     NanoFLANNRadiusResultSet<float, int> result(sq_radius, dists, indices);
-    kdtree->radiusSearchCustomCallback(curr_pt.data, result, search_param);
+    kdtree.findNeighbors(result, curr_pt.data);
 
     if (indices.size() < 4) return;
 
-    // get points for computation
-    const pcl::PointCloud<PointWithInfo> neigobors(point_cloud, indices);
-
-    // Placeholder for the 3x3 covariance matrix at each surface patch
-    Eigen::Matrix3f covariance_matrix;
-    // 16-bytes aligned placeholder for the XYZ centroid of a surface patch
-    Eigen::Vector4f xyz_centroid;
-    // Estimate the XYZ centroid
-    pcl::compute3DCentroid(neigobors, xyz_centroid);
-    // Compute the 3x3 covariance matrix
-    pcl::computeCovarianceMatrix(neigobors, xyz_centroid, covariance_matrix);
     // Compute pca
-    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3f> es;
-    es.compute(covariance_matrix);
-    const auto &eigenvectors = es.eigenvectors();
-    const auto &eigenvalues = es.eigenvalues();
+    LocalPCA pca;
+    computeLocalPCA(point_cloud, indices, pca);
+    const auto &eigenvectors = pca.eigenvectors;
+    const auto &eigenvalues = pca.eigenvalues;
 
     // normal direction
     curr_pt.getNormalVector3fMap() = Eigen::Vector3f(eigenvectors.col(0));
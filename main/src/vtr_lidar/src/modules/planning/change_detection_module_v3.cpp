@@ -18,9 +18,9 @@
  */
 #include "vtr_lidar/modules/planning/change_detection_module_v3.hpp"
 
-#include "pcl/features/normal_3d.h"
-
 #include "vtr_lidar/data_types/costmap.hpp"
+#include "vtr_lidar/features/normal.hpp"
+#include "vtr_lidar/filters/support_filter.hpp"
 #include "vtr_lidar/filters/voxel_downsample.hpp"
 
 #include "vtr_lidar/utils/nanoflann_utils.hpp"
@@ -30,31 +30,6 @@ namespace lidar {
 
 namespace {
 
-template <class PointT>
-void computeCentroidAndNormal(const pcl::PointCloud<PointT> &points,
-                              Eigen::Vector3f &centroid,
-                              Eigen::Vector3f &normal, float &roughness) {
-  // 16-bytes aligned placeholder for the XYZ centroid of a surface patch
-  Eigen::Vector4f centroid_homo;
-  // Placeholder for the 3x3 covariance matrix at each surface patch
-  Eigen::Matrix3f cov;
-
-  // Estimate the XYZ centroid
-  pcl::compute3DCentroid(points, centroid_homo);
-
-  // Compute the 3x3 covariance matrix
-  pcl::computeCovarianceMatrix(points, centroid_homo, cov);
-
-  // Compute pca
-  Eigen::SelfAdjointEigenSolver<Eigen::Matrix3f> es;
-  es.compute(cov);
-
-  // save results
-  centroid = centroid_homo.head<3>();
-  normal = es.eigenvectors().col(0);
-  roughness = es.eigenvalues()(0);  // variance
-}
-
 template <typename PointT>
 class DetectChangeOp {
  public:
@@ -121,6 +96,7 @@ auto ChangeDetectionModuleV3::Config::fromROS(
   config->influence_distance = node->declare_parameter<float>(param_prefix + ".influence_distance", config->influence_distance);
   config->minimum_distance = node->declare_parameter<float>(param_prefix + ".minimum_distance", config->minimum_distance);
   // general
+  config->num_threads = node->declare_parameter<int>(param_prefix + ".num_threads", config->num_threads);
   config->visualize = node->declare_parameter<bool>(param_prefix + ".visualize", config->visualize);
   // clang-format on
   return config;
@@ -192,60 +168,84 @@ void ChangeDetectionModuleV3::run_(QueryCache &qdata0, OutputCache &output0,
   aligned_mat = T_m_s.cast<float>() * query_mat;
   aligned_norms_mat = T_m_s.cast<float>() * query_norms_mat;
 
-  // create kd-tree of the map
-  NanoFLANNAdapter<PointWithInfo> adapter(map_point_cloud);
+  if (map_point_cloud.empty()) {
+    CLOG(WARNING, "lidar.change_detection") << "Localization submap is empty, skipping change detection";
+    return;
+  }
+
+  // kd-tree of the map, built once per submap and shared with localization
   KDTreeSearchParams search_params;
-  KDTreeParams tree_params(10 /* max leaf */);
-  auto kdtree = std::make_unique<KDTree<PointWithInfo>>(3, adapter, tree_params);
-  kdtree->buildIndex();
+  const auto kdtree = submap_loc.staticKDTree();
+
+  // plane statistics are per map point, so they stay valid for the submap
+  if (plane_stats_submap_.lock() != qdata.submap_loc.ptr()) {
+    plane_stats_submap_ = qdata.submap_loc.ptr();
+    plane_stats_.assign(map_point_cloud.size(), PlaneStats());
+  }
 
   std::vector<long unsigned> nn_inds(aligned_points.size());
   std::vector<float> nn_dists(aligned_points.size(), -1.0f);
   // compute nearest neighbors and point to point distances
+#pragma omp parallel for schedule(dynamic, 64) num_threads(config_->num_threads)
   for (size_t i = 0; i < aligned_points.size(); i++) {
     KDTreeResultSet result_set(1);
     result_set.init(&nn_inds[i], &nn_dists[i]);
     kdtree->findNeighbors(result_set, aligned_points[i].data, search_params);
   }
-  // compute point to plane distance
+
+  // plane statistics of the matched map points not seen before
+  std::vector<size_t> new_map_inds;
+  for (const auto &nn_ind : nn_inds) {
+    auto &stats = plane_stats_[nn_ind];
+    if (stats.num_measurements >= 0.0f) continue;
+    stats.num_measurements = 0.0f;  // claimed, computed below
+    new_map_inds.emplace_back(nn_ind);
+  }
   const auto sq_search_radius = config_->search_radius * config_->search_radius;
-  std::vector<float> roughnesses(aligned_points.size(), 0.0f);
-  std::vector<float> num_measurements(aligned_points.size(), 0.0f);
-  for (size_t i = 0; i < aligned_points.size(); i++) {
-    // radius search of the closest point
+#pragma omp parallel for schedule(dynamic, 16) num_threads(config_->num_threads)
+  for (size_t k = 0; k < new_map_inds.size(); k++) {
+    // radius search of the map point
     std::vector<float> dists;
     std::vector<int> indices;
     NanoFLANNRadiusResultSet<float, int> result(sq_search_radius, dists, indices);
-    kdtree->radiusSearchCustomCallback(map_point_cloud[nn_inds[i]].data, result, search_params);
+    kdtree->radiusSearchCustomCallback(map_point_cloud[new_map_inds[k]].data, result, search_params);
 
     // filter based on neighbors in map /// \todo parameters
     if (indices.size() < 10) continue;
 
-    //
-    num_measurements[i] = static_cast<float>(indices.size());
-
-    // compute the planar distance
-    Eigen::Vector3f centroid, normal;
-    computeCentroidAndNormal(pcl::PointCloud<PointWithInfo>(map_point_cloud, indices), centroid, normal, roughnesses[i]);
-
-    const auto diff = aligned_points[i].getVector3fMap() - centroid;
-    nn_dists[i] = std::abs(diff.dot(normal));
+    LocalPCA pca;
+    computeLocalPCA(map_point_cloud, indices, pca);
+    auto &stats = plane_stats_[new_map_inds[k]];
+    stats.num_measurements = static_cast<float>(indices.size());
+    stats.roughness = pca.eigenvalues(0);
+    stats.centroid = pca.centroid;
+    stats.normal = pca.eigenvectors.col(0);
   }
 
+  // point to plane distance and cost, from the plane of the closest map point
+#pragma omp parallel for schedule(static, 256) num_threads(config_->num_threads)
   for (size_t i = 0; i < aligned_points.size(); i++) {
+    const auto &stats = plane_stats_[nn_inds[i]];
+    const float num_measurements = stats.num_measurements;
+    const float plane_roughness = num_measurements > 0.0f ? stats.roughness : 0.0f;
+    if (num_measurements > 0.0f) {
+      const auto diff = aligned_points[i].getVector3fMap() - stats.centroid;
+      nn_dists[i] = std::abs(diff.dot(stats.normal));
+    }
+
     aligned_points[i].flex23 = 0.0f;
     //
     const auto cost = [&]() -> float {
       // clang-format off
       if (config_->use_prior) {
-        const float alpha_n = config_->alpha0 + num_measurements[i] / 2.0f;
-        const float beta_n = config_->beta0 + roughnesses[i] * num_measurements[i] / 2.0f;
+        const float alpha_n = config_->alpha0 + num_measurements / 2.0f;
+        const float beta_n = config_->beta0 + plane_roughness * num_measurements / 2.0f;
         const float roughness = beta_n / alpha_n;
         const float df = 2 * alpha_n;
         const float sqdists = nn_dists[i] * nn_dists[i] / roughness;
         return -std::log(std::pow(1 + sqdists / df, -(df + 1) / 2));
       } else {
-        const float roughness = roughnesses[i];
+        const float roughness = plane_roughness;
         return (nn_dists[i] * nn_dists[i]) / (2 * roughness) + std::log(std::sqrt(roughness));
       }
       // clang-format on
@@ -258,39 +258,18 @@ void ChangeDetectionModuleV3::run_(QueryCache &qdata0, OutputCache &output0,
   }
 
   // add support region
-  if (config_->use_support_filtering) {
-    // create kd-tree of the aligned points
-    NanoFLANNAdapter<PointWithInfo> query_adapter(aligned_points);
-    KDTreeSearchParams search_params;
-    KDTreeParams tree_params(/* max leaf */ 10);
-    auto query_kdtree =
-        std::make_unique<KDTree<PointWithInfo>>(3, query_adapter, tree_params);
-    query_kdtree->buildIndex();
-    //
-    std::vector<size_t> toremove;
-    toremove.reserve(100);
-    const float sq_support_radius = std::pow(config_->support_radius, 2);
-    for (size_t i = 0; i < aligned_points.size(); i++) {
-      // ignore non-change points
-      if (aligned_points[i].flex23 == 0.0f) continue;
-
-      //
-      std::vector<std::pair<size_t, float>> inds_dists;
-      inds_dists.reserve(10);
-      query_kdtree->radiusSearch(aligned_points[i].data, sq_support_radius,
-                                 inds_dists, search_params);
-      //
-      float support = 0.0f;
-      for (const auto &ind_dist : inds_dists) {
-        if (ind_dist.first == i) continue;
-        support += aligned_points[ind_dist.first].flex23 *
-                   std::exp(-ind_dist.second / (2 * config_->support_variance));
-      }
-      //
-      if (support < config_->support_threshold) toremove.push_back(i);
-    }
+  if (config_->use_support_filtering && config_->support_radius > 0.0f) {
+    std::vector<size_t> changes;
+    for (size_t i = 0; i < aligned_points.size(); i++)
+      if (aligned_points[i].flex23 != 0.0f) changes.emplace_back(i);
+
+    const auto support = supportSum(aligned_points, changes,
+                                    config_->support_radius,
+                                    config_->support_variance,
+                                    config_->num_threads);
     // change back to non-change points
-    for (const auto &i : toremove) aligned_points[i].flex23 = 0.0f;
+    for (size_t k = 0; k < changes.size(); k++)
+      if (support[k] < config_->support_threshold) aligned_points[changes[k]].flex23 = 0.0f;
   }
 
   // retrieve the pre-processed scan and convert it to the vertex frame
@@ -530,13 +509,13 @@ void ChangeDetectionModuleV3::run_(QueryCache &qdata0, OutputCache &output0,
     //CLOG(ERROR, "obstacle_detection.cbit") << "Displaying all Keys: " << keys2;
     //CLOG(ERROR, "obstacle_detection.cbit") << "Displaying all Values: " << vals2;
 
-    // Update the output cache
-    // Define a mutex to protect access to output.obs_map
+    // Update the output cache, the grid is built before taking the lock and
+    // published by swapping the pointer
+    tactic::ObstacleGrid::ConstPtr obs_map = costmap->toObstacleGrid(0.01);
     {
-        // Lock the mutex before modifying output.obs_map
         std::lock_guard<std::mutex> lock(output.obsMapMutex);
         output.costmap_sid = costmap->vertex_sid(); 
-        output.obs_map = costmap->filter(0.01); // Modify output.obs_map safely
+        output.obs_map = obs_map;
         output.grid_resolution = config_->resolution;
     } 
   }
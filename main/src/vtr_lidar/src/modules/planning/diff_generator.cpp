@@ -22,28 +22,11 @@
 #include "vtr_lidar/filters/voxel_downsample.hpp"
 
 #include "vtr_lidar/utils/nanoflann_utils.hpp"
+#include "vtr_lidar/utils/point_conversions.hpp"
 
 namespace vtr {
 namespace lidar {
 
-void velodyneCart2Pol(pcl::PointCloud<PointWithInfo>& point_cloud) {
-  for (size_t i = 0; i < point_cloud.size(); i++) {
-    auto &p = point_cloud[i];
-    auto &pm1 = i > 0 ? point_cloud[i - 1] : point_cloud[i];
-
-    p.rho = sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
-    p.theta = atan2(sqrt(p.x * p.x + p.y * p.y), p.z);
-    p.phi = atan2(p.y, p.x) + M_PI / 2;
-
-    if (i > 0 && (p.phi - pm1.phi) > 1.5 * M_PI)
-      p.phi -= 2 * M_PI;
-    else if (i > 0 && (p.phi - pm1.phi) < -1.5 * M_PI)
-      p.phi += 2 * M_PI;
-  }
-}
-
-
-
 using namespace tactic;
 
 auto DifferenceDetector::Config::fromROS(
@@ -132,7 +115,7 @@ void DifferenceDetector::run_(QueryCache &qdata0, OutputCache &output0,
   aligned_map_norms_mat = T_s_m.cast<float>() * map_norms_mat;
 
 
-  velodyneCart2Pol(aligned_map);
+  conversions::cart2pol(aligned_map, M_PI / 2, true);
 
   // create kd-tree of the map
   //Could this be done ahead of time and stored?
@@ -42,6 +42,7 @@ auto GroundExtractionModule::Config::fromROS(
   config->bin_size_small = node->declare_parameter<float>(param_prefix + ".bin_size_small", config->bin_size_small);
   config->num_bins_large = (size_t)node->declare_parameter<int>(param_prefix + ".num_bins_large", config->num_bins_large);
   config->bin_size_large = node->declare_parameter<float>(param_prefix + ".bin_size_large", config->bin_size_large);
+  config->num_threads = node->declare_parameter<int>(param_prefix + ".num_threads", config->num_threads);
   // occupancy grid
   config->resolution = node->declare_parameter<float>(param_prefix + ".resolution", config->resolution);
   config->size_x = node->declare_parameter<float>(param_prefix + ".size_x", config->size_x);
@@ -72,6 +73,10 @@ GroundExtractionModule::GroundExtractionModule(
   himmelsbach_.bin_size_small = config_->bin_size_small;
   himmelsbach_.num_bins_large = config_->num_bins_large;
   himmelsbach_.bin_size_large = config_->bin_size_large;
+  himmelsbach_.num_threads = config_->num_threads;
+  // the submap is transformed into the vertex frame, so polar coordinates of
+  // its points are not valid
+  himmelsbach_.use_polar = false;
 }
 
 void GroundExtractionModule::run_(QueryCache &qdata0, OutputCache &output0,
@@ -35,13 +35,13 @@ class ComputeCorridorOp {
     auto lock = chain.guard();
     // compute vertex lookahead
     const auto distance = chain.dist(curr_sid);
-    const auto T_w_curr = chain.pose(curr_sid);
+    const auto T_w_curr = chain.T_start(curr_sid);
     // forwards
     for (auto query_sid = curr_sid;
          query_sid < chain.size() &&
          (chain.dist(query_sid) - distance) < lookahead_distance_;
          ++query_sid) {
-      const auto T_curr_query = T_w_curr.inverse() * chain.pose(query_sid);
+      const auto T_curr_query = T_w_curr.inverse() * chain.T_start(query_sid);
       T_curr_query_vec.emplace_back(T_curr_query.matrix());
       T_curr_query_xy_vec.emplace_back(
           T_curr_query.matrix().block<2, 1>(0, 3).cast<float>());
@@ -18,8 +18,7 @@
  */
 #include "vtr_lidar/modules/planning/terrain_assessment_module.hpp"
 
-#include "pcl/features/normal_3d.h"
-
+#include "vtr_lidar/features/normal.hpp"
 #include "vtr_lidar/utils/nanoflann_utils.hpp"
 
 namespace vtr {
@@ -36,12 +35,12 @@ class ComputeCorridorOp {
     auto lock = chain.guard();
     // compute vertex lookahead
     const auto distance = chain.dist(curr_sid);
-    const auto T_w_curr = chain.pose(curr_sid);
+    const auto T_w_curr = chain.T_start(curr_sid);
     for (auto query_sid = curr_sid;
          query_sid < chain.size() &&
          (chain.dist(query_sid) - distance) < lookahead_distance_;
          ++query_sid) {
-      const auto T_curr_query = T_w_curr.inverse() * chain.pose(query_sid);
+      const auto T_curr_query = T_w_curr.inverse() * chain.T_start(query_sid);
       T_curr_query_vec.emplace_back(T_curr_query.matrix());
       T_curr_query_xy_vec.emplace_back(
           T_curr_query.matrix().block<2, 1>(0, 3).cast<float>());
@@ -133,31 +132,17 @@ class AssessTerrainOp {
     for (size_t i = 0; i < num_neighbors; i++) indices[i] = inds_dists[i].first;
 
     /// apply pca to compute the roughness
-    // get points for computation
-    const pcl::PointCloud<PointT> query_points(points_, indices);
-
-    // Placeholder for the 3x3 covariance matrix at each surface patch
-    Eigen::Matrix3f covariance_matrix;
-    // 16-bytes aligned placeholder for the XYZ centroid of a surface patch
-    Eigen::Vector4f xyz_centroid;
-
-    // Estimate the XYZ centroid
-    pcl::compute3DCentroid(query_points, xyz_centroid);
-    // Compute the 3x3 covariance matrix
-    pcl::computeCovarianceMatrix(query_points, xyz_centroid, covariance_matrix);
-
-    // Compute pca
-    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3f> es;
-    es.compute(covariance_matrix);
+    LocalPCA pca;
+    computeLocalPCA(points_, indices, pca);
 
     // compute the roughness (smallest eigenvalue)
-    float roughness = std::abs(es.eigenvalues()(0));
+    float roughness = std::abs(pca.eigenvalues(0));
 #if false
     // compute the slope of the surface (1 is vertical, 0 is horizontal)
-    float slope = std::abs(es.eigenvectors()(0, 2));
+    float slope = std::abs(pca.eigenvectors(0, 2));
     // compute the step height (max difference between points)
     std::vector<float> z_values(num_neighbors);
-    for (size_t i = 0; i < num_neighbors; i++) z_values[i] = query_points[i].z;
+    for (size_t i = 0; i < num_neighbors; i++) z_values[i] = points_[indices[i]].z;
     std::sort(z_values.begin(), z_values.end());
     // \todo consider using the 90 percentile
     float step_height = z_values[num_neighbors - 1] - z_values[0];
@@ -113,7 +113,7 @@ void DynamicDetectionModule::runAsync_(QueryCache &qdata0, OutputCache &,
   /// load the map and check if it is already merged
   {
     const auto map_msg = target_vertex->retrieve<PointMap<PointWithInfo>>(
-        "pointmap", "vtr_lidar_msgs/msg/PointMap");
+        "pointmap", "vtr_lidar_msgs/msg/ChunkedPointMap");
     auto locked_map_msg_ref = map_msg->sharedLocked();  // lock the msg
     auto &locked_map_msg = locked_map_msg_ref.get();
 
@@ -151,7 +151,7 @@ void DynamicDetectionModule::runAsync_(QueryCache &qdata0, OutputCache &,
 
   // get a copy of the current map for updating
   const auto map_msg = target_vertex->retrieve<PointMap<PointWithInfo>>(
-      "pointmap", "vtr_lidar_msgs/msg/PointMap");
+      "pointmap", "vtr_lidar_msgs/msg/ChunkedPointMap");
   auto updated_map = map_msg->sharedLocked().get().getData();
 
   // initialize dynamic observation
@@ -198,7 +198,7 @@ void DynamicDetectionModule::runAsync_(QueryCache &qdata0, OutputCache &,
 
     // retrieve point scan from this vertex
     const auto scan_msg = vertex->retrieve<PointScan<PointWithInfo>>(
-        "filtered_point_cloud", "vtr_lidar_msgs/msg/PointScan");
+        "filtered_point_cloud", "vtr_lidar_msgs/msg/ChunkedPointScan");
 
     /// \note follow the convention to lock point map first then these scans.
     auto pointscan = scan_msg->sharedLocked().get().getData();
@@ -247,7 +247,7 @@ void DynamicDetectionModule::runAsync_(QueryCache &qdata0, OutputCache &,
   // update the point map of this vertex
   {
     const auto map_msg = target_vertex->retrieve<PointMap<PointWithInfo>>(
-        "pointmap", "vtr_lidar_msgs/msg/PointMap");
+        "pointmap", "vtr_lidar_msgs/msg/ChunkedPointMap");
     auto locked_map_msg_ref = map_msg->locked();  // lock the msg
     auto &locked_map_msg = locked_map_msg_ref.get();
     locked_map_msg.setData(updated_map);
@@ -262,7 +262,7 @@ void DynamicDetectionModule::runAsync_(QueryCache &qdata0, OutputCache &,
         updated_map_copy, target_vertex->vertexTime());
     target_vertex->insert<PointMap<PointWithInfo>>(
         "pointmap_v" + std::to_string(updated_map_copy->version()),
-        "vtr_lidar_msgs/msg/PointMap", updated_map_copy_msg);
+        "vtr_lidar_msgs/msg/ChunkedPointMap", updated_map_copy_msg);
   }
 
   /// publish the transformed pointcloud
@@ -273,7 +273,7 @@ void DynamicDetectionModule::runAsync_(QueryCache &qdata0, OutputCache &,
     {
       // load old map for reference
       const auto map_msg = target_vertex->retrieve<PointMap<PointWithInfo>>(
-          "pointmap_v1", "vtr_lidar_msgs/msg/PointMap");
+          "pointmap_v1", "vtr_lidar_msgs/msg/ChunkedPointMap");
       auto locked_map_msg_ref = map_msg->sharedLocked();  // lock the msg
       auto &locked_map_msg = locked_map_msg_ref.get();
       auto pointmap = locked_map_msg.getData();
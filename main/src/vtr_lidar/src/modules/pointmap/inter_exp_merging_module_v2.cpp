@@ -101,7 +101,7 @@ void InterExpMergingModuleV2::runAsync_(QueryCache &qdata0, OutputCache &,
 
   /// retrieve the map for the curr vertex
   const auto curr_map_msg = curr_vertex->retrieve<PointMap<PointWithInfo>>(
-      "pointmap", "vtr_lidar_msgs/msg/PointMap");
+      "pointmap", "vtr_lidar_msgs/msg/ChunkedPointMap");
   if (curr_map_msg == nullptr) { 
       CLOG(WARNING, "lidar.inter_exp_merging")
           << "Pointmap pointer, skipped.";
@@ -139,7 +139,7 @@ void InterExpMergingModuleV2::runAsync_(QueryCache &qdata0, OutputCache &,
   const auto mepointmap_msg = [&]() -> std::shared_ptr<MultiExpPointMapLM> {
     auto mepointmap_msg =
         priv_vertex->retrieve<MultiExpPointMap<PointWithInfo>>(
-            "mepointmap", "vtr_lidar_msgs/msg/MultiExpPointMap");
+            "mepointmap", "vtr_lidar_msgs/msg/ChunkedMultiExpPointMap");
     if (mepointmap_msg != nullptr) return mepointmap_msg;
 
     // create the map
@@ -148,7 +148,8 @@ void InterExpMergingModuleV2::runAsync_(QueryCache &qdata0, OutputCache &,
     mepointmap_msg = std::make_shared<MultiExpPointMapLM>(
         mepointmap, priv_vertex->vertexTime());
     priv_vertex->insert<MultiExpPointMap<PointWithInfo>>(
-        "mepointmap", "vtr_lidar_msgs/msg/MultiExpPointMap", mepointmap_msg);
+        "mepointmap", "vtr_lidar_msgs/msg/ChunkedMultiExpPointMap",
+        mepointmap_msg);
     CLOG(INFO, "lidar.inter_exp_merging")
         << "Created a new map for vertex: " << priv_vid;
     return mepointmap_msg;
@@ -83,7 +83,7 @@ void IntraExpMergingModule::runAsync_(QueryCache &qdata0, OutputCache &,
       << "Intra-Experience Merging for vertex: " << target_vid;
   auto vertex = graph->at(target_vid);
   const auto map_msg = vertex->retrieve<PointMap<PointWithInfo>>(
-      "point_map", "vtr_lidar_msgs/msg/PointMap");
+      "point_map", "vtr_lidar_msgs/msg/ChunkedPointMap");
   auto locked_map_msg_ref = map_msg->locked();  // lock the msg
   auto &locked_map_msg = locked_map_msg_ref.get();
 
@@ -125,7 +125,7 @@ void IntraExpMergingModule::runAsync_(QueryCache &qdata0, OutputCache &,
     /// Retrieve point scans from this vertex
     const auto time_range = vertex->timeRange();
     const auto scan_msgs = vertex->retrieve<PointScan<PointWithInfo>>(
-        "point_scan", "vtr_lidar_msgs/msg/PointMap", time_range.first,
+        "point_scan", "vtr_lidar_msgs/msg/ChunkedPointScan", time_range.first,
         time_range.second);
 
     CLOG(DEBUG, "lidar.intra_exp_merging")
@@ -174,7 +174,7 @@ void IntraExpMergingModule::runAsync_(QueryCache &qdata0, OutputCache &,
       updated_map_copy, locked_map_msg.getTimestamp());
   vertex->insert<PointMap<PointWithInfo>>(
       "point_map_v" + std::to_string(updated_map_copy->version()),
-      "vtr_lidar_msgs/msg/PointMap", updated_map_copy_msg);
+      "vtr_lidar_msgs/msg/ChunkedPointMap", updated_map_copy_msg);
 
   /// publish the transformed pointcloud
   if (config_->visualize) {
@@ -110,7 +110,7 @@ void IntraExpMergingModuleV2::runAsync_(QueryCache &qdata0, OutputCache &,
   /// load the map and check if it is already merged
   {
     const auto map_msg = target_vertex->retrieve<PointMap<PointWithInfo>>(
-        "pointmap", "vtr_lidar_msgs/msg/PointMap");
+        "pointmap", "vtr_lidar_msgs/msg/ChunkedPointMap");
     if (map_msg == nullptr) { 
       CLOG(WARNING, "lidar.inter_exp_merging")
           << "No pointmap pointer, skipped.";
@@ -165,7 +165,7 @@ void IntraExpMergingModuleV2::runAsync_(QueryCache &qdata0, OutputCache &,
 
     // retrieve point map v0 (initial map) from this vertex
     const auto map_msg = vertex->retrieve<PointMap<PointWithInfo>>(
-        "pointmap_v0", "vtr_lidar_msgs/msg/PointMap");
+        "pointmap_v0", "vtr_lidar_msgs/msg/ChunkedPointMap");
 
     auto pointmap = map_msg->sharedLocked().get().getData();
     const auto &T_v_m = (T_target_curr * pointmap.T_vertex_this()).matrix();
@@ -216,7 +216,7 @@ void IntraExpMergingModuleV2::runAsync_(QueryCache &qdata0, OutputCache &,
   // update the point map of this vertex
   {
     const auto map_msg = target_vertex->retrieve<PointMap<PointWithInfo>>(
-        "pointmap", "vtr_lidar_msgs/msg/PointMap");
+        "pointmap", "vtr_lidar_msgs/msg/ChunkedPointMap");
     auto locked_map_msg_ref = map_msg->locked();  // lock the msg
     auto &locked_map_msg = locked_map_msg_ref.get();
     locked_map_msg.setData(updated_map);
@@ -231,7 +231,7 @@ void IntraExpMergingModuleV2::runAsync_(QueryCache &qdata0, OutputCache &,
         updated_map_copy, target_vertex->vertexTime());
     target_vertex->insert<PointMap<PointWithInfo>>(
         "pointmap_v" + std::to_string(updated_map_copy->version()),
-        "vtr_lidar_msgs/msg/PointMap", updated_map_copy_msg);
+        "vtr_lidar_msgs/msg/ChunkedPointMap", updated_map_copy_msg);
   }
 
   /// publish the transformed pointcloud
@@ -242,7 +242,7 @@ void IntraExpMergingModuleV2::runAsync_(QueryCache &qdata0, OutputCache &,
     {
       // load old map for reference
       const auto map_msg = target_vertex->retrieve<PointMap<PointWithInfo>>(
-          "pointmap_v0", "vtr_lidar_msgs/msg/PointMap");
+          "pointmap_v0", "vtr_lidar_msgs/msg/ChunkedPointMap");
       auto locked_map_msg_ref = map_msg->sharedLocked();  // lock the msg
       auto &locked_map_msg = locked_map_msg_ref.get();
       auto pointmap = locked_map_msg.getData();
@@ -19,12 +19,14 @@
 #include "vtr_lidar/modules/preprocessing/conversions/aeva_conversion_module.hpp"
 
 #include "pcl_conversions/pcl_conversions.h"
-#include "sensor_msgs/point_cloud2_iterator.hpp"
+
+#include "vtr_lidar/utils/point_conversions.hpp"
 
 namespace vtr {
 namespace lidar {
 
 using namespace tactic;
+using namespace conversions;
 
 auto AevaConversionModule::Config::fromROS(const rclcpp::Node::SharedPtr &node,
                                            const std::string &param_prefix)
@@ -51,28 +53,25 @@ void AevaConversionModule::run_(QueryCache &qdata0, OutputCache &,
   // Input
   const auto &points = *qdata.points;
 
-  auto point_cloud =
-      std::make_shared<pcl::PointCloud<PointWithInfo>>(points.rows(), 1);
+  auto point_cloud = qdata.createPointCloud();
+  point_cloud->resize(points.rows());
 
   for (size_t idx = 0; idx < (size_t)points.rows(); idx++) {
     // cartesian coordinates
-    point_cloud->at(idx).x = points(idx, 0);
-    point_cloud->at(idx).y = points(idx, 1);
-    point_cloud->at(idx).z = points(idx, 2);
+    auto &p = (*point_cloud)[idx];
+    p.x = points(idx, 0);
+    p.y = points(idx, 1);
+    p.z = points(idx, 2);
 
     // radial velocity
-    point_cloud->at(idx).flex23 = points(idx, 4);
+    p.flex23 = points(idx, 4);
 
     // pointwise timestamp
-    point_cloud->at(idx).timestamp = static_cast<int64_t>(points(idx, 5) * 1e9);
+    p.timestamp = static_cast<int64_t>(points(idx, 5) * 1e9);
   }
 
   // Aeva has no polar coordinates, so compute them manually.
-  for (auto &p : *point_cloud) {
-    p.rho = std::sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
-    p.theta = std::atan2(std::sqrt(p.x * p.x + p.y * p.y), p.z);
-    p.phi = std::atan2(p.y, p.x);
-  }
+  cart2pol(*point_cloud);
 
   // Output
   qdata.raw_point_cloud = point_cloud;
@@ -19,12 +19,14 @@
 #include "vtr_lidar/modules/preprocessing/conversions/honeycomb_conversion_module_v2.hpp"
 
 #include "pcl_conversions/pcl_conversions.h"
-#include "sensor_msgs/point_cloud2_iterator.hpp"
+
+#include "vtr_lidar/utils/point_conversions.hpp"
 
 namespace vtr {
 namespace lidar {
 
 using namespace tactic;
+using namespace conversions;
 
 auto HoneycombConversionModuleV2::Config::fromROS(
     const rclcpp::Node::SharedPtr &node, const std::string &param_prefix)
@@ -69,44 +71,45 @@ void HoneycombConversionModuleV2::run_(QueryCache &qdata0, OutputCache &,
   /// center of spin, where beam side 0 is 0 degree and beam side 1 is +-180
   /// degree.
 
-  auto point_cloud = std::make_shared<pcl::PointCloud<PointWithInfo>>(
-      msg->width * msg->height, 1);
+  auto point_cloud = qdata.createPointCloud();
+  point_cloud->resize(msg->width * msg->height);
 
   // time stamp at the center of the spin
   const int64_t center_time =
       msg->header.stamp.sec * 1e9 + msg->header.stamp.nanosec;
 
-  // iterators
   // clang-format off
-  sensor_msgs::PointCloud2ConstIterator<float> iter_x(*msg, "x"), iter_y(*msg, "y"), iter_z(*msg, "z");
-  sensor_msgs::PointCloud2ConstIterator<float> iter_rho(*msg, "range"), iter_theta(*msg, "pitch"), iter_phi(*msg, "yaw");
-  sensor_msgs::PointCloud2ConstIterator<uint8_t> iter_beam_side(*msg, "beam_side");
+  const PointCloud2Field<float> x(*msg, "x"), y(*msg, "y"), z(*msg, "z");
+  const PointCloud2Field<float> range(*msg, "range"), pitch(*msg, "pitch"), yaw(*msg, "yaw");
+  const PointCloud2Field<uint8_t> beam_side(*msg, "beam_side");
   // clang-format on
 
   float phi0, phi1;
   size_t i0 = 0, i1 = 0;
   constexpr double PI2 = 2 * M_PI;
-  for (size_t idx = 0; iter_x != iter_x.end(); ++idx, ++iter_x, ++iter_y,
-              ++iter_z, ++iter_rho, ++iter_theta, ++iter_phi,
-              ++iter_beam_side) {
+  forEachPoint(*msg, [&](const size_t idx, const uint8_t *point) {
+    auto &p = (*point_cloud)[idx];
+    const auto point_yaw = yaw(point);
+    const auto point_beam_side = beam_side(point);
+
     // cartesian coordinates - copied directly
-    point_cloud->at(idx).x = *iter_x;
-    point_cloud->at(idx).y = *iter_y;
-    point_cloud->at(idx).z = *iter_z;
+    p.x = x(point);
+    p.y = y(point);
+    p.z = z(point);
 
     // polar coordinates - we add 2pi to beam 1 so that lasers from beam 0 and
     // beam 1 are separated - this is required for nearest neighbor search while
     // avoiding motion distortion issues.
-    const auto theta = (*iter_theta) * M_PI / 180;
-    auto phi = (*iter_phi) * M_PI / 180;
-    if (*iter_beam_side == 0) {
+    const auto theta = pitch(point) * M_PI / 180;
+    auto phi = point_yaw * M_PI / 180;
+    if (point_beam_side == 0) {
       if (i0 && (phi - phi0) > M_PI)
         phi -= 2 * M_PI;
       else if (i0 && (phi - phi0) < -M_PI)
         phi += 2 * M_PI;
       phi0 = phi;
       i0++;
-    } else if (*iter_beam_side == 1) {
+    } else if (point_beam_side == 1) {
       phi += PI2;
       if (i1 && (phi - phi1) > M_PI)
         phi -= 2 * M_PI;
@@ -119,30 +122,25 @@ void HoneycombConversionModuleV2::run_(QueryCache &qdata0, OutputCache &,
       CLOG(ERROR, "lidar.honeycomb_converter") << err;
       throw std::runtime_error{err};
     }
-    point_cloud->at(idx).rho = *iter_rho;
-    point_cloud->at(idx).theta = theta;
-    point_cloud->at(idx).phi = phi;
+    p.rho = range(point);
+    p.theta = theta;
+    p.phi = phi;
 
     // time stamp
     double point_time;
-    if (*iter_beam_side == 0) {
+    if (point_beam_side == 0) {
       // from -180 to 180 in 0.2 seconds
-      point_time = (double)(*iter_phi) / 1800.0;  // 5Hz(180*0.1s)
-    } else if (*iter_beam_side == 1) {
+      point_time = (double)point_yaw / 1800.0;  // 5Hz(180*0.1s)
+    } else {
       // from 0 to 180 then -180 to 0 in 0.2 seconds
-      if (*iter_phi > 0) {
-        point_time = ((double)(*iter_phi) - 180.0) / 1800.0;
+      if (point_yaw > 0) {
+        point_time = ((double)point_yaw - 180.0) / 1800.0;
       } else {
-        point_time = ((double)(*iter_phi) + 180.0) / 1800.0;
+        point_time = ((double)point_yaw + 180.0) / 1800.0;
       }
-    } else {
-      std::string err{"Unknown beam side."};
-      CLOG(ERROR, "lidar.honeycomb_converter") << err;
-      throw std::runtime_error{err};
     }
-    point_cloud->at(idx).timestamp =
-        center_time + static_cast<int64_t>(point_time * 1e9);
-  }
+    p.timestamp = center_time + static_cast<int64_t>(point_time * 1e9);
+  });
 
   /// Output
   qdata.raw_point_cloud = point_cloud;
@@ -19,32 +19,14 @@
 #include "vtr_lidar/modules/preprocessing/conversions/ouster_conversion_module.hpp"
 
 #include "pcl_conversions/pcl_conversions.h"
-#include "sensor_msgs/point_cloud2_iterator.hpp"
+
+#include "vtr_lidar/utils/point_conversions.hpp"
 
 namespace vtr {
 namespace lidar {
 
 using namespace tactic;
-
-namespace {
-
-void ousterCart2Pol(pcl::PointCloud<PointWithInfo> &point_cloud) {
-  for (size_t i = 0; i < point_cloud.size(); i++) {
-    auto &p = point_cloud[i];
-    auto &pm1 = i > 0 ? point_cloud[i - 1] : point_cloud[i];
-
-    p.rho = sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
-    p.theta = atan2(sqrt(p.x * p.x + p.y * p.y), p.z);
-    p.phi = atan2(p.y, p.x) + M_PI / 2;
-
-    if (i > 0 && (p.phi - pm1.phi) > 1.5 * M_PI)
-      p.phi -= 2 * M_PI;
-    else if (i > 0 && (p.phi - pm1.phi) < -1.5 * M_PI)
-      p.phi += 2 * M_PI;
-  }
-}
-
-}  // namespace
+using namespace conversions;
 
 auto OusterConversionModule::Config::fromROS(
     const rclcpp::Node::SharedPtr &node, const std::string &param_prefix)
@@ -81,38 +63,27 @@ void OusterConversionModule::run_(QueryCache &qdata0, OutputCache &,
   // Input
   const auto &msg = qdata.pointcloud_msg.ptr();
 
-  auto point_cloud = std::make_shared<pcl::PointCloud<PointWithInfo>>(
-      msg->width * msg->height, 1);
+  auto point_cloud = qdata.createPointCloud();
+  point_cloud->resize(msg->width * msg->height);
 
-  // iterators
   // clang-format off
-  sensor_msgs::PointCloud2ConstIterator<float> iter_x(*msg, "x"), iter_y(*msg, "y"), iter_z(*msg, "z");
-  sensor_msgs::PointCloud2ConstIterator<double> iter_time(*msg, "t");
-  sensor_msgs::PointCloud2ConstIterator<float> iter_intensity(*msg, "intensity");
-
+  const PointCloud2Field<float> x(*msg, "x"), y(*msg, "y"), z(*msg, "z");
+  const PointCloud2Field<double> time(*msg, "t");
+  const PointCloud2Field<float> intensity(*msg, "intensity");
   // clang-format on
-
-  for (size_t idx = 0; iter_x != iter_x.end();
-       ++idx, ++iter_x, ++iter_y, ++iter_z, ++iter_time, ++iter_intensity) {
+  forEachPoint(*msg, [&](const size_t idx, const uint8_t *point) {
+    auto &p = (*point_cloud)[idx];
     // cartesian coordinates
-    point_cloud->at(idx).x = *iter_x;
-    point_cloud->at(idx).y = *iter_y;
-    point_cloud->at(idx).z = *iter_z;
-    point_cloud->at(idx).intensity = *iter_intensity;
-
+    p.x = x(point);
+    p.y = y(point);
+    p.z = z(point);
+    p.intensity = intensity(point);
     // pointwise timestamp
-    //CLOG(DEBUG, "lidar.ouster_converter") << "Timestamp is: " << *iter_time;
-    //CLOG(DEBUG, "lidar.ouster_converter") << "Message Header Stamp (sec)" << (msg->header).stamp.sec;
-    //CLOG(DEBUG, "lidar.ouster_converter") << "Message Header Stamp (nanosec)" << (msg->header).stamp.nanosec;
-
-
-    point_cloud->at(idx).timestamp = static_cast<int64_t>(*iter_time * 1e9);
-    //CLOG(DEBUG, "lidar.ouster_converter") << "First point info - x: " << *iter_x << " y: " << *iter_y << " z: " << *iter_z << " timestamp: " << static_cast<int64_t>(*iter_time * 1e9);
-    //CLOG(DEBUG, "lidar.ouster_converter") << "Second point info - x: " << *iter_x << " y: " << *iter_y << " z: " << *iter_z << " timestamp: " << static_cast<int64_t>(*iter_time);
-  }
+    p.timestamp = static_cast<int64_t>(time(point) * 1e9);
+  });
 
-  auto filtered_point_cloud =
-      std::make_shared<pcl::PointCloud<PointWithInfo>>(*point_cloud);
+  auto filtered_point_cloud = qdata.createPointCloud();
+  *filtered_point_cloud = *point_cloud;
 
   /// Range cropping
   if (config_->filter_warthog_points){
@@ -129,7 +100,7 @@ void OusterConversionModule::run_(QueryCache &qdata0, OutputCache &,
 
 
   // ouster has no polar coordinates, so compute them manually.
-  ousterCart2Pol(*filtered_point_cloud);
+  cart2pol(*filtered_point_cloud, M_PI / 2, true);
 
   // Output
   qdata.raw_point_cloud = filtered_point_cloud;
@@ -19,32 +19,14 @@
 #include "vtr_lidar/modules/preprocessing/conversions/velodyne_conversion_module.hpp"
 
 #include "pcl_conversions/pcl_conversions.h"
-#include "sensor_msgs/point_cloud2_iterator.hpp"
+
+#include "vtr_lidar/utils/point_conversions.hpp"
 
 namespace vtr {
 namespace lidar {
 
 using namespace tactic;
-
-namespace {
-
-void velodyneCart2Pol(pcl::PointCloud<PointWithInfo> &point_cloud) {
-  for (size_t i = 0; i < point_cloud.size(); i++) {
-    auto &p = point_cloud[i];
-    auto &pm1 = i > 0 ? point_cloud[i - 1] : point_cloud[i];
-
-    p.rho = sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
-    p.theta = atan2(sqrt(p.x * p.x + p.y * p.y), p.z);
-    p.phi = atan2(p.y, p.x) + M_PI / 2;
-
-    if (i > 0 && (p.phi - pm1.phi) > 1.5 * M_PI)
-      p.phi -= 2 * M_PI;
-    else if (i > 0 && (p.phi - pm1.phi) < -1.5 * M_PI)
-      p.phi += 2 * M_PI;
-  }
-}
-
-}  // namespace
+using namespace conversions;
 
 auto VelodyneConversionModule::Config::fromROS(
     const rclcpp::Node::SharedPtr &node, const std::string &param_prefix)
@@ -76,25 +58,26 @@ void VelodyneConversionModule::run_(QueryCache &qdata0, OutputCache &,
   const auto &stamp = *qdata.stamp; 
   const auto &points = *qdata.points;
 
-  auto point_cloud =
-      std::make_shared<pcl::PointCloud<PointWithInfo>>(points.rows(), 1);
+  auto point_cloud = qdata.createPointCloud();
+  point_cloud->resize(points.rows());
 
     
     CLOG(INFO, "lidar.velodyne_converter") << "Made PCL";
 
   for (size_t idx = 0; idx < (size_t)points.rows(); idx++) {
     // cartesian coordinates
-    point_cloud->at(idx).x = points(idx, 0);
-    point_cloud->at(idx).y = points(idx, 1);
-    point_cloud->at(idx).z = points(idx, 2);
+    auto &p = (*point_cloud)[idx];
+    p.x = points(idx, 0);
+    p.y = points(idx, 1);
+    p.z = points(idx, 2);
     
     // pointwise timestamp
-    point_cloud->at(idx).timestamp =
+    p.timestamp =
         static_cast<int64_t>(points(idx, 5) * 1e9);// + stamp; See comment above where stamp is loaded
   }
 
   // Velodyne has no polar coordinates, so compute them manually.
-  velodyneCart2Pol(*point_cloud);
+  cart2pol(*point_cloud, M_PI / 2, true);
 
   // Output
   qdata.raw_point_cloud = point_cloud;
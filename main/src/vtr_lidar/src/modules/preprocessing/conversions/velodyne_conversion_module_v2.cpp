@@ -19,40 +19,14 @@
 #include "vtr_lidar/modules/preprocessing/conversions/velodyne_conversion_module_v2.hpp"
 
 #include "pcl_conversions/pcl_conversions.h"
-#include "sensor_msgs/point_cloud2_iterator.hpp"
+
+#include "vtr_lidar/utils/point_conversions.hpp"
 
 namespace vtr {
 namespace lidar {
 
 using namespace tactic;
-
-namespace {
-
-void velodyneCart2Pol(pcl::PointCloud<PointWithInfo> &point_cloud) {
-  for (size_t i = 0; i < point_cloud.size(); i++) {
-    auto &p = point_cloud[i];
-    auto &pm1 = i > 0 ? point_cloud[i - 1] : point_cloud[i];
-
-    p.rho = sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
-    p.theta = atan2(sqrt(p.x * p.x + p.y * p.y), p.z);
-    p.phi = atan2(p.y, p.x); // + M_PI / 2;
-
-    if (i > 0 && (p.phi - pm1.phi) > 1.5 * M_PI)
-      p.phi -= 2 * M_PI;
-    else if (i > 0 && (p.phi - pm1.phi) < -1.5 * M_PI)
-      p.phi += 2 * M_PI;
-  }
-}
-
-void estimateTime(pcl::PointCloud<PointWithInfo> &point_cloud, int64_t time_offset, double angular_vel) {
-  for (size_t i = 0; i < point_cloud.size(); i++) {
-    auto &p = point_cloud[i];
-
-    p.timestamp = time_offset + static_cast<int64_t>((p.phi) / angular_vel * 1e9);
-  }
-}
-
-}  // namespace
+using namespace conversions;
 
 auto VelodyneConversionModuleV2::Config::fromROS(
     const rclcpp::Node::SharedPtr &node, const std::string &param_prefix)
@@ -84,28 +58,32 @@ void VelodyneConversionModuleV2::run_(QueryCache &qdata0, OutputCache &,
   // Input
   const auto &msg = qdata.pointcloud_msg.ptr();
 
-  auto point_cloud = std::make_shared<pcl::PointCloud<PointWithInfo>>(
-      msg->width * msg->height, 1);
+  auto point_cloud = qdata.createPointCloud();
+  point_cloud->resize(msg->width * msg->height);
 
-  // iterators
   // clang-format off
-  sensor_msgs::PointCloud2ConstIterator<float> iter_x(*msg, "x"), iter_y(*msg, "y"), iter_z(*msg, "z");
-  sensor_msgs::PointCloud2ConstIterator<float> iter_intensity(*msg, "intensity");
-  for (size_t idx = 0; iter_x != iter_x.end();
-       ++idx, ++iter_x, ++iter_y, ++iter_z, ++iter_intensity) {
+  const PointCloud2Field<float> x(*msg, "x"), y(*msg, "y"), z(*msg, "z");
+  const PointCloud2Field<float> intensity(*msg, "intensity");
+  forEachPoint(*msg, [&](const size_t idx, const uint8_t *point) {
     // cartesian coordinates
-    point_cloud->at(idx).x = *iter_x;
-    point_cloud->at(idx).y = *iter_y;
-    point_cloud->at(idx).z = *iter_z;
-    point_cloud->at(idx).intensity = *iter_intensity;
-  }
-
- 
+    auto &p = (*point_cloud)[idx];
+    p.x = x(point);
+    p.y = y(point);
+    p.z = z(point);
+    p.intensity = intensity(point);
+  });
   // clang-format on
-  
 
   // Velodyne has no polar coordinates, so compute them manually.
-  velodyneCart2Pol(*point_cloud);
+  cart2pol(*point_cloud, 0, true);
+
+  const auto decode_time = [&](const std::string &name) {
+    const PointCloud2Field<double> time(*msg, name);
+    // pointwise timestamp
+    forEachPoint(*msg, [&](const size_t idx, const uint8_t *point) {
+      (*point_cloud)[idx].timestamp = static_cast<int64_t>(time(point) * 1e9);
+    });
+  };
 
   if (config_->estimate_time){
       CLOG(INFO, "lidar.velodyne_converter_v2") << "Timings wil be estimated from yaw angle";
@@ -113,21 +91,11 @@ void VelodyneConversionModuleV2::run_(QueryCache &qdata0, OutputCache &,
   } else {
     try {
       try{
-        sensor_msgs::PointCloud2ConstIterator<double> iter_time(*msg, "t");
-        // pointwise timestamp
-        for (size_t idx = 0; iter_time != iter_time.end();
-          ++idx, ++iter_time) {
-            point_cloud->at(idx).timestamp = static_cast<int64_t>(*iter_time * 1e9);
-        }
+        decode_time("t");
         CLOG(INFO, "lidar.velodyne_converter_v2") << "Timings from t";
       }
       catch (...){
-        sensor_msgs::PointCloud2ConstIterator<double> iter_time(*msg, "time");
-        // pointwise timestamp
-        for (size_t idx = 0; iter_time != iter_time.end();
-          ++idx, ++iter_time) {
-            point_cloud->at(idx).timestamp = static_cast<int64_t>(*iter_time * 1e9);
-        }
+        decode_time("time");
         CLOG(INFO, "lidar.velodyne_converter_v2") << "Timings from time";
 
       }
@@ -143,8 +111,8 @@ void VelodyneConversionModuleV2::run_(QueryCache &qdata0, OutputCache &,
   //If a lower horizontal resolution is acceptable, then set the horizontal downsample > 1.
   //A value of 2 will leave 1/2 the points, in general 1/n points will be retained.
 
-  auto filtered_point_cloud =
-    std::make_shared<pcl::PointCloud<PointWithInfo>>(*point_cloud);
+  auto filtered_point_cloud = qdata.createPointCloud();
+  *filtered_point_cloud = *point_cloud;
   CLOG(DEBUG, "lidar.velodyne_converter_v2") << "Reducing the point cloud density by " << config_->horizontal_downsample
       << "original size was " << point_cloud->size();
   if (config_->horizontal_downsample > 1) {  
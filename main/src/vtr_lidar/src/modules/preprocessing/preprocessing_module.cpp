@@ -119,10 +119,10 @@ void PreprocessingModule::run_(QueryCache &qdata0, OutputCache &,
   CLOG(DEBUG, "lidar.preprocessing")
       << "raw point cloud size: " << point_cloud->size();
 
-  auto filtered_point_cloud =
-      std::make_shared<pcl::PointCloud<PointWithInfo>>(*point_cloud);
-  auto nn_downsampled_cloud = 
-      std::make_shared<pcl::PointCloud<PointWithInfo>>(*point_cloud);
+  auto filtered_point_cloud = qdata.createPointCloud();
+  *filtered_point_cloud = *point_cloud;
+  auto nn_downsampled_cloud = qdata.createPointCloud();
+  *nn_downsampled_cloud = *point_cloud;
 
   /// Range cropping
   {
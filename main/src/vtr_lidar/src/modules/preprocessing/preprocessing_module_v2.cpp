@@ -70,8 +70,8 @@ void PreprocessingModuleV2::run_(QueryCache &qdata0, OutputCache &,
   CLOG(DEBUG, "lidar.preprocessing")
       << "raw point cloud size: " << point_cloud->size();
 
-  auto filtered_point_cloud =
-      std::make_shared<pcl::PointCloud<PointWithInfo>>(*point_cloud);
+  auto filtered_point_cloud = qdata.createPointCloud();
+  *filtered_point_cloud = *point_cloud;
 
   /// Range cropping
   {
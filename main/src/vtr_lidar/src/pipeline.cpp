@@ -18,6 +18,7 @@
  */
 #include "vtr_lidar/pipeline.hpp"
 
+#include "vtr_lidar/data_types/point_chunk.hpp"
 #include "vtr_lidar/data_types/pointmap_pointer.hpp"
 #include "vtr_tactic/modules/factory.hpp"
 
@@ -41,6 +42,11 @@ auto LidarPipeline::Config::fromROS(const rclcpp::Node::SharedPtr &node,
   
   config->save_raw_point_cloud = node->declare_parameter<bool>(param_prefix + ".save_raw_point_cloud", config->save_raw_point_cloud);
   config->save_nn_point_cloud = node->declare_parameter<bool>(param_prefix + ".save_nn_point_cloud", config->save_nn_point_cloud);
+
+  config->mmap_point_storage = node->declare_parameter<bool>(param_prefix + ".mmap_point_storage", config->mmap_point_storage);
+
+  config->query_cache_pool_size = node->declare_parameter<int>(param_prefix + ".query_cache_pool_size", config->query_cache_pool_size);
+  config->point_cloud_pool_size = node->declare_parameter<int>(param_prefix + ".point_cloud_pool_size", config->point_cloud_pool_size);
   // clang-format on
   return config;
 }
@@ -59,12 +65,32 @@ LidarPipeline::LidarPipeline(
   // localization
   for (auto module : config_->localization)
     localization_.push_back(factory()->get("localization." + module));
+  // recycled per-frame data, a query cache is reset once the tactic and all
+  // async tasks released it, which returns its point clouds to their pool
+  query_cache_pool_ = std::make_shared<ObjectPool<LidarQueryCache>>(
+      std::max(config_->query_cache_pool_size, 0),
+      [](LidarQueryCache &qdata) {
+        // copy assignment keeps the shared_from_this state of qdata
+        static const LidarQueryCache empty;
+        qdata = empty;
+      });
+  point_cloud_pool_ = std::make_shared<PointCloudPool>(
+      std::max(config_->point_cloud_pool_size, 0),
+      [](pcl::PointCloud<PointWithInfo> &point_cloud) {
+        point_cloud.clear();  // keeps the allocated memory
+      });
 }
 
 OutputCache::Ptr LidarPipeline::createOutputCache() const {
   return std::make_shared<LidarOutputCache>();
 }
 
+QueryCache::Ptr LidarPipeline::createQueryCache() {
+  const auto qdata = query_cache_pool_->acquire();
+  qdata->point_cloud_pool = point_cloud_pool_;
+  return qdata;
+}
+
 void LidarPipeline::reset() {
   // reset modules
   for (const auto &module : preprocessing_) module->reset();
@@ -79,6 +105,24 @@ void LidarPipeline::reset() {
   T_sv_m_odo_ = tactic::EdgeTransform(true);
   // localization cached data
   submap_loc_ = nullptr;
+  // pool usage so far
+  const auto qstats = query_cache_pool_->statistics();
+  const auto pstats = point_cloud_pool_->statistics();
+  CLOG(DEBUG, "lidar.pipeline")
+      << "Query cache pool - hits: " << qstats.hits
+      << ", misses: " << qstats.misses << ", in use: " << qstats.in_use << "/"
+      << qstats.size << "; point cloud pool - hits: " << pstats.hits
+      << ", misses: " << pstats.misses << ", in use: " << pstats.in_use << "/"
+      << pstats.size;
+}
+
+void LidarPipeline::initialize_(const OutputCache::Ptr &,
+                                const Graph::Ptr &graph) {
+  // point chunk files live next to the graph data streams, and are loaded
+  // whenever a storable refers to one even if writing them is disabled
+  PointChunkStore::configure(
+      PointChunkStore::defaultDirectory(graph->filePath()),
+      config_->mmap_point_storage);
 }
 
 void LidarPipeline::preprocess_(const QueryCache::Ptr &qdata0,
@@ -155,7 +199,8 @@ void LidarPipeline::onVertexCreation_(const QueryCache::Ptr &qdata0,
     using PointScanLM = storage::LockableMessage<PointScan<PointWithInfo>>;
     auto scan_odo_msg = std::make_shared<PointScanLM>(scan_odo, *qdata->stamp);
     vertex->insert<PointScan<PointWithInfo>>(
-        "filtered_point_cloud", "vtr_lidar_msgs/msg/PointScan", scan_odo_msg);
+        "filtered_point_cloud", "vtr_lidar_msgs/msg/ChunkedPointScan",
+        scan_odo_msg);
     CLOG(DEBUG, "lidar.pipeline") << "Saved filtered pointcloud to vertex" << vertex;
 
   }
@@ -171,7 +216,8 @@ void LidarPipeline::onVertexCreation_(const QueryCache::Ptr &qdata0,
     auto raw_scan_odo_msg =
         std::make_shared<PointScanLM>(raw_scan_odo, *qdata->stamp);
     vertex->insert<PointScan<PointWithInfo>>(
-        "raw_point_cloud", "vtr_lidar_msgs/msg/PointScan", raw_scan_odo_msg);
+        "raw_point_cloud", "vtr_lidar_msgs/msg/ChunkedPointScan",
+        raw_scan_odo_msg);
     CLOG(DEBUG, "lidar.pipeline") << "Saved raw pointcloud to vertex" << vertex;
   }
 
@@ -186,7 +232,8 @@ void LidarPipeline::onVertexCreation_(const QueryCache::Ptr &qdata0,
     auto nn_scan_odo_msg =
         std::make_shared<PointScanLM>(nn_scan, *qdata->stamp);
     vertex->insert<PointScan<PointWithInfo>>(
-        "nn_point_cloud", "vtr_lidar_msgs/msg/PointScan", nn_scan_odo_msg);
+        "nn_point_cloud", "vtr_lidar_msgs/msg/ChunkedPointScan",
+        nn_scan_odo_msg);
 
     CLOG(DEBUG, "lidar.pipeline") << "Saved nn pointcloud to vertex" << vertex;
   }
@@ -217,12 +264,12 @@ void LidarPipeline::onVertexCreation_(const QueryCache::Ptr &qdata0,
     using PointMapLM = storage::LockableMessage<PointMap<PointWithInfo>>;
     auto submap_msg = std::make_shared<PointMapLM>(submap_odo, *qdata->stamp);
     vertex->insert<PointMap<PointWithInfo>>(
-        "pointmap", "vtr_lidar_msgs/msg/PointMap", submap_msg);
+        "pointmap", "vtr_lidar_msgs/msg/ChunkedPointMap", submap_msg);
     // save a copy
     auto submap2_msg = std::make_shared<PointMapLM>(submap_odo, *qdata->stamp);
     vertex->insert<PointMap<PointWithInfo>>(
         "pointmap_v" + std::to_string(submap_odo->version()),
-        "vtr_lidar_msgs/msg/PointMap", submap2_msg);
+        "vtr_lidar_msgs/msg/ChunkedPointMap", submap2_msg);
 
     // save the submap vertex id and transform
     submap_vid_odo_ = *qdata->vid_odo;
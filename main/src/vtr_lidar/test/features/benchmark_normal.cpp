@@ -0,0 +1,151 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file benchmark_normal.cpp
+ * \brief Throughput of the one-pass local PCA kernel used for normals,
+ * roughness and planarity vs. the previous copy, two pass and iterative
+ * eigensolver version.
+ */
+#include <random>
+
+#include "vtr_common/timing/stopwatch.hpp"
+#include "vtr_lidar/data_types/point.hpp"
+#include "vtr_lidar/features/normal.hpp"
+#include "vtr_logging/logging_init.hpp"
+
+using namespace vtr;
+using namespace vtr::logging;
+using namespace vtr::lidar;
+
+namespace {
+
+constexpr int num_queries = 100000;
+constexpr int num_neighbors = 20;
+constexpr int num_threads = 4;
+
+/// Previous implementation shared by the normal, map maintenance, terrain
+/// assessment and change detection modules
+void legacyPCA(const pcl::PointCloud<PointWithInfo> &point_cloud,
+               const std::vector<int> &indices, LocalPCA &pca) {
+  const pcl::PointCloud<PointWithInfo> points(point_cloud, indices);
+  Eigen::Matrix3f covariance_matrix;
+  Eigen::Vector4f xyz_centroid;
+  pcl::compute3DCentroid(points, xyz_centroid);
+  pcl::computeCovarianceMatrix(points, xyz_centroid, covariance_matrix);
+  Eigen::SelfAdjointEigenSolver<Eigen::Matrix3f> es;
+  es.compute(covariance_matrix);
+  pca.centroid = xyz_centroid.head<3>();
+  pca.eigenvalues = es.eigenvalues();
+  pca.eigenvectors = es.eigenvectors();
+}
+
+}  // namespace
+
+int main(int, char **) {
+  configureLogging("", true);
+
+  /// noisy planar and linear patches, far from the origin like map points
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> uniform(-0.5, 0.5);
+  std::normal_distribution<float> normal;
+  pcl::PointCloud<PointWithInfo> point_cloud;
+  std::vector<int> indices;
+  std::vector<size_t> offsets{0};
+  for (int q = 0; q < num_queries; ++q) {
+    const Eigen::Vector3f center(200 + 100 * uniform(gen),
+                                 -300 + 100 * uniform(gen), 5);
+    const float noise = (q % 3 == 0) ? 0.001 : (q % 3 == 1 ? 0.02 : 0.1);
+    const float width = (q % 2 == 0) ? 1.0 : 0.05;
+    for (int k = 0; k < num_neighbors; ++k) {
+      PointWithInfo p;
+      p.x = center.x() + uniform(gen);
+      p.y = center.y() + width * uniform(gen);
+      p.z = center.z() + noise * normal(gen);
+      indices.push_back(point_cloud.size());
+      point_cloud.push_back(p);
+    }
+    offsets.push_back(indices.size());
+  }
+
+  common::timing::Stopwatch<> timer(false);
+  const auto elapsed_ms = [&timer]() {
+    const auto ms = (double)timer.count<std::chrono::microseconds>() / 1000.0;
+    timer.reset();
+    return ms;
+  };
+
+  std::vector<LocalPCA> previous(num_queries), current(num_queries);
+
+  timer.start();
+  std::vector<int> neighbors;
+  for (int q = 0; q < num_queries; ++q) {
+    neighbors.assign(indices.begin() + offsets[q],
+                     indices.begin() + offsets[q + 1]);
+    legacyPCA(point_cloud, neighbors, previous[q]);
+  }
+  timer.stop();
+  const auto previous_ms = elapsed_ms();
+
+  timer.start();
+  for (int q = 0; q < num_queries; ++q)
+    computeLocalPCA(point_cloud, indices.data() + offsets[q],
+                    offsets[q + 1] - offsets[q], current[q]);
+  timer.stop();
+  const auto current_ms = elapsed_ms();
+
+  timer.start();
+  const auto batched = computeLocalPCA(point_cloud, indices, offsets,
+                                       /* min size */ 1, num_threads);
+  timer.stop();
+  const auto batched_ms = elapsed_ms();
+
+  CLOG(INFO, "test") << num_queries << " queries of " << num_neighbors
+                     << " neighbors - previous: " << previous_ms
+                     << " ms, current: " << current_ms << " ms, batched ("
+                     << num_threads << " threads): " << batched_ms << " ms";
+
+  /// compare against a double precision reference
+  float previous_error = 0, current_error = 0, normal_error = 0;
+  bool same_batched = true;
+  for (int q = 0; q < num_queries; ++q) {
+    Eigen::Vector3d mean = Eigen::Vector3d::Zero();
+    for (size_t i = offsets[q]; i < offsets[q + 1]; ++i)
+      mean += point_cloud[indices[i]].getVector3fMap().cast<double>();
+    mean /= num_neighbors;
+    Eigen::Matrix3d scatter = Eigen::Matrix3d::Zero();
+    for (size_t i = offsets[q]; i < offsets[q + 1]; ++i) {
+      const Eigen::Vector3d d =
+          point_cloud[indices[i]].getVector3fMap().cast<double>() - mean;
+      scatter += d * d.transpose();
+    }
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> es(scatter);
+    const double l0 = es.eigenvalues()(0);
+    previous_error = std::max(
+        previous_error, (float)(std::abs(previous[q].eigenvalues(0) - l0) / l0));
+    current_error = std::max(
+        current_error, (float)(std::abs(current[q].eigenvalues(0) - l0) / l0));
+    normal_error = std::max(
+        normal_error, 1 - std::abs(current[q].eigenvectors.col(0).dot(
+                              previous[q].eigenvectors.col(0))));
+    same_batched &= batched[q].eigenvalues == current[q].eigenvalues;
+  }
+  CLOG(INFO, "test") << "Max relative error of the smallest eigenvalue - "
+                     << "previous: " << previous_error
+                     << ", current: " << current_error
+                     << "; max normal 1 - cos: " << normal_error
+                     << ", same batched: " << same_batched;
+
+  return 0;
+}
@@ -0,0 +1,167 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file benchmark_voxel_hash_map.cpp
+ * \brief Voxel grid hashing: VoxelHashMap vs. std::unordered_map, for
+ * downsampling 200k-point scans and for insert-heavy point map updates.
+ */
+#include <random>
+#include <unordered_map>
+
+#include "vtr_common/timing/stopwatch.hpp"
+#include "vtr_lidar/data_types/point.hpp"
+#include "vtr_lidar/data_types/pointmap.hpp"
+#include "vtr_lidar/filters/voxel_downsample.hpp"
+#include "vtr_logging/logging_init.hpp"
+
+using namespace vtr;
+using namespace vtr::logging;
+using namespace vtr::lidar;
+
+namespace {
+
+constexpr int num_frames = 20;
+constexpr int num_scan_points = 200000;
+constexpr float frame_voxel_size = 0.1;
+constexpr float map_voxel_size = 0.3;
+
+pcl::PointCloud<PointWithInfo> simulateScan(std::mt19937 &gen,
+                                            const float sensor_x) {
+  std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  pcl::PointCloud<PointWithInfo> scan;
+  scan.reserve(num_scan_points);
+  for (int i = 0; i < num_scan_points; ++i) {
+    const float azimuth = 2.0 * M_PI * uniform(gen);
+    const float range = 2.0 + 38.0 * uniform(gen);
+    PointWithInfo p;
+    p.x = sensor_x + range * std::cos(azimuth);
+    p.y = range * std::sin(azimuth);
+    p.z = -1.5 + 3.0 * uniform(gen);
+    scan.push_back(p);
+  }
+  return scan;
+}
+
+/** \brief voxelDownsample as implemented with std::unordered_map */
+void voxelDownsampleStd(pcl::PointCloud<PointWithInfo> &point_cloud,
+                        const float &sample_dl) {
+  using namespace voxel_downsample;
+  const float inv_dl = 1 / sample_dl;
+  std::unordered_map<pointmap::VoxKey, VoxelCenter<PointWithInfo>> samples;
+  samples.reserve(point_cloud.size());
+  size_t i = 0;
+  for (const auto &p : point_cloud) {
+    const pointmap::VoxKey k((int)std::floor(p.x * inv_dl),
+                             (int)std::floor(p.y * inv_dl),
+                             (int)std::floor(p.z * inv_dl));
+    if (samples.count(k) < 1)
+      samples.emplace(k, VoxelCenter<PointWithInfo>(
+                             i, p,
+                             Point3D((k.x + 0.5) * sample_dl,
+                                     (k.y + 0.5) * sample_dl,
+                                     (k.z + 0.5) * sample_dl)));
+    else
+      samples.at(k).update(i, p);
+    i++;
+  }
+  std::vector<int> indices;
+  indices.reserve(samples.size());
+  for (const auto &v : samples) indices.push_back(v.second.idx);
+  point_cloud = pcl::PointCloud<PointWithInfo>(point_cloud, indices);
+}
+
+}  // namespace
+
+int main(int, char **) {
+  configureLogging("", true);
+
+  std::mt19937 gen(0);
+  std::vector<pcl::PointCloud<PointWithInfo>> scans;
+  for (int frame = 0; frame < num_frames; ++frame)
+    scans.emplace_back(simulateScan(gen, 0.5 * frame));
+
+  common::timing::Stopwatch<> timer(false);
+  const auto elapsed_ms = [&timer]() {
+    const auto ms = (double)timer.count<std::chrono::microseconds>() / 1000.0;
+    timer.reset();
+    return ms / num_frames;
+  };
+
+  /// downsampling
+  size_t std_size = 0, flat_size = 0;
+  for (const auto &scan : scans) {
+    auto cloud = scan;
+    timer.start();
+    voxelDownsampleStd(cloud, frame_voxel_size);
+    timer.stop();
+    std_size += cloud.size();
+  }
+  const auto std_downsample_ms = elapsed_ms();
+  for (const auto &scan : scans) {
+    auto cloud = scan;
+    timer.start();
+    voxelDownsample(cloud, frame_voxel_size);
+    timer.stop();
+    flat_size += cloud.size();
+  }
+  const auto flat_downsample_ms = elapsed_ms();
+  CLOG(INFO, "test") << "Downsampling, std::unordered_map: "
+                     << std_downsample_ms << " ms, VoxelHashMap: "
+                     << flat_downsample_ms << " ms (" << std_size << " vs "
+                     << flat_size << " points)";
+
+  /// insert-heavy map update, keys only (as in PointMap::update)
+  std::unordered_map<pointmap::VoxKey, size_t> std_map;
+  std_map.reserve(10 * num_scan_points);
+  for (const auto &scan : scans) {
+    timer.start();
+    for (const auto &p : scan) {
+      const pointmap::VoxKey k((int)std::floor(p.x / map_voxel_size),
+                               (int)std::floor(p.y / map_voxel_size),
+                               (int)std::floor(p.z / map_voxel_size));
+      std_map.try_emplace(k, std_map.size());
+    }
+    timer.stop();
+  }
+  const auto std_update_ms = elapsed_ms();
+  VoxelHashMap<size_t> flat_map(4 * num_scan_points);
+  for (const auto &scan : scans) {
+    timer.start();
+    for (const auto &p : scan) {
+      const pointmap::VoxKey k((int)std::floor(p.x / map_voxel_size),
+                               (int)std::floor(p.y / map_voxel_size),
+                               (int)std::floor(p.z / map_voxel_size));
+      flat_map.try_emplace(k, flat_map.size());
+    }
+    timer.stop();
+  }
+  const auto flat_update_ms = elapsed_ms();
+  CLOG(INFO, "test") << "Map update, std::unordered_map: " << std_update_ms
+                     << " ms, VoxelHashMap: " << flat_update_ms << " ms ("
+                     << std_map.size() << " vs " << flat_map.size()
+                     << " voxels)";
+
+  /// point map update, including point copies
+  PointMap<PointWithInfo> point_map(map_voxel_size);
+  for (const auto &scan : scans) {
+    timer.start();
+    point_map.update(scan);
+    timer.stop();
+  }
+  CLOG(INFO, "test") << "PointMap update: " << elapsed_ms() << " ms ("
+                     << point_map.size() << " points)";
+
+  return 0;
+}
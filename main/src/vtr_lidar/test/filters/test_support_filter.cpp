@@ -0,0 +1,119 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file test_support_filter.cpp
+ * \brief Checks the grid support sum of change detection against a
+ * brute-force radius search.
+ */
+#include <gmock/gmock.h>
+
+#include <random>
+
+#include "vtr_lidar/data_types/point.hpp"
+#include "vtr_lidar/filters/support_filter.hpp"
+#include "vtr_logging/logging_init.hpp"
+
+using namespace ::testing;  // NOLINT
+using namespace vtr;
+using namespace vtr::logging;
+using namespace vtr::lidar;
+
+namespace {
+
+/** \brief Change points flagged in flex23, spread in x and y, flat in z */
+pcl::PointCloud<PointWithInfo> randomPoints(std::mt19937 &gen,
+                                            const size_t num_points) {
+  std::uniform_real_distribution<float> coord(-8.0, 8.0);
+  std::uniform_real_distribution<float> unit(0.0, 1.0);
+  pcl::PointCloud<PointWithInfo> points;
+  points.resize(num_points);
+  for (auto &p : points) {
+    p.x = coord(gen);
+    p.y = coord(gen) * 0.5f;
+    p.z = coord(gen) * 0.05f;
+    p.flex23 = unit(gen) < 0.3f ? 1.0f : 0.0f;
+  }
+  return points;
+}
+
+std::vector<float> bruteForceSupport(
+    const pcl::PointCloud<PointWithInfo> &points,
+    const std::vector<size_t> &changes, const float radius,
+    const float variance) {
+  std::vector<float> support(changes.size(), 0.0f);
+  for (size_t k = 0; k < changes.size(); ++k) {
+    const auto &point = points[changes[k]];
+    for (size_t j = 0; j < points.size(); ++j) {
+      if (j == changes[k]) continue;
+      const float sq_dist =
+          (points[j].getVector3fMap() - point.getVector3fMap()).squaredNorm();
+      if (sq_dist >= radius * radius) continue;
+      support[k] += points[j].flex23 * std::exp(-sq_dist / (2 * variance));
+    }
+  }
+  return support;
+}
+
+std::vector<size_t> changePoints(const pcl::PointCloud<PointWithInfo> &points) {
+  std::vector<size_t> changes;
+  for (size_t i = 0; i < points.size(); ++i)
+    if (points[i].flex23 != 0.0f) changes.emplace_back(i);
+  return changes;
+}
+
+}  // namespace
+
+TEST(LIDAR, support_sum_matches_brute_force) {
+  std::mt19937 gen(3);
+  for (int trial = 0; trial < 10; ++trial) {
+    const auto points = randomPoints(gen, 3000);
+    const auto changes = changePoints(points);
+    const float radius = 0.25f + trial * 0.1f;
+    const float variance = 0.05f;
+
+    const auto expected = bruteForceSupport(points, changes, radius, variance);
+    const auto support = supportSum(points, changes, radius, variance, 4);
+    ASSERT_EQ(support.size(), changes.size());
+    for (size_t k = 0; k < changes.size(); ++k)
+      EXPECT_NEAR(support[k], expected[k], 1e-4f * (1.0f + expected[k]));
+  }
+}
+
+TEST(LIDAR, support_sum_corner_cases) {
+  pcl::PointCloud<PointWithInfo> points;
+  EXPECT_TRUE(supportSum(points, {}, 0.5f, 0.1f).empty());
+
+  // a single change point has no support, even from non-change points
+  points.resize(3);
+  for (auto &p : points) p.x = p.y = p.z = p.flex23 = 0.0f;
+  points[0].flex23 = 1.0f;
+  points[1].x = 0.1f;
+  EXPECT_THAT(supportSum(points, {0}, 0.5f, 0.1f), ElementsAre(0.0f));
+
+  // points exactly one radius apart do not support each other
+  points[1].flex23 = 1.0f;
+  points[1].x = 0.5f;
+  EXPECT_THAT(supportSum(points, {0, 1}, 0.5f, 0.1f), ElementsAre(0.0f, 0.0f));
+  points[1].x = 0.25f;
+  const float expected = std::exp(-0.0625f / 0.2f);
+  EXPECT_THAT(supportSum(points, {0, 1}, 0.5f, 0.1f),
+              ElementsAre(FloatEq(expected), FloatEq(expected)));
+}
+
+int main(int argc, char **argv) {
+  configureLogging("", true);
+  InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
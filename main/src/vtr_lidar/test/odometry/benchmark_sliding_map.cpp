@@ -0,0 +1,174 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file benchmark_sliding_map.cpp
+ * \brief Per-frame latency of the odometry sliding map kd-tree: incremental
+ * index maintained by PointMap vs. rebuilding nanoflann trees every frame.
+ *
+ * Each simulated frame mimics OdometryICPModule (nearest neighbor search for
+ * every scan point over a few iterations) and OdometryMapMaintenanceModuleV2
+ * (map update, radius search around every scan point, life time filter).
+ */
+#include <random>
+#include <type_traits>
+
+#include "vtr_common/timing/stopwatch.hpp"
+#include "vtr_lidar/data_types/point.hpp"
+#include "vtr_lidar/data_types/pointmap.hpp"
+#include "vtr_lidar/utils/nanoflann_utils.hpp"
+#include "vtr_logging/logging_init.hpp"
+
+using namespace vtr;
+using namespace vtr::logging;
+using namespace vtr::lidar;
+
+namespace {
+
+constexpr int num_frames = 50;
+constexpr int num_scan_points = 60000;
+constexpr int num_icp_iterations = 10;
+constexpr float map_voxel_size = 0.3;
+constexpr float point_life_time = 20.0;
+
+/** \brief A scan of a corridor with walls and poles, sensor moving along x */
+pcl::PointCloud<PointWithInfo> simulateScan(std::mt19937 &gen,
+                                            const float sensor_x) {
+  std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  pcl::PointCloud<PointWithInfo> scan;
+  scan.reserve(num_scan_points);
+  for (int i = 0; i < num_scan_points; ++i) {
+    const float azimuth = 2.0 * M_PI * i / num_scan_points;
+    const float range = 2.0 + 38.0 * uniform(gen);
+    PointWithInfo p;
+    p.x = sensor_x + range * std::cos(azimuth);
+    p.y = range * std::sin(azimuth);
+    if (i % 3 == 0) {  // ground
+      p.z = -1.5 + 0.02 * uniform(gen);
+    } else if (i % 3 == 1) {  // walls
+      p.y = (p.y > 0 ? 10.0 : -10.0) + 0.02 * uniform(gen);
+      p.z = -1.5 + 4.0 * uniform(gen);
+    } else {  // poles
+      p.x = std::round(p.x / 7.0) * 7.0 + 0.02 * uniform(gen);
+      p.z = -1.5 + 3.0 * uniform(gen);
+    }
+    scan.push_back(p);
+  }
+  return scan;
+}
+
+template <class KDTreeType>
+float icpSearch(const KDTreeType &kdtree,
+                const pcl::PointCloud<PointWithInfo> &scan) {
+  float sum = 0;
+  for (int it = 0; it < num_icp_iterations; ++it) {
+    for (const auto &p : scan) {
+      size_t index;
+      float sq_dist;
+      KDTreeResultSet result(1);
+      result.init(&index, &sq_dist);
+      if constexpr (std::is_same_v<KDTreeType, KDTree<PointWithInfo>>)
+        kdtree.findNeighbors(result, p.data, KDTreeSearchParams());
+      else
+        kdtree.findNeighbors(result, p.data);
+      sum += sq_dist;
+    }
+  }
+  return sum;
+}
+
+template <class KDTreeType>
+size_t normalSearch(const KDTreeType &kdtree,
+                    const pcl::PointCloud<PointWithInfo> &scan) {
+  const float sq_radius = std::pow(3.0 * map_voxel_size, 2);
+  size_t sum = 0;
+  std::vector<float> dists;
+  std::vector<int> indices;
+  for (const auto &p : scan) {
+    NanoFLANNRadiusResultSet<float, int> result(sq_radius, dists, indices);
+    if constexpr (std::is_same_v<KDTreeType, KDTree<PointWithInfo>>)
+      kdtree.radiusSearchCustomCallback(p.data, result, KDTreeSearchParams());
+    else
+      kdtree.findNeighbors(result, p.data);
+    sum += indices.size();
+  }
+  return sum;
+}
+
+/** \returns per-frame latency in ms */
+double run(const bool incremental) {
+  std::mt19937 gen(0);
+  PointMap<PointWithInfo> sliding_map(map_voxel_size);
+  const auto update_cb = [](bool, PointWithInfo &curr_pt,
+                            const PointWithInfo &) {
+    curr_pt.life_time = point_life_time;
+  };
+  const auto filter_cb = [](PointWithInfo &p) {
+    p.life_time -= 1.0;
+    return bool(p.life_time > 0.0);
+  };
+
+  float checksum = 0;
+  common::timing::Stopwatch<> timer(false);
+  for (int frame = 0; frame < num_frames; ++frame) {
+    const auto scan = simulateScan(gen, 0.5 * frame);
+    if (frame > 0) timer.start();
+
+    // odometry icp
+    if (sliding_map.size() > 0) {
+      if (incremental) {
+        checksum += icpSearch(sliding_map.kdtree(), scan);
+      } else {
+        NanoFLANNAdapter<PointWithInfo> adapter(sliding_map.point_cloud());
+        KDTree<PointWithInfo> kdtree(3, adapter, KDTreeParams(10));
+        kdtree.buildIndex();
+        checksum += icpSearch(kdtree, scan);
+      }
+    }
+
+    // odometry map maintenance
+    sliding_map.update(scan, update_cb);
+    if (incremental) {
+      checksum += normalSearch(sliding_map.kdtree(), scan);
+    } else {
+      NanoFLANNAdapter<PointWithInfo> adapter(sliding_map.point_cloud());
+      KDTree<PointWithInfo> kdtree(3, adapter, KDTreeParams(10));
+      kdtree.buildIndex();
+      checksum += normalSearch(kdtree, scan);
+    }
+    sliding_map.filter(filter_cb);
+
+    timer.stop();
+  }
+  CLOG(INFO, "test") << (incremental ? "incremental" : "rebuild    ")
+                     << " map size: " << sliding_map.size()
+                     << ", checksum: " << checksum;
+  return (double)timer.count<std::chrono::microseconds>() / 1000.0 /
+         (num_frames - 1);
+}
+
+}  // namespace
+
+int main(int, char **) {
+  configureLogging("", true);
+
+  const auto rebuild_ms = run(/* incremental */ false);
+  const auto incremental_ms = run(/* incremental */ true);
+
+  CLOG(INFO, "test") << "Per-frame latency, rebuild kd-tree every frame: "
+                     << rebuild_ms << " ms";
+  CLOG(INFO, "test") << "Per-frame latency, incremental kd-tree: "
+                     << incremental_ms << " ms";
+  return 0;
+}
@@ -0,0 +1,169 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file benchmark_point_conversions.cpp
+ * \brief Per-frame latency of PointCloud2 decoding and polar conversion of the
+ * lidar conversion modules vs. the previous iterator and libm based version.
+ */
+#include <random>
+
+#include "sensor_msgs/point_cloud2_iterator.hpp"
+
+#include "vtr_common/timing/stopwatch.hpp"
+#include "vtr_lidar/data_types/point.hpp"
+#include "vtr_lidar/utils/point_conversions.hpp"
+#include "vtr_logging/logging_init.hpp"
+
+using namespace vtr;
+using namespace vtr::logging;
+using namespace vtr::lidar;
+
+namespace {
+
+constexpr int num_frames = 20;
+constexpr int num_beams = 128;
+constexpr int num_columns = 2048;  // 262144 points per frame
+
+/** \brief An organized spinning lidar frame with x, y, z, intensity and t */
+sensor_msgs::msg::PointCloud2 simulateFrame(std::mt19937 &gen) {
+  std::uniform_real_distribution<float> range(1.0, 100.0);
+  sensor_msgs::msg::PointCloud2 msg;
+  sensor_msgs::PointCloud2Modifier modifier(msg);
+  modifier.setPointCloud2Fields(
+      5, "x", 1, sensor_msgs::msg::PointField::FLOAT32, "y", 1,
+      sensor_msgs::msg::PointField::FLOAT32, "z", 1,
+      sensor_msgs::msg::PointField::FLOAT32, "intensity", 1,
+      sensor_msgs::msg::PointField::FLOAT32, "t", 1,
+      sensor_msgs::msg::PointField::FLOAT64);
+  modifier.resize(num_beams * num_columns);
+  msg.height = num_beams;
+  msg.width = num_columns;
+  msg.row_step = num_columns * msg.point_step;
+
+  sensor_msgs::PointCloud2Iterator<float> x(msg, "x"), y(msg, "y"), z(msg, "z");
+  sensor_msgs::PointCloud2Iterator<float> intensity(msg, "intensity");
+  sensor_msgs::PointCloud2Iterator<double> t(msg, "t");
+  for (int b = 0; b < num_beams; ++b) {
+    const float elevation = (b - num_beams / 2) * M_PI / 512;
+    for (int c = 0; c < num_columns; ++c, ++x, ++y, ++z, ++intensity, ++t) {
+      const float azimuth = -M_PI + 2 * M_PI * c / num_columns;
+      const float r = range(gen);
+      *x = r * std::cos(elevation) * std::cos(azimuth);
+      *y = r * std::cos(elevation) * std::sin(azimuth);
+      *z = r * std::sin(elevation);
+      *intensity = r;
+      *t = 0.1 * c / num_columns;
+    }
+  }
+  return msg;
+}
+
+/// Previous implementation of the ouster conversion module
+void legacyConvert(const sensor_msgs::msg::PointCloud2 &msg,
+                   pcl::PointCloud<PointWithInfo> &point_cloud) {
+  point_cloud = pcl::PointCloud<PointWithInfo>(msg.width * msg.height, 1);
+  // clang-format off
+  sensor_msgs::PointCloud2ConstIterator<float> iter_x(msg, "x"), iter_y(msg, "y"), iter_z(msg, "z");
+  sensor_msgs::PointCloud2ConstIterator<double> iter_time(msg, "t");
+  sensor_msgs::PointCloud2ConstIterator<float> iter_intensity(msg, "intensity");
+  // clang-format on
+  for (size_t idx = 0; iter_x != iter_x.end();
+       ++idx, ++iter_x, ++iter_y, ++iter_z, ++iter_time, ++iter_intensity) {
+    point_cloud.at(idx).x = *iter_x;
+    point_cloud.at(idx).y = *iter_y;
+    point_cloud.at(idx).z = *iter_z;
+    point_cloud.at(idx).intensity = *iter_intensity;
+    point_cloud.at(idx).timestamp = static_cast<int64_t>(*iter_time * 1e9);
+  }
+  for (size_t i = 0; i < point_cloud.size(); i++) {
+    auto &p = point_cloud[i];
+    auto &pm1 = i > 0 ? point_cloud[i - 1] : point_cloud[i];
+    p.rho = sqrt(p.x * p.x + p.y * p.y + p.z * p.z);
+    p.theta = atan2(sqrt(p.x * p.x + p.y * p.y), p.z);
+    p.phi = atan2(p.y, p.x) + M_PI / 2;
+    if (i > 0 && (p.phi - pm1.phi) > 1.5 * M_PI)
+      p.phi -= 2 * M_PI;
+    else if (i > 0 && (p.phi - pm1.phi) < -1.5 * M_PI)
+      p.phi += 2 * M_PI;
+  }
+}
+
+/// Current implementation of the ouster conversion module
+void convert(const sensor_msgs::msg::PointCloud2 &msg,
+             pcl::PointCloud<PointWithInfo> &point_cloud) {
+  using namespace conversions;
+  point_cloud = pcl::PointCloud<PointWithInfo>(msg.width * msg.height, 1);
+  const PointCloud2Field<float> x(msg, "x"), y(msg, "y"), z(msg, "z");
+  const PointCloud2Field<double> time(msg, "t");
+  const PointCloud2Field<float> intensity(msg, "intensity");
+  forEachPoint(msg, [&](const size_t idx, const uint8_t *point) {
+    auto &p = point_cloud[idx];
+    p.x = x(point);
+    p.y = y(point);
+    p.z = z(point);
+    p.intensity = intensity(point);
+    p.timestamp = static_cast<int64_t>(time(point) * 1e9);
+  });
+  cart2pol(point_cloud, M_PI / 2, true);
+}
+
+}  // namespace
+
+int main(int, char **) {
+  configureLogging("", true);
+
+  std::mt19937 gen(42);
+  std::vector<sensor_msgs::msg::PointCloud2> frames;
+  for (int i = 0; i < num_frames; ++i) frames.emplace_back(simulateFrame(gen));
+
+  common::timing::Stopwatch<> timer(false);
+  const auto elapsed_ms = [&timer]() {
+    const auto ms = (double)timer.count<std::chrono::microseconds>() / 1000.0;
+    timer.reset();
+    return ms / num_frames;
+  };
+
+  pcl::PointCloud<PointWithInfo> previous, current;
+
+  timer.start();
+  for (const auto &frame : frames) legacyConvert(frame, previous);
+  timer.stop();
+  const auto previous_ms = elapsed_ms();
+
+  timer.start();
+  for (const auto &frame : frames) convert(frame, current);
+  timer.stop();
+  const auto current_ms = elapsed_ms();
+
+  CLOG(INFO, "test") << "Frames of " << num_beams * num_columns
+                     << " points - previous: " << previous_ms
+                     << " ms, current: " << current_ms << " ms per frame";
+
+  /// polar coordinates of the last frame should agree
+  float rho_error = 0, theta_error = 0, phi_error = 0;
+  bool same_timestamps = true;
+  for (size_t i = 0; i < current.size(); ++i) {
+    rho_error = std::max(rho_error, std::abs(current[i].rho - previous[i].rho));
+    theta_error =
+        std::max(theta_error, std::abs(current[i].theta - previous[i].theta));
+    phi_error = std::max(phi_error, std::abs(current[i].phi - previous[i].phi));
+    same_timestamps &= current[i].timestamp == previous[i].timestamp;
+  }
+  CLOG(INFO, "test") << "Max error - rho: " << rho_error
+                     << ", theta: " << theta_error << ", phi: " << phi_error
+                     << ", same timestamps: " << same_timestamps;
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file test_point_conversions.cpp
+ * \brief Checks the documented error of fastAtan2 and the polar coordinates
+ * computed by cart2pol against std::atan2.
+ */
+#include <gmock/gmock.h>
+
+#include <random>
+
+#include "vtr_lidar/data_types/point.hpp"
+#include "vtr_lidar/utils/point_conversions.hpp"
+#include "vtr_logging/logging_init.hpp"
+
+using namespace ::testing;  // NOLINT
+using namespace vtr::logging;
+using namespace vtr::lidar;
+using namespace vtr::lidar::conversions;
+
+namespace {
+
+/** \brief documented bound of fastAtan2 in point_conversions.hpp */
+constexpr double atan2_error = 2e-6;
+
+}  // namespace
+
+TEST(LIDAR, fast_atan2_error_bound) {
+  // every direction, at magnitudes from tiny to large
+  constexpr int num_angles = 1 << 20;
+  double max_error = 0.0;
+  for (const float r : {1e-30f, 1e-3f, 1.0f, 1e3f, 1e30f}) {
+    for (int i = 0; i < num_angles; ++i) {
+      const double angle = 2 * M_PI * i / num_angles - M_PI;
+      const float x = r * std::cos(angle), y = r * std::sin(angle);
+      const double error = std::abs(fastAtan2(y, x) - std::atan2((double)y, x));
+      // +-pi both describe the negative x axis
+      max_error = std::max(max_error, std::min(error, 2 * M_PI - error));
+    }
+  }
+  EXPECT_LT(max_error, atan2_error);
+
+  // random points, including the worst case ratios around the diagonals
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> coord(-100.0, 100.0);
+  for (int i = 0; i < 1000000; ++i) {
+    const float x = coord(gen), y = coord(gen);
+    EXPECT_NEAR(fastAtan2(y, x), std::atan2((double)y, x), atan2_error);
+    EXPECT_NEAR(fastAtan2(x, x), std::atan2((double)x, x), atan2_error);
+  }
+
+  // axes and the origin
+  EXPECT_EQ(fastAtan2(0.0f, 0.0f), 0.0f);
+  EXPECT_EQ(fastAtan2(0.0f, 1.0f), 0.0f);
+  EXPECT_NEAR(fastAtan2(1.0f, 0.0f), M_PI / 2, atan2_error);
+  EXPECT_NEAR(fastAtan2(-1.0f, 0.0f), -M_PI / 2, atan2_error);
+  EXPECT_NEAR(fastAtan2(0.0f, -1.0f), M_PI, atan2_error);
+}
+
+TEST(LIDAR, cart2pol_matches_atan2) {
+  // a spinning scan crossing +-pi, with noisy azimuth
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> noise(-0.01, 0.01);
+  std::uniform_real_distribution<float> range(0.5, 100.0);
+  pcl::PointCloud<PointWithInfo> point_cloud;
+  for (int i = 0; i < 1000; ++i) {
+    const double phi = 2 * M_PI * i / 1000 + noise(gen) + M_PI / 4;
+    const double theta = M_PI / 2 + 10 * noise(gen);
+    const float rho = range(gen);
+    PointWithInfo p;
+    p.x = rho * std::sin(theta) * std::cos(phi);
+    p.y = rho * std::sin(theta) * std::sin(phi);
+    p.z = rho * std::cos(theta);
+    point_cloud.push_back(p);
+  }
+
+  const float phi_offset = M_PI / 2;
+  cart2pol(point_cloud, phi_offset, true);
+
+  double prev_phi = 0.0;
+  for (size_t i = 0; i < point_cloud.size(); ++i) {
+    const auto &p = point_cloud[i];
+    const double x = p.x, y = p.y, z = p.z;
+    double phi = std::atan2(y, x) + phi_offset;
+    if (i > 0 && phi - prev_phi > 1.5 * M_PI) phi -= 2 * M_PI;
+    if (i > 0 && phi - prev_phi < -1.5 * M_PI) phi += 2 * M_PI;
+    prev_phi = phi;
+
+    const double rho = std::sqrt(x * x + y * y + z * z);
+    EXPECT_NEAR(p.rho, rho, 1e-6 * rho);
+    EXPECT_NEAR(p.theta, std::atan2(std::sqrt(x * x + y * y), z), 1e-5);
+    EXPECT_NEAR(p.phi, phi, 1e-5);
+  }
+}
+
+int main(int argc, char **argv) {
+  configureLogging("", true);
+  InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
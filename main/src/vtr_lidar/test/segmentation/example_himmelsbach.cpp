@@ -20,8 +20,10 @@
 #include <pcl/visualization/pcl_visualizer.h>
 #include <boost/algorithm/string.hpp>
 
+#include "vtr_common/timing/stopwatch.hpp"
 #include "vtr_lidar/data_types/point.hpp"
 #include "vtr_lidar/segmentation/himmelsbach.hpp"
+#include "vtr_lidar/utils/point_conversions.hpp"
 #include "vtr_logging/logging_init.hpp"
 
 // pcl type visualization implementations
@@ -96,8 +98,25 @@ int main(int, char **) {
     point_cloud->at(idx).y = points(idx, 1);
     point_cloud->at(idx).z = points(idx, 2);
   }
+  // polar coordinates as computed by the conversion modules
+  conversions::cart2pol(*point_cloud);
 
+  common::timing::Stopwatch<> timer;
   const auto ground_idx = himmelsbach(*point_cloud);
+  timer.stop();
+  CLOG(INFO, "test") << "Extracted " << ground_idx.size() << " ground points of "
+                     << point_cloud->size() << " in " << timer;
+
+  // same segmentation from precomputed polar coordinates, in parallel
+  himmelsbach.use_polar = true;
+  himmelsbach.num_threads = 4;
+  timer.reset();
+  timer.start();
+  const auto polar_ground_idx = himmelsbach(*point_cloud);
+  timer.stop();
+  CLOG(INFO, "test") << "Extracted " << polar_ground_idx.size()
+                     << " ground points from polar coordinates with "
+                     << himmelsbach.num_threads << " threads in " << timer;
   PointCloud::Ptr ground_cloud(new PointCloud);
   for (const auto &idx : ground_idx)
     ground_cloud->push_back(point_cloud->at(idx));
@@ -0,0 +1,78 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file test_pipeline.cpp
+ */
+#include <gmock/gmock.h>
+
+#include <deque>
+
+#include "vtr_lidar/pipeline.hpp"
+#include "vtr_logging/logging_init.hpp"
+
+using namespace ::testing;  // NOLINT
+using namespace vtr;
+using namespace vtr::logging;
+using namespace vtr::lidar;
+
+TEST(LIDAR, pipeline_pools_steady_state) {
+  const auto config = std::make_shared<LidarPipeline::Config>();
+  LidarPipeline pipeline(config);
+
+  // frames still used by later stages and async tasks when a new one arrives
+  constexpr size_t num_frames = 1000;
+  constexpr size_t frames_in_flight = 3;
+  constexpr size_t clouds_per_frame = 4;
+  std::deque<std::shared_ptr<LidarQueryCache>> in_flight;
+  for (size_t i = 0; i < num_frames; ++i) {
+    const auto qdata = std::dynamic_pointer_cast<LidarQueryCache>(
+        pipeline.createQueryCache());
+    ASSERT_NE(qdata, nullptr);
+    std::vector<std::shared_ptr<pcl::PointCloud<PointWithInfo>>> clouds;
+    for (size_t j = 0; j < clouds_per_frame; ++j) {
+      clouds.emplace_back(qdata->createPointCloud());
+      EXPECT_TRUE(clouds.back()->empty());
+      clouds.back()->resize(100);
+    }
+    qdata->raw_point_cloud = clouds[0];
+    qdata->preprocessed_point_cloud = clouds[1];
+    qdata->nn_point_cloud = clouds[2];
+    qdata->undistorted_point_cloud = clouds[3];
+
+    in_flight.push_back(qdata);
+    if (in_flight.size() > frames_in_flight) in_flight.pop_front();
+  }
+
+  // only the first frames, before any frame finished, allocate; afterwards a
+  // finished frame returns its query cache and point clouds to the pools
+  const auto qstats = pipeline.queryCachePoolStatistics();
+  EXPECT_EQ(qstats.misses, frames_in_flight + 1);
+  EXPECT_EQ(qstats.hits, num_frames - qstats.misses);
+  EXPECT_EQ(qstats.in_use, frames_in_flight);
+  const auto pstats = pipeline.pointCloudPoolStatistics();
+  EXPECT_EQ(pstats.misses, (frames_in_flight + 1) * clouds_per_frame);
+  EXPECT_EQ(pstats.hits, num_frames * clouds_per_frame - pstats.misses);
+  EXPECT_EQ(pstats.in_use, frames_in_flight * clouds_per_frame);
+
+  in_flight.clear();
+  EXPECT_EQ(pipeline.queryCachePoolStatistics().in_use, (size_t)0);
+  EXPECT_EQ(pipeline.pointCloudPoolStatistics().in_use, (size_t)0);
+}
+
+int main(int argc, char** argv) {
+  configureLogging("", true);
+  InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -18,8 +18,13 @@
  */
 #include <gmock/gmock.h>
 
+#include <random>
+#include <thread>
+#include <unordered_map>
+
 #include "vtr_lidar/data_types/point.hpp"
 #include "vtr_lidar/data_types/pointmap.hpp"
+#include "vtr_lidar/utils/nanoflann_utils.hpp"
 #include "vtr_logging/logging_init.hpp"
 
 using namespace ::testing;  // NOLINT
@@ -176,6 +181,168 @@ TEST(LIDAR, point_map_read_write) {
   }
 }
 
+// clang-format off
+TEST(LIDAR, point_map_kdtree) {
+  PointMap<PointWithInfo> point_map(0.1);
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> dist(-10.0, 10.0);
+
+  const auto brute_force_nn = [&](const PointWithInfo& query) {
+    const auto& points = point_map.point_cloud();
+    float best = std::numeric_limits<float>::max();
+    for (const auto& p : points)
+      best = std::min(best, (p.getVector3fMap() - query.getVector3fMap()).squaredNorm());
+    return best;
+  };
+
+  for (int frame = 0; frame < 10; frame++) {
+    pcl::PointCloud<PointWithInfo> point_cloud;
+    for (int i = 0; i < 2000; i++) {
+      PointWithInfo p;
+      p.x = dist(gen); p.y = dist(gen); p.z = 0.1 * dist(gen);
+      p.life_time = frame % 3 + 1;
+      point_cloud.push_back(p);
+    }
+    point_map.update(point_cloud);
+    // built after the first update, maintained incrementally afterwards
+    const auto& kdtree = point_map.kdtree();
+    point_map.filter([](PointWithInfo& p) { return (p.life_time -= 1.0) > 0.0; });
+    EXPECT_EQ(kdtree.size(), point_map.size());
+
+    for (int i = 0; i < 100; i++) {
+      PointWithInfo query;
+      query.x = dist(gen); query.y = dist(gen); query.z = 0.1 * dist(gen);
+      size_t index;
+      float sq_dist;
+      KDTreeResultSet result(1);
+      result.init(&index, &sq_dist);
+      kdtree.findNeighbors(result, query.data);
+      EXPECT_FLOAT_EQ(sq_dist, brute_force_nn(query));
+      EXPECT_FLOAT_EQ(sq_dist, (point_map.point_cloud()[index].getVector3fMap() - query.getVector3fMap()).squaredNorm());
+    }
+  }
+}
+// clang-format on
+
+TEST(LIDAR, point_map_kdtree_copy) {
+  pcl::PointCloud<PointWithInfo> point_cloud;
+  for (int i = 0; i < 100; i++) {
+    PointWithInfo p;
+    p.x = i - 50; p.y = 0; p.z = 0;
+    point_cloud.push_back(p);
+  }
+
+  // copies of the index start without a tree
+  LazyIncrementalKDTree<PointWithInfo> kdtree;
+  EXPECT_EQ(kdtree.get(point_cloud).size(), point_cloud.size());
+  EXPECT_TRUE(kdtree.built());
+  const LazyIncrementalKDTree<PointWithInfo> copy(kdtree);
+  EXPECT_FALSE(copy.built());
+  LazyIncrementalKDTree<PointWithInfo> assigned;
+  assigned.get(point_cloud);
+  assigned = kdtree;
+  EXPECT_FALSE(assigned.built());
+
+  // a copied map builds its own tree over its own points
+  PointMap<PointWithInfo> point_map(0.1);
+  point_map.update(point_cloud);
+  point_map.kdtree();
+  PointMap<PointWithInfo> copy_map(point_map);
+  copy_map.filter([](const PointWithInfo& p) { return p.x > 0.0; });
+  EXPECT_EQ(copy_map.kdtree().size(), copy_map.size());
+  EXPECT_EQ(point_map.kdtree().size(), point_map.size());
+  EXPECT_NE(copy_map.size(), point_map.size());
+}
+
+TEST(LIDAR, point_map_static_kdtree) {
+  PointMap<PointWithInfo> point_map(0.1);
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> dist(-10.0, 10.0);
+  pcl::PointCloud<PointWithInfo> point_cloud;
+  for (int i = 0; i < 5000; i++) {
+    PointWithInfo p;
+    p.x = dist(gen);
+    p.y = dist(gen);
+    p.z = dist(gen);
+    point_cloud.push_back(p);
+  }
+  point_map.update(point_cloud);
+
+  // concurrent consumers share one tree
+  std::vector<StaticKDTree<PointWithInfo>::ConstPtr> kdtrees(4);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kdtrees.size(); ++i)
+    threads.emplace_back([&, i] { kdtrees[i] = point_map.staticKDTree(); });
+  for (auto& thread : threads) thread.join();
+  for (const auto& kdtree : kdtrees) EXPECT_EQ(kdtree, kdtrees[0]);
+  EXPECT_EQ(kdtrees[0]->size(), point_map.size());
+
+  for (size_t i = 0; i < point_map.size(); i += 100) {
+    size_t index;
+    float sq_dist;
+    KDTreeResultSet result(1);
+    result.init(&index, &sq_dist);
+    kdtrees[0]->findNeighbors(result, point_map.point_cloud()[i].data,
+                              KDTreeSearchParams());
+    EXPECT_EQ(index, i);
+    EXPECT_FLOAT_EQ(sq_dist, 0.0);
+  }
+
+  // copies index their own points and changes drop the tree
+  const PointMap<PointWithInfo> copy(point_map);
+  EXPECT_NE(copy.staticKDTree(), kdtrees[0]);
+  point_map.filter([](const PointWithInfo& p) { return p.x > 0.0; });
+  const auto kdtree = point_map.staticKDTree();
+  EXPECT_NE(kdtree, kdtrees[0]);
+  EXPECT_EQ(kdtree->size(), point_map.size());
+}
+
+TEST(LIDAR, voxel_hash_map) {
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int> coord(-1000, 1000);
+
+  VoxelHashMap<size_t> voxel_map;
+  std::unordered_map<pointmap::VoxKey, size_t> reference;
+  // insert past the initial capacity to exercise rehashing
+  for (size_t i = 0; i < 20000; ++i) {
+    const pointmap::VoxKey k(coord(gen), coord(gen) / 10, coord(gen) / 100);
+    const auto res = voxel_map.try_emplace(k, i);
+    const auto ref_res = reference.try_emplace(k, i);
+    EXPECT_EQ(res.second, ref_res.second);
+    EXPECT_EQ(*res.first, ref_res.first->second);
+  }
+  EXPECT_EQ(voxel_map.size(), reference.size());
+  for (size_t i = 0; i < 20000; ++i) {
+    const pointmap::VoxKey k(coord(gen), coord(gen) / 10, coord(gen) / 100);
+    const auto value = voxel_map.find(k);
+    const auto it = reference.find(k);
+    ASSERT_EQ(value == nullptr, it == reference.end());
+    if (value != nullptr) EXPECT_EQ(*value, it->second);
+  }
+
+  // extreme coordinates do not collide with each other or the origin
+  voxel_map.clear();
+  EXPECT_TRUE(voxel_map.empty());
+  voxel_map.try_emplace(pointmap::VoxKey(-(1 << 20), -(1 << 20), -(1 << 20)), 1);
+  voxel_map.try_emplace(pointmap::VoxKey((1 << 20) - 2, (1 << 20) - 2, (1 << 20) - 2), 2);
+  EXPECT_EQ(voxel_map.size(), (size_t)2);
+  EXPECT_EQ(voxel_map.count(pointmap::VoxKey(0, 0, 0)), (size_t)0);
+  EXPECT_EQ(*voxel_map.find(pointmap::VoxKey(-(1 << 20), -(1 << 20), -(1 << 20))), (size_t)1);
+
+  // coordinates out of the Morton code range do not alias the ones in range
+  const pointmap::VoxKey in_range(0, 0, 0), out_of_range(1 << 21, 0, 0);
+  EXPECT_EQ(voxel_map.try_emplace(in_range, 3).second, true);
+  EXPECT_EQ(voxel_map.count(out_of_range), (size_t)0);
+  EXPECT_EQ(voxel_map.try_emplace(out_of_range, 4).second, true);
+  EXPECT_EQ(voxel_map.try_emplace(out_of_range, 5).second, false);
+  EXPECT_EQ(voxel_map.size(), (size_t)4);
+  EXPECT_EQ(*voxel_map.find(in_range), (size_t)3);
+  EXPECT_EQ(*voxel_map.find(out_of_range), (size_t)4);
+  EXPECT_EQ(voxel_map.count(pointmap::VoxKey((1 << 20) - 1, 0, 0)), (size_t)0);
+  voxel_map.clear();
+  EXPECT_EQ(voxel_map.count(out_of_range), (size_t)0);
+}
+
 int main(int argc, char** argv) {
   configureLogging("", true);
   InitGoogleTest(&argc, argv);
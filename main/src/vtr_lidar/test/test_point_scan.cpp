@@ -18,9 +18,13 @@
  */
 #include <gmock/gmock.h>
 
+#include <filesystem>
+
 #include "vtr_lidar/data_types/point.hpp"
+#include "vtr_lidar/data_types/point_chunk.hpp"
 #include "vtr_lidar/data_types/pointmap.hpp"
 #include "vtr_logging/logging_init.hpp"
+#include "vtr_storage/stream/data_stream_accessor.hpp"
 
 using namespace ::testing;  // NOLINT
 using namespace vtr;
@@ -92,6 +96,183 @@ TEST(LIDAR, point_scan_read_write) {
   // clang-format on
 }
 
+TEST(LIDAR, point_scan_read_write_chunk) {
+  const auto directory =
+      std::filesystem::temp_directory_path() / "vtr_lidar_test_point_chunks";
+  std::filesystem::remove_all(directory);
+  PointChunkStore::configure(directory, true);
+
+  auto point_scan = std::make_shared<PointScan<PointWithInfo>>();
+  for (int i = 0; i < 1000; i++) {
+    PointWithInfo p;
+    p.x = 1 + i;
+    p.y = 2 + i;
+    p.z = 3 + i;
+    p.timestamp = 11 + i;
+    point_scan->point_cloud().push_back(p);
+  }
+  point_scan->vertex_id() = tactic::VertexId(1, 1);
+
+  const auto msg = point_scan->toStorable();
+  EXPECT_FALSE(msg.chunk_file.empty());
+  EXPECT_EQ(msg.scan.point_cloud.data.size(), (size_t)0);
+  EXPECT_TRUE(std::filesystem::exists(directory / msg.chunk_file));
+
+  auto point_scan2 = PointScan<PointWithInfo>::fromStorable(msg);
+  ASSERT_EQ(point_scan2->size(), point_scan->size());
+  EXPECT_EQ(point_scan2->vertex_id(), point_scan->vertex_id());
+  EXPECT_EQ(point_scan2->point_cloud().width, point_scan->point_cloud().width);
+  for (size_t i = 0; i < point_scan->size(); i++) {
+    EXPECT_EQ(point_scan2->point_cloud()[i].x, point_scan->point_cloud()[i].x);
+    EXPECT_EQ(point_scan2->point_cloud()[i].timestamp,
+              point_scan->point_cloud()[i].timestamp);
+  }
+
+  // storing again keeps the chunk file if the points are unchanged, whereas a
+  // copy is stored as another chunk file
+  EXPECT_EQ(point_scan->toStorable().chunk_file, msg.chunk_file);
+  auto point_scan3 = std::make_shared<PointScan<PointWithInfo>>(*point_scan);
+  const auto msg3 = point_scan3->toStorable();
+  EXPECT_NE(msg3.chunk_file, msg.chunk_file);
+  const auto num_files = [&directory] {
+    using It = std::filesystem::directory_iterator;
+    return std::distance(It(directory), It());
+  };
+  EXPECT_EQ(num_files(), 2);
+
+  // changed points are written to a new chunk file replacing the old one
+  point_scan->point_cloud()[0].x = -1;
+  const auto msg2 = point_scan->toStorable();
+  EXPECT_NE(msg2.chunk_file, msg.chunk_file);
+  EXPECT_FALSE(std::filesystem::exists(directory / msg.chunk_file));
+  EXPECT_EQ(PointScan<PointWithInfo>::fromStorable(msg2)->point_cloud()[0].x,
+            -1);
+  EXPECT_EQ(num_files(), 2);
+
+  // chunks written before can still be loaded when writing is disabled
+  PointChunkStore::configure(directory, false);
+  EXPECT_EQ(PointScan<PointWithInfo>::fromStorable(msg3)->size(),
+            point_scan->size());
+  // and are removed once superseded by a message
+  const auto msg4 = point_scan3->toStorable();
+  EXPECT_TRUE(msg4.chunk_file.empty());
+  EXPECT_FALSE(std::filesystem::exists(directory / msg3.chunk_file));
+  EXPECT_EQ(num_files(), 1);
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST(LIDAR, point_map_chunk_per_stream) {
+  const auto graph =
+      std::filesystem::temp_directory_path() / "vtr_lidar_test_chunk_streams";
+  std::filesystem::remove_all(graph);
+  const auto data_dir = (graph / "data").string();
+  PointChunkStore::configure(PointChunkStore::defaultDirectory(graph), true);
+
+  using PointMapLM = storage::LockableMessage<PointMap<PointWithInfo>>;
+  using PointMapAccessor =
+      storage::DataStreamAccessor<PointMap<PointWithInfo>>;
+  const auto make_points = [](const int num_points) {
+    pcl::PointCloud<PointWithInfo> point_cloud;
+    for (int i = 0; i < num_points; i++) {
+      PointWithInfo p;
+      p.x = i;
+      p.y = p.z = 0;
+      point_cloud.push_back(p);
+    }
+    return point_cloud;
+  };
+
+  // the same map stored as the initial map and its copy, as by the pipeline
+  {
+    PointMapAccessor pointmap(data_dir, "pointmap",
+                              "vtr_lidar_msgs/msg/ChunkedPointMap");
+    PointMapAccessor pointmap_v0(data_dir, "pointmap_v0",
+                                 "vtr_lidar_msgs/msg/ChunkedPointMap");
+    auto point_map = std::make_shared<PointMap<PointWithInfo>>(0.1);
+    point_map->update(make_points(100));
+    pointmap.write(std::make_shared<PointMapLM>(point_map, 1));
+    pointmap_v0.write(std::make_shared<PointMapLM>(point_map, 1));
+  }
+
+  // the map is updated in place, as by the intra-experience merging module
+  {
+    PointMapAccessor pointmap(data_dir, "pointmap",
+                              "vtr_lidar_msgs/msg/ChunkedPointMap");
+    const auto map_msg = pointmap.readAtIndex(1);
+    auto updated_map = map_msg->unlocked().get().getData();
+    updated_map.update(make_points(200));
+    updated_map.version() = PointMap<PointWithInfo>::INTRA_EXP_MERGED;
+    map_msg->locked().get().setData(updated_map);
+    pointmap.write(map_msg);
+  }
+
+  // the initial map is kept
+  PointMapAccessor pointmap(data_dir, "pointmap",
+                            "vtr_lidar_msgs/msg/ChunkedPointMap");
+  PointMapAccessor pointmap_v0(data_dir, "pointmap_v0",
+                               "vtr_lidar_msgs/msg/ChunkedPointMap");
+  const auto map = pointmap.readAtIndex(1)->unlocked().get().getData();
+  const auto map_v0 = pointmap_v0.readAtIndex(1)->unlocked().get().getData();
+  EXPECT_EQ(map.size(), (size_t)200);
+  EXPECT_EQ(map.version(), PointMap<PointWithInfo>::INTRA_EXP_MERGED);
+  EXPECT_EQ(map_v0.size(), (size_t)100);
+  EXPECT_EQ(map_v0.version(), PointMap<PointWithInfo>::INITIAL);
+
+  // the chunk file replaced by the update is removed once it is committed
+  using It = std::filesystem::directory_iterator;
+  const auto directory = PointChunkStore::defaultDirectory(graph);
+  EXPECT_EQ(std::distance(It(directory), It()), 2);
+
+  PointChunkStore::configure(PointChunkStore::defaultDirectory(graph), false);
+  std::filesystem::remove_all(graph);
+}
+
+TEST(LIDAR, point_map_legacy_stream) {
+  const auto graph =
+      std::filesystem::temp_directory_path() / "vtr_lidar_test_legacy_stream";
+  std::filesystem::remove_all(graph);
+  const auto data_dir = (graph / "data").string();
+  const auto directory = PointChunkStore::defaultDirectory(graph);
+  PointChunkStore::configure(directory, true);
+
+  using PointMapLM = storage::LockableMessage<PointMap<PointWithInfo>>;
+  using PointMapAccessor =
+      storage::DataStreamAccessor<PointMap<PointWithInfo>>;
+  auto point_map = std::make_shared<PointMap<PointWithInfo>>(0.1);
+  pcl::PointCloud<PointWithInfo> point_cloud;
+  for (int i = 0; i < 100; i++) {
+    PointWithInfo p;
+    p.x = i;
+    p.y = p.z = 0;
+    point_cloud.push_back(p);
+  }
+  point_map->update(point_cloud);
+
+  // a stream created with the PointMap type, as before point chunks
+  {
+    PointMapAccessor pointmap(data_dir, "pointmap",
+                              "vtr_lidar_msgs/msg/PointMap");
+    pointmap.write(std::make_shared<PointMapLM>(point_map, 1));
+  }
+  using It = std::filesystem::directory_iterator;
+  EXPECT_EQ(std::distance(It(directory), It()), 0);
+
+  // keeps its type, and is read and written with it
+  PointMapAccessor pointmap(data_dir, "pointmap",
+                            "vtr_lidar_msgs/msg/ChunkedPointMap");
+  EXPECT_EQ(pointmap.streamType(), "vtr_lidar_msgs/msg/PointMap");
+  const auto map_msg = pointmap.readAtIndex(1);
+  EXPECT_EQ(map_msg->unlocked().get().getData().size(), (size_t)100);
+  pointmap.write(std::make_shared<PointMapLM>(point_map, 2));
+  EXPECT_EQ(pointmap.readAtIndex(2)->unlocked().get().getData().size(),
+            (size_t)100);
+  EXPECT_EQ(std::distance(It(directory), It()), 0);
+
+  PointChunkStore::configure(directory, false);
+  std::filesystem::remove_all(graph);
+}
+
 int main(int argc, char** argv) {
   configureLogging("", true);
   InitGoogleTest(&argc, argv);
@@ -87,7 +87,8 @@ class GraphMapServer : public tactic::Graph::Callback,
   using UniqueLock = std::unique_lock<Mutex>;
   using SharedLock = std::shared_lock<Mutex>;
 
-  void start(const rclcpp::Node::SharedPtr& node, const GraphPtr& graph);
+  void start(const rclcpp::Node::SharedPtr& node, const GraphPtr& graph,
+             const tactic::PrivilegedGraph::Ptr& privileged_graph);
 
  private:
   /// these functions, if necessary, must lock graph first then internal lock
@@ -122,26 +123,54 @@ class GraphMapServer : public tactic::Graph::Callback,
   /// these functions are called by functions above, do not lock mutex inside
   /** \brief Helper to get a shared pointer to the graph */
   GraphPtr getGraph() const;
-  /** \brief Returns a privileged graph (only contains teach routes) */
+  /** \brief Returns the privileged graph (only contains teach routes) */
   GraphBasePtr getPrivilegedGraph() const;
   /** \brief Compute graph in a privileged frame, changes vid2tf_map_ */
   void optimizeGraph(const GraphBasePtr& priv_graph);
+  /** \brief Re-solve the given vertices only, changes vid2tf_map_ */
+  void optimizeGraph(const GraphBasePtr& priv_graph,
+                     const VertexId::UnorderedSet& region);
   void updateVertexProjection();
   void updateVertexType();
+  void updateVertexType(GraphVertex& vertex);
   void updateVertexName();
+  void updateVertexName(GraphVertex& vertex);
   void computeRoutes(const GraphBasePtr& priv_graph);
   /** \brief Update the graph incrementally when no optimization is needed */
   bool updateIncrementally(const EdgePtr& e);
+  /** \brief Adds the new vertex to, connected to the known vertex from */
+  void addVertexIncrementally(const VertexId& from, const VertexId& to,
+                              const Transform& T_to_from);
+  /**
+   * \brief Relax the region affected by a new spatial edge only, publishing
+   * the changed vertices
+   * \return false if a complete update is needed instead
+   */
+  bool relaxIncrementally(const EdgePtr& e);
+  /** \brief Loop closed by a new edge from -> to, plus a margin around it */
+  VertexId::UnorderedSet getRelaxationRegion(const VertexId& from,
+                                             const VertexId& to) const;
 
   void updateRobotProjection();
 
  private:
   /** \brief Graph that generates the callbacks */
   GraphWeakPtr graph_;
+  /** \brief Privileged part of the graph, updated before the callbacks */
+  tactic::PrivilegedGraph::Ptr privileged_graph_;
 
   /** \brief Protects all class member accesses */
   mutable Mutex mutex_;
 
+  /** \brief Relax only the region affected by a new edge */
+  bool incremental_relaxation_ = true;
+  /** \brief Number of hops added around a closed loop when relaxing it */
+  int relaxation_margin_ = 20;
+  /** \brief Vertices relaxed incrementally since the end of the last run */
+  VertexId::UnorderedSet relaxed_vids_;
+  /** \brief Vertices added incrementally since the last complete update */
+  VertexId::UnorderedSet added_vids_;
+
   /** \brief Cached T_vertex_root transform */
   VertexId2TransformMap vid2tf_map_;
   /** \brief VertexId to its index in graph_state_.vertices */
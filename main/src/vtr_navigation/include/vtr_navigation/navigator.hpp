@@ -16,6 +16,8 @@
  * \file navigator.hpp
  * \author Yuchen Wu, Autonomous Space Robotics Lab (ASRL)
  */
+#include <queue>
+
 #include "rclcpp/rclcpp.hpp"
 
 #include "vtr_navigation/graph_map_server.hpp"
@@ -83,6 +85,7 @@ class Navigator {
 
   /// VTR building blocks
   GraphMapServer::Ptr graph_map_server_;
+  tactic::PrivilegedGraph::Ptr privileged_graph_;
   tactic::Graph::Ptr graph_;
   tactic::Tactic::Ptr tactic_;
   path_planning::PathPlannerInterface::Ptr path_planner_;
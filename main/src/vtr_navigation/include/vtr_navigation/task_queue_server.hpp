@@ -22,6 +22,7 @@
 
 #include "vtr_navigation_msgs/msg/task_queue_task.hpp"
 #include "vtr_navigation_msgs/msg/task_queue_update.hpp"
+#include "vtr_navigation_msgs/srv/latency_state.hpp"
 #include "vtr_navigation_msgs/srv/task_queue_state.hpp"
 
 #include "vtr_tactic/task_queue.hpp"
@@ -40,6 +41,7 @@ class TaskQueueServer : public tactic::TaskExecutor::Callback {
   using TaskQueueTask = vtr_navigation_msgs::msg::TaskQueueTask;
   using TaskQueueUpdate = vtr_navigation_msgs::msg::TaskQueueUpdate;
   using TaskQueueStateSrv = vtr_navigation_msgs::srv::TaskQueueState;
+  using LatencyStateSrv = vtr_navigation_msgs::srv::LatencyState;
 
   TaskQueueServer(const rclcpp::Node::SharedPtr& node);
 
@@ -51,6 +53,10 @@ class TaskQueueServer : public tactic::TaskExecutor::Callback {
   void taskQueueStateSrvCallback(
       const std::shared_ptr<TaskQueueStateSrv::Request>,
       std::shared_ptr<TaskQueueStateSrv::Response> response) const;
+  /** \brief Reports latency histograms, starts/stops the pipeline trace */
+  void latencyStateSrvCallback(
+      const std::shared_ptr<LatencyStateSrv::Request> request,
+      std::shared_ptr<LatencyStateSrv::Response> response) const;
 
  private:
   /** \brief Protects all class member accesses */
@@ -64,6 +70,8 @@ class TaskQueueServer : public tactic::TaskExecutor::Callback {
   rclcpp::Publisher<TaskQueueUpdate>::SharedPtr task_queue_update_pub_;
   /** \brief Service to request a relaxed version of the graph */
   rclcpp::Service<TaskQueueStateSrv>::SharedPtr task_queue_state_srv_;
+  /** \brief Service to query latencies of the pipeline */
+  rclcpp::Service<LatencyStateSrv>::SharedPtr latency_state_srv_;
 };
 
 }  // namespace navigation
@@ -18,6 +18,8 @@
  */
 #include "vtr_navigation/graph_map_server.hpp"
 
+#include <queue>
+
 #include "vtr_pose_graph/optimization/pose_graph_optimizer.hpp"
 #include "vtr_pose_graph/optimization/pose_graph_relaxation.hpp"
 
@@ -54,11 +56,28 @@ Eigen::Matrix4d fromLngLatTheta(const double lng, const double lat,
   T_map_root.topRightCorner<2, 1>() << res.uv.u, res.uv.v;
   return T_map_root;
 }
+
+void relax(pose_graph::PoseGraphOptimizer<tactic::GraphBase>& optimizer) {
+  // add pose graph relaxation factors
+  // default covariance to use
+  Eigen::Matrix<double, 6, 6> cov(Eigen::Matrix<double, 6, 6>::Identity());
+  cov.topLeftCorner<3, 3>() *= LINEAR_NOISE * LINEAR_NOISE;
+  cov.bottomRightCorner<3, 3>() *= ANGLE_NOISE * ANGLE_NOISE;
+  auto relaxation_factor =
+      std::make_shared<pose_graph::PoseGraphRelaxation<tactic::GraphBase>>(cov);
+  optimizer.addFactor(relaxation_factor);
+
+  // udpates the tf map
+  using SolverType = steam::DoglegGaussNewtonSolver;
+  optimizer.optimize<SolverType>();
+}
 }  // namespace
 
-void GraphMapServer::start(const rclcpp::Node::SharedPtr& node,
-                           const GraphPtr& graph) {
+void GraphMapServer::start(
+    const rclcpp::Node::SharedPtr& node, const GraphPtr& graph,
+    const tactic::PrivilegedGraph::Ptr& privileged_graph) {
   graph_ = graph;
+  privileged_graph_ = privileged_graph;
 
   // clang-format off
   /// Parameters: default to UTIAS campus, only for initialization
@@ -66,6 +85,8 @@ void GraphMapServer::start(const rclcpp::Node::SharedPtr& node,
   const auto lng = node->declare_parameter<double>("graph_projection.origin_lng", -79.466092);
   const auto theta = node->declare_parameter<double>("graph_projection.origin_theta", 0.);
   const auto scale = node->declare_parameter<double>("graph_projection.scale", 1.);
+  incremental_relaxation_ = node->declare_parameter<bool>("graph_relaxation.incremental", true);
+  relaxation_margin_ = node->declare_parameter<int>("graph_relaxation.margin", 20);
 
   /// Publishers and services
   callback_group_ = node->create_callback_group(rclcpp::CallbackGroupType::MutuallyExclusive);
@@ -277,7 +298,10 @@ void GraphMapServer::vertexAdded(const VertexPtr& v) {
 void GraphMapServer::edgeAdded(const EdgePtr& e) {
   UniqueLock lock(mutex_);
   if (updateIncrementally(e)) return;
+  if (incremental_relaxation_ && relaxIncrementally(e)) return;
   //
+  relaxed_vids_.clear();
+  added_vids_.clear();
   const auto priv_graph = getPrivilegedGraph();
   optimizeGraph(priv_graph);
   updateVertexProjection();
@@ -294,6 +318,33 @@ void GraphMapServer::endRun() {
   if (getGraph()->numberOfVertices() <= 1) return;
 
   const auto priv_graph = getPrivilegedGraph();
+  // the graph has been kept up to date, re-solve the loops closed in this run
+  // together and only refresh the routes
+  if (incremental_relaxation_ &&
+      priv_graph->numberOfVertices() == graph_state_.vertices.size()) {
+    if (!relaxed_vids_.empty()) {
+      optimizeGraph(priv_graph, relaxed_vids_);
+      for (const auto& vid : relaxed_vids_) {
+        auto& vertex = graph_state_.vertices[vid2idx_map_.at(vid)];
+        std::tie(vertex.lng, vertex.lat, vertex.theta) = project_vertex_(vid);
+      }
+      relaxed_vids_.clear();
+    }
+    // terrain types and names are final once the run has ended
+    for (const auto& vid : added_vids_) {
+      auto& vertex = graph_state_.vertices[vid2idx_map_.at(vid)];
+      updateVertexType(vertex);
+      updateVertexName(vertex);
+    }
+    added_vids_.clear();
+    computeRoutes(priv_graph);
+    //
+    graph_state_pub_->publish(graph_state_);
+    return;
+  }
+
+  relaxed_vids_.clear();
+  added_vids_.clear();
   optimizeGraph(priv_graph);
   updateVertexProjection();
   updateVertexType();
@@ -366,11 +417,8 @@ auto GraphMapServer::getGraph() const -> GraphPtr {
 }
 
 auto GraphMapServer::getPrivilegedGraph() const -> GraphBasePtr {
-  // get the current privileged graph
-  const auto graph = getGraph();
-  using PrivEval = tactic::PrivilegedEvaluator<tactic::GraphBase>;
-  auto priv_eval = std::make_shared<PrivEval>(*graph);
-  return graph->getSubgraph(priv_eval);
+  // cached until a privileged edge is added
+  return privileged_graph_->subgraph();
 }
 
 void GraphMapServer::optimizeGraph(const tactic::GraphBase::Ptr& priv_graph) {
@@ -379,19 +427,7 @@ void GraphMapServer::optimizeGraph(const tactic::GraphBase::Ptr& priv_graph) {
 
   pose_graph::PoseGraphOptimizer<tactic::GraphBase> optimizer(
       priv_graph, root_vid, vid2tf_map_);
-
-  // add pose graph relaxation factors
-  // default covariance to use
-  Eigen::Matrix<double, 6, 6> cov(Eigen::Matrix<double, 6, 6>::Identity());
-  cov.topLeftCorner<3, 3>() *= LINEAR_NOISE * LINEAR_NOISE;
-  cov.bottomRightCorner<3, 3>() *= ANGLE_NOISE * ANGLE_NOISE;
-  auto relaxation_factor =
-      std::make_shared<pose_graph::PoseGraphRelaxation<tactic::GraphBase>>(cov);
-  optimizer.addFactor(relaxation_factor);
-
-  // udpates the tf map
-  using SolverType = steam::DoglegGaussNewtonSolver;
-  optimizer.optimize<SolverType>();
+  relax(optimizer);
 
   // update the graph state vertices and idx map
   auto& vertices = graph_state_.vertices;
@@ -408,6 +444,16 @@ void GraphMapServer::optimizeGraph(const tactic::GraphBase::Ptr& priv_graph) {
   }
 }
 
+void GraphMapServer::optimizeGraph(const tactic::GraphBase::Ptr& priv_graph,
+                                   const VertexId::UnorderedSet& region) {
+  const auto map_info = getGraph()->getMapInfo();
+  const auto root_vid = VertexId(map_info.root_vid);
+
+  pose_graph::PoseGraphOptimizer<tactic::GraphBase> optimizer(
+      priv_graph, root_vid, region, vid2tf_map_);
+  relax(optimizer);
+}
+
 void GraphMapServer::updateVertexProjection() {
   const auto map_info = getGraph()->getMapInfo();
 
@@ -500,30 +546,32 @@ void GraphMapServer::updateVertexProjection() {
 }
 
 void GraphMapServer::updateVertexType() {
+  for (auto&& vertex : graph_state_.vertices) updateVertexType(vertex);
+}
+
+void GraphMapServer::updateVertexType(GraphVertex& vertex) {
   const auto graph = getGraph();
-  auto& vertices = graph_state_.vertices;
-  for (auto&& vertex : vertices) {
-    const auto env_info_msg =
-        graph->at(vertex.id)
-            ->retrieve<tactic::EnvInfo>("env_info",
-                                        "vtr_tactic_msgs/msg/EnvInfo");
-    vertex.type = env_info_msg->sharedLocked().get().getData().terrain_type;
-    graph->at(vertex.id)->SetTerrainType(vertex.type);
-    int vertex_type = vertex.type;
-    CLOG(DEBUG, "navigation.graph_map_server") << "Updating Graph Vertex Type: " << vertex_type;
-  }
+  const auto env_info_msg =
+      graph->at(vertex.id)
+          ->retrieve<tactic::EnvInfo>("env_info",
+                                      "vtr_tactic_msgs/msg/EnvInfo");
+  vertex.type = env_info_msg->sharedLocked().get().getData().terrain_type;
+  graph->at(vertex.id)->SetTerrainType(vertex.type);
+  int vertex_type = vertex.type;
+  CLOG(DEBUG, "navigation.graph_map_server") << "Updating Graph Vertex Type: " << vertex_type;
 }
 
 void GraphMapServer::updateVertexName() {
-  const auto graph = getGraph();
-  auto& vertices = graph_state_.vertices;
-  for (auto&& vertex : vertices) {
-    const auto waypoint_name_msg =
-        graph->at(VertexId(vertex.id))
-            ->retrieve<tactic::WaypointName>("waypoint_name",
-                                        "vtr_tactic_msgs/msg/WaypointName");
-    vertex.name = waypoint_name_msg->sharedLocked().get().getData().name;
-  }
+  for (auto&& vertex : graph_state_.vertices) updateVertexName(vertex);
+}
+
+void GraphMapServer::updateVertexName(GraphVertex& vertex) {
+  const auto waypoint_name_msg =
+      getGraph()
+          ->at(VertexId(vertex.id))
+          ->retrieve<tactic::WaypointName>("waypoint_name",
+                                           "vtr_tactic_msgs/msg/WaypointName");
+  vertex.name = waypoint_name_msg->sharedLocked().get().getData().name;
 }
 
 void GraphMapServer::computeRoutes(const tactic::GraphBase::Ptr& priv_graph) {
@@ -601,6 +649,15 @@ bool GraphMapServer::updateIncrementally(const EdgePtr& e) {
     throw std::runtime_error{ss.str()};
   }
 
+  addVertexIncrementally(from, to, T_to_from);
+
+  CLOG(DEBUG, "navigation.graph_map_server") << "Incremental update succeeded";
+  return true;
+}
+
+void GraphMapServer::addVertexIncrementally(const VertexId& from,
+                                            const VertexId& to,
+                                            const Transform& T_to_from) {
   // vid2tfmap update
   vid2tf_map_[to] = T_to_from * vid2tf_map_.at(from);
 
@@ -613,6 +670,8 @@ bool GraphMapServer::updateIncrementally(const EdgePtr& e) {
   vertex.id = to;
   vertex.neighbors.push_back(from);
   vid2idx_map_[to] = vertices.size() - 1;
+  added_vids_.insert(from);
+  added_vids_.insert(to);
 
   // projection
   const auto [lng, lat, theta] = project_vertex_(to);
@@ -666,10 +725,106 @@ bool GraphMapServer::updateIncrementally(const EdgePtr& e) {
   graph_update.vertex_from = vertices[vid2idx_map_.at(from)];
   graph_update.vertex_to = vertices[vid2idx_map_.at(to)];
   graph_update_pub_->publish(graph_update);
+}
 
-  CLOG(DEBUG, "navigation.graph_map_server") << "Incremental update succeeded";
+bool GraphMapServer::relaxIncrementally(const EdgePtr& e) {
+  if (!e->isSpatial()) return false;
+
+  const auto from = e->from();
+  const auto to = e->to();
+  const bool from_known = vid2tf_map_.count(from) != 0;
+  const bool to_known = vid2tf_map_.count(to) != 0;
+
+  // not connected to the main graph (trunk), same as temporal edges
+  if (!from_known && !to_known) {
+    CLOG(DEBUG, "navigation.graph_map_server")
+        << "Neither " << from << " nor " << to
+        << " is in vid2tf_map_, not updating the map.";
+    return true;
+  }
+  // a new branch, no loop is closed so no optimization is needed
+  if (!from_known || !to_known) {
+    if (from_known)
+      addVertexIncrementally(from, to, e->T());
+    else
+      addVertexIncrementally(to, from, e->T().inverse());
+    CLOG(DEBUG, "navigation.graph_map_server") << "Incremental update succeeded";
+    return true;
+  }
+
+  // a loop closure, relax the loop and its surroundings
+  const auto region = getRelaxationRegion(from, to);
+  if (region.empty()) return false;
+  // every vertex of the problem must be known and have a warm start
+  const auto priv_graph = getPrivilegedGraph();
+  for (const auto& vid : region) {
+    if (!priv_graph->contains(vid)) return false;
+    for (const auto& neighbor : priv_graph->neighbors(vid))
+      if (vid2idx_map_.count(neighbor) == 0) return false;
+  }
+
+  optimizeGraph(priv_graph, region);
+  relaxed_vids_.insert(region.begin(), region.end());
+
+  // graph_state_.vertices.<neighbors>
+  auto& vertices = graph_state_.vertices;
+  vertices[vid2idx_map_.at(from)].neighbors.push_back(to);
+  vertices[vid2idx_map_.at(to)].neighbors.push_back(from);
+
+  // projection, and publish the changed vertices only
+  GraphUpdate graph_update;
+  for (const auto& vid : region) {
+    auto& vertex = vertices[vid2idx_map_.at(vid)];
+    std::tie(vertex.lng, vertex.lat, vertex.theta) = project_vertex_(vid);
+    graph_update.vertices.push_back(vertex);
+  }
+  graph_update_pub_->publish(graph_update);
+  updateRobotProjection();
+
+  CLOG(DEBUG, "navigation.graph_map_server")
+      << "Incremental relaxation of " << region.size() << " out of "
+      << vertices.size() << " vertices succeeded";
   return true;
 }
 
+auto GraphMapServer::getRelaxationRegion(const VertexId& from,
+                                         const VertexId& to) const
+    -> VertexId::UnorderedSet {
+  const auto& vertices = graph_state_.vertices;
+  const auto neighbors = [&](const VertexId& vid) -> const auto& {
+    return vertices[vid2idx_map_.at(vid)].neighbors;
+  };
+
+  // shortest loop (in hops) closed by the new edge
+  std::unordered_map<VertexId, VertexId> parents{{from, from}};
+  std::queue<VertexId> queue;
+  queue.push(from);
+  while (!queue.empty() && parents.count(to) == 0) {
+    const auto curr = queue.front();
+    queue.pop();
+    for (const auto& neighbor : neighbors(curr))
+      if (parents.try_emplace(VertexId(neighbor), curr).second)
+        queue.push(VertexId(neighbor));
+  }
+  if (parents.count(to) == 0) return {};
+
+  VertexId::UnorderedSet region;
+  std::vector<VertexId> frontier;
+  for (auto vid = to; region.insert(vid).second; vid = parents.at(vid))
+    frontier.push_back(vid);
+
+  // plus a margin so that the correction is smoothed into the graph
+  for (int depth = 0; depth < relaxation_margin_ && !frontier.empty();
+       ++depth) {
+    std::vector<VertexId> next;
+    for (const auto& vid : frontier)
+      for (const auto& neighbor : neighbors(vid))
+        if (region.insert(VertexId(neighbor)).second)
+          next.push_back(VertexId(neighbor));
+    frontier.swap(next);
+  }
+  return region;
+}
+
 }  // namespace navigation
 }  // namespace vtr
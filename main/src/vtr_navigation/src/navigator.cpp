@@ -84,9 +84,25 @@ Navigator::Navigator(const rclcpp::Node::SharedPtr& node) : node_(node) {
 
   /// pose graph
   auto new_graph = node_->declare_parameter<bool>("start_new_graph", false);
+  // write-behind policy of data stream accessors, writes through by default
+  storage::DataStreamAccessorBase::WriteConfig write_config;
+  // clang-format off
+  write_config.max_pending_messages = node_->declare_parameter<int>("graph_write.max_pending_messages", (int)write_config.max_pending_messages);
+  write_config.max_pending_bytes = node_->declare_parameter<int>("graph_write.max_pending_bytes", (int)write_config.max_pending_bytes);
+  write_config.max_pending_time = std::chrono::milliseconds(node_->declare_parameter<int>("graph_write.max_pending_time_ms", (int)write_config.max_pending_time.count()));
+  // clang-format on
+  storage::DataStreamAccessorBase::setDefaultWriteConfig(write_config);
+  // the privileged graph is updated first, graph map server depends on it
+  privileged_graph_ = std::make_shared<tactic::PrivilegedGraph>();
+  using GraphCallbackList =
+      pose_graph::GraphCallbackList<tactic::Vertex, tactic::Edge>;
+  const auto graph_callbacks = std::make_shared<GraphCallbackList>(
+      std::vector<tactic::Graph::CallbackPtr>{privileged_graph_,
+                                              graph_map_server_});
   graph_ = tactic::Graph::MakeShared(data_dir + "/graph", !new_graph,
-                                     graph_map_server_);
-  graph_map_server_->start(node_, graph_);
+                                     graph_callbacks);
+  privileged_graph_->initialize(graph_);
+  graph_map_server_->start(node_, graph_, privileged_graph_);
 
   /// tactic
   auto pipeline_factory = std::make_shared<ROSPipelineFactory>(node_);
@@ -105,7 +121,7 @@ Navigator::Navigator(const rclcpp::Node::SharedPtr& node) : node_(node) {
                            std::make_shared<CommandPublisher>(node_));
 
   /// route planner
-  route_planner_ = std::make_shared<BFSPlanner>(graph_);
+  route_planner_ = std::make_shared<BFSPlanner>(privileged_graph_);
 
   /// mission server
   mission_server_ = std::make_shared<ROSMissionServer>();
@@ -171,6 +187,7 @@ Navigator::~Navigator() {
   path_planner_.reset();
   tactic_.reset();
   graph_.reset();
+  privileged_graph_.reset();
   graph_map_server_.reset();
 
   CLOG(INFO, "navigation") << "VT&R3 destruction done! Bye-bye.";
@@ -224,8 +241,12 @@ void Navigator::lidarCallback(
 
   CLOG(DEBUG, "navigation") << "Received a lidar pointcloud with stamp " << timestamp;
 
-  // Convert message to query_data format and store into query_data
-  auto query_data = std::make_shared<lidar::LidarQueryCache>();
+  // Convert message to query_data format and store into query_data, recycled
+  // from the pipeline if possible
+  auto query_data = std::dynamic_pointer_cast<lidar::LidarQueryCache>(
+      tactic_->createQueryCache());
+  if (query_data == nullptr)
+    query_data = std::make_shared<lidar::LidarQueryCache>();
 
   LockGuard lock(mutex_);
 
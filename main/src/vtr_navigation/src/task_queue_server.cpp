@@ -18,6 +18,8 @@
  */
 #include "vtr_navigation/task_queue_server.hpp"
 
+#include "vtr_tactic/instrumentation.hpp"
+
 namespace vtr {
 namespace navigation {
 
@@ -28,6 +30,7 @@ TaskQueueServer::TaskQueueServer(const rclcpp::Node::SharedPtr& node) {
   //
   task_queue_update_pub_ = node->create_publisher<TaskQueueUpdate>("task_queue_update", 100);
   task_queue_state_srv_ = node->create_service<TaskQueueStateSrv>("task_queue_state_srv", std::bind(&TaskQueueServer::taskQueueStateSrvCallback, this, std::placeholders::_1, std::placeholders::_2), rmw_qos_profile_services_default, callback_group_);
+  latency_state_srv_ = node->create_service<LatencyStateSrv>("latency_state_srv", std::bind(&TaskQueueServer::latencyStateSrvCallback, this, std::placeholders::_1, std::placeholders::_2), rmw_qos_profile_services_default, callback_group_);
   // clang-format on
 }
 
@@ -69,5 +72,40 @@ void TaskQueueServer::taskQueueStateSrvCallback(
   for (const auto& task : id2task_map_) tasks.push_back(task.second);
 }
 
+void TaskQueueServer::latencyStateSrvCallback(
+    const std::shared_ptr<LatencyStateSrv::Request> request,
+    std::shared_ptr<LatencyStateSrv::Response> response) const {
+  CLOG(DEBUG, "navigation.task_queue_server")
+      << "Received latency state request";
+  auto& registry = tactic::LatencyRegistry::instance();
+  for (const auto& [name, summary] : registry.summaries()) {
+    vtr_navigation_msgs::msg::LatencyStats stats;
+    stats.name = name;
+    stats.count = summary.count;
+    stats.mean_ms = summary.mean_ms;
+    stats.p50_ms = summary.p50_ms;
+    stats.p90_ms = summary.p90_ms;
+    stats.p99_ms = summary.p99_ms;
+    stats.max_ms = summary.max_ms;
+    response->stats.push_back(stats);
+  }
+  if (request->reset) registry.reset();
+
+  auto& recorder = tactic::TraceRecorder::instance();
+  if (request->trace == LatencyStateSrv::Request::TRACE_START) {
+    recorder.start();
+  } else if (request->trace == LatencyStateSrv::Request::TRACE_STOP) {
+    recorder.stop();
+    if (!request->trace_file.empty()) {
+      try {
+        recorder.write(request->trace_file);
+      } catch (const std::runtime_error&) {
+        // already logged, the latencies are still reported
+      }
+    }
+  }
+  response->trace_enabled = recorder.enabled();
+}
+
 }  // namespace navigation
 }  // namespace vtr
\ No newline at end of file
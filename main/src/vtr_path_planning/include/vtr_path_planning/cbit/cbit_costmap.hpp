@@ -19,23 +19,21 @@
 
 // This header defines a temporal costmap class which will be updated by the current ros occupancy grid in the vtr_lidar package.
 
-#include <unordered_map>
 #include <memory>
 
+#include "vtr_tactic/obstacle_grid.hpp"
 #include "vtr_tactic/tactic.hpp"
-#include "vtr_common/utils/hash.hpp"  // for std::pair hash
 
 #pragma once
 
 class CBITCostmap {
     public:
-        // The actual costmap is an unordered map of (x,y) coordinate keys corresponding to the occupancy grid value of that cell
-        //std::unique_ptr<std::unordered_map<std::pair<float, float>, float>> obs_map_ptr;
-        // Costmap in the costmap frame
-        std::unordered_map<std::pair<float, float>, float> obs_map;
+        // The actual costmap is a dense grid of occupancy values shared with the obstacle detection pipeline (never modified)
+        // Costmap in the costmap frame, replaced with std::atomic_store as the planner thread reads it concurrently
+        vtr::tactic::ObstacleGrid::ConstPtr obs_map;
 
         // For storing a history of the costmaps for temporal filtering
-        std::vector<std::unordered_map<std::pair<float, float>, float>> obs_map_vect;
+        std::vector<vtr::tactic::ObstacleGrid::ConstPtr> obs_map_vect;
 
         //std::unique_ptr<vtr::tactic::EdgeTransform> T_r_costmap_ptr;
         // We also want to store a pointer to the current transform from the robot to the costmap
@@ -60,7 +60,7 @@ class CBITPlanner {
         double sample_box_width;
         double dynamic_window_width;
         Tree tree;
-        std::vector<std::shared_ptr<Node>> samples;
+        NodeSet samples;
 
         // Repair mode variables
         bool repair_mode = false; // Flag for whether or not we should resume the planner in repair mode to update the tree following a state update
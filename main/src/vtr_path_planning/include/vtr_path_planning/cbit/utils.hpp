@@ -19,12 +19,14 @@
 
 // Contains some useful helper functions and classes for the cbit planner
 
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <tuple>
 #include <cmath>
 #include <iostream>
 #include <map>
+#include <unordered_map>
 
 #pragma once
 
@@ -86,14 +88,161 @@ class Node {
 };
 
 
+// Vector of nodes with O(1) membership/removal and a uniform grid index over (p,q) for radius searches
+// Nodes must not move in (p,q) while they are in the set
+class NodeSet {
+    public:
+        using NodePtr = std::shared_ptr<Node>;
+
+        NodeSet(double cell_size = 1.0) : cell_size{cell_size} {}
+
+        // Cell size of the grid index, best set to the typical search radius (rebuilds the index)
+        void set_cell_size(double new_cell_size);
+
+        size_t size() const { return nodes.size(); }
+        bool empty() const { return nodes.empty(); }
+        const NodePtr& operator[](size_t i) const { return nodes[i]; }
+        std::vector<NodePtr>::const_iterator begin() const { return nodes.begin(); }
+        std::vector<NodePtr>::const_iterator end() const { return nodes.end(); }
+        void reserve(size_t n);
+        void clear();
+
+        bool contains(const NodePtr& node) const { return index.count(node.get()) > 0; }
+        // Adds a node at the back, returns false (and does nothing) if the node is already in the set
+        bool push_back(const NodePtr& node);
+        // Removes a node by swapping it with the back, returns false if the node is not in the set
+        bool erase(const NodePtr& node);
+
+        // Removes all nodes satisfying pred in place, keeping the order of the remaining nodes
+        template <typename Pred>
+        size_t erase_if(Pred pred)
+        {
+            size_t kept = 0;
+            for (size_t i = 0; i < nodes.size(); i++)
+            {
+                if (pred(nodes[i]))
+                {
+                    index.erase(nodes[i].get());
+                    remove_from_cell(nodes[i]);
+                    continue;
+                }
+                if (kept != i)
+                {
+                    nodes[kept] = std::move(nodes[i]);
+                    index[nodes[kept].get()] = kept;
+                }
+                kept++;
+            }
+            size_t removed = nodes.size() - kept;
+            nodes.resize(kept);
+            return removed;
+        }
+
+        // Calls op(node) for every node within radius of center (inclusive), in no particular order
+        template <typename Op>
+        void for_each_in_radius(const Node& center, double radius, Op op) const
+        {
+            int min_p = cell_of(center.p - radius), max_p = cell_of(center.p + radius);
+            int min_q = cell_of(center.q - radius), max_q = cell_of(center.q + radius);
+            for (int cp = min_p; cp <= max_p; cp++)
+            {
+                for (int cq = min_q; cq <= max_q; cq++)
+                {
+                    auto cell = cells.find(cell_key(cp, cq));
+                    if (cell == cells.end())
+                    {
+                        continue;
+                    }
+                    for (const auto& node : cell->second)
+                    {
+                        double dp = node->p - center.p;
+                        double dq = node->q - center.q;
+                        if (sqrt((dp * dp) + (dq * dq)) <= radius)
+                        {
+                            op(node);
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        int cell_of(double x) const { return static_cast<int>(std::floor(x / cell_size)); }
+        static uint64_t cell_key(int cp, int cq) { return (static_cast<uint64_t>(static_cast<uint32_t>(cp)) << 32) | static_cast<uint32_t>(cq); }
+        void remove_from_cell(const NodePtr& node);
+
+        double cell_size;
+        std::vector<NodePtr> nodes;
+        std::unordered_map<const Node*, size_t> index; // position in nodes
+        std::unordered_map<uint64_t, std::vector<NodePtr>> cells;
+};
+
+
+// Vector of (parent, child) edges with O(1) membership test and removal by child
+// Edges are unique, adding an edge that is already in the set does nothing
+class EdgeSet {
+    public:
+        using Edge = std::tuple<std::shared_ptr<Node>, std::shared_ptr<Node>>;
+
+        size_t size() const { return edges.size(); }
+        bool empty() const { return edges.empty(); }
+        const Edge& operator[](size_t i) const { return edges[i]; }
+        std::vector<Edge>::const_iterator begin() const { return edges.begin(); }
+        std::vector<Edge>::const_iterator end() const { return edges.end(); }
+        void reserve(size_t n);
+        void clear();
+
+        bool contains(const std::shared_ptr<Node>& v, const std::shared_ptr<Node>& x) const;
+        bool push_back(const Edge& edge);
+        // Removes all edges ending at x, returns the number of edges removed
+        size_t erase_child(const std::shared_ptr<Node>& x);
+
+        // Removes all edges satisfying pred in place, keeping the order of the remaining edges
+        template <typename Pred>
+        size_t erase_if(Pred pred)
+        {
+            size_t kept = 0;
+            for (size_t i = 0; i < edges.size(); i++)
+            {
+                if (pred(edges[i]))
+                {
+                    unlink(edges[i]);
+                    continue;
+                }
+                if (kept != i)
+                {
+                    edges[kept] = std::move(edges[i]);
+                    index[key(edges[kept])] = kept;
+                }
+                kept++;
+            }
+            size_t removed = edges.size() - kept;
+            edges.resize(kept);
+            return removed;
+        }
+
+    private:
+        using Key = std::pair<const Node*, const Node*>;
+        struct KeyHash {
+            size_t operator()(const Key& k) const { return std::hash<const Node*>()(k.first) * 31 + std::hash<const Node*>()(k.second); }
+        };
+        static Key key(const Edge& edge) { return Key(std::get<0>(edge).get(), std::get<1>(edge).get()); }
+        void unlink(const Edge& edge);
+
+        std::vector<Edge> edges;
+        std::unordered_map<Key, size_t, KeyHash> index; // position in edges
+        std::unordered_map<const Node*, std::vector<const Node*>> parents; // parents of each child
+};
+
+
 // Class for storing the tree in unordered sets
 class Tree {
     public:
-        std::vector<std::shared_ptr<Node>> V;
-        std::vector<std::shared_ptr<Node>> V_Old;
+        NodeSet V;
+        NodeSet V_Old;
         std::vector<std::shared_ptr<Node>> V_Repair_Backup;
-        std::vector<std::tuple<std::shared_ptr<Node>, std::shared_ptr<Node>>>  E;
-        std::vector<std::tuple<std::shared_ptr<Node>, std::shared_ptr<Node>>>  E_Old;
+        EdgeSet E;
+        EdgeSet E_Old;
         std::vector<std::shared_ptr<Node>> QV; // using shared pointers
         std::multimap<double, std::shared_ptr<Node>> QV2;
         std::vector<std::tuple<std::shared_ptr<Node>, std::shared_ptr<Node>>> QE;
@@ -28,7 +28,7 @@ namespace path_planning {
 
 namespace {
 // Function for converting Transformation matrices into se(2) [x, y, z, roll, pitch, yaw]
-inline std::tuple<double, double, double, double, double, double> T2xyzrpy(const tactic::EdgeTransform& T) 
+inline std::tuple<double, double, double, double, double, double> T2xyzrpy(const lgmath::se3::Transformation& T) 
 {
   const auto Tm = T.matrix();
   return std::make_tuple(Tm(0, 3), Tm(1, 3), Tm(2,3), std::atan2(Tm(2, 1), Tm(2, 2)), std::atan2(-1*Tm(2, 0), sqrt(pow(Tm(2, 1),2) + pow(Tm(2, 2),2))), std::atan2(Tm(1, 0), Tm(0, 0)));
@@ -241,7 +241,7 @@ void CBIT::initializeRoute(RobotState& robot_state) {
   {
   }
 
-  lgmath::se3::TransformationWithCovariance teach_frame;
+  lgmath::se3::Transformation teach_frame;
   std::tuple<double, double, double, double, double, double> se3_vector;
   Pose se3_pose;
   std::vector<Pose> euclid_path_vec; // Store the se3 frames w.r.t the initial world frame into a path vector
@@ -249,7 +249,7 @@ void CBIT::initializeRoute(RobotState& robot_state) {
   // Loop through all frames in the teach path, convert to euclidean coords w.r.t the first frame and store it in a cbit Path class (vector of se(3) poses)
   for (size_t i = 0; i < chain.size(); i++)
   {
-    teach_frame = chain.pose(i);
+    teach_frame = chain.T_start(i);
     se3_vector = T2xyzrpy(teach_frame);
     se3_pose = Pose(std::get<0>(se3_vector), std::get<1>(se3_vector), std::get<2>(se3_vector), std::get<3>(se3_vector), std::get<4>(se3_vector), std::get<5>(se3_vector));
     euclid_path_vec.push_back(se3_pose);
@@ -344,35 +344,44 @@ auto CBIT::computeCommand(RobotState& robot_state) -> Command {
   if ((prev_stamp != stamp) && (obstacle_avoidance == true))
   {
     
-    std::lock_guard<std::mutex> lock(robot_state.obsMapMutex);
-    // Read or use output.obs_map safely
-    auto obs_map = robot_state.obs_map;
-    const auto costmap_sid = robot_state.costmap_sid;
-    const auto T_start_vertex = chain.pose(costmap_sid);
-    costmap_ptr->grid_resolution = robot_state.grid_resolution;
-  
-    CLOG(DEBUG, "cbit.obstacle_filtering") << "The size of the map is: " << obs_map.size();
-
-    // Updating the costmap pointer
-    CLOG(DEBUG, "cbit.obstacle_filtering") << "Updating Costmap SID to: " << costmap_sid;
-    costmap_ptr->obs_map = obs_map;
-    // Store the transform T_c_w (from costmap to world)
-    costmap_ptr->T_c_w = T_start_vertex.inverse(); // note that T_start_vertex is T_w_c if we want to bring keypoints to the world frame
-    // Store the grid resoltuion
-    CLOG(DEBUG, "cbit.obstacle_filtering") << "The costmap to world transform is: " << T_start_vertex.inverse();
-
-    // Storing sequences of costmaps for temporal filtering purposes
-    // For the first x iterations, fill the obstacle vector
-    if (costmap_ptr->obs_map_vect.size() < config_->costmap_history)
+    // Take a snapshot of the latest costmap, the grid itself is never modified so only the pointer is copied under the lock
+    tactic::ObstacleGrid::ConstPtr obs_map;
+    unsigned costmap_sid;
     {
-      costmap_ptr->obs_map_vect.push_back(obs_map);
-      costmap_ptr->T_c_w_vect.push_back(costmap_ptr->T_c_w);
+      std::lock_guard<std::mutex> lock(robot_state.obsMapMutex);
+      obs_map = robot_state.obs_map;
+      costmap_sid = robot_state.costmap_sid;
+      costmap_ptr->grid_resolution = robot_state.grid_resolution;
     }
-    // After that point, we then do a sliding window using shift operations, moving out the oldest map and appending the newest one
-    else
+
+    // Nothing to update until the first costmap has been published
+    if (obs_map != nullptr)
     {
-      costmap_ptr->obs_map_vect[config_->costmap_history-1] = obs_map;
-      costmap_ptr->T_c_w_vect[config_->costmap_history-1] = costmap_ptr->T_c_w ;
+      const auto T_start_vertex = chain.pose(costmap_sid);
+
+      CLOG(DEBUG, "cbit.obstacle_filtering") << "The size of the map is: " << obs_map->size();
+
+      // Updating the costmap pointer
+      CLOG(DEBUG, "cbit.obstacle_filtering") << "Updating Costmap SID to: " << costmap_sid;
+      std::atomic_store(&costmap_ptr->obs_map, obs_map);
+      // Store the transform T_c_w (from costmap to world)
+      costmap_ptr->T_c_w = T_start_vertex.inverse(); // note that T_start_vertex is T_w_c if we want to bring keypoints to the world frame
+      // Store the grid resoltuion
+      CLOG(DEBUG, "cbit.obstacle_filtering") << "The costmap to world transform is: " << T_start_vertex.inverse();
+
+      // Storing sequences of costmaps for temporal filtering purposes
+      // For the first x iterations, fill the obstacle vector
+      if (costmap_ptr->obs_map_vect.size() < config_->costmap_history)
+      {
+        costmap_ptr->obs_map_vect.push_back(obs_map);
+        costmap_ptr->T_c_w_vect.push_back(costmap_ptr->T_c_w);
+      }
+      // After that point, we then do a sliding window using shift operations, moving out the oldest map and appending the newest one
+      else
+      {
+        costmap_ptr->obs_map_vect[config_->costmap_history-1] = obs_map;
+        costmap_ptr->T_c_w_vect[config_->costmap_history-1] = costmap_ptr->T_c_w ;
+      }
     }
   }
   prev_stamp = stamp;
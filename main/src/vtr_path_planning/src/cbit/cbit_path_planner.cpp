@@ -88,6 +88,10 @@ void CBITPlanner::InitializePlanningSpace()
   tree.V.reserve(10000);
   tree.V_Old.reserve(10000);
   tree.E.reserve(10000);
+
+  // Vertices and samples are searched within the expansion radius, use it as the grid size of their spatial index
+  tree.V.set_cell_size(conf.initial_exp_rad);
+  samples.set_cell_size(conf.initial_exp_rad);
   //tree.QV.reserve(10000);
   //tree.QE.reserve(10000);
 
@@ -229,17 +233,11 @@ void CBITPlanner::Planning(vtr::path_planning::BasePathPlanner::RobotState& robo
         tree.QE2.clear();
 
        // Alternative: Take all points in a radius of 2.0m around the new robot state (only if they are a ahead though)
-        double sample_dist;
-        for (int i = 0; i < tree.V.size(); i++)
+        // TODO: replace magic number with a param, represents radius to search for state update rewires
+        tree.V.for_each_in_radius(*p_goal, 5.0, [&](const std::shared_ptr<Node>& vertex)
         {
-          //tree.QV2.insert(std::pair<double, std::shared_ptr<Node>>((tree.V[i]->g_T_weighted + h_estimated_admissible(*tree.V[i], *p_goal)), tree.V[i]));
-          sample_dist = calc_dist(*(tree.V[i]), *p_goal);
-          //if ((sample_dist <= 5.0) && ((tree.V[i])->p > (p_goal->p + (conf.initial_exp_rad/2)))) // TODO: replace magic number with a param, represents radius to search for state update rewires
-          if (sample_dist <= 5.0) // TODO: replace magic number with a param, represents radius to search for state update rewires
-          {
-            tree.QV2.insert(std::pair<double, std::shared_ptr<Node>>((tree.V[i]->g_T_weighted + h_estimated_admissible(*tree.V[i], *p_goal)), tree.V[i]));
-          }
-        }
+          tree.QV2.insert(std::pair<double, std::shared_ptr<Node>>((vertex->g_T_weighted + h_estimated_admissible(*vertex, *p_goal)), vertex));
+        });
 
         CLOG(INFO, "cbit_planner.path_planning") << "Robot State Updated Successfully, p: " << p_goal->p << " q: " << p_goal->q;
         CLOG(INFO, "cbit_planner.path_planning") << "QV size: " << tree.QV2.size();
@@ -343,30 +341,16 @@ void CBITPlanner::Planning(vtr::path_planning::BasePathPlanner::RobotState& robo
           CLOG(WARNING, "cbit_planner.path_planning") << "Collision Free Vertex is - p: " << col_free_vertex->p << " q: " << col_free_vertex->q;
 
           // Vertex Prune (maintain only vertices to the right of the collision free vertex)
-          std::vector<std::shared_ptr<Node>> pruned_vertex_tree;
-          pruned_vertex_tree.reserve(tree.V.size());
-          for (int i =0; i<tree.V.size(); i++)
+          tree.V.erase_if([&](const std::shared_ptr<Node>& vertex)
           {
-            if (tree.V[i]->p >= col_free_vertex->p)
-            {
-              pruned_vertex_tree.push_back(tree.V[i]);
-            }
-          }
-          tree.V = pruned_vertex_tree;
-
+            return !(vertex->p >= col_free_vertex->p);
+          });
 
           // Edge Prune (maintain only edges to the right of the collision free vertex)
-          std::vector<std::tuple<std::shared_ptr<Node>, std::shared_ptr<Node>>>  pruned_edge_tree;
-          pruned_edge_tree.reserve(tree.E.size());
-          for (int i = 0; i <tree.E.size(); i++)
+          tree.E.erase_if([&](const EdgeSet::Edge& edge)
           {
-            if (std::get<1>(tree.E[i])->p >= col_free_vertex->p)
-            {
-              pruned_edge_tree.push_back(tree.E[i]);
-            }
-          }
-  
-          tree.E = pruned_edge_tree;
+            return !(std::get<1>(edge)->p >= col_free_vertex->p);
+          });
 
           // Reset the goal, and add it to the samples
           p_goal->parent = nullptr;
@@ -417,30 +401,27 @@ void CBITPlanner::Planning(vtr::path_planning::BasePathPlanner::RobotState& robo
       if (p_goal->g_T_weighted < INFINITY)
       {
         std::vector<std::shared_ptr<Node>> new_samples = SampleBox(m);
-        samples.insert(samples.end(), new_samples.begin(), new_samples.end());
+        for (const auto& new_sample : new_samples)
+        {
+          samples.push_back(new_sample);
+        }
         CLOG(INFO, "cbit_planner.path_planning") << "Sampling Box";
       }
       
       else
       {
         std::vector<std::shared_ptr<Node>> new_samples = SampleFreeSpace(m);
-        samples.insert(samples.end(), new_samples.begin(), new_samples.end());
+        for (const auto& new_sample : new_samples)
+        {
+          samples.push_back(new_sample);
+        }
         CLOG(INFO, "cbit_planner.path_planning") << "Sample Free Space";
       }
 
     
       // Backup the old tree:
-      tree.V_Old.clear();
-      tree.E_Old.clear();
-      for (int i = 0; i < tree.V.size(); i++)
-      {
-        tree.V_Old.push_back((tree.V[i]));
-      }
-
-      for (int i = 0; i < tree.E.size(); i++)
-      {
-        tree.E_Old.push_back(tree.E[i]);
-      }
+      tree.V_Old = tree.V;
+      tree.E_Old = tree.E;
 
       // Initialize the Vertex Queue with all nearby vertices in the tree;
       std::random_device rd;     // Only used once to initialise (seed) engine
@@ -527,22 +508,8 @@ void CBITPlanner::Planning(vtr::path_planning::BasePathPlanner::RobotState& robo
           // Check if xm is in the tree, if it is, we need to do some rewiring of any other edge which has xm as an endpoint
           if (node_in_tree_v2(xm) == true)
           {
-            // loop through edges, delete those which have the same xm end node
-            int upper_edge_index = tree.E.size();
-            for (int i = 0; i < upper_edge_index; i++)
-            {
-              if (std::get<1>(tree.E[i]) == xm) // changed to equating pointer addresses
-              {
-                  // Once we process the vertex and have it ready to return, remove it from the edge queue (This is a fast way of doing so)
-                  auto it = tree.E.begin() + i; 
-                  *it = std::move(tree.E.back());
-                  tree.E.pop_back();
-
-                  // NEED TO BE VERY CAREFUL WITH THE INDEX HERE, ANYTIME WE DO A DELETION WE NEED TO DECREMENT, AS WELL AS ADJUST THE UPPER ITERATOR SIZE
-                  i = i - 1;
-                  upper_edge_index = upper_edge_index - 1;
-              }
-            }
+            // delete the edges which have the same xm end node
+            tree.E.erase_child(xm);
 
             // Set cost to comes
             xm->g_T_weighted = vm->g_T_weighted + weighted_cost;
@@ -555,17 +522,7 @@ void CBITPlanner::Planning(vtr::path_planning::BasePathPlanner::RobotState& robo
           {
             // If the end point is not in the tree, it must have come from a random sample.
             // Remove it from the samples, add it to the vertex tree and vertex queue:
-            for (int i = 0; i < samples.size(); i++)
-            {
-              if (samples[i] == xm)
-              {
-                auto it = samples.begin() + i;
-                *it = std::move(samples.back());
-                samples.pop_back();
-
-                break; // Once we find the one to delete, it is safe to break, there should only every be one
-              }
-            }
+            samples.erase(xm);
             // Set cost to comes
             xm->g_T_weighted = vm->g_T_weighted + weighted_cost;
             xm->g_T = vm->g_T + actual_cost;
@@ -766,48 +723,28 @@ void CBITPlanner::Prune(double c_best, double c_best_weighted)
   }
 
   // Using the cost threshold, prune the samples (weighted eyeball prune)
-  // I think for vectors, its probably faster to just copy the samples to a new pointer vector which do satisfy the constraint,
-  // Then overwrite the samples, instead of doing many many deletions
-  std::vector<std::shared_ptr<Node>> samples_pruned;
-  for (int i = 0; i < samples.size(); i++)
+  // The samples, vertices and edges are pruned in place, so that their spatial and edge indices are only updated for removed entries
+  samples.erase_if([&](const std::shared_ptr<Node>& sample)
   {
-    if (f_estimated(*samples[i], *p_start, *p_goal, conf.alpha) < cost_threshold)// Also handles inf flagged values
-    {
-      samples_pruned.push_back(std::shared_ptr<Node> (samples[i]));
-    }
-  }
+    return !(f_estimated(*sample, *p_start, *p_goal, conf.alpha) < cost_threshold); // Also handles inf flagged values
+  });
 
   // We also check the tree and add samples for unconnected vertices back to the sample set
-  std::vector<std::shared_ptr<Node>> vertex_pruned;
-  int vertices_size = tree.V.size(); 
-  for (int i = 0; i < vertices_size; i++)
+  tree.V.erase_if([&](const std::shared_ptr<Node>& vertex)
   {
-    if (tree.V[i]->g_T_weighted == INFINITY)
+    if (vertex->g_T_weighted == INFINITY)
     {
-      samples_pruned.push_back(std::shared_ptr<Node> (tree.V[i]));
+      samples.push_back(vertex);
     }
-    if ((f_estimated(*tree.V[i], *p_start, *p_goal, conf.alpha) <= cost_threshold) && (tree.V[i]->g_T_weighted < INFINITY))
-    {
-      
-      vertex_pruned.push_back(std::shared_ptr<Node> (tree.V[i]));
-    }
-  }
-  // After we do both the above loops update the sample vector
-  samples = samples_pruned;
-  tree.V = vertex_pruned;
-
+    return !((f_estimated(*vertex, *p_start, *p_goal, conf.alpha) <= cost_threshold) && (vertex->g_T_weighted < INFINITY));
+  });
 
   // Similar Prune of the Edges
-  std::vector<std::tuple<std::shared_ptr<Node>, std::shared_ptr<Node>>>  edge_pruned;
-  for (int i = 0; i <tree.E.size(); i++)
+  tree.E.erase_if([&](const EdgeSet::Edge& edge)
   {
     // In the below condition, I also include the prune of vertices with inf cost to come values
-    if ((f_estimated(*std::get<0>(tree.E[i]), *p_start, *p_goal, conf.alpha) <= cost_threshold) && (f_estimated(*std::get<1>(tree.E[i]), *p_start, *p_goal, conf.alpha) <= cost_threshold))
-    {
-      edge_pruned.push_back(std::tuple<std::shared_ptr<Node>, std::shared_ptr<Node>> (tree.E[i]));
-    }
-  }
-  tree.E = edge_pruned;
+    return !((f_estimated(*std::get<0>(edge), *p_start, *p_goal, conf.alpha) <= cost_threshold) && (f_estimated(*std::get<1>(edge), *p_start, *p_goal, conf.alpha) <= cost_threshold));
+  });
 }
 
 
@@ -1005,32 +942,32 @@ void CBITPlanner::ExpandVertex(std::shared_ptr<Node> v)
 {
   // Note its easier in c++ to remove the vertex from the queue in the bestinvertexqueue function instead
   // Find nearby samples and filter by heuristic potential
-  for (int i = 0; i < samples.size(); i++)
+  samples.for_each_in_radius(*v, conf.initial_exp_rad, [&](const std::shared_ptr<Node>& sample)
   {
-    if ((calc_dist(*samples[i], *v) <= conf.initial_exp_rad) && ((g_estimated_admissible(*v, *p_start) + calc_weighted_dist(*v, *samples[i], conf.alpha) + h_estimated_admissible(*samples[i], *p_goal)) <= p_goal->g_T_weighted))
+    if ((g_estimated_admissible(*v, *p_start) + calc_weighted_dist(*v, *sample, conf.alpha) + h_estimated_admissible(*sample, *p_goal)) <= p_goal->g_T_weighted)
     {
-      samples[i]->g_T = INFINITY;
-      samples[i]->g_T_weighted = INFINITY;
+      sample->g_T = INFINITY;
+      sample->g_T_weighted = INFINITY;
 
       // direct method
-      tree.QE2.insert(std::pair<double, std::tuple<std::shared_ptr<Node>, std::shared_ptr<Node>>>((v->g_T_weighted + calc_weighted_dist(*v,*samples[i],conf.alpha) + h_estimated_admissible(*samples[i], *p_goal)), std::tuple<std::shared_ptr<Node>, std::shared_ptr<Node>> {(v), (samples[i])}));
+      tree.QE2.insert(std::pair<double, std::tuple<std::shared_ptr<Node>, std::shared_ptr<Node>>>((v->g_T_weighted + calc_weighted_dist(*v,*sample,conf.alpha) + h_estimated_admissible(*sample, *p_goal)), std::tuple<std::shared_ptr<Node>, std::shared_ptr<Node>> {(v), (sample)}));
 
     }
-  }  
+  });
 
   // find nearby vertices and filter by heuristic potential
-  for (int i = 0; i < tree.V.size(); i++)
+  tree.V.for_each_in_radius(*v, conf.initial_exp_rad, [&](const std::shared_ptr<Node>& vertex)
   {
-    if ((calc_dist(*tree.V[i], *v) <= conf.initial_exp_rad) && ((g_estimated_admissible(*v, *p_start) + calc_weighted_dist(*v, *tree.V[i], conf.alpha) + h_estimated_admissible(*tree.V[i], *p_goal)) < p_goal->g_T_weighted) && ((v->g_T_weighted + calc_weighted_dist(*v, *tree.V[i], conf.alpha)) < tree.V[i]->g_T_weighted))
+    if (((g_estimated_admissible(*v, *p_start) + calc_weighted_dist(*v, *vertex, conf.alpha) + h_estimated_admissible(*vertex, *p_goal)) < p_goal->g_T_weighted) && ((v->g_T_weighted + calc_weighted_dist(*v, *vertex, conf.alpha)) < vertex->g_T_weighted))
     {
-      if (edge_in_tree_v2(v, tree.V[i]) == false)
+      if (edge_in_tree_v2(v, vertex) == false)
       {
         // If all conditions satisfied, add the edge to the queue
-        tree.QE2.insert(std::pair<double, std::tuple<std::shared_ptr<Node>, std::shared_ptr<Node>>>((v->g_T_weighted + calc_weighted_dist(*v,*tree.V[i],conf.alpha) + h_estimated_admissible(*tree.V[i], *p_goal)), std::tuple<std::shared_ptr<Node>, std::shared_ptr<Node>> {(v), (tree.V[i])}));
+        tree.QE2.insert(std::pair<double, std::tuple<std::shared_ptr<Node>, std::shared_ptr<Node>>>((v->g_T_weighted + calc_weighted_dist(*v,*vertex,conf.alpha) + h_estimated_admissible(*vertex, *p_goal)), std::tuple<std::shared_ptr<Node>, std::shared_ptr<Node>> {(v), (vertex)}));
 
       }
-    } 
-  }
+    }
+  });
 }
 
 
@@ -1219,16 +1156,8 @@ std::shared_ptr<Node> CBITPlanner::col_check_path_v2(double max_lookahead_p)
 // This version uses address matching (safer)
 bool CBITPlanner::edge_in_tree_v2(std::shared_ptr<Node> v, std::shared_ptr<Node> x)
 {
-  int edges_size = tree.E.size();
-  for (int i = 0; i < edges_size; i++ )
-  {
-    // Alternative way to do this using node addresses
-    if ((std::get<0>(tree.E[i]) == v) && (std::get<1>(tree.E[i]) == x))
-    {
-      return true;
-    }
-  }
-  return false;
+  // Hashed lookup on the node addresses
+  return tree.E.contains(v, x);
 }
 
 
@@ -1236,17 +1165,7 @@ bool CBITPlanner::edge_in_tree_v2(std::shared_ptr<Node> v, std::shared_ptr<Node>
 // Function for checking whether a node lives in the Vertex tree, updated to use address matching (safer)
 bool CBITPlanner::node_in_tree_v2(std::shared_ptr<Node>  x)
 {
-  int vertices_size = tree.V.size();
-  for (int i = 0; i < vertices_size; i++ )
-  {
-      
-    if (x == tree.V[i])
-    {
-        return true;
-    }
-  }
-  return false;
-  
+  return tree.V.contains(x);
 }
 
 
@@ -1330,27 +1249,19 @@ Pose CBITPlanner::lin_interpolate(int p_ind, double p_val)
 // Under normal operation we plan paths around a slightly more conservative buffer around each obstacle (equal to influence dist + min dist)
 bool CBITPlanner::costmap_col_tight(Node node)
 {
+  // Snapshot of the costmap, the control thread may publish a new one meanwhile
+  const auto obs_map = std::atomic_load(&cbit_costmap_ptr->obs_map);
+  if (obs_map == nullptr)
+  {
+    return false;
+  }
+
   Eigen::Matrix<double, 4, 1> test_pt({node.p, node.q, node.z, 1});
 
   auto collision_pt = cbit_costmap_ptr->T_c_w * test_pt;
 
-  // Round the collision point x and y values down to the nearest grid resolution so that it can be found in the obstacle unordered_map
-  float x_key = floor(collision_pt[0] / cbit_costmap_ptr->grid_resolution) * cbit_costmap_ptr->grid_resolution;
-  float y_key = floor(collision_pt[1] / cbit_costmap_ptr->grid_resolution) * cbit_costmap_ptr->grid_resolution;
-
-  float grid_value;
-
-  // Check to see if the point is in the obstacle map
-  // We need to use a try/catch in this metod as if the key value pair doesnt exist (it usually wont) we catch an out of range error
-  try 
-  {
-  // Block of code to try
-    grid_value = cbit_costmap_ptr->obs_map.at(std::pair<float, float> (x_key, y_key));
-  }
-  catch (std::out_of_range) 
-  {
-    grid_value = 0.0;
-  }
+  // Look up the grid cell containing the collision point (cells outside of the costmap are free)
+  const float grid_value = obs_map->atPoint(collision_pt[0], collision_pt[1]);
 
   if (grid_value >= 0.99) // By switching this from > 0.0 to 0.99, we effectively only collision check the path out to the "minimum_distance" obs config param
   {
@@ -1366,27 +1277,17 @@ bool CBITPlanner::costmap_col_tight(Node node)
 // More conservative costmap checking out to a distance of "influence_distance" + "minimum_distance" away
 bool CBITPlanner::costmap_col(Node node)
 {
-  Eigen::Matrix<double, 4, 1> test_pt({node.p, node.q, node.z, 1});
-  auto collision_pt = cbit_costmap_ptr->T_c_w * test_pt;
-
-  // Round the collision point x and y values down to the nearest grid resolution so that it can be found in the obstacle unordered_map
-  float x_key = floor(collision_pt[0] / cbit_costmap_ptr->grid_resolution) * cbit_costmap_ptr->grid_resolution;
-  float y_key = floor(collision_pt[1] / cbit_costmap_ptr->grid_resolution) * cbit_costmap_ptr->grid_resolution;
-
-  float grid_value;
-
-  // Check to see if the point is in the obstacle map
-  // If it isnt in the map we will catch an out of range error
-  try 
+  const auto obs_map = std::atomic_load(&cbit_costmap_ptr->obs_map);
+  if (obs_map == nullptr)
   {
-      grid_value = cbit_costmap_ptr->obs_map.at(std::pair<float, float> (x_key, y_key));
+    return false;
   }
-  
-  catch (std::out_of_range) 
-  {
 
-    grid_value = 0.0;
-  }
+  Eigen::Matrix<double, 4, 1> test_pt({node.p, node.q, node.z, 1});
+  auto collision_pt = cbit_costmap_ptr->T_c_w * test_pt;
+
+  // Look up the grid cell containing the collision point (cells outside of the costmap are free)
+  const float grid_value = obs_map->atPoint(collision_pt[0], collision_pt[1]);
 
   if (grid_value > 0.0)
     {
@@ -94,6 +94,166 @@ double calc_dist(Node start_node, Node end_node)
 }
 
 
+// NodeSet functions:
+
+void NodeSet::set_cell_size(double new_cell_size)
+{
+    cell_size = new_cell_size;
+    cells.clear();
+    for (const auto& node : nodes)
+    {
+        cells[cell_key(cell_of(node->p), cell_of(node->q))].push_back(node);
+    }
+}
+
+void NodeSet::reserve(size_t n)
+{
+    nodes.reserve(n);
+    index.reserve(n);
+}
+
+void NodeSet::clear()
+{
+    nodes.clear();
+    index.clear();
+    cells.clear();
+}
+
+bool NodeSet::push_back(const NodePtr& node)
+{
+    if (index.emplace(node.get(), nodes.size()).second == false)
+    {
+        return false;
+    }
+    nodes.push_back(node);
+    cells[cell_key(cell_of(node->p), cell_of(node->q))].push_back(node);
+    return true;
+}
+
+bool NodeSet::erase(const NodePtr& node)
+{
+    auto itr = index.find(node.get());
+    if (itr == index.end())
+    {
+        return false;
+    }
+    size_t i = itr->second;
+    index.erase(itr);
+    remove_from_cell(node);
+
+    // Move the last node into the freed slot
+    if (i != nodes.size() - 1)
+    {
+        nodes[i] = std::move(nodes.back());
+        index[nodes[i].get()] = i;
+    }
+    nodes.pop_back();
+    return true;
+}
+
+void NodeSet::remove_from_cell(const NodePtr& node)
+{
+    auto cell = cells.find(cell_key(cell_of(node->p), cell_of(node->q)));
+    if (cell == cells.end())
+    {
+        return;
+    }
+    auto& cell_nodes = cell->second;
+    for (size_t i = 0; i < cell_nodes.size(); i++)
+    {
+        if (cell_nodes[i] == node)
+        {
+            cell_nodes[i] = std::move(cell_nodes.back());
+            cell_nodes.pop_back();
+            break;
+        }
+    }
+    if (cell_nodes.empty())
+    {
+        cells.erase(cell);
+    }
+}
+
+
+// EdgeSet functions:
+
+void EdgeSet::reserve(size_t n)
+{
+    edges.reserve(n);
+    index.reserve(n);
+}
+
+void EdgeSet::clear()
+{
+    edges.clear();
+    index.clear();
+    parents.clear();
+}
+
+bool EdgeSet::contains(const std::shared_ptr<Node>& v, const std::shared_ptr<Node>& x) const
+{
+    return index.count(Key(v.get(), x.get())) > 0;
+}
+
+bool EdgeSet::push_back(const Edge& edge)
+{
+    if (index.emplace(key(edge), edges.size()).second == false)
+    {
+        return false;
+    }
+    edges.push_back(edge);
+    parents[std::get<1>(edge).get()].push_back(std::get<0>(edge).get());
+    return true;
+}
+
+size_t EdgeSet::erase_child(const std::shared_ptr<Node>& x)
+{
+    auto itr = parents.find(x.get());
+    if (itr == parents.end())
+    {
+        return 0;
+    }
+    const auto child_parents = std::move(itr->second);
+    parents.erase(itr);
+
+    for (const auto* v : child_parents)
+    {
+        auto edge_itr = index.find(Key(v, x.get()));
+        size_t i = edge_itr->second;
+        index.erase(edge_itr);
+
+        // Move the last edge into the freed slot
+        if (i != edges.size() - 1)
+        {
+            edges[i] = std::move(edges.back());
+            index[key(edges[i])] = i;
+        }
+        edges.pop_back();
+    }
+    return child_parents.size();
+}
+
+void EdgeSet::unlink(const Edge& edge)
+{
+    index.erase(key(edge));
+    auto itr = parents.find(std::get<1>(edge).get());
+    auto& child_parents = itr->second;
+    for (size_t i = 0; i < child_parents.size(); i++)
+    {
+        if (child_parents[i] == std::get<0>(edge).get())
+        {
+            child_parents[i] = child_parents.back();
+            child_parents.pop_back();
+            break;
+        }
+    }
+    if (child_parents.empty())
+    {
+        parents.erase(itr);
+    }
+}
+
+
 // Function for calculating the expansion radius based on the sample density
 double exp_radius(double q, double sample_box_height, double sample_box_width, double eta)
 {   /*
@@ -143,8 +143,17 @@ class EdgeId {
   /** \brief Check if the id is valid */
   bool isValid() const { return id_.first.isValid() && id_.second.isValid(); }
 
-  /** \brief Hash operator for use in stl containers */
-  size_t hash() const { return id_.first.hash() ^ id_.second.hash(); }
+  /**
+   * \brief Hash operator for use in stl containers
+   * \note xor of the vertex hashes would collide for all temporal edges, as
+   * consecutive vertex ids only differ in their lowest bits
+   */
+  size_t hash() const {
+    size_t seed = id_.first.hash();
+    seed ^= id_.second.hash() + 0x9e3779b97f4a7c15ULL + (seed << 6) +
+            (seed >> 2);
+    return seed;
+  }
 
   /**
    * \brief Comparison operators
@@ -18,6 +18,8 @@
  */
 #pragma once
 
+#include <vector>
+
 #include "vtr_common/utils/macros.hpp"
 
 namespace vtr {
@@ -35,5 +37,29 @@ class GraphCallbackInterface {
   virtual void edgeAdded(const EdgePtr&) {}
 };
 
+/** \brief Forwards graph callbacks to multiple callbacks, in order */
+template <class V, class E>
+class GraphCallbackList : public GraphCallbackInterface<V, E> {
+ public:
+  PTR_TYPEDEFS(GraphCallbackList);
+
+  using Base = GraphCallbackInterface<V, E>;
+  using EdgePtr = typename Base::EdgePtr;
+  using VertexPtr = typename Base::VertexPtr;
+
+  GraphCallbackList(const std::vector<typename Base::Ptr>& callbacks)
+      : callbacks_(callbacks) {}
+
+  void vertexAdded(const VertexPtr& v) override {
+    for (const auto& callback : callbacks_) callback->vertexAdded(v);
+  }
+  void edgeAdded(const EdgePtr& e) override {
+    for (const auto& callback : callbacks_) callback->edgeAdded(e);
+  }
+
+ private:
+  const std::vector<typename Base::Ptr> callbacks_;
+};
+
 }  // namespace pose_graph
 }  // namespace vtr
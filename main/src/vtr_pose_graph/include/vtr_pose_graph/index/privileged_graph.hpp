@@ -0,0 +1,91 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file privileged_graph.hpp
+ */
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "vtr_pose_graph/index/callback_interface.hpp"
+#include "vtr_pose_graph/index/graph_base.hpp"
+
+namespace vtr {
+namespace pose_graph {
+
+/**
+ * \brief The privileged (teach) part of a graph, maintained incrementally from
+ * graph callbacks instead of being extracted from the whole graph every time.
+ * \details Same definition as eval::mask::privileged: an edge is privileged if
+ * it is manual, or if both its vertices have a manual edge. Graph callbacks
+ * must be forwarded to this class (e.g. through a GraphCallbackList), and
+ * initialize must be called once the graph has been loaded.
+ */
+template <class GRAPH>
+class PrivilegedGraph : public GraphCallbackInterface<typename GRAPH::Vertex,
+                                                      typename GRAPH::Edge> {
+ public:
+  PTR_TYPEDEFS(PrivilegedGraph);
+
+  using Base =
+      GraphCallbackInterface<typename GRAPH::Vertex, typename GRAPH::Edge>;
+  using VertexPtr = typename Base::VertexPtr;
+  using EdgePtr = typename Base::EdgePtr;
+  using GraphPtr = typename GRAPH::Ptr;
+  using GraphWeakPtr = typename GRAPH::WeakPtr;
+  using GraphBasePtr = typename GRAPH::Base::Ptr;
+
+  /** \brief Adds all existing edges of graph, which must outlive this class */
+  void initialize(const GraphPtr& graph);
+
+  void vertexAdded(const VertexPtr&) override {}
+  void edgeAdded(const EdgePtr& e) override;
+
+  /** \brief Returns the privileged subgraph, only rebuilt after it changed */
+  GraphBasePtr subgraph() const;
+
+  /** \brief Incremented whenever a privileged edge is added */
+  size_t version() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return version_;
+  }
+
+ private:
+  /// these functions are called with mutex_ locked
+  void addEdge(const EdgeId& e, const bool manual);
+  void addPrivilegedEdge(const EdgeId& e);
+
+  /** \brief Protects all members below */
+  mutable std::mutex mutex_;
+
+  GraphWeakPtr graph_;
+  /** \brief Vertices with a manual edge */
+  std::unordered_set<VertexId> manual_vertices_;
+  /** \brief Privileged edges */
+  std::unordered_set<EdgeId> edges_;
+  /** \brief Autonomous edges waiting for a vertex to get a manual edge */
+  std::unordered_map<VertexId, std::vector<EdgeId>> pending_edges_;
+
+  size_t version_ = 0;
+  /** \brief Cached subgraph, reset whenever a privileged edge is added */
+  mutable GraphBasePtr subgraph_ = nullptr;
+};
+
+}  // namespace pose_graph
+}  // namespace vtr
+
+#include "vtr_pose_graph/index/privileged_graph.inl"
@@ -0,0 +1,100 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file privileged_graph.inl
+ */
+#pragma once
+
+#include "vtr_pose_graph/index/privileged_graph.hpp"
+
+namespace vtr {
+namespace pose_graph {
+
+template <class GRAPH>
+void PrivilegedGraph<GRAPH>::initialize(const GraphPtr& graph) {
+  const auto change_lock = graph->guard();
+  std::lock_guard<std::mutex> lock(mutex_);
+  graph_ = graph;
+  for (auto it = graph->beginEdge(); it != graph->endEdge(); ++it)
+    addEdge(it->id(), it->isManual());
+}
+
+template <class GRAPH>
+void PrivilegedGraph<GRAPH>::edgeAdded(const EdgePtr& e) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  addEdge(e->id(), e->isManual());
+}
+
+template <class GRAPH>
+auto PrivilegedGraph<GRAPH>::subgraph() const -> GraphBasePtr {
+  GraphPtr graph;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (subgraph_ != nullptr) return subgraph_;
+    graph = graph_.lock();
+  }
+  if (graph == nullptr) {
+    std::string err{"Graph has expired or privileged graph not initialized"};
+    CLOG(ERROR, "pose_graph") << err;
+    throw std::runtime_error(err);
+  }
+
+  // copying the graph reads its vertices and edges, same lock order as
+  // initialize and the callbacks
+  const auto change_lock = graph->guard();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (subgraph_ != nullptr) return subgraph_;
+  simple::SimpleGraph::EdgeList edges(edges_.begin(), edges_.end());
+  subgraph_ = GRAPH::Base::MakeShared(*graph, simple::SimpleGraph(edges));
+  return subgraph_;
+}
+
+template <class GRAPH>
+void PrivilegedGraph<GRAPH>::addEdge(const EdgeId& e, const bool manual) {
+  if (manual) {
+    addPrivilegedEdge(e);
+    // autonomous edges of a vertex become privileged once both its vertices
+    // have a manual edge
+    for (const auto& v : {e.id1(), e.id2()}) {
+      if (!manual_vertices_.insert(v).second) continue;
+      const auto pending = pending_edges_.find(v);
+      if (pending == pending_edges_.end()) continue;
+      for (const auto& pe : pending->second) {
+        const auto other = pe.id1() == v ? pe.id2() : pe.id1();
+        // otherwise still pending on the other vertex
+        if (manual_vertices_.count(other)) addPrivilegedEdge(pe);
+      }
+      pending_edges_.erase(pending);
+    }
+    return;
+  }
+  bool privileged = true;
+  for (const auto& v : {e.id1(), e.id2()}) {
+    if (manual_vertices_.count(v)) continue;
+    pending_edges_[v].push_back(e);
+    privileged = false;
+  }
+  if (privileged) addPrivilegedEdge(e);
+}
+
+template <class GRAPH>
+void PrivilegedGraph<GRAPH>::addPrivilegedEdge(const EdgeId& e) {
+  if (!edges_.insert(e).second) return;
+  ++version_;
+  subgraph_ = nullptr;
+}
+
+}  // namespace pose_graph
+}  // namespace vtr
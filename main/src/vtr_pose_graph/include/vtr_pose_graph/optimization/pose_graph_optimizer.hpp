@@ -60,6 +60,20 @@ class PoseGraphOptimizer {
   PoseGraphOptimizer(const GraphPtr& graph, const VertexId& root,
                      VertexId2TransformMap& vid2tf_map);
 
+  /**
+   * \brief incremental mode, only re-linearizes and re-solves the active
+   * vertices, warm started from vid2tf_map
+   * \details Neighbors of the active vertices are added as locked states so
+   * that the solution stays attached to the rest of the graph, all other
+   * vertices and edges are left out of the problem. The root stays locked if
+   * it is active.
+   * \throws std::runtime_error if an active vertex or one of its neighbors is
+   * not in vid2tf_map
+   */
+  PoseGraphOptimizer(const GraphPtr& graph, const VertexId& root,
+                     const VertexId::UnorderedSet& active,
+                     VertexId2TransformMap& vid2tf_map);
+
   /** \brief adds factors to the optimization problem */
   void addFactor(const typename PGOFactorInterface<Graph>::Ptr& factor);
 
@@ -99,6 +113,43 @@ PoseGraphOptimizer<Graph>::PoseGraphOptimizer(const GraphPtr& graph,
   state_map_.at(root)->locked() = true;
 }
 
+template <class Graph>
+PoseGraphOptimizer<Graph>::PoseGraphOptimizer(
+    const GraphPtr& graph, const VertexId& root,
+    const VertexId::UnorderedSet& active, VertexId2TransformMap& vid2tf_map)
+    : vid2tf_map_(vid2tf_map) {
+  // neighbors of the active vertices are kept at their current estimate
+  VertexId::UnorderedSet boundary;
+  for (const auto& vid : active)
+    for (const auto& neighbor : graph->neighbors(vid))
+      if (active.count(neighbor) == 0) boundary.insert(neighbor);
+
+  VertexId::Vector vertices(active.begin(), active.end());
+  vertices.insert(vertices.end(), boundary.begin(), boundary.end());
+  if (vertices.empty()) {
+    graph_ = graph;
+    return;
+  }
+  graph_ = graph->getSubgraph(vertices);
+
+  // warm start from the current estimate
+  for (const auto& vid : vertices) {
+    const auto tf = vid2tf_map_.find(vid);
+    if (tf == vid2tf_map_.end()) {
+      std::stringstream ss;
+      ss << "Vertex " << vid << " has no initial estimate for relaxation";
+      CLOG(ERROR, "pose_graph") << ss.str();
+      throw std::runtime_error(ss.str());
+    }
+    state_map_[vid] = steam::se3::SE3StateVar::MakeShared(tf->second);
+  }
+  for (const auto& vid : boundary) state_map_.at(vid)->locked() = true;
+  if (active.count(root))
+    state_map_.at(root)->locked() = true;
+  else if (boundary.empty())  // a separate component, fix one of its vertices
+    state_map_.at(vertices.front())->locked() = true;
+}
+
 template <class Graph>
 void PoseGraphOptimizer<Graph>::addFactor(
     const typename PGOFactorInterface<Graph>::Ptr& factor) {
@@ -134,8 +185,8 @@ void PoseGraphOptimizer<Graph>::optimize(
   solver.optimize();
 
   // update the tf map
-  for (auto iter = vid2tf_map_.begin(); iter != vid2tf_map_.end(); ++iter)
-    iter->second = state_map_.at(iter->first)->value();
+  for (const auto& [vid, state] : state_map_)
+    if (!state->locked()) vid2tf_map_[vid] = state->value();
 }
 
 }  // namespace pose_graph
@@ -242,28 +242,40 @@ void LocalizationChain<Graph>::searchClosestTrunk(bool search_backwards) {
            ? unsigned(std::max(int(trunk_sid_) - config_.search_back_depth, 0))
            : trunk_sid_);
 
-  EdgeTransform T_trunk_root = this->pose(trunk_sid_).inverse();
-  EdgeTransform T_leaf_root = T_leaf_trunk() * T_trunk_root;
+  // The search only needs the geometry, so it runs on the covariance-free
+  // poses of the path and leaves the covariance to pose()
+  using Transform = lgmath::se3::Transformation;
+  const Transform T_trunk_root = this->T_start(trunk_sid_).inverse();
+  this->expandTransforms(end_sid - 1);
+  const Transform T_leaf_trunk =
+      static_cast<const Transform &>(T_leaf_petiole_) *
+      static_cast<const Transform &>(T_petiole_twig_) *
+      static_cast<const Transform &>(T_twig_branch_) *
+      static_cast<const Transform &>(T_branch_trunk_);
+  const Transform T_leaf_root = T_leaf_trunk * T_trunk_root;
+
+  // "distance" of every vertex in the search window, independent of each other
+  std::vector<double> distances(end_sid - begin_sid);
+  for (unsigned sid = begin_sid; sid < end_sid; ++sid) {
+    const Eigen::Matrix<double, 6, 1> se3_leaf_new =
+        (T_leaf_root * this->transforms_[sid]).vec();
+    distances[sid - begin_sid] =
+        se3_leaf_new.head<3>().norm() +
+        config_.angle_weight * se3_leaf_new.tail<3>().norm();
+  }
 
   // Find the closest vertex (updating Trunk) now that VO has updated the leaf
-  for (auto path_it = this->begin(begin_sid); unsigned(path_it) < end_sid;
-       ++path_it) {
-    EdgeTransform T_root_new = this->pose(path_it);
-    EdgeTransform T_leaf_new = T_leaf_root * T_root_new;
-
-    // Calculate the "distance"
-    Eigen::Matrix<double, 6, 1> se3_leaf_new = T_leaf_new.vec();
-    double distance = se3_leaf_new.head<3>().norm() +
-                      config_.angle_weight * se3_leaf_new.tail<3>().norm();
+  for (unsigned sid = begin_sid; sid < end_sid; ++sid) {
+    const double distance = distances[sid - begin_sid];
 
     // This block is just for the debug log below
-    if (unsigned(path_it) == trunk_sid_) trunk_distance = distance;
+    if (sid == trunk_sid_) trunk_distance = distance;
 
     // Record the best distance
     max_distance = std::max(distance, max_distance);
     if (distance < best_distance) {
       best_distance = distance;
-      best_sid = unsigned(path_it);
+      best_sid = sid;
     }
 
     // This block detects direction switches, and prevents searching across them
@@ -272,9 +284,9 @@ void LocalizationChain<Graph>::searchClosestTrunk(bool search_backwards) {
     // and it only stops at cusps that pass X m in 'distance' from the current
     // position
     if (search_backwards == false && max_distance > config_.min_cusp_distance &&
-        unsigned(path_it) > begin_sid && unsigned(path_it) + 1 < end_sid) {
-      Eigen::Matrix<double, 6, 1> vec_prev_cur = path_it->T().vec();
-      Eigen::Matrix<double, 6, 1> vec_cur_next = (path_it + 1)->T().vec();
+        sid > begin_sid && sid + 1 < end_sid) {
+      const auto &vec_prev_cur = this->edge_vecs_[sid];
+      const auto &vec_cur_next = this->edge_vecs_[sid + 1];
       // + means they are in the same direction (note the negative at the front
       // to invert one of them)
       double r_dot = vec_prev_cur.head<3>().dot(vec_cur_next.head<3>());
@@ -286,8 +298,8 @@ void LocalizationChain<Graph>::searchClosestTrunk(bool search_backwards) {
       // a cusp
       if (T_dot < 0) {
         CLOG_EVERY_N(1, DEBUG, "pose_graph")
-            << "Not searching past the cusp at " << path_it->to() << ", "
-            << distance << " (m/8degress) away.";
+            << "Not searching past the cusp at " << this->sequence_[sid]
+            << ", " << distance << " (m/8degress) away.";
         break;
       }
     }
@@ -61,6 +61,16 @@ class Path {
   /** \brief Vertex id implicitly converts to unsigned */
   EdgeTransform pose(VertexId vtx_id) const = delete;
 
+  /**
+   * \brief Get the pose at a sequence index without covariance, for callers
+   * that only need the geometry.
+   * \details Expanded separately from pose, composing transforms is much
+   * cheaper without propagating the covariance.
+   */
+  lgmath::se3::Transformation T_start(unsigned seq_id) const;
+  /** \brief Vertex id implicitly converts to unsigned */
+  lgmath::se3::Transformation T_start(VertexId vtx_id) const = delete;
+
   /** \brief Gets the cumu. distance along the path at a sequence index */
   double dist(unsigned seq_id) const;
   /** \brief Gets the cumu. distance along the path at an iterator position */
@@ -84,6 +94,9 @@ class Path {
  protected:
   virtual void initSequence();
 
+  /** \brief Expands transforms_ and edge_vecs_ up to this id, lock held */
+  void expandTransforms(unsigned seq_id) const;
+
   /** \brief An iterator to a specified id along the path */
   Iterator begin(const unsigned& seq_id = 0) const;
   /** \brief An iterator to the end of the path (beyond the last vertex) */
@@ -93,6 +106,10 @@ class Path {
   Sequence sequence_;
   mutable std::vector<EdgeTransform> poses_;
   mutable std::vector<double> distances_;
+  /** \brief Covariance-free poses, expanded on demand by expandTransforms */
+  mutable std::vector<lgmath::se3::Transformation> transforms_;
+  /** \brief se(3) vector of the edge into each vertex, zero for the first */
+  mutable std::vector<Eigen::Matrix<double, 6, 1>> edge_vecs_;
 
   /** \brief for thread safety, use whenever read from/write to the path */
   mutable Mutex mutex_;
@@ -170,6 +187,37 @@ EdgeTransform Path<GraphT>::pose(unsigned seq_id) const {
   return poses_[seq_id];
 }
 
+template <class GraphT>
+lgmath::se3::Transformation Path<GraphT>::T_start(unsigned seq_id) const {
+  LockGuard lock(mutex_);
+  if (seq_id >= sequence_.size()) {
+    std::string err{"[Path][T_start] id out of range."};
+    CLOG(ERROR, "pose_graph") << err;
+    throw std::range_error(err);
+  }
+  expandTransforms(seq_id);
+  return transforms_[seq_id];
+}
+
+template <class GraphT>
+void Path<GraphT>::expandTransforms(unsigned seq_id) const {
+  // We've already done up to this point
+  if (seq_id < transforms_.size()) return;
+  // Initialize if it's the first pose
+  Iterator it = begin(transforms_.size());
+  if (transforms_.empty()) {
+    transforms_.emplace_back();
+    edge_vecs_.emplace_back(Eigen::Matrix<double, 6, 1>::Zero());
+    ++it;
+  }
+  for (; unsigned(it) <= seq_id; ++it) {
+    // T_root_current = T_root_prev * T_prev_current, as in ComposeTf
+    const lgmath::se3::Transformation T_prev_curr = it->T();
+    transforms_.emplace_back(transforms_.back() * T_prev_curr);
+    edge_vecs_.emplace_back(T_prev_curr.vec());
+  }
+}
+
 template <class GraphT>
 double Path<GraphT>::dist(unsigned seq_id) const {
   LockGuard lock(mutex_);
@@ -225,6 +273,10 @@ void Path<GraphT>::initSequence() {
   poses_.reserve(sequence_.size());
   distances_.clear();
   distances_.reserve(sequence_.size());
+  transforms_.clear();
+  transforms_.reserve(sequence_.size());
+  edge_vecs_.clear();
+  edge_vecs_.reserve(sequence_.size());
 }
 
 /** \brief An iterator to a specified id along the path */
@@ -80,6 +80,9 @@ class SimpleGraph {
   /** \brief Construct a path/cycle from a list of vertices */
   SimpleGraph(const VertexList &vertices, bool cyclic = false);
 
+  /** \brief Makes room for num_vertices vertices without rehashing */
+  void reserve(const size_t num_vertices) { node_map_.reserve(num_vertices); }
+
   /** \brief Add a vertex */
   void addVertex(const VertexId &vertex);
   /**
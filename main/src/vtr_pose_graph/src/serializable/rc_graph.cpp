@@ -18,14 +18,41 @@
  */
 #include "vtr_pose_graph/serializable/rc_graph.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <iomanip>
+#include <limits>
+#include <thread>
+
+#include "vtr_common/timing/stopwatch.hpp"
 
 namespace fs = std::filesystem;
 
 namespace vtr {
 namespace pose_graph {
 
+namespace {
+
+/** \brief Number of threads deserializing vertices and edges at startup */
+const int num_load_threads =
+    std::clamp((int)std::thread::hardware_concurrency(), 1, 8);
+
+/**
+ * \brief Number of messages stored at consecutive indices starting from 1,
+ * loading stops at the first missing index.
+ */
+template <typename MessagePtr>
+size_t numConsecutive(const std::vector<MessagePtr>& msgs) {
+  size_t num = 0;
+  while (num < msgs.size() &&
+         msgs[num]->locked().get().getIndex() == (storage::Index)num + 1)
+    ++num;
+  return num;
+}
+
+}  // namespace
+
 RCGraph::RCGraph(const std::string& file_path, const bool load,
                  const CallbackPtr& callback)
     : GraphType(callback),
@@ -34,10 +61,36 @@ RCGraph::RCGraph(const std::string& file_path, const bool load,
           fs::path{file_path} / "data", Name2AccessorMapBase())) {
   if (load && fs::exists(fs::path(file_path_) / "index")) {
     CLOG(INFO, "pose_graph") << "Loading pose graph from " << file_path;
+    using Stopwatch = common::timing::Stopwatch<>;
+    std::vector<std::unique_ptr<Stopwatch>> timer;
+    std::vector<std::string> clock_str;
+    clock_str.push_back("Graph Index ........ ");
+    timer.emplace_back(std::make_unique<Stopwatch>(false));
+    clock_str.push_back("Vertices ........... ");
+    timer.emplace_back(std::make_unique<Stopwatch>(false));
+    clock_str.push_back("Edges .............. ");
+    timer.emplace_back(std::make_unique<Stopwatch>(false));
+    clock_str.push_back("Simple Graph ....... ");
+    timer.emplace_back(std::make_unique<Stopwatch>(false));
+
+    timer[0]->start();
     loadGraphIndex();
+    timer[0]->stop();
+    timer[1]->start();
     loadVertices();
+    timer[1]->stop();
+    timer[2]->start();
     loadEdges();
+    timer[2]->stop();
+    timer[3]->start();
     buildSimpleGraph();
+    timer[3]->stop();
+
+    CLOG(INFO, "pose_graph")
+        << "Loaded " << vertices_.size() << " vertices and " << edges_.size()
+        << " edges, timing info (ms):";
+    for (size_t i = 0; i < clock_str.size(); i++)
+      CLOG(INFO, "pose_graph") << "  " << clock_str[i] << timer[i]->count();
   } else {
     CLOG(INFO, "pose_graph") << "Creating a new pose graph.";
     if (fs::exists(file_path_)) fs::remove_all(file_path_);
@@ -84,12 +137,18 @@ void RCGraph::loadVertices() {
   CLOG(DEBUG, "pose_graph") << "Loading vertices from disk";
 
   VertexMsgAccessor accessor{fs::path{file_path_},  "vertices", "vtr_pose_graph_msgs/msg/Vertex"};
-  for (int index = 1;; index++) {
-    const auto msg = accessor.readAtIndex(index);
-    if (!msg) break;
+  const auto msgs = accessor.readAtIndexRange(1, std::numeric_limits<int>::max(), num_load_threads);
+  const auto num_msgs = numConsecutive(msgs);
+
+  std::vector<VertexPtr> vertices(num_msgs);
+#pragma omp parallel for schedule(static) num_threads(num_load_threads)
+  for (size_t i = 0; i < num_msgs; ++i) {
+    const auto vertex_msg = msgs[i]->locked().get().getData();
+    vertices[i] = RCVertex::MakeShared(vertex_msg, name2accessor_map_, msgs[i]);
+  }
 
-    auto vertex_msg = msg->locked().get().getData();
-    auto vertex = RCVertex::MakeShared(vertex_msg, name2accessor_map_, msg);
+  vertices_.reserve(num_msgs);
+  for (const auto& vertex : vertices) {
     vertices_.insert(std::make_pair(vertex->id(), vertex));
     CLOG(DEBUG, "pose_graph") << "- loaded vertex " << *vertex;
   }
@@ -99,18 +158,25 @@ void RCGraph::loadEdges() {
   CLOG(DEBUG, "pose_graph") << "Loading edges from disk";
 
   EdgeMsgAccessor accessor{fs::path{file_path_}, "edges", "vtr_pose_graph_msgs/msg/Edge"};
-  for (int index = 1;; index++) {
-    const auto msg = accessor.readAtIndex(index);
-    if (!msg) break;
+  const auto msgs = accessor.readAtIndexRange(1, std::numeric_limits<int>::max(), num_load_threads);
+  const auto num_msgs = numConsecutive(msgs);
+
+  std::vector<EdgePtr> edges(num_msgs);
+#pragma omp parallel for schedule(static) num_threads(num_load_threads)
+  for (size_t i = 0; i < num_msgs; ++i) {
+    const auto edge_msg = msgs[i]->locked().get().getData();
+    edges[i] = RCEdge::MakeShared(edge_msg, msgs[i]);
+  }
 
-    auto edge_msg = msg->locked().get().getData();
-    auto edge = RCEdge::MakeShared(edge_msg, msg);
+  edges_.reserve(num_msgs);
+  for (const auto& edge : edges) {
     edges_.insert(std::make_pair(edge->id(), edge));
     CLOG(DEBUG, "pose_graph") << " - loaded edge " << *edge;
   }
 }
 
 void RCGraph::buildSimpleGraph() {
+  graph_.reserve(vertices_.size());
   // First add all vertices to the simple graph
   for (auto it = vertices_.begin(); it != vertices_.end(); ++it)
     graph_.addVertex(it->first);
@@ -141,6 +207,22 @@ void RCGraph::saveVertices() {
   CLOG(DEBUG, "pose_graph") << "Saving vertices to disk";
   for (auto iter = vertices_.begin(); iter != vertices_.end(); ++iter)
     iter->second->unload();
+  // commit queued writes of all streams
+  {
+    using Ms = std::chrono::duration<double, std::milli>;
+    const auto name2accessor_map_locked = name2accessor_map_->sharedLocked();
+    for (const auto& [name, accessor] : name2accessor_map_locked.get().second) {
+      accessor->flush();
+      const auto stats = accessor->getWriteStats();
+      CLOG(DEBUG, "pose_graph")
+          << "- stream " << name << ": " << stats.messages_written
+          << " messages, " << stats.bytes_written << " bytes in "
+          << stats.commits << " commits, commit time "
+          << Ms(stats.commit_time).count() << " ms (max "
+          << Ms(stats.max_commit_time).count() << " ms), max queue depth "
+          << stats.max_queue_depth;
+    }
+  }
   VertexMsgAccessor accessor{fs::path{file_path_}, "vertices", "vtr_pose_graph_msgs/msg/Vertex"};
   for (auto it = vertices_.begin(); it != vertices_.end(); ++it)
     accessor.write(it->second->serialize());
@@ -0,0 +1,127 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file test_privileged_graph.cpp
+ */
+#include <gtest/gtest.h>
+
+#include "vtr_logging/logging_init.hpp"
+#include "vtr_pose_graph/evaluator/evaluators.hpp"
+#include "vtr_pose_graph/index/graph.hpp"
+#include "vtr_pose_graph/index/privileged_graph.hpp"
+
+using namespace ::testing;
+using namespace vtr::logging;
+using namespace vtr::pose_graph;
+
+namespace {
+
+std::set<EdgeId> edgesOf(const BasicGraphBase& graph) {
+  std::set<EdgeId> edges;
+  for (auto it = graph.beginEdge(); it != graph.endEdge(); ++it)
+    edges.insert(it->id());
+  return edges;
+}
+
+}  // namespace
+
+class PrivilegedGraphTestFixture : public Test {
+ public:
+  void SetUp() override { privileged_graph_->initialize(graph_); }
+
+  /** \brief Subgraph extracted by the privileged evaluator */
+  std::set<EdgeId> evaluatorEdges() const {
+    using PrivilegedEval = eval::mask::privileged::Eval<BasicGraph>;
+    auto evaluator = std::make_shared<PrivilegedEval>(*graph_);
+    return edgesOf(*graph_->getSubgraph(evaluator));
+  }
+
+  PrivilegedGraph<BasicGraph>::Ptr privileged_graph_ =
+      std::make_shared<PrivilegedGraph<BasicGraph>>();
+  BasicGraph::Ptr graph_ = std::make_shared<BasicGraph>(
+      std::make_shared<GraphCallbackList<VertexBase, EdgeBase>>(
+          std::vector<BasicGraph::CallbackPtr>{privileged_graph_}));
+};
+
+TEST_F(PrivilegedGraphTestFixture, incremental_update) {
+  // clang-format off
+  // R0: teach, manual temporal edges
+  graph_->addRun();
+  graph_->addVertex();
+  for (int i = 1; i < 10; ++i) {
+    graph_->addVertex();
+    graph_->addEdge(VertexId(0, i - 1), VertexId(0, i), EdgeType::Temporal, true, EdgeTransform(true));
+  }
+  EXPECT_EQ(privileged_graph_->version(), (size_t)9);
+  EXPECT_EQ(edgesOf(*privileged_graph_->subgraph()), evaluatorEdges());
+
+  // R1: repeat, autonomous edges are never privileged
+  const auto subgraph = privileged_graph_->subgraph();
+  graph_->addRun();
+  graph_->addVertex();
+  for (int i = 1; i < 10; ++i) {
+    graph_->addVertex();
+    graph_->addEdge(VertexId(1, i - 1), VertexId(1, i), EdgeType::Temporal, false, EdgeTransform(true));
+  }
+  graph_->addEdge(VertexId(1, 1), VertexId(0, 1), EdgeType::Spatial, false, EdgeTransform(true));
+  EXPECT_EQ(privileged_graph_->version(), (size_t)9);
+  EXPECT_EQ(privileged_graph_->subgraph(), subgraph);  // cached
+  EXPECT_EQ(edgesOf(*privileged_graph_->subgraph()), evaluatorEdges());
+
+  // R2: autonomous edges added before their vertices have manual edges
+  graph_->addRun();
+  for (int i = 0; i < 4; ++i) graph_->addVertex();
+  graph_->addEdge(VertexId(2, 0), VertexId(2, 1), EdgeType::Temporal, false, EdgeTransform(true));
+  graph_->addEdge(VertexId(2, 1), VertexId(2, 2), EdgeType::Temporal, false, EdgeTransform(true));
+  graph_->addEdge(VertexId(2, 1), VertexId(0, 5), EdgeType::Spatial, false, EdgeTransform(true));
+  EXPECT_EQ(edgesOf(*privileged_graph_->subgraph()), evaluatorEdges());
+  graph_->addEdge(VertexId(2, 1), VertexId(0, 2), EdgeType::Spatial, true, EdgeTransform(true));
+  EXPECT_EQ(edgesOf(*privileged_graph_->subgraph()), evaluatorEdges());
+  graph_->addEdge(VertexId(2, 0), VertexId(0, 1), EdgeType::Spatial, true, EdgeTransform(true));
+  EXPECT_EQ(edgesOf(*privileged_graph_->subgraph()), evaluatorEdges());
+  graph_->addEdge(VertexId(2, 2), VertexId(2, 3), EdgeType::Temporal, true, EdgeTransform(true));
+  EXPECT_EQ(edgesOf(*privileged_graph_->subgraph()), evaluatorEdges());
+  // clang-format on
+
+  // 9 + 2 manual spatial + 1 manual temporal + 3 autonomous edges of R2
+  EXPECT_EQ(privileged_graph_->version(), (size_t)15);
+  EXPECT_EQ(privileged_graph_->subgraph()->numberOfEdges(), (unsigned)15);
+}
+
+TEST_F(PrivilegedGraphTestFixture, initialize_from_existing_graph) {
+  // clang-format off
+  graph_->addRun();
+  for (int i = 0; i < 3; ++i) graph_->addVertex();
+  graph_->addEdge(VertexId(0, 0), VertexId(0, 1), EdgeType::Temporal, true, EdgeTransform(true));
+  graph_->addEdge(VertexId(0, 1), VertexId(0, 2), EdgeType::Temporal, false, EdgeTransform(true));
+  graph_->addRun();
+  for (int i = 0; i < 2; ++i) graph_->addVertex();
+  graph_->addEdge(VertexId(1, 0), VertexId(1, 1), EdgeType::Temporal, false, EdgeTransform(true));
+  graph_->addEdge(VertexId(1, 0), VertexId(0, 2), EdgeType::Spatial, true, EdgeTransform(true));
+  // clang-format on
+
+  // a new privileged graph only sees the graph through initialize
+  PrivilegedGraph<BasicGraph> privileged_graph;
+  privileged_graph.initialize(graph_);
+  EXPECT_EQ(edgesOf(*privileged_graph.subgraph()), evaluatorEdges());
+  EXPECT_EQ(edgesOf(*privileged_graph.subgraph()),
+            edgesOf(*privileged_graph_->subgraph()));
+}
+
+int main(int argc, char** argv) {
+  configureLogging("", true);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -120,6 +120,36 @@ TEST_F(EvaluatorTestFixture, RelaxationDoesntChangePoseGraph) {
 
 }
 
+TEST_F(EvaluatorTestFixture, IncrementalRelaxationOnlyChangesActiveVertices) {
+  const auto root_vid = VertexId(0, 0);
+  const auto original_map = map_;
+
+  // perturb 1 and 2, then relax them only with their neighbors 0 and 3 fixed
+  const VertexId::UnorderedSet active{VertexId(0, 1), VertexId(0, 2)};
+  for (const auto& vid : active)
+    map_[vid] = EdgeTransform(Eigen::Matrix3d::Identity(), Eigen::Vector3d{0.5, 0.3, 0.0}) * map_.at(vid);
+  PoseGraphOptimizer<BasicGraphBase> optimizer(graph_, root_vid, active, map_);
+
+  Eigen::Matrix<double, 6, 6> cov(Eigen::Matrix<double, 6, 6>::Identity());
+  cov.topLeftCorner<3, 3>() *= LINEAR_NOISE * LINEAR_NOISE;
+  cov.bottomRightCorner<3, 3>() *= ANGLE_NOISE * ANGLE_NOISE;
+  optimizer.addFactor(std::make_shared<PoseGraphRelaxation<BasicGraphBase>>(cov));
+
+  using SolverType = steam::DoglegGaussNewtonSolver;
+  optimizer.optimize<SolverType>();
+
+  for (const auto& vid : {VertexId(0, 0), VertexId(0, 3)})
+    EXPECT_EQ(map_.at(vid).matrix(), original_map.at(vid).matrix());
+  // edges from 0 to 3 are consistent, the perturbation should be undone
+  for (const auto& vid : active)
+    EXPECT_TRUE(map_.at(vid).matrix().isApprox(original_map.at(vid).matrix(), 1e-6));
+
+  // vertices must be warm started
+  map_.erase(VertexId(0, 3));
+  EXPECT_THROW(PoseGraphOptimizer<BasicGraphBase>(graph_, root_vid, active, map_),
+               std::runtime_error);
+}
+
 // clang-format on
 
 int main(int argc, char** argv) {
@@ -199,6 +199,17 @@ TEST_F(ChainTest, simulate_localization_skipped_frames) {
   print(chain_);
 }
 
+TEST_F(ChainTest, covariance_free_poses) {
+  for (unsigned sid = 0; sid < chain_.size(); ++sid)
+    EXPECT_TRUE(chain_.T_start(sid).matrix() == chain_.pose(sid).matrix());
+
+  // 5 x 0.4 m along the repeat run is 2 privileged vertices from the start
+  chain_.setPetiole(VertexId(1, 5));
+  chain_.updatePetioleToLeafTransform(EdgeTransform(true), true, false);
+  EXPECT_EQ(chain_.trunkSequenceId(), 2u);
+  EXPECT_TRUE(chain_.T_leaf_trunk().vec().isZero(1e-9));
+}
+
 int main(int argc, char** argv) {
   configureLogging("", true);
   testing::InitGoogleTest(&argc, argv);
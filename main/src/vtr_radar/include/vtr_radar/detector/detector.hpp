@@ -37,6 +37,12 @@ class Detector {
                    const std::vector<int64_t> &azimuth_times,
                    const std::vector<double> &azimuth_angles,
                    pcl::PointCloud<PointT> &pointcloud) = 0;
+
+  /** \brief Sets the number of threads processing azimuths in parallel */
+  void setNumThreads(const int num_threads) { num_threads_ = num_threads; }
+
+ protected:
+  int num_threads_ = 1;
 };
 
 template <class PointT>
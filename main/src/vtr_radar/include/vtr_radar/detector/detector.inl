@@ -25,13 +25,105 @@ namespace vtr {
 namespace radar {
 
 namespace {
-bool sort_desc_by_first(const std::pair<int, float> &a,
-                        const std::pair<int, float> &b) {
-  return (a.first > b.first);
+
+/** \brief Per-thread buffers reused across azimuths */
+struct DetectorScratch {
+  std::vector<double> prefix;
+  std::vector<uint8_t> detected;
+  std::vector<float> window;
+  std::vector<std::pair<float, int>> intens;
+};
+
+/** \brief Sum of row[begin, end) in double precision */
+inline double rowSum(const float *row, const int begin, const int end) {
+  double sum = 0;
+#pragma omp simd reduction(+ : sum)
+  for (int j = begin; j < end; ++j) sum += row[j];
+  return sum;
 }
-bool sort_asc_by_second(const std::pair<int, float> &a,
-                        const std::pair<int, float> &b) {
-  return (a.second < b.second);
+
+/** \brief prefix[j] is the sum of row[0, j) in double precision */
+inline void prefixSum(const float *row, const int cols,
+                      std::vector<double> &prefix) {
+  prefix.resize(cols + 1);
+  prefix[0] = 0;
+  for (int j = 0; j < cols; ++j) prefix[j + 1] = prefix[j] + row[j];
+}
+
+/**
+ * \brief Appends the range of the center of every run of detected cells in
+ * [begin, end) to ranges. A run still open at end is only kept if
+ * close_last_run is true.
+ */
+inline void peakRanges(const uint8_t *detected, const int begin, const int end,
+                       const float res, const double range_offset,
+                       const bool close_last_run, std::vector<float> &ranges) {
+  float peak_points = 0;
+  int num_peak_points = 0;
+  for (int j = begin; j < end; ++j) {
+    if (detected[j]) {
+      peak_points += j;
+      num_peak_points += 1;
+    } else if (num_peak_points > 0) {
+      ranges.push_back(res * peak_points / num_peak_points + range_offset);
+      peak_points = 0;
+      num_peak_points = 0;
+    }
+  }
+  if (close_last_run && num_peak_points > 0)
+    ranges.push_back(res * peak_points / num_peak_points + range_offset);
+}
+
+/**
+ * \brief Replaces one element equal to old_value in the sorted values by
+ * new_value, shifting only the elements in between.
+ */
+inline void replaceSorted(std::vector<float> &values, const float old_value,
+                          const float new_value) {
+  auto pos = std::lower_bound(values.begin(), values.end(), old_value);
+  if (new_value >= old_value) {
+    for (auto next = pos + 1; next != values.end() && *next < new_value;
+         ++pos, ++next)
+      *pos = *next;
+  } else {
+    for (; pos != values.begin() && *(pos - 1) > new_value; --pos)
+      *pos = *(pos - 1);
+  }
+  *pos = new_value;
+}
+
+/**
+ * \brief Runs detect(i, scratch, ranges) on every azimuth in parallel, then
+ * writes the detected ranges into pointcloud in azimuth order.
+ */
+template <class PointT, class DetectFunc>
+void detectAzimuths(const int rows, const std::vector<int64_t> &azimuth_times,
+                    const std::vector<double> &azimuth_angles,
+                    const int num_threads, const DetectFunc &detect,
+                    pcl::PointCloud<PointT> &pointcloud) {
+  std::vector<std::vector<float>> ranges(rows);
+#pragma omp parallel num_threads(num_threads)
+  {
+    DetectorScratch scratch;
+#pragma omp for schedule(dynamic, 10)
+    for (int i = 0; i < rows; ++i) detect(i, scratch, ranges[i]);
+  }
+
+  std::vector<size_t> offsets(rows + 1, 0);
+  for (int i = 0; i < rows; ++i)
+    offsets[i + 1] = offsets[i] + ranges[i].size();
+  pointcloud.clear();
+  pointcloud.resize(offsets[rows]);
+#pragma omp parallel for schedule(static) num_threads(num_threads)
+  for (int i = 0; i < rows; ++i) {
+    for (size_t k = 0; k < ranges[i].size(); ++k) {
+      auto &p = pointcloud[offsets[i] + k];
+      p.rho = ranges[i][k];
+      p.phi = azimuth_angles[i];
+      p.theta = 0;
+      p.timestamp = azimuth_times[i];
+    }
+  }
 }
 
 }  // namespace
@@ -41,7 +133,6 @@ void KStrongest<PointT>::run(const cv::Mat &raw_scan, const float &res,
                              const std::vector<int64_t> &azimuth_times,
                              const std::vector<double> &azimuth_angles,
                              pcl::PointCloud<PointT> &pointcloud) {
-  pointcloud.clear();
   const int rows = raw_scan.rows;
   const int cols = raw_scan.cols;
   auto mincol = minr_ / res;
@@ -49,40 +140,29 @@ void KStrongest<PointT>::run(const cv::Mat &raw_scan, const float &res,
   auto maxcol = maxr_ / res;
   if (maxcol > cols || maxcol < 0) maxcol = cols;
   const auto N = maxcol - mincol;
+  const int begin = mincol, end = std::ceil(maxcol);
 
-  // #pragma omp parallel for
-  for (int i = 0; i < rows; ++i) {
-    std::vector<std::pair<float, int>> intens;
-    intens.reserve(N / 2);
-    double mean = 0;
-    for (int j = mincol; j < maxcol; ++j) {
-      mean += raw_scan.at<float>(i, j);
-    }
-    mean /= N;
+  const auto detect = [&](const int i, DetectorScratch &scratch,
+                          std::vector<float> &ranges) {
+    const float *row = raw_scan.ptr<float>(i);
+    const double mean = rowSum(row, begin, end) / N;
     const double thres = mean * threshold2_ + threshold3_;
-    for (int j = mincol; j < maxcol; ++j) {
-      if (raw_scan.at<float>(i, j) >= thres)
-        intens.emplace_back(raw_scan.at<float>(i, j), j);
-    }
-    // sort intensities in descending order
-    std::sort(intens.begin(), intens.end(), sort_desc_by_first);
-    const double azimuth = azimuth_angles[i];
-    const int64_t time = azimuth_times[i];
-    pcl::PointCloud<PointT> polar_time;
-    for (int j = 0; j < kstrong_; ++j) {
-      if (intens[j].first < thres) break;
-      PointT p;
-      p.rho = float(intens[j].second) * res + range_offset_;
-      p.phi = azimuth;
-      p.theta = 0;
-      p.timestamp = time;
-      polar_time.push_back(p);
-    }
-    // #pragma omp critical
-    {
-      pointcloud.insert(pointcloud.end(), polar_time.begin(), polar_time.end());
-    }
-  }
+    auto &intens = scratch.intens;
+    intens.clear();
+    for (int j = begin; j < end; ++j)
+      if (row[j] >= thres) intens.emplace_back(row[j], j);
+    // only the k strongest intensities are needed in descending order
+    const auto k = std::min<size_t>(std::max(kstrong_, 0), intens.size());
+    std::partial_sort(intens.begin(), intens.begin() + k, intens.end(),
+                      [](const auto &a, const auto &b) {
+                        return a.first > b.first ||
+                               (a.first == b.first && a.second < b.second);
+                      });
+    for (size_t j = 0; j < k; ++j)
+      ranges.push_back(float(intens[j].second) * res + range_offset_);
+  };
+  detectAzimuths(rows, azimuth_times, azimuth_angles, this->num_threads_,
+                 detect, pointcloud);
 }
 
 template <class PointT>
@@ -90,7 +170,6 @@ void Cen2018<PointT>::run(const cv::Mat &raw_scan, const float &res,
                           const std::vector<int64_t> &azimuth_times,
                           const std::vector<double> &azimuth_angles,
                           pcl::PointCloud<PointT> &pointcloud) {
-  pointcloud.clear();
   const int rows = raw_scan.rows;
   const int cols = raw_scan.cols;
   auto mincol = minr_ / res;
@@ -98,20 +177,18 @@ void Cen2018<PointT>::run(const cv::Mat &raw_scan, const float &res,
   auto maxcol = maxr_ / res;
   if (maxcol > cols || maxcol < 0) maxcol = cols;
   const auto N = maxcol - mincol;
+  const int begin = mincol, end = std::ceil(maxcol);
 
-  std::vector<float> sigma_q(rows, 0);
   // TODO: try implementing an efficient median filter
   // Estimate the bias and subtract it from the signal
   cv::Mat q = raw_scan.clone();
+#pragma omp parallel for schedule(static) num_threads(this->num_threads_)
   for (int i = 0; i < rows; ++i) {
-    float mean = 0;
-    for (int j = mincol; j < maxcol; ++j) {
-      mean += raw_scan.at<float>(i, j);
-    }
-    mean /= N;
-    for (int j = mincol; j < maxcol; ++j) {
-      q.at<float>(i, j) = raw_scan.at<float>(i, j) - mean;
-    }
+    const float *row = raw_scan.ptr<float>(i);
+    float *q_row = q.ptr<float>(i);
+    const float mean = rowSum(row, begin, end) / N;
+#pragma omp simd
+    for (int j = begin; j < end; ++j) q_row[j] = row[j] - mean;
   }
 
   // Create 1D Gaussian Filter
@@ -130,65 +207,36 @@ void Cen2018<PointT>::run(const cv::Mat &raw_scan, const float &res,
   cv::Mat p;
   cv::filter2D(q, p, -1, filter, cv::Point(-1, -1), 0, cv::BORDER_REFLECT101);
 
-  // Estimate variance of noise at each azimuth
-  for (int i = 0; i < rows; ++i) {
+  // Estimate variance of noise at each azimuth and extract peak centers
+  const auto detect = [&](const int i, DetectorScratch &scratch,
+                          std::vector<float> &ranges) {
+    const float *q_row = q.ptr<float>(i);
+    const float *p_row = p.ptr<float>(i);
+    float sigma = 0;
     int nonzero = 0;
-    for (int j = mincol; j < maxcol; ++j) {
-      float n = q.at<float>(i, j);
+    for (int j = begin; j < end; ++j) {
+      const float n = q_row[j];
       if (n < 0) {
-        sigma_q[i] += 2 * (n * n);
+        sigma += 2 * (n * n);
         nonzero++;
       }
     }
-    if (nonzero)
-      sigma_q[i] = sqrt(sigma_q[i] / nonzero);
-    else
-      sigma_q[i] = 0.034;
-  }
-  // Extract peak centers from each azimuth
-  // #pragma omp parallel for
-  for (int i = 0; i < rows; ++i) {
-    pcl::PointCloud<PointT> polar_time;
-    float peak_points = 0;
-    int num_peak_points = 0;
-    const float thres = zq_ * sigma_q[i];
-    const double azimuth = azimuth_angles[i];
-    const int64_t time = azimuth_times[i];
-    for (int j = mincol; j < maxcol; ++j) {
-      const float nqp = exp(
-          -0.5 * pow((q.at<float>(i, j) - p.at<float>(i, j)) / sigma_q[i], 2));
-      const float npp = exp(-0.5 * pow(p.at<float>(i, j) / sigma_q[i], 2));
+    sigma = nonzero ? sqrt(sigma / nonzero) : 0.034;
+
+    const float thres = zq_ * sigma;
+    auto &detected = scratch.detected;
+    detected.resize(cols);
+    for (int j = begin; j < end; ++j) {
+      const float nqp = exp(-0.5 * pow((q_row[j] - p_row[j]) / sigma, 2));
+      const float npp = exp(-0.5 * pow(p_row[j] / sigma, 2));
       const float b = nqp - npp;
-      const float y = q.at<float>(i, j) * (1 - nqp) + p.at<float>(i, j) * b;
-      if (y > thres) {
-        peak_points += j;
-        num_peak_points += 1;
-      } else if (num_peak_points > 0) {
-        PointT p;
-        p.rho = res * peak_points / num_peak_points + range_offset_;
-        p.phi = azimuth;
-        p.theta = 0;
-        p.timestamp = time;
-        polar_time.push_back(p);
-        peak_points = 0;
-        num_peak_points = 0;
-      }
+      const float y = q_row[j] * (1 - nqp) + p_row[j] * b;
+      detected[j] = y > thres;
     }
-    if (num_peak_points > 0) {
-      const double azimuth = azimuth_angles[rows - 1];
-      const int64_t time = azimuth_times[rows - 1];
-      PointT p;
-      p.rho = res * peak_points / num_peak_points + range_offset_;
-      p.phi = azimuth;
-      p.theta = 0;
-      p.timestamp = time;
-      polar_time.push_back(p);
-    }
-    // #pragma omp critical
-    {
-      pointcloud.insert(pointcloud.end(), polar_time.begin(), polar_time.end());
-    }
-  }
+    peakRanges(detected.data(), begin, end, res, range_offset_, true, ranges);
+  };
+  detectAzimuths(rows, azimuth_times, azimuth_angles, this->num_threads_,
+                 detect, pointcloud);
 }
 
 template <class PointT>
@@ -196,7 +244,6 @@ void CACFAR<PointT>::run(const cv::Mat &raw_scan, const float &res,
                          const std::vector<int64_t> &azimuth_times,
                          const std::vector<double> &azimuth_angles,
                          pcl::PointCloud<PointT> &pointcloud) {
-  pointcloud.clear();
   const int rows = raw_scan.rows;
   const int cols = raw_scan.cols;
   if (width_ % 2 == 0) width_ += 1;
@@ -207,49 +254,37 @@ void CACFAR<PointT>::run(const cv::Mat &raw_scan, const float &res,
   auto maxcol = maxr_ / res - w2 - guard_;
   if (maxcol > cols || maxcol < 0) maxcol = cols;
   const int N = maxcol - mincol;
+  const int mean_begin = mincol, mean_end = std::ceil(maxcol);
+  // training cells must be within the scan
+  const int begin = std::max(mean_begin, w2 + guard_);
+  const int end = std::min(mean_end, cols - w2 - guard_);
 
-  // #pragma omp parallel for
-  for (int i = 0; i < rows; ++i) {
-    const double azimuth = azimuth_angles[i];
-    const int64_t time = azimuth_times[i];
-    pcl::PointCloud<PointT> polar_time;
-    double mean = 0;
-    for (int j = mincol; j < maxcol; ++j) {
-      mean += raw_scan.at<float>(i, j);
-    }
-    mean /= N;
-
-    for (int j = mincol; j < maxcol; ++j) {
-      double stat = 0;  // (statistic) estimate of clutter power
-      double left = 0;
-      double right = 0;
-      // for (int k = -w2 - guard_; k <= w2 + guard_; ++k) {
-      //   if (k < -guard_ || k > guard_)
-      //     stat += raw_scan.at<float>(i, j + k);
-      // }
-      for (int k = -w2 - guard_; k < -guard_; ++k) {
-        left += raw_scan.at<float>(i, j + k);
-      }
-      for (int k = guard_ + 1; k <= w2 + guard_; ++k) {
-        right += raw_scan.at<float>(i, j + k);
-      }
-      stat = std::max(left, right);
+  const int guard = guard_, half_window = window / 2;
+  const double threshold = threshold_, threshold2 = threshold2_,
+               threshold3 = threshold3_;
+  const auto detect = [&](const int i, DetectorScratch &scratch,
+                          std::vector<float> &ranges) {
+    const float *row = raw_scan.ptr<float>(i);
+    const double mean = rowSum(row, mean_begin, mean_end) / N;
+    prefixSum(row, cols, scratch.prefix);
+    scratch.detected.resize(cols);
+    const double *prefix = scratch.prefix.data();
+    uint8_t *detected = scratch.detected.data();
+    // clutter power is the greater sum of the left and right training cells
+#pragma omp simd
+    for (int j = begin; j < end; ++j) {
+      const double left = prefix[j - guard] - prefix[j - w2 - guard];
+      const double right = prefix[j + w2 + guard + 1] - prefix[j + guard + 1];
+      const double stat = std::max(left, right);
       const float thres =
-          threshold_ * stat / (window / 2) + threshold2_ * mean + threshold3_;
-      if (raw_scan.at<float>(i, j) > thres) {
-        PointT p;
-        p.rho = j * res + range_offset_;
-        p.phi = azimuth;
-        p.theta = 0;
-        p.timestamp = time;
-        polar_time.push_back(p);
-      }
-    }
-    // #pragma omp critical
-    {
-      pointcloud.insert(pointcloud.end(), polar_time.begin(), polar_time.end());
+          threshold * stat / half_window + threshold2 * mean + threshold3;
+      detected[j] = row[j] > thres;
     }
-  }
+    for (int j = begin; j < end; ++j)
+      if (detected[j]) ranges.push_back(j * res + range_offset_);
+  };
+  detectAzimuths(rows, azimuth_times, azimuth_angles, this->num_threads_,
+                 detect, pointcloud);
 }
 
 template <class PointT>
@@ -257,7 +292,6 @@ void OSCFAR<PointT>::run(const cv::Mat &raw_scan, const float &res,
                          const std::vector<int64_t> &azimuth_times,
                          const std::vector<double> &azimuth_angles,
                          pcl::PointCloud<PointT> &pointcloud) {
-  pointcloud.clear();
   const int rows = raw_scan.rows;
   const int cols = raw_scan.cols;
   if (width_ % 2 == 0) width_ += 1;
@@ -267,79 +301,44 @@ void OSCFAR<PointT>::run(const cv::Mat &raw_scan, const float &res,
   auto maxcol = maxr_ / res - w2;
   if (maxcol > cols || maxcol < 0) maxcol = cols;
   const int N = maxcol - mincol;
+  const int mean_begin = mincol, mean_end = std::ceil(maxcol);
+  // training cells must be within the scan
+  const int begin = std::max(mean_begin, w2 + 1);
+  const int end = std::min(mean_end, cols - w2);
+  if (w2 < 1 || begin >= end) {
+    pointcloud.clear();
+    return;
+  }
+  const int kstat = std::clamp(kstat_, 0, 2 * w2 - 1);
 
-  // #pragma omp parallel for
-  for (int i = 0; i < rows; ++i) {
-    const double azimuth = azimuth_angles[i];
-    const int64_t time = azimuth_times[i];
-    pcl::PointCloud<PointT> polar_time;
-    double mean = 0;
-    for (int j = mincol; j < maxcol; ++j) {
-      mean += raw_scan.at<float>(i, j);
-    }
-    mean /= N;
-
-    std::vector<std::pair<int, float>> window;
-    window.reserve(width_ - 1);
-    int j = mincol - 1;
-    for (int k = -w2; k < 0; ++k) {
-      window.emplace_back(j + k, raw_scan.at<float>(i, j + k));
-    }
-    for (int k = 1; k <= w2; ++k) {
-      window.emplace_back(j + k, raw_scan.at<float>(i, j + k));
-    }
-    std::sort(window.begin(), window.end(), sort_asc_by_second);
-
-    float peak_points = 0;
-    int num_peak_points = 0;
+  const auto detect = [&](const int i, DetectorScratch &scratch,
+                          std::vector<float> &ranges) {
+    const float *row = raw_scan.ptr<float>(i);
+    const double mean = rowSum(row, mean_begin, mean_end) / N;
 
-    for (j = mincol; j < maxcol; ++j) {
-      // remove cell under test and left-most cell
-      window.erase(std::remove_if(window.begin(), window.end(),
-                                  [&](const std::pair<float, int> &p) -> bool {
-                                    return p.first == j ||
-                                           p.first == j - w2 - 1;
-                                  }),
-                   window.end());
-      // insert prev CUT and right-most cell
-      auto prevcut = std::make_pair(j - 1, raw_scan.at<float>(i, j - 1));
-      auto it = std::lower_bound(window.begin(), window.end(), prevcut,
-                                 sort_asc_by_second);
-      window.insert(it, prevcut);
-      auto newentry = std::make_pair(j + w2, raw_scan.at<float>(i, j + w2));
-      it = std::lower_bound(window.begin(), window.end(), newentry,
-                            sort_asc_by_second);
-      window.insert(it, newentry);
+    // sorted training cells around the cell under test, without guard cells
+    auto &window = scratch.window;
+    window.clear();
+    for (int k = -w2; k <= w2; ++k)
+      if (k != 0) window.push_back(row[begin - 1 + k]);
+    std::sort(window.begin(), window.end());
 
-      // DEBUG: check that the window is indeed sorted:
-      // assert(window.size() == width_ - 1);
-      // for (size_t k = 1; k < window.size(); ++k) {
-      //   if (window[k - 1].second > window[k].second) {
-      //     throw std::runtime_error("window not sorted.");
-      //   }
-      // }
+    auto &detected = scratch.detected;
+    detected.resize(cols);
+    for (int j = begin; j < end; ++j) {
+      // the cell under test becomes a training cell of the previous one, and
+      // the window slides by one cell
+      replaceSorted(window, row[j], row[j - 1]);
+      replaceSorted(window, row[j - w2 - 1], row[j + w2]);
       // (statistic) estimate of clutter power
-      double stat = window[kstat_].second;
+      const double stat = window[kstat];
       const float thres = threshold_ * stat + threshold2_ * mean + threshold3_;
-      if (raw_scan.at<float>(i, j) > thres) {
-        peak_points += j;
-        num_peak_points += 1;
-      } else if (num_peak_points > 0) {
-        PointT p;
-        p.rho = res * peak_points / num_peak_points + range_offset_;
-        p.phi = azimuth;
-        p.theta = 0;
-        p.timestamp = time;
-        polar_time.push_back(p);
-        peak_points = 0;
-        num_peak_points = 0;
-      }
-    }
-    // #pragma omp critical
-    {
-      pointcloud.insert(pointcloud.end(), polar_time.begin(), polar_time.end());
+      detected[j] = row[j] > thres;
     }
-  }
+    peakRanges(detected.data(), begin, end, res, range_offset_, false, ranges);
+  };
+  detectAzimuths(rows, azimuth_times, azimuth_angles, this->num_threads_,
+                 detect, pointcloud);
 }
 
 template <class PointT>
@@ -347,7 +346,6 @@ void ModifiedCACFAR<PointT>::run(const cv::Mat &raw_scan, const float &res,
                                  const std::vector<int64_t> &azimuth_times,
                                  const std::vector<double> &azimuth_angles,
                                  pcl::PointCloud<PointT> &pointcloud) {
-  pointcloud.clear();
   const int rows = raw_scan.rows;
   const int cols = raw_scan.cols;
   if (width_ % 2 == 0) width_ += 1;
@@ -357,48 +355,36 @@ void ModifiedCACFAR<PointT>::run(const cv::Mat &raw_scan, const float &res,
   auto maxcol = maxr_ / res - w2 - guard_;
   if (maxcol > cols || maxcol < 0) maxcol = cols;
   const int N = maxcol - mincol;
+  const int mean_begin = mincol, mean_end = std::ceil(maxcol);
+  // training cells must be within the scan
+  const int begin = std::max(mean_begin, w2 + guard_);
+  const int end = std::min(mean_end, cols - w2 - guard_);
 
-  for (int i = 0; i < rows; ++i) {
-    const double azimuth = azimuth_angles[i];
-    const int64_t time = azimuth_times[i];
-    pcl::PointCloud<PointT> polar_time;
-    double mean = 0;
-    for (int j = mincol; j < maxcol; ++j) {
-      mean += raw_scan.at<float>(i, j);
-    }
-    mean /= N;
-
-    float peak_points = 0;
-    int num_peak_points = 0;
-
-    for (int j = mincol; j < maxcol; ++j) {
-      double left = 0;
-      double right = 0;
-      for (int k = -w2 - guard_; k < -guard_; ++k)
-        left += raw_scan.at<float>(i, j + k);
-      for (int k = guard_ + 1; k <= w2 + guard_; ++k)
-        right += raw_scan.at<float>(i, j + k);
+  const int guard = guard_;
+  const double threshold = threshold_, threshold2 = threshold2_,
+               threshold3 = threshold3_;
+  const auto detect = [&](const int i, DetectorScratch &scratch,
+                          std::vector<float> &ranges) {
+    const float *row = raw_scan.ptr<float>(i);
+    const double mean = rowSum(row, mean_begin, mean_end) / N;
+    prefixSum(row, cols, scratch.prefix);
+    scratch.detected.resize(cols);
+    const double *prefix = scratch.prefix.data();
+    uint8_t *detected = scratch.detected.data();
+#pragma omp simd
+    for (int j = begin; j < end; ++j) {
+      const double left = prefix[j - guard] - prefix[j - w2 - guard];
+      const double right = prefix[j + w2 + guard + 1] - prefix[j + guard + 1];
       // (statistic) estimate of clutter power
-      // const double stat = (left + right) / (2 * w2);
       const double stat = std::max(left, right) / w2;  // GO-CFAR
-      const float thres = threshold_ * stat + threshold2_ * mean + threshold3_;
-      if (raw_scan.at<float>(i, j) > thres) {
-        peak_points += j;
-        num_peak_points += 1;
-      } else if (num_peak_points > 0) {
-        PointT p;
-        p.rho = res * peak_points / num_peak_points + range_offset_;
-        p.phi = azimuth;
-        p.theta = 0;
-        p.timestamp = time;
-        polar_time.push_back(p);
-        peak_points = 0;
-        num_peak_points = 0;
-      }
+      const float thres = threshold * stat + threshold2 * mean + threshold3;
+      detected[j] = row[j] > thres;
     }
-    pointcloud.insert(pointcloud.end(), polar_time.begin(), polar_time.end());
-  }
+    peakRanges(detected, begin, end, res, range_offset_, false, ranges);
+  };
+  detectAzimuths(rows, azimuth_times, azimuth_angles, this->num_threads_,
+                 detect, pointcloud);
 }
 
 }  // namespace radar
-}  // namespace vtr
\ No newline at end of file
+}  // namespace vtr
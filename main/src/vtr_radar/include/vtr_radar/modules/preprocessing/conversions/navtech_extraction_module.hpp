@@ -85,6 +85,9 @@ class NavtechExtractionModule : public tactic::BaseModule {
     double beta = 0.049;
     std::string chirp_type = "both";
 
+    /** \brief number of threads processing azimuths in the detector */
+    int num_threads = 4;
+
     bool visualize = false;
 
     static ConstPtr fromROS(const rclcpp::Node::SharedPtr &node,
@@ -18,6 +18,8 @@
  */
 #pragma once
 
+#include <memory>
+
 #include <opencv2/opencv.hpp>
 
 #include "vtr_radar/data_types/point.hpp"
@@ -31,7 +33,61 @@ void load_radar(const std::string &path, std::vector<int64_t> &timestamps,
 void load_radar(const cv::Mat &raw_data, std::vector<int64_t> &timestamps,
                 std::vector<double> &azimuths, cv::Mat &fft_data);
 
-/** \brief Returns the cartesian image of a radar scan */
+/**
+ * \brief Returns a view of every step-th azimuth (row) of a scan, starting
+ * from row offset. The view shares the data of scan, nothing is copied.
+ */
+cv::Mat decimate_azimuths(const cv::Mat &scan, const int step,
+                          const int offset = 0);
+
+/**
+ * \brief Precomputed cv::remap tables from a polar radar scan to its
+ * cartesian image. The tables only depend on the azimuths of the scan and the
+ * image parameters, so they are built once and reused for every scan.
+ */
+class PolarToCartesianRemap {
+ public:
+  using ConstPtr = std::shared_ptr<const PolarToCartesianRemap>;
+
+  /**
+   * \brief Returns the tables of these parameters, building them if they are
+   * not in the cache. Thread safe.
+   */
+  static ConstPtr get(const std::vector<double> &azimuths,
+                      const float radar_resolution,
+                      const float cart_resolution, const int cart_pixel_width,
+                      const bool interpolate_crossover);
+
+  PolarToCartesianRemap(const std::vector<double> &azimuths,
+                        const float radar_resolution,
+                        const float cart_resolution,
+                        const int cart_pixel_width,
+                        const bool interpolate_crossover);
+
+  bool matches(const std::vector<double> &azimuths,
+               const float radar_resolution, const float cart_resolution,
+               const int cart_pixel_width,
+               const bool interpolate_crossover) const;
+
+  void remap(const cv::Mat &fft_data, cv::Mat &cartesian,
+             const int output_type = CV_8UC1) const;
+
+ private:
+  const std::vector<double> azimuths_;
+  const float radar_resolution_;
+  const float cart_resolution_;
+  const int cart_pixel_width_;
+  const bool interpolate_crossover_;
+
+  /// fixed point tables from cv::convertMaps, which cv::remap would otherwise
+  /// recompute from floating point tables on every call
+  cv::Mat map1_, map2_;
+};
+
+/**
+ * \brief Returns the cartesian image of a radar scan
+ * \note uses the cached tables of PolarToCartesianRemap
+ */
 // clang-format off
 void radar_polar_to_cartesian(const cv::Mat &fft_data,
                               const std::vector<double> &azimuths,
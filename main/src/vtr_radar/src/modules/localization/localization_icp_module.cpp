@@ -19,6 +19,7 @@
 #include "vtr_radar/modules/localization/localization_icp_module.hpp"
 
 #include "vtr_radar/utils/nanoflann_utils.hpp"
+#include "vtr_tactic/icp_cost_term.hpp"
 
 namespace vtr {
 namespace radar {
@@ -99,6 +100,19 @@ void LocalizationICPModule::run_(QueryCache &qdata0, OutputCache &,
   /// compound transform for alignment (sensor to point map transform)
   const auto T_m_s_eval = inverse(compose(T_s_r_var, compose(T_r_v_var, T_v_m_var)));
 
+  /// optimization problem, reused across iterations with the point matches
+  /// refilled every iteration
+  // matches are accumulated in parallel inside the icp cost term, so the
+  // problem itself is single threaded
+  OptimizationProblem problem(1);
+  problem.addStateVariable(T_r_v_var);
+  if (config_->use_pose_prior) problem.addCostTerm(prior_cost_term);
+  // auto loss_func = HuberLossFunc::MakeShared(config_->huber_delta);
+  auto loss_func = CauchyLossFunc::MakeShared(config_->cauchy_k);
+  const auto icp_cost_term = ICPCostTerm::MakeShared({T_m_s_eval}, loss_func, config_->num_threads);
+  icp_cost_term->reserve(query_points.size());
+  problem.addCostTerm(icp_cost_term);
+
   /// Initialize aligned points for matching (Deep copy of targets)
   pcl::PointCloud<PointWithInfo> aligned_points(query_points);
 
@@ -194,20 +208,8 @@ void LocalizationICPModule::run_(QueryCache &qdata0, OutputCache &,
     /// point to point optimization
     timer[3]->start();
 
-    // initialize problem
-    OptimizationProblem problem(config_->num_threads);
-
-    // add variables
-    problem.addStateVariable(T_r_v_var);
-
-    // add prior cost terms
-    if (config_->use_pose_prior) problem.addCostTerm(prior_cost_term);
-
-    // shared loss function
-    // auto loss_func = HuberLossFunc::MakeShared(config_->huber_delta);
-    auto loss_func = CauchyLossFunc::MakeShared(config_->cauchy_k);
-    // cost terms and noise model
-#pragma omp parallel for schedule(dynamic, 10) num_threads(config_->num_threads)
+    // refill the icp cost term with the current matches
+    icp_cost_term->clear();
     for (const auto &ind : filtered_sample_inds) {
       // noise model W = n * n.T (information matrix)
       Eigen::Matrix3d W = [&] {
@@ -224,19 +226,12 @@ void LocalizationICPModule::run_(QueryCache &qdata0, OutputCache &,
         Eigen::Matrix3d W = Eigen::Matrix3d::Identity();
         return W;
       }();
-      auto noise_model = StaticNoiseModel<3>::MakeShared(W, NoiseType::INFORMATION);
 
       // query and reference point
       const auto qry_pt = query_mat.block<3, 1>(0, ind.first).cast<double>();
       const auto ref_pt = map_mat.block<3, 1>(0, ind.second).cast<double>();
 
-      const auto error_func = p2p::p2pError(T_m_s_eval, ref_pt, qry_pt);
-
-      // create cost term and add to problem
-      auto cost = WeightedLeastSqCostTerm<3>::MakeShared(error_func, noise_model, loss_func);
-
-#pragma omp critical(loc_icp_add_p2p_error_cost)
-      problem.addCostTerm(cost);
+      icp_cost_term->add(qry_pt, ref_pt, W);
     }
 
     // optimize
@@ -88,6 +88,8 @@ auto NavtechExtractionModule::Config::fromROS(
   config->beta = node->declare_parameter<double>(param_prefix + ".beta", config->beta);
   config->chirp_type = node->declare_parameter<std::string>(param_prefix + ".chirp_type", config->chirp_type);
 
+  config->num_threads = node->declare_parameter<int>(param_prefix + ".num_threads", config->num_threads);
+
   config->visualize = node->declare_parameter<bool>(param_prefix + ".visualize", config->visualize);
   // clang-format on
   return config;
@@ -124,7 +126,6 @@ void NavtechExtractionModule::run_(QueryCache &qdata0, OutputCache &,
   /// temp variables
   cv::Mat scan_use;
   cv::Mat fft_scan;
-  cv::Mat cartesian;
   std::vector<int64_t> azimuth_times;
   std::vector<double> azimuth_angles;
   /// \note for now we retrieve radar resolution from load_radar function
@@ -138,44 +139,23 @@ void NavtechExtractionModule::run_(QueryCache &qdata0, OutputCache &,
   float cart_resolution = config_->cart_resolution;
   beta = config_->beta;
 
-  // Downsample scan based on desired chirp type
+  // Downsample scan based on desired chirp type, without copying the scan
   if (config_->chirp_type == "up") {
     // Choose only every second row, starting from row 0
-    scan_use = cv::Mat::zeros(scan.rows / 2, scan.cols, cv::IMREAD_GRAYSCALE);
-    int j = 0;
-    for (int i = 0; i < scan.rows; i+=2) {
-      scan.row(i).copyTo(scan_use.row(j));
-      j++;
-    }
+    scan_use = decimate_azimuths(scan, 2, 0);
   } else if (config_->chirp_type == "down") {
     // Choose only every second row, starting from row 1
-    scan_use = cv::Mat::zeros(scan.rows / 2, scan.cols, cv::IMREAD_GRAYSCALE);
-    int j = 0;
-    for (int i = 1; i < scan.rows; i+=2) {
-      scan.row(i).copyTo(scan_use.row(i));
-      j++;
-    }
+    scan_use = decimate_azimuths(scan, 2, 1);
   } else{
     scan_use = scan;
   }
 
   // Load scan, times, azimuths from scan
   load_radar(scan_use, azimuth_times, azimuth_angles, fft_scan);
-
-  // Convert to cartesian BEV image
-  int cart_pixel_width = (2 * config_->maxr) / cart_resolution;
-  radar_polar_to_cartesian(fft_scan, azimuth_angles, cartesian,
-                           radar_resolution, cart_resolution, cart_pixel_width,
-                           true, CV_32F);
   CLOG(DEBUG, "radar.navtech_extractor")
       << "fft_scan has " << fft_scan.rows << " rows and " << fft_scan.cols
       << " cols with resolution " << radar_resolution;
 
-  CLOG(DEBUG, "radar.navtech_extractor") << "cartesian has " << cartesian.rows
-                                         << " rows and " << cartesian.cols
-                                         << " cols with resolution "
-                                         << cart_resolution;
-                                    
   CLOG(DEBUG, "radar.navtech_extractor") << "azimuth_angles has " << azimuth_angles.size() << " elements";
   CLOG(DEBUG, "radar.navtech_extractor") << "azimuth_times has " << azimuth_times.size() << " elements";
 
@@ -219,6 +199,7 @@ void NavtechExtractionModule::run_(QueryCache &qdata0, OutputCache &,
     Cen2018 detector = Cen2018<PointWithInfo>(
         config_->cen2018.zq, config_->cen2018.sigma, config_->minr,
         config_->maxr, config_->range_offset);
+    detector.setNumThreads(config_->num_threads);
     detector.run(fft_scan, radar_resolution, azimuth_times, azimuth_angles,
                  raw_point_cloud);
   } else if (config_->detector == "kstrongest") {
@@ -226,6 +207,7 @@ void NavtechExtractionModule::run_(QueryCache &qdata0, OutputCache &,
         config_->kstrong.kstrong, config_->kstrong.threshold2,
         config_->kstrong.threshold3, config_->minr, config_->maxr,
         config_->range_offset);
+    detector.setNumThreads(config_->num_threads);
     detector.run(fft_scan, radar_resolution, azimuth_times, azimuth_angles,
                  raw_point_cloud);
   } else if (config_->detector == "cacfar") {
@@ -233,6 +215,7 @@ void NavtechExtractionModule::run_(QueryCache &qdata0, OutputCache &,
         config_->cacfar.width, config_->cacfar.guard, config_->cacfar.threshold,
         config_->cacfar.threshold2, config_->cacfar.threshold3, config_->minr,
         config_->maxr, config_->range_offset);
+    detector.setNumThreads(config_->num_threads);
     detector.run(fft_scan, radar_resolution, azimuth_times, azimuth_angles,
                  raw_point_cloud);
   } else if (config_->detector == "oscfar") {
@@ -241,6 +224,7 @@ void NavtechExtractionModule::run_(QueryCache &qdata0, OutputCache &,
         config_->oscfar.threshold, config_->oscfar.threshold2,
         config_->oscfar.threshold3, config_->minr, config_->maxr,
         config_->range_offset);
+    detector.setNumThreads(config_->num_threads);
     detector.run(fft_scan, radar_resolution, azimuth_times, azimuth_angles,
                  raw_point_cloud);
   } else if (config_->detector == "modified_cacfar") {
@@ -249,6 +233,7 @@ void NavtechExtractionModule::run_(QueryCache &qdata0, OutputCache &,
         config_->modified_cacfar.threshold, config_->modified_cacfar.threshold2,
         config_->modified_cacfar.threshold3, config_->minr, config_->maxr,
         config_->range_offset);
+    detector.setNumThreads(config_->num_threads);
     detector.run(fft_scan, radar_resolution, azimuth_times, azimuth_angles,
                  raw_point_cloud);
   } else {
@@ -282,6 +267,13 @@ void NavtechExtractionModule::run_(QueryCache &qdata0, OutputCache &,
     fft_scan.convertTo(fft_scan_image.image, CV_8UC1, 255);
     fft_scan_pub_->publish(*fft_scan_image.toImageMsg());
 
+    // Convert to cartesian BEV image, only needed for visualization
+    cv::Mat cartesian;
+    int cart_pixel_width = (2 * config_->maxr) / cart_resolution;
+    radar_polar_to_cartesian(fft_scan, azimuth_angles, cartesian,
+                             radar_resolution, cart_resolution,
+                             cart_pixel_width, true, CV_32F);
+
     // publish the cartesian bev image
     cv_bridge::CvImage bev_scan_image;
     bev_scan_image.header.frame_id = "radar";
@@ -19,6 +19,13 @@
  */
 #include "vtr_radar/utils/utils.hpp"
 
+#include <array>
+#include <cstring>
+#include <list>
+#include <mutex>
+
+#include "vtr_logging/logging.hpp"
+
 namespace vtr {
 namespace radar {
 
@@ -36,19 +43,36 @@ void load_radar(const cv::Mat &raw_data, std::vector<int64_t> &timestamps,
   timestamps = std::vector<int64_t>(N, 0);
   azimuths = std::vector<double>(N, 0);
   const uint range_bins = raw_data.cols - 11;
-  fft_data = cv::Mat::zeros(N, range_bins, CV_32F);
-  // #pragma omp parallel
+  fft_data.create(N, range_bins, CV_32F);
+  // intensities are 8-bit, look them up instead of dividing every bin
+  static const auto intensity = []() {
+    std::array<float, 256> intensity;
+    for (int i = 0; i < 256; ++i) intensity[i] = (float)i / 255.0;
+    return intensity;
+  }();
   for (uint i = 0; i < N; ++i) {
     const uchar *byteArray = raw_data.ptr<uchar>(i);
-    timestamps[i] = *((int64_t *)(byteArray)) * time_convert;
-    azimuths[i] = *((uint16_t *)(byteArray + 8)) * encoder_conversion;
+    int64_t timestamp;
+    uint16_t encoder;
+    std::memcpy(&timestamp, byteArray, sizeof(timestamp));
+    std::memcpy(&encoder, byteArray + 8, sizeof(encoder));
+    timestamps[i] = timestamp * time_convert;
+    azimuths[i] = encoder * encoder_conversion;
     // The 10th byte is reserved but unused
-    for (uint j = 0; j < range_bins; ++j) {
-      fft_data.at<float>(i, j) = (float)*(byteArray + 11 + j) / 255.0;
-    }
+    const uchar *bins = byteArray + 11;
+    float *fft_row = fft_data.ptr<float>(i);
+    for (uint j = 0; j < range_bins; ++j) fft_row[j] = intensity[bins[j]];
   }
 }
 
+cv::Mat decimate_azimuths(const cv::Mat &scan, const int step,
+                          const int offset) {
+  const int rows = std::max(scan.rows - offset + step - 1, 0) / step;
+  if (rows == 0) return cv::Mat(0, scan.cols, scan.type());
+  return cv::Mat(rows, scan.cols, scan.type(),
+                 const_cast<uchar *>(scan.ptr(offset)), scan.step[0] * step);
+}
+
 // clang-format off
 namespace {
 
@@ -84,73 +108,115 @@ double get_azimuth_index(const std::vector<double> &azimuths,
 }
 // clang-format on
 
-void radar_polar_to_cartesian(const cv::Mat &fft_data,
-                              const std::vector<double> &azimuths,
-                              cv::Mat &cartesian, const float radar_resolution,
-                              const float cart_resolution,
-                              const int cart_pixel_width,
-                              const bool interpolate_crossover,
-                              const int output_type) {
-  cv::Mat fft = fft_data.clone();
+PolarToCartesianRemap::ConstPtr PolarToCartesianRemap::get(
+    const std::vector<double> &azimuths, const float radar_resolution,
+    const float cart_resolution, const int cart_pixel_width,
+    const bool interpolate_crossover) {
+  // a handful of entries covers all radar resolutions and image sizes in use
+  static constexpr size_t capacity = 4;
+  static std::mutex mutex;
+  static std::list<ConstPtr> cache;  // most recently used first
+
+  std::lock_guard<std::mutex> lock(mutex);
+  for (auto it = cache.begin(); it != cache.end(); ++it) {
+    if (!(*it)->matches(azimuths, radar_resolution, cart_resolution,
+                        cart_pixel_width, interpolate_crossover))
+      continue;
+    cache.splice(cache.begin(), cache, it);
+    return cache.front();
+  }
+  CLOG(DEBUG, "radar.utils")
+      << "Building polar to cartesian remap tables for " << azimuths.size()
+      << " azimuths, radar resolution " << radar_resolution
+      << ", cartesian resolution " << cart_resolution << " and width "
+      << cart_pixel_width;
+  cache.emplace_front(std::make_shared<const PolarToCartesianRemap>(
+      azimuths, radar_resolution, cart_resolution, cart_pixel_width,
+      interpolate_crossover));
+  if (cache.size() > capacity) cache.pop_back();
+  return cache.front();
+}
+
+PolarToCartesianRemap::PolarToCartesianRemap(
+    const std::vector<double> &azimuths, const float radar_resolution,
+    const float cart_resolution, const int cart_pixel_width,
+    const bool interpolate_crossover)
+    : azimuths_(azimuths),
+      radar_resolution_(radar_resolution),
+      cart_resolution_(cart_resolution),
+      cart_pixel_width_(cart_pixel_width),
+      interpolate_crossover_(interpolate_crossover) {
   float cart_min_range = (cart_pixel_width / 2) * cart_resolution;
   if (cart_pixel_width % 2 == 0)
     cart_min_range = (cart_pixel_width / 2 - 0.5) * cart_resolution;
 
-  cv::Mat map_x = cv::Mat::zeros(cart_pixel_width, cart_pixel_width, CV_32F);
-  cv::Mat map_y = cv::Mat::zeros(cart_pixel_width, cart_pixel_width, CV_32F);
-
-  // #pragma omp parallel for collapse(2)
-  for (int j = 0; j < map_y.cols; ++j) {
-    for (int i = 0; i < map_y.rows; ++i) {
-      map_y.at<float>(i, j) = -1 * cart_min_range + j * cart_resolution;
-    }
-  }
-  // #pragma omp parallel for collapse(2)
-  for (int i = 0; i < map_x.rows; ++i) {
-    for (int j = 0; j < map_x.cols; ++j) {
-      map_x.at<float>(i, j) = cart_min_range - i * cart_resolution;
-    }
-  }
-
-  cv::Mat range = cv::Mat::zeros(cart_pixel_width, cart_pixel_width, CV_32F);
-  cv::Mat angle = cv::Mat::zeros(cart_pixel_width, cart_pixel_width, CV_32F);
-  // double azimuth_step = azimuths[1] - azimuths[0];
-  // #pragma omp parallel for collapse(2)
-  for (int i = 0; i < range.rows; ++i) {
-    for (int j = 0; j < range.cols; ++j) {
-      float x = map_x.at<float>(i, j);
-      float y = map_y.at<float>(i, j);
+  cv::Mat range(cart_pixel_width, cart_pixel_width, CV_32F);
+  cv::Mat angle(cart_pixel_width, cart_pixel_width, CV_32F);
+#pragma omp parallel for schedule(dynamic, 10)
+  for (int i = 0; i < cart_pixel_width; ++i) {
+    float *range_row = range.ptr<float>(i);
+    float *angle_row = angle.ptr<float>(i);
+    const float x = cart_min_range - i * cart_resolution;
+    for (int j = 0; j < cart_pixel_width; ++j) {
+      const float y = -1 * cart_min_range + j * cart_resolution;
       float r = (sqrt(pow(x, 2) + pow(y, 2)) - radar_resolution / 2) /
                 radar_resolution;
       if (r < 0) r = 0;
-      range.at<float>(i, j) = r;
+      range_row[j] = r;
       float theta = atan2f(y, x);
       if (theta < 0) theta += 2 * M_PI;
-      // if (navtech_version == CIR204) {
-      angle.at<float>(i, j) = get_azimuth_index(azimuths, theta);
-      // } else {
-      // angle.at<float>(i, j) = (theta - azimuths[0]) / azimuth_step;
-      // }
-    }
-  }
-  if (interpolate_crossover) {
-    cv::Mat a0 = cv::Mat::zeros(1, fft.cols, CV_32F);
-    cv::Mat aN_1 = cv::Mat::zeros(1, fft.cols, CV_32F);
-    for (int j = 0; j < fft.cols; ++j) {
-      a0.at<float>(0, j) = fft.at<float>(0, j);
-      aN_1.at<float>(0, j) = fft.at<float>(fft.rows - 1, j);
+      angle_row[j] = get_azimuth_index(azimuths, theta);
+      // the scan is padded with one azimuth on each side
+      if (interpolate_crossover) angle_row[j] += 1;
     }
-    cv::vconcat(aN_1, fft, fft);
-    cv::vconcat(fft, a0, fft);
-    angle = angle + 1;
   }
+  cv::convertMaps(range, angle, map1_, map2_, CV_16SC2);
+}
+
+bool PolarToCartesianRemap::matches(const std::vector<double> &azimuths,
+                                    const float radar_resolution,
+                                    const float cart_resolution,
+                                    const int cart_pixel_width,
+                                    const bool interpolate_crossover) const {
+  return radar_resolution == radar_resolution_ &&
+         cart_resolution == cart_resolution_ &&
+         cart_pixel_width == cart_pixel_width_ &&
+         interpolate_crossover == interpolate_crossover_ &&
+         azimuths == azimuths_;
+}
 
-  cv::remap(fft, cartesian, range, angle, cv::INTER_LINEAR, cv::BORDER_CONSTANT,
-            cv::Scalar(0, 0, 0));
+void PolarToCartesianRemap::remap(const cv::Mat &fft_data, cv::Mat &cartesian,
+                                  const int output_type) const {
+  if (interpolate_crossover_) {
+    // wrap the last and the first azimuth around the scan
+    const int rows = fft_data.rows;
+    cv::Mat fft(rows + 2, fft_data.cols, fft_data.type());
+    fft_data.row(rows - 1).copyTo(fft.row(0));
+    fft_data.copyTo(fft.rowRange(1, rows + 1));
+    fft_data.row(0).copyTo(fft.row(rows + 1));
+    cv::remap(fft, cartesian, map1_, map2_, cv::INTER_LINEAR,
+              cv::BORDER_CONSTANT, cv::Scalar(0, 0, 0));
+  } else {
+    cv::remap(fft_data, cartesian, map1_, map2_, cv::INTER_LINEAR,
+              cv::BORDER_CONSTANT, cv::Scalar(0, 0, 0));
+  }
   if (output_type != CV_32F) {
     cartesian.convertTo(cartesian, output_type, 255.0);
   }
 }
 
+void radar_polar_to_cartesian(const cv::Mat &fft_data,
+                              const std::vector<double> &azimuths,
+                              cv::Mat &cartesian, const float radar_resolution,
+                              const float cart_resolution,
+                              const int cart_pixel_width,
+                              const bool interpolate_crossover,
+                              const int output_type) {
+  const auto remap = PolarToCartesianRemap::get(
+      azimuths, radar_resolution, cart_resolution, cart_pixel_width,
+      interpolate_crossover);
+  remap->remap(fft_data, cartesian, output_type);
+}
+
 }  // namespace radar
 }  // namespace vtr
\ No newline at end of file
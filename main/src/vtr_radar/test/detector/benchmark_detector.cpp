@@ -0,0 +1,187 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file benchmark_detector.cpp
+ * \brief Per-scan latency of the Navtech radar detectors vs. their previous
+ * scalar implementation.
+ *
+ * Usage: benchmark_detector [directory of recorded radar scans (png)]
+ * Without a directory, 400x3360 scans with clutter and targets are simulated.
+ */
+#include <filesystem>
+#include <random>
+
+#include "vtr_common/timing/stopwatch.hpp"
+#include "vtr_logging/logging_init.hpp"
+#include "vtr_radar/detector/detector.hpp"
+
+#include "legacy_detector.hpp"
+
+using namespace vtr;
+using namespace vtr::logging;
+using namespace vtr::radar;
+
+namespace {
+
+constexpr int num_simulated_scans = 20;
+constexpr int num_azimuths = 400;
+constexpr int num_range_bins = 3360;
+constexpr float res = 0.0438;
+constexpr double minr = 2.0;
+constexpr double maxr = 100.0;
+constexpr double range_offset = -0.31;
+constexpr int num_threads = 4;
+
+using legacy::Scan;
+const legacy::RangeConfig config{res, minr, maxr, range_offset};
+
+Scan simulateScan(std::mt19937 &gen) {
+  std::exponential_distribution<float> clutter(10.0);
+  std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  Scan scan;
+  scan.fft_data = cv::Mat::zeros(num_azimuths, num_range_bins, CV_32F);
+  for (int i = 0; i < num_azimuths; ++i) {
+    scan.times.push_back(i * 625000);
+    scan.azimuths.push_back(2 * M_PI * i / num_azimuths);
+    float *row = scan.fft_data.ptr<float>(i);
+    for (int j = 0; j < num_range_bins; ++j)
+      row[j] = std::min(clutter(gen), 1.0f);
+    // a few targets spread over several range bins
+    for (int t = 0; t < 20; ++t) {
+      const int center = 50 + uniform(gen) * (num_range_bins - 100);
+      const float peak = 0.4 + 0.6 * uniform(gen);
+      for (int k = -4; k <= 4; ++k)
+        row[center + k] = std::max(row[center + k], peak / (1 + k * k));
+    }
+  }
+  return scan;
+}
+
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  configureLogging("", true);
+
+  std::vector<Scan> scans;
+  if (argc > 1) {
+    for (const auto &entry : std::filesystem::directory_iterator(argv[1])) {
+      if (entry.path().extension() != ".png") continue;
+      Scan scan;
+      load_radar(entry.path().string(), scan.times, scan.azimuths,
+                 scan.fft_data);
+      scans.emplace_back(std::move(scan));
+    }
+  } else {
+    std::mt19937 gen(0);
+    for (int i = 0; i < num_simulated_scans; ++i)
+      scans.emplace_back(simulateScan(gen));
+  }
+  if (scans.empty()) {
+    CLOG(ERROR, "test") << "No radar scans found in " << argv[1];
+    return 1;
+  }
+  CLOG(INFO, "test") << "Running detectors on " << scans.size() << " "
+                     << scans.front().fft_data.rows << "x"
+                     << scans.front().fft_data.cols << " scans";
+
+  common::timing::Stopwatch<> timer(false);
+  pcl::PointCloud<PointWithInfo> pointcloud;
+
+  /// runs func on every scan, returns latency per scan and number of points
+  const auto time_scans = [&](const auto &func) {
+    size_t num_points = 0;
+    timer.reset();
+    for (const auto &scan : scans) {
+      timer.start();
+      func(scan);
+      timer.stop();
+      num_points += pointcloud.size();
+    }
+    const auto ms = (double)timer.count<std::chrono::microseconds>() / 1000.0;
+    return std::make_pair(ms / scans.size(), num_points);
+  };
+
+  const auto report = [&](const std::string &name, const auto &legacy_func,
+                          auto &detector) {
+    const auto [legacy_ms, legacy_points] = time_scans(legacy_func);
+    const auto run = [&](const Scan &scan) {
+      detector.run(scan.fft_data, res, scan.times, scan.azimuths, pointcloud);
+    };
+    detector.setNumThreads(1);
+    const auto [serial_ms, serial_points] = time_scans(run);
+    detector.setNumThreads(num_threads);
+    const auto [parallel_ms, parallel_points] = time_scans(run);
+    CLOG(INFO, "test") << name << ": previous " << legacy_ms << " ms, 1 thread "
+                       << serial_ms << " ms, " << num_threads << " threads "
+                       << parallel_ms << " ms per scan (" << legacy_points
+                       << " vs " << serial_points << " vs " << parallel_points
+                       << " points)";
+  };
+
+  {
+    KStrongest<PointWithInfo> detector(10, 0.5, 0.22, minr, maxr,
+                                       range_offset);
+    report(
+        "K-strongest",
+        [&](const Scan &scan) {
+          legacy::kstrongest(scan, config, 10, 0.5, 0.22, pointcloud);
+        },
+        detector);
+  }
+  {
+    Cen2018<PointWithInfo> detector(3.0, 17, minr, maxr, range_offset);
+    report(
+        "Cen2018",
+        [&](const Scan &scan) {
+          legacy::cen2018(scan, config, 3.0, 17, pointcloud);
+        },
+        detector);
+  }
+  {
+    CACFAR<PointWithInfo> detector(40, 2, 0.5, 0.5, 0.22, minr, maxr,
+                                   range_offset);
+    report(
+        "CA-CFAR",
+        [&](const Scan &scan) {
+          legacy::cacfar(scan, config, 40, 2, 0.5, 0.5, 0.22, false,
+                         pointcloud);
+        },
+        detector);
+  }
+  {
+    OSCFAR<PointWithInfo> detector(40, 2, 20, 0.5, 0.5, 0.22, minr, maxr,
+                                   range_offset);
+    report(
+        "OS-CFAR",
+        [&](const Scan &scan) {
+          legacy::oscfar(scan, config, 40, 20, 0.5, 0.5, 0.22, pointcloud);
+        },
+        detector);
+  }
+  {
+    ModifiedCACFAR<PointWithInfo> detector(40, 2, 0.5, 0.5, 0.22, minr, maxr,
+                                           range_offset);
+    report(
+        "Modified CA-CFAR",
+        [&](const Scan &scan) {
+          legacy::cacfar(scan, config, 40, 2, 0.5, 0.5, 0.22, true,
+                         pointcloud);
+        },
+        detector);
+  }
+
+  return 0;
+}
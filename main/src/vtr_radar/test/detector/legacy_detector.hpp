@@ -0,0 +1,290 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file legacy_detector.hpp
+ * \brief Previous scalar implementation of the Navtech radar detectors, one
+ * azimuth at a time, as a reference for tests and benchmarks.
+ */
+#pragma once
+
+#include "vtr_radar/detector/detector.hpp"
+
+namespace vtr {
+namespace radar {
+namespace legacy {
+
+struct Scan {
+  cv::Mat fft_data;
+  std::vector<int64_t> times;
+  std::vector<double> azimuths;
+};
+
+struct RangeConfig {
+  float res;
+  double minr;
+  double maxr;
+  double range_offset;
+};
+
+
+template <class PointT>
+void emit(const float rho, const double azimuth, const int64_t time,
+          pcl::PointCloud<PointT> &polar_time) {
+  PointT p;
+  p.rho = rho;
+  p.phi = azimuth;
+  p.theta = 0;
+  p.timestamp = time;
+  polar_time.push_back(p);
+}
+
+template <class PointT>
+void kstrongest(const Scan &scan, const RangeConfig &config,
+                const int kstrong, const double threshold2,
+                const double threshold3, pcl::PointCloud<PointT> &pointcloud) {
+  const auto &raw_scan = scan.fft_data;
+  const auto [res, minr, maxr, range_offset] = config;
+  pointcloud.clear();
+  const int rows = raw_scan.rows;
+  const int cols = raw_scan.cols;
+  auto mincol = minr / res;
+  if (mincol > cols || mincol < 0) mincol = 0;
+  auto maxcol = maxr / res;
+  if (maxcol > cols || maxcol < 0) maxcol = cols;
+  const auto N = maxcol - mincol;
+  for (int i = 0; i < rows; ++i) {
+    std::vector<std::pair<float, int>> intens;
+    intens.reserve(N / 2);
+    double mean = 0;
+    for (int j = mincol; j < maxcol; ++j) mean += raw_scan.at<float>(i, j);
+    mean /= N;
+    const double thres = mean * threshold2 + threshold3;
+    for (int j = mincol; j < maxcol; ++j) {
+      if (raw_scan.at<float>(i, j) >= thres)
+        intens.emplace_back(raw_scan.at<float>(i, j), j);
+    }
+    std::sort(intens.begin(), intens.end(),
+              [](const auto &a, const auto &b) { return a.first > b.first; });
+    pcl::PointCloud<PointT> polar_time;
+    for (int j = 0; j < kstrong && j < (int)intens.size(); ++j)
+      emit(float(intens[j].second) * res + range_offset, scan.azimuths[i],
+           scan.times[i], polar_time);
+    pointcloud.insert(pointcloud.end(), polar_time.begin(), polar_time.end());
+  }
+}
+
+template <class PointT>
+void cen2018(const Scan &scan, const RangeConfig &config, const double zq,
+             const int sigma, pcl::PointCloud<PointT> &pointcloud) {
+  const auto &raw_scan = scan.fft_data;
+  const auto [res, minr, maxr, range_offset] = config;
+  pointcloud.clear();
+  const int rows = raw_scan.rows;
+  const int cols = raw_scan.cols;
+  auto mincol = minr / res;
+  if (mincol > cols || mincol < 0) mincol = 0;
+  auto maxcol = maxr / res;
+  if (maxcol > cols || maxcol < 0) maxcol = cols;
+  const auto N = maxcol - mincol;
+  std::vector<float> sigma_q(rows, 0);
+  cv::Mat q = raw_scan.clone();
+  for (int i = 0; i < rows; ++i) {
+    float mean = 0;
+    for (int j = mincol; j < maxcol; ++j) mean += raw_scan.at<float>(i, j);
+    mean /= N;
+    for (int j = mincol; j < maxcol; ++j)
+      q.at<float>(i, j) = raw_scan.at<float>(i, j) - mean;
+  }
+  int fsize = sigma * 2 * 3;
+  if (fsize % 2 == 0) fsize += 1;
+  const int mu = fsize / 2;
+  const float sig_sqr = sigma * sigma;
+  cv::Mat filter = cv::Mat::zeros(1, fsize, CV_32F);
+  float s = 0;
+  for (int i = 0; i < fsize; ++i) {
+    filter.at<float>(0, i) = exp(-0.5 * (i - mu) * (i - mu) / sig_sqr);
+    s += filter.at<float>(0, i);
+  }
+  filter /= s;
+  cv::Mat p;
+  cv::filter2D(q, p, -1, filter, cv::Point(-1, -1), 0, cv::BORDER_REFLECT101);
+  for (int i = 0; i < rows; ++i) {
+    int nonzero = 0;
+    for (int j = mincol; j < maxcol; ++j) {
+      float n = q.at<float>(i, j);
+      if (n < 0) {
+        sigma_q[i] += 2 * (n * n);
+        nonzero++;
+      }
+    }
+    if (nonzero)
+      sigma_q[i] = sqrt(sigma_q[i] / nonzero);
+    else
+      sigma_q[i] = 0.034;
+  }
+  for (int i = 0; i < rows; ++i) {
+    pcl::PointCloud<PointT> polar_time;
+    float peak_points = 0;
+    int num_peak_points = 0;
+    const float thres = zq * sigma_q[i];
+    for (int j = mincol; j < maxcol; ++j) {
+      const float nqp = exp(
+          -0.5 * pow((q.at<float>(i, j) - p.at<float>(i, j)) / sigma_q[i], 2));
+      const float npp = exp(-0.5 * pow(p.at<float>(i, j) / sigma_q[i], 2));
+      const float b = nqp - npp;
+      const float y = q.at<float>(i, j) * (1 - nqp) + p.at<float>(i, j) * b;
+      if (y > thres) {
+        peak_points += j;
+        num_peak_points += 1;
+      } else if (num_peak_points > 0) {
+        emit(res * peak_points / num_peak_points + range_offset,
+             scan.azimuths[i], scan.times[i], polar_time);
+        peak_points = 0;
+        num_peak_points = 0;
+      }
+    }
+    if (num_peak_points > 0)
+      emit(res * peak_points / num_peak_points + range_offset,
+           scan.azimuths[i], scan.times[i], polar_time);
+    pointcloud.insert(pointcloud.end(), polar_time.begin(), polar_time.end());
+  }
+}
+
+/** \brief CA-CFAR (peaks = false) and modified CA-CFAR (peaks = true) */
+template <class PointT>
+void cacfar(const Scan &scan, const RangeConfig &config, int width,
+            const int guard, const double threshold, const double threshold2,
+            const double threshold3, const bool peaks,
+            pcl::PointCloud<PointT> &pointcloud) {
+  const auto &raw_scan = scan.fft_data;
+  const auto [res, minr, maxr, range_offset] = config;
+  pointcloud.clear();
+  const int rows = raw_scan.rows;
+  const int cols = raw_scan.cols;
+  if (width % 2 == 0) width += 1;
+  const int w2 = std::floor(width / 2);
+  const int window = width + guard * 2;
+  auto mincol = minr / res + w2 + guard + 1;
+  if (mincol > cols || mincol < 0) mincol = 0;
+  auto maxcol = maxr / res - w2 - guard;
+  if (maxcol > cols || maxcol < 0) maxcol = cols;
+  const int N = maxcol - mincol;
+  for (int i = 0; i < rows; ++i) {
+    pcl::PointCloud<PointT> polar_time;
+    double mean = 0;
+    for (int j = mincol; j < maxcol; ++j) mean += raw_scan.at<float>(i, j);
+    mean /= N;
+    float peak_points = 0;
+    int num_peak_points = 0;
+    for (int j = mincol; j < maxcol; ++j) {
+      double left = 0;
+      double right = 0;
+      for (int k = -w2 - guard; k < -guard; ++k)
+        left += raw_scan.at<float>(i, j + k);
+      for (int k = guard + 1; k <= w2 + guard; ++k)
+        right += raw_scan.at<float>(i, j + k);
+      const double stat = std::max(left, right);
+      const float thres =
+          (peaks ? threshold * (stat / w2) : threshold * stat / (window / 2)) +
+          threshold2 * mean + threshold3;
+      const bool detected = raw_scan.at<float>(i, j) > thres;
+      if (!peaks) {
+        if (detected)
+          emit(j * res + range_offset, scan.azimuths[i], scan.times[i],
+               polar_time);
+      } else if (detected) {
+        peak_points += j;
+        num_peak_points += 1;
+      } else if (num_peak_points > 0) {
+        emit(res * peak_points / num_peak_points + range_offset,
+             scan.azimuths[i], scan.times[i], polar_time);
+        peak_points = 0;
+        num_peak_points = 0;
+      }
+    }
+    pointcloud.insert(pointcloud.end(), polar_time.begin(), polar_time.end());
+  }
+}
+
+template <class PointT>
+void oscfar(const Scan &scan, const RangeConfig &config, int width,
+            const int kstat, const double threshold, const double threshold2,
+            const double threshold3, pcl::PointCloud<PointT> &pointcloud) {
+  const auto &raw_scan = scan.fft_data;
+  const auto [res, minr, maxr, range_offset] = config;
+  pointcloud.clear();
+  const int rows = raw_scan.rows;
+  const int cols = raw_scan.cols;
+  if (width % 2 == 0) width += 1;
+  const int w2 = std::floor(width / 2);
+  auto mincol = minr / res + w2 + 1;
+  if (mincol > cols || mincol < 0) mincol = 0;
+  auto maxcol = maxr / res - w2;
+  if (maxcol > cols || maxcol < 0) maxcol = cols;
+  const int N = maxcol - mincol;
+  const auto by_value = [](const std::pair<int, float> &a,
+                           const std::pair<int, float> &b) {
+    return a.second < b.second;
+  };
+  for (int i = 0; i < rows; ++i) {
+    pcl::PointCloud<PointT> polar_time;
+    double mean = 0;
+    for (int j = mincol; j < maxcol; ++j) mean += raw_scan.at<float>(i, j);
+    mean /= N;
+    std::vector<std::pair<int, float>> window;
+    window.reserve(width - 1);
+    int j = mincol - 1;
+    for (int k = -w2; k < 0; ++k)
+      window.emplace_back(j + k, raw_scan.at<float>(i, j + k));
+    for (int k = 1; k <= w2; ++k)
+      window.emplace_back(j + k, raw_scan.at<float>(i, j + k));
+    std::sort(window.begin(), window.end(), by_value);
+    float peak_points = 0;
+    int num_peak_points = 0;
+    for (j = mincol; j < maxcol; ++j) {
+      window.erase(std::remove_if(window.begin(), window.end(),
+                                  [&](const std::pair<int, float> &p) {
+                                    return p.first == j ||
+                                           p.first == j - w2 - 1;
+                                  }),
+                   window.end());
+      auto prevcut = std::make_pair(j - 1, raw_scan.at<float>(i, j - 1));
+      window.insert(std::lower_bound(window.begin(), window.end(), prevcut,
+                                     by_value),
+                    prevcut);
+      auto newentry = std::make_pair(j + w2, raw_scan.at<float>(i, j + w2));
+      window.insert(std::lower_bound(window.begin(), window.end(), newentry,
+                                     by_value),
+                    newentry);
+      const double stat = window[kstat].second;
+      const float thres = threshold * stat + threshold2 * mean + threshold3;
+      if (raw_scan.at<float>(i, j) > thres) {
+        peak_points += j;
+        num_peak_points += 1;
+      } else if (num_peak_points > 0) {
+        emit(res * peak_points / num_peak_points + range_offset,
+             scan.azimuths[i], scan.times[i], polar_time);
+        peak_points = 0;
+        num_peak_points = 0;
+      }
+    }
+    pointcloud.insert(pointcloud.end(), polar_time.begin(), polar_time.end());
+  }
+}
+
+
+}  // namespace legacy
+}  // namespace radar
+}  // namespace vtr
@@ -0,0 +1,203 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file test_detector.cpp
+ * \brief Checks that the radar detectors find exactly the same points as
+ * their previous scalar implementation.
+ */
+#include <gmock/gmock.h>
+
+#include <random>
+
+#include "vtr_logging/logging_init.hpp"
+#include "vtr_radar/detector/detector.hpp"
+
+#include "legacy_detector.hpp"
+
+using namespace ::testing;  // NOLINT
+using namespace vtr;
+using namespace vtr::logging;
+using namespace vtr::radar;
+
+namespace {
+
+constexpr int num_scans = 3;
+constexpr int num_azimuths = 64;
+constexpr int num_range_bins = 512;
+constexpr float res = 0.25;
+
+/**
+ * \brief Simulated scans with clutter and targets, with intensities such that
+ * every sum of a detector is exact and both implementations see the same
+ * values. If unique, no two range bins of an azimuth have the same intensity,
+ * otherwise intensities are multiples of 1/256 (sums exact in float).
+ */
+std::vector<legacy::Scan> simulateScans(const bool unique) {
+  std::mt19937 gen(0);
+  std::exponential_distribution<float> clutter(10.0);
+  std::uniform_real_distribution<float> uniform(0.0, 1.0);
+  std::vector<legacy::Scan> scans(num_scans);
+  for (auto &scan : scans) {
+    scan.fft_data = cv::Mat::zeros(num_azimuths, num_range_bins, CV_32F);
+    for (int i = 0; i < num_azimuths; ++i) {
+      scan.times.push_back(i * 625000);
+      scan.azimuths.push_back(2 * M_PI * i / num_azimuths);
+      float *row = scan.fft_data.ptr<float>(i);
+      for (int j = 0; j < num_range_bins; ++j)
+        row[j] = std::min(clutter(gen), 1.0f);
+      // targets at the edges of the scan as well
+      for (int t = 0; t < 6; ++t) {
+        const int center = uniform(gen) * num_range_bins;
+        const float peak = 0.4 + 0.6 * uniform(gen);
+        for (int k = -4; k <= 4; ++k) {
+          if (center + k < 0 || center + k >= num_range_bins) continue;
+          row[center + k] = std::max(row[center + k], peak / (1 + k * k));
+        }
+      }
+      for (int j = 0; j < num_range_bins; ++j) {
+        if (unique)  // 12 bits of intensity, 12 bits of range bin
+          row[j] = std::ldexp(std::floor(row[j] * 4095) * 4096 + j, -24);
+        else
+          row[j] = std::round(row[j] * 256) / 256;
+      }
+    }
+  }
+  return scans;
+}
+
+/** \brief Ranges within the scans, and up to both ends of the scans */
+const std::vector<legacy::RangeConfig> range_configs{
+    {res, 2.0, 100.0, -0.31}, {res, 0.0, num_range_bins * res, -0.31}};
+
+/**
+ * \brief Runs detector with 1 and 4 threads and legacy on every scan, and
+ * expects the same points in the same order.
+ */
+template <class LegacyFunc>
+void expectSameDetections(const std::vector<legacy::Scan> &scans,
+                          const LegacyFunc &legacy_func,
+                          Detector<PointWithInfo> &detector) {
+  pcl::PointCloud<PointWithInfo> expected, pointcloud;
+  size_t num_points = 0;
+  for (const auto &scan : scans) {
+    legacy_func(scan, expected);
+    num_points += expected.size();
+    for (const int num_threads : {1, 4}) {
+      detector.setNumThreads(num_threads);
+      detector.run(scan.fft_data, res, scan.times, scan.azimuths, pointcloud);
+      ASSERT_EQ(pointcloud.size(), expected.size());
+      for (size_t k = 0; k < expected.size(); ++k) {
+        EXPECT_EQ(pointcloud[k].rho, expected[k].rho) << "point " << k;
+        EXPECT_EQ(pointcloud[k].phi, expected[k].phi) << "point " << k;
+        EXPECT_EQ(pointcloud[k].timestamp, expected[k].timestamp);
+      }
+    }
+  }
+  EXPECT_GT(num_points, (size_t)0);
+}
+
+}  // namespace
+
+TEST(RADAR, detector_kstrongest) {
+  const auto scans = simulateScans(true);
+  for (const auto &config : range_configs) {
+    KStrongest<PointWithInfo> detector(10, 0.5, 0.22, config.minr, config.maxr,
+                                       config.range_offset);
+    expectSameDetections(
+        scans,
+        [&](const legacy::Scan &scan, pcl::PointCloud<PointWithInfo> &pc) {
+          legacy::kstrongest(scan, config, 10, 0.5, 0.22, pc);
+        },
+        detector);
+  }
+}
+
+TEST(RADAR, detector_cen2018) {
+  const auto scans = simulateScans(false);
+  for (const auto &config : range_configs) {
+    Cen2018<PointWithInfo> detector(3.0, 17, config.minr, config.maxr,
+                                    config.range_offset);
+    expectSameDetections(
+        scans,
+        [&](const legacy::Scan &scan, pcl::PointCloud<PointWithInfo> &pc) {
+          legacy::cen2018(scan, config, 3.0, 17, pc);
+        },
+        detector);
+  }
+}
+
+TEST(RADAR, detector_cacfar) {
+  const auto scans = simulateScans(true);
+  for (const auto &config : range_configs) {
+    for (const int guard : {0, 2}) {
+      for (const int width : {16, 41}) {
+        CACFAR<PointWithInfo> detector(width, guard, 1.0, 0.5, 0.22,
+                                       config.minr, config.maxr,
+                                       config.range_offset);
+        expectSameDetections(
+            scans,
+            [&](const legacy::Scan &scan, pcl::PointCloud<PointWithInfo> &pc) {
+              legacy::cacfar(scan, config, width, guard, 1.0, 0.5, 0.22, false,
+                             pc);
+            },
+            detector);
+      }
+    }
+  }
+}
+
+TEST(RADAR, detector_oscfar) {
+  const auto scans = simulateScans(true);
+  for (const auto &config : range_configs) {
+    for (const int width : {16, 41}) {
+      const int kstat = width / 2;
+      OSCFAR<PointWithInfo> detector(width, 0, kstat, 1.0, 0.5, 0.22,
+                                     config.minr, config.maxr,
+                                     config.range_offset);
+      expectSameDetections(
+          scans,
+          [&](const legacy::Scan &scan, pcl::PointCloud<PointWithInfo> &pc) {
+            legacy::oscfar(scan, config, width, kstat, 1.0, 0.5, 0.22, pc);
+          },
+          detector);
+    }
+  }
+}
+
+TEST(RADAR, detector_modified_cacfar) {
+  const auto scans = simulateScans(true);
+  for (const auto &config : range_configs) {
+    for (const int guard : {0, 2}) {
+      for (const int width : {16, 41}) {
+        ModifiedCACFAR<PointWithInfo> detector(width, guard, 1.0, 0.5, 0.22,
+                                               config.minr, config.maxr,
+                                               config.range_offset);
+        expectSameDetections(
+            scans,
+            [&](const legacy::Scan &scan, pcl::PointCloud<PointWithInfo> &pc) {
+              legacy::cacfar(scan, config, width, guard, 1.0, 0.5, 0.22, true,
+                             pc);
+            },
+            detector);
+      }
+    }
+  }
+}
+
+int main(int argc, char **argv) {
+  configureLogging("", true);
+  InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,204 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file benchmark_polar_to_cartesian.cpp
+ * \brief Per-scan latency of radar preprocessing (chirp decimation, scan
+ * loading and cartesian image) vs. the previous per-scan implementation.
+ */
+#include <random>
+
+#include "vtr_common/timing/stopwatch.hpp"
+#include "vtr_logging/logging_init.hpp"
+#include "vtr_radar/utils/utils.hpp"
+
+using namespace vtr;
+using namespace vtr::logging;
+using namespace vtr::radar;
+
+namespace {
+
+constexpr int num_scans = 20;
+constexpr int num_azimuths = 800;  // both chirps
+constexpr int num_range_bins = 3360;
+constexpr float radar_resolution = 0.0438;
+constexpr float cart_resolution = 0.2384;
+constexpr double maxr = 100.0;
+
+/** \brief A raw Navtech scan: timestamp, encoder, reserved byte, intensities */
+cv::Mat simulateRawScan(std::mt19937 &gen) {
+  std::uniform_int_distribution<int> intensity(0, 255);
+  cv::Mat raw(num_azimuths, num_range_bins + 11, CV_8UC1);
+  for (int i = 0; i < num_azimuths; ++i) {
+    uchar *row = raw.ptr<uchar>(i);
+    const int64_t timestamp = 1000000 + i * 312;
+    const uint16_t encoder = (i / 2) * 5600 / (num_azimuths / 2);
+    std::memcpy(row, &timestamp, sizeof(timestamp));
+    std::memcpy(row + 8, &encoder, sizeof(encoder));
+    row[10] = 0;
+    for (int j = 0; j < num_range_bins; ++j) row[11 + j] = intensity(gen);
+  }
+  return raw;
+}
+
+/// Previous implementation, tables and copies rebuilt for every scan
+namespace legacy {
+
+cv::Mat decimate(const cv::Mat &scan) {
+  cv::Mat scan_use = cv::Mat::zeros(scan.rows / 2, scan.cols, CV_8UC1);
+  int j = 0;
+  for (int i = 0; i < scan.rows; i += 2) scan.row(i).copyTo(scan_use.row(j++));
+  return scan_use;
+}
+
+void load_radar(const cv::Mat &raw_data, std::vector<int64_t> &timestamps,
+                std::vector<double> &azimuths, cv::Mat &fft_data) {
+  const int64_t time_convert = 1000;
+  const double encoder_conversion = 2 * M_PI / 5600;
+  const uint N = raw_data.rows;
+  timestamps = std::vector<int64_t>(N, 0);
+  azimuths = std::vector<double>(N, 0);
+  const uint range_bins = raw_data.cols - 11;
+  fft_data = cv::Mat::zeros(N, range_bins, CV_32F);
+  for (uint i = 0; i < N; ++i) {
+    const uchar *byteArray = raw_data.ptr<uchar>(i);
+    timestamps[i] = *((int64_t *)(byteArray)) * time_convert;
+    azimuths[i] = *((uint16_t *)(byteArray + 8)) * encoder_conversion;
+    for (uint j = 0; j < range_bins; ++j)
+      fft_data.at<float>(i, j) = (float)*(byteArray + 11 + j) / 255.0;
+  }
+}
+
+double get_azimuth_index(const std::vector<double> &azimuths,
+                         const double azimuth) {
+  const auto low = std::lower_bound(azimuths.begin(), azimuths.end(), azimuth);
+  int closest = std::min<int>(low - azimuths.begin(), azimuths.size() - 1);
+  if (closest > 0 && std::fabs(azimuth - azimuths[closest - 1]) <
+                         std::fabs(azimuth - azimuths[closest]))
+    --closest;
+  const int M = azimuths.size();
+  double index = closest;
+  if (azimuths[closest] < azimuth && closest < M - 1)
+    index += (azimuth - azimuths[closest]) /
+             (azimuths[closest + 1] - azimuths[closest]);
+  else if (azimuths[closest] > azimuth && closest > 0)
+    index -= (azimuths[closest] - azimuth) /
+             (azimuths[closest] - azimuths[closest - 1]);
+  return index;
+}
+
+void radar_polar_to_cartesian(const cv::Mat &fft_data,
+                              const std::vector<double> &azimuths,
+                              cv::Mat &cartesian, const int cart_pixel_width) {
+  cv::Mat fft = fft_data.clone();
+  float cart_min_range = (cart_pixel_width / 2) * cart_resolution;
+  if (cart_pixel_width % 2 == 0)
+    cart_min_range = (cart_pixel_width / 2 - 0.5) * cart_resolution;
+  cv::Mat range = cv::Mat::zeros(cart_pixel_width, cart_pixel_width, CV_32F);
+  cv::Mat angle = cv::Mat::zeros(cart_pixel_width, cart_pixel_width, CV_32F);
+  for (int i = 0; i < range.rows; ++i) {
+    for (int j = 0; j < range.cols; ++j) {
+      const float x = cart_min_range - i * cart_resolution;
+      const float y = -1 * cart_min_range + j * cart_resolution;
+      float r = (sqrt(pow(x, 2) + pow(y, 2)) - radar_resolution / 2) /
+                radar_resolution;
+      if (r < 0) r = 0;
+      range.at<float>(i, j) = r;
+      float theta = atan2f(y, x);
+      if (theta < 0) theta += 2 * M_PI;
+      angle.at<float>(i, j) = get_azimuth_index(azimuths, theta);
+    }
+  }
+  cv::Mat a0 = fft.row(0).clone(), aN_1 = fft.row(fft.rows - 1).clone();
+  cv::vconcat(aN_1, fft, fft);
+  cv::vconcat(fft, a0, fft);
+  angle = angle + 1;
+  cv::remap(fft, cartesian, range, angle, cv::INTER_LINEAR,
+            cv::BORDER_CONSTANT, cv::Scalar(0, 0, 0));
+}
+
+}  // namespace legacy
+
+}  // namespace
+
+int main(int, char **) {
+  configureLogging("", true);
+
+  std::mt19937 gen(42);
+  std::vector<cv::Mat> scans;
+  for (int i = 0; i < num_scans; ++i) scans.emplace_back(simulateRawScan(gen));
+
+  const int cart_pixel_width = (2 * maxr) / cart_resolution;
+
+  common::timing::Stopwatch<> timer(false);
+  const auto elapsed_ms = [&timer]() {
+    const auto ms = (double)timer.count<std::chrono::microseconds>() / 1000.0;
+    timer.reset();
+    return ms / num_scans;
+  };
+
+  std::vector<int64_t> times;
+  std::vector<double> azimuths;
+  cv::Mat fft_data, previous, current;
+
+  /// previous implementation
+  double decimate_ms = 0, load_ms = 0, cartesian_ms = 0;
+  for (const auto &scan : scans) {
+    timer.start();
+    const auto scan_use = legacy::decimate(scan);
+    timer.stop();
+    decimate_ms += elapsed_ms();
+    timer.start();
+    legacy::load_radar(scan_use, times, azimuths, fft_data);
+    timer.stop();
+    load_ms += elapsed_ms();
+    timer.start();
+    legacy::radar_polar_to_cartesian(fft_data, azimuths, previous,
+                                     cart_pixel_width);
+    timer.stop();
+    cartesian_ms += elapsed_ms();
+  }
+  CLOG(INFO, "test") << "Previous - decimation: " << decimate_ms
+                     << " ms, loading: " << load_ms
+                     << " ms, cartesian: " << cartesian_ms << " ms per scan";
+
+  /// cached tables and zero-copy decimation, the first scan builds the tables
+  decimate_ms = 0, load_ms = 0, cartesian_ms = 0;
+  for (const auto &scan : scans) {
+    timer.start();
+    const auto scan_use = decimate_azimuths(scan, 2, 0);
+    timer.stop();
+    decimate_ms += elapsed_ms();
+    timer.start();
+    load_radar(scan_use, times, azimuths, fft_data);
+    timer.stop();
+    load_ms += elapsed_ms();
+    timer.start();
+    radar_polar_to_cartesian(fft_data, azimuths, current, radar_resolution,
+                             cart_resolution, cart_pixel_width, true, CV_32F);
+    timer.stop();
+    cartesian_ms += elapsed_ms();
+  }
+  CLOG(INFO, "test") << "Current - decimation: " << decimate_ms
+                     << " ms, loading: " << load_ms
+                     << " ms, cartesian: " << cartesian_ms << " ms per scan";
+
+  /// results of the last scan should agree
+  legacy::radar_polar_to_cartesian(fft_data, azimuths, previous,
+                                   cart_pixel_width);
+  CLOG(INFO, "test") << "Max cartesian difference: "
+                     << cv::norm(previous, current, cv::NORM_INF);
+
+  return 0;
+}
@@ -18,36 +18,44 @@
  */
 #pragma once
 
+#include <mutex>
+
+#include "vtr_route_planning/csr_graph.hpp"
 #include "vtr_route_planning/route_planner_interface.hpp"
 
 namespace vtr {
 namespace route_planning {
 
+/**
+ * \brief Plans routes on the privileged graph, as shortest paths by distance.
+ * \details The privileged graph is maintained from graph callbacks, and its
+ * CSR adjacency is only rebuilt after it changed.
+ */
 class BFSPlanner : public RoutePlannerInterface {
  public:
   PTR_TYPEDEFS(BFSPlanner);
 
-  using GraphPtr = tactic::Graph::Ptr;
-  using GraphWeakPtr = tactic::Graph::WeakPtr;
-  using GraphBasePtr = tactic::GraphBase::Ptr;
+  using PrivilegedGraph = tactic::PrivilegedGraph;
 
-  BFSPlanner(const GraphPtr &graph) : graph_(graph) {}
+  BFSPlanner(const PrivilegedGraph::Ptr &privileged_graph)
+      : privileged_graph_(privileged_graph) {}
 
   PathType path(const VertexId &from, const VertexId &to) override;
   PathType path(const VertexId &from, const VertexId::List &to,
                 std::list<uint64_t> &idx) override;
 
  private:
-  /** \brief Helper to get a shared pointer to the graph */
-  GraphPtr getGraph() const;
-  /** \brief Returns a privileged graph (only contains teach routes) */
-  GraphBasePtr getPrivilegedGraph() const;
-  /** \brief Computes path from -> to given the privileged graph */
-  PathType path(const GraphBasePtr &priv_graph, const VertexId &from,
-                const VertexId &to);
-
-  GraphWeakPtr graph_;
+  /** \brief Returns the adjacency of the current privileged graph */
+  CSRGraph::ConstPtr getAdjacency();
+
+  const PrivilegedGraph::Ptr privileged_graph_;
+
+  /** \brief Protects adjacency_ and adjacency_version_ */
+  std::mutex mutex_;
+  CSRGraph::ConstPtr adjacency_ = nullptr;
+  /** \brief Version of the privileged graph the adjacency was built from */
+  size_t adjacency_version_ = 0;
 };
 
 }  // namespace route_planning
-}  // namespace vtr
\ No newline at end of file
+}  // namespace vtr
@@ -0,0 +1,99 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file csr_graph.hpp
+ */
+#pragma once
+
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "vtr_common/utils/macros.hpp"
+#include "vtr_pose_graph/id/id.hpp"
+
+namespace vtr {
+namespace route_planning {
+
+/**
+ * \brief Contiguous (compressed sparse row) adjacency of a graph weighted by
+ * edge length, searched with A*.
+ * \details The A* heuristic uses distances to a few landmark vertices (ALT):
+ * |d(l, to) - d(l, v)| is a lower bound of d(v, to) for any landmark l, so
+ * paths are optimal even though vertex positions are not globally consistent.
+ * The adjacency is immutable, rebuild it when the graph changes.
+ */
+class CSRGraph {
+ public:
+  PTR_TYPEDEFS(CSRGraph);
+
+  using VertexId = pose_graph::VertexId;
+  using PathType = VertexId::Vector;
+  using WeightedEdge = std::tuple<VertexId, VertexId, double>;
+
+  /**
+   * \brief Builds the adjacency of all vertices and edges of graph
+   * \param[in] num_landmarks number of landmarks of the A* heuristic
+   */
+  template <class GRAPH>
+  CSRGraph(const GRAPH &graph, const size_t num_landmarks = 4) {
+    VertexId::Vector vertices;
+    for (auto it = graph.beginVertex(); it != graph.endVertex(); ++it)
+      vertices.push_back(it->id());
+    std::vector<WeightedEdge> edges;
+    for (auto it = graph.beginEdge(); it != graph.endEdge(); ++it)
+      edges.emplace_back(it->from(), it->to(), it->T().r_ab_inb().norm());
+    build(vertices, edges, num_landmarks);
+  }
+
+  CSRGraph(const VertexId::Vector &vertices,
+           const std::vector<WeightedEdge> &edges,
+           const size_t num_landmarks = 4) {
+    build(vertices, edges, num_landmarks);
+  }
+
+  size_t numberOfVertices() const { return vertices_.size(); }
+  size_t numberOfEdges() const { return neighbors_.size() / 2; }
+
+  /**
+   * \brief Returns the shortest path from -> to, both included
+   * \throws std::invalid_argument if from or to is not in the graph
+   * \throws std::runtime_error if to cannot be reached from from
+   */
+  PathType path(const VertexId &from, const VertexId &to) const;
+
+ private:
+  void build(const VertexId::Vector &vertices,
+             const std::vector<WeightedEdge> &edges,
+             const size_t num_landmarks);
+  /** \brief Distances from source to all vertices, infinity if unreachable */
+  std::vector<double> dijkstra(const unsigned source) const;
+  /** \brief Lower bound of the distance between v and target */
+  double heuristic(const unsigned v, const unsigned target) const;
+  unsigned index(const VertexId &v) const;
+
+  /** \brief Vertex ids by index, and their index */
+  VertexId::Vector vertices_;
+  std::unordered_map<VertexId, unsigned> indices_;
+  /** \brief Neighbors of vertex i are in [offsets_[i], offsets_[i + 1]) */
+  std::vector<unsigned> offsets_;
+  std::vector<unsigned> neighbors_;
+  std::vector<double> weights_;
+  /** \brief Distances from every landmark to all vertices */
+  std::vector<std::vector<double>> landmark_distances_;
+};
+
+}  // namespace route_planning
+}  // namespace vtr
@@ -30,15 +30,15 @@ auto BFSPlanner::path(const VertexId &from, const VertexId::List &to,
   }
   idx.clear();
 
-  const auto priv_graph = getPrivilegedGraph();
+  const auto adjacency = getAdjacency();
 
-  auto rval = path(priv_graph, from, to.front());
+  auto rval = adjacency->path(from, to.front());
   idx.push_back(rval.empty() ? 0 : (rval.size() - 1));
 
   auto from_iter = to.begin();
   auto to_iter = std::next(from_iter);
   for (; to_iter != to.end(); ++from_iter, ++to_iter) {
-    const auto segment = path(priv_graph, *from_iter, *to_iter);
+    const auto segment = adjacency->path(*from_iter, *to_iter);
     rval.insert(rval.end(), std::next(segment.begin()), segment.end());
     idx.push_back(rval.empty() ? 0 : (rval.size() - 1));
   }
@@ -47,39 +47,22 @@ auto BFSPlanner::path(const VertexId &from, const VertexId::List &to,
 }
 
 auto BFSPlanner::path(const VertexId &from, const VertexId &to) -> PathType {
-  return path(getPrivilegedGraph(), from, to);
+  return getAdjacency()->path(from, to);
 }
 
-auto BFSPlanner::getGraph() const -> GraphPtr {
-  if (auto graph_acquired = graph_.lock())
-    return graph_acquired;
-  else {
-    std::string err{"Graph has expired"};
-    CLOG(ERROR, "route_planning.bfs") << err;
-    throw std::runtime_error(err);
+auto BFSPlanner::getAdjacency() -> CSRGraph::ConstPtr {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // version first, a newer subgraph only causes an extra rebuild next time
+  const auto version = privileged_graph_->version();
+  if (adjacency_ == nullptr || version != adjacency_version_) {
+    adjacency_ = std::make_shared<CSRGraph>(*privileged_graph_->subgraph());
+    adjacency_version_ = version;
+    CLOG(DEBUG, "route_planning.bfs")
+        << "Rebuilt route graph of " << adjacency_->numberOfVertices()
+        << " vertices and " << adjacency_->numberOfEdges() << " edges";
   }
-  return nullptr;
-}
-
-auto BFSPlanner::getPrivilegedGraph() const -> GraphBasePtr {
-  // get the current privileged graph
-  const auto graph = getGraph();
-  using PrivEval = tactic::PrivilegedEvaluator<tactic::GraphBase>;
-  auto priv_eval = std::make_shared<PrivEval>(*graph);
-  return graph->getSubgraph(priv_eval);
-}
-
-auto BFSPlanner::path(const GraphBasePtr &priv_graph, const VertexId &from,
-                      const VertexId &to) -> PathType {
-  const auto computed_path = priv_graph->dijkstraSearch(from, to);
-  //
-  PathType rval;
-  rval.reserve(computed_path->numberOfVertices());
-  for (auto it = computed_path->begin(from), ite = computed_path->end();
-       it != ite; ++it)
-    rval.push_back(*it);
-  return rval;
+  return adjacency_;
 }
 
 }  // namespace route_planning
-}  // namespace vtr
\ No newline at end of file
+}  // namespace vtr
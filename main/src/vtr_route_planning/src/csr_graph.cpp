@@ -0,0 +1,181 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file csr_graph.cpp
+ */
+#include "vtr_route_planning/csr_graph.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+#include <sstream>
+#include <stdexcept>
+
+#include "vtr_logging/logging.hpp"
+
+namespace vtr {
+namespace route_planning {
+
+namespace {
+
+constexpr double inf = std::numeric_limits<double>::infinity();
+constexpr unsigned invalid = std::numeric_limits<unsigned>::max();
+
+/** \brief Min-heap of (priority, vertex index) */
+using Queue = std::priority_queue<std::pair<double, unsigned>,
+                                  std::vector<std::pair<double, unsigned>>,
+                                  std::greater<std::pair<double, unsigned>>>;
+
+}  // namespace
+
+void CSRGraph::build(const VertexId::Vector &vertices,
+                     const std::vector<WeightedEdge> &edges,
+                     const size_t num_landmarks) {
+  // sorted vertices, so that the adjacency does not depend on hash order
+  vertices_ = vertices;
+  for (const auto &[from, to, weight] : edges) {
+    vertices_.push_back(from);
+    vertices_.push_back(to);
+  }
+  std::sort(vertices_.begin(), vertices_.end());
+  vertices_.erase(std::unique(vertices_.begin(), vertices_.end()),
+                  vertices_.end());
+  indices_.reserve(vertices_.size());
+  for (unsigned i = 0; i < vertices_.size(); ++i) indices_[vertices_[i]] = i;
+
+  // both directions of every edge
+  offsets_.assign(vertices_.size() + 1, 0);
+  for (const auto &[from, to, weight] : edges) {
+    ++offsets_[indices_.at(from) + 1];
+    ++offsets_[indices_.at(to) + 1];
+  }
+  for (size_t i = 0; i < vertices_.size(); ++i) offsets_[i + 1] += offsets_[i];
+  neighbors_.resize(offsets_.back());
+  weights_.resize(offsets_.back());
+  std::vector<unsigned> next(offsets_.begin(), offsets_.end() - 1);
+  for (const auto &[from, to, weight] : edges) {
+    const auto i = indices_.at(from), j = indices_.at(to);
+    neighbors_[next[i]] = j, weights_[next[i]++] = weight;
+    neighbors_[next[j]] = i, weights_[next[j]++] = weight;
+  }
+
+  // landmarks by farthest point selection, each one as far as possible from
+  // the previous ones, starting from the vertex farthest from the first one
+  landmark_distances_.clear();
+  if (vertices_.empty()) return;
+  const auto argmax = [](const std::vector<double> &distances) {
+    return (unsigned)std::distance(
+        distances.begin(),
+        std::max_element(distances.begin(), distances.end()));
+  };
+  auto from_first = dijkstra(0);
+  for (auto &distance : from_first)
+    if (std::isinf(distance)) distance = 0.0;
+  auto landmark = argmax(from_first);
+  // vertices not reachable from any landmark are picked first
+  std::vector<double> min_distances(vertices_.size(), inf);
+  for (size_t l = 0; l < num_landmarks; ++l) {
+    landmark_distances_.emplace_back(dijkstra(landmark));
+    const auto &distances = landmark_distances_.back();
+    for (size_t i = 0; i < vertices_.size(); ++i)
+      min_distances[i] = std::min(min_distances[i], distances[i]);
+    landmark = argmax(min_distances);
+    if (min_distances[landmark] == 0.0) break;  // all vertices are landmarks
+  }
+}
+
+auto CSRGraph::path(const VertexId &from, const VertexId &to) const
+    -> PathType {
+  const auto source = index(from), target = index(to);
+
+  std::vector<double> g(vertices_.size(), inf);
+  std::vector<unsigned> parents(vertices_.size(), invalid);
+  std::vector<bool> closed(vertices_.size(), false);
+  Queue queue;
+  g[source] = 0.0;
+  queue.emplace(heuristic(source, target), source);
+  while (!queue.empty()) {
+    const auto v = queue.top().second;
+    queue.pop();
+    if (closed[v]) continue;
+    if (v == target) break;
+    closed[v] = true;
+    for (auto k = offsets_[v]; k < offsets_[v + 1]; ++k) {
+      const auto u = neighbors_[k];
+      const double g_u = g[v] + weights_[k];
+      if (closed[u] || g_u >= g[u]) continue;
+      g[u] = g_u;
+      parents[u] = v;
+      queue.emplace(g_u + heuristic(u, target), u);
+    }
+  }
+
+  if (std::isinf(g[target])) {
+    std::stringstream err;
+    err << "No route from " << from << " to " << to;
+    CLOG(ERROR, "route_planning") << err.str();
+    throw std::runtime_error(err.str());
+  }
+
+  PathType rval;
+  for (auto v = target; v != invalid; v = parents[v])
+    rval.push_back(vertices_[v]);
+  std::reverse(rval.begin(), rval.end());
+  return rval;
+}
+
+std::vector<double> CSRGraph::dijkstra(const unsigned source) const {
+  std::vector<double> distances(vertices_.size(), inf);
+  Queue queue;
+  distances[source] = 0.0;
+  queue.emplace(0.0, source);
+  while (!queue.empty()) {
+    const auto [d, v] = queue.top();
+    queue.pop();
+    if (d > distances[v]) continue;
+    for (auto k = offsets_[v]; k < offsets_[v + 1]; ++k) {
+      const auto u = neighbors_[k];
+      if (d + weights_[k] >= distances[u]) continue;
+      distances[u] = d + weights_[k];
+      queue.emplace(distances[u], u);
+    }
+  }
+  return distances;
+}
+
+double CSRGraph::heuristic(const unsigned v, const unsigned target) const {
+  double h = 0.0;
+  for (const auto &distances : landmark_distances_) {
+    // the landmark is in another connected component
+    if (std::isinf(distances[v]) || std::isinf(distances[target])) continue;
+    h = std::max(h, std::abs(distances[target] - distances[v]));
+  }
+  return h;
+}
+
+unsigned CSRGraph::index(const VertexId &v) const {
+  const auto it = indices_.find(v);
+  if (it == indices_.end()) {
+    std::stringstream err;
+    err << "Vertex " << v << " is not in the route graph";
+    CLOG(ERROR, "route_planning") << err.str();
+    throw std::invalid_argument(err.str());
+  }
+  return it->second;
+}
+
+}  // namespace route_planning
+}  // namespace vtr
@@ -0,0 +1,128 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file test_csr_graph.cpp
+ */
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "vtr_logging/logging_init.hpp"
+#include "vtr_pose_graph/evaluator/evaluators.hpp"
+#include "vtr_pose_graph/index/graph.hpp"
+#include "vtr_route_planning/csr_graph.hpp"
+
+using namespace ::testing;
+using namespace vtr;
+using namespace vtr::logging;
+using namespace vtr::pose_graph;
+using namespace vtr::route_planning;
+
+class CSRGraphTestFixture : public Test {
+ public:
+  void SetUp() override {
+    /* Create a ladder with random edge lengths, plus an unconnected run
+     * R0: 0 --- 1 --- 2 --- ... --- 99
+     *     |     |     |              |
+     * R1: 0 --- 1 --- 2 --- ... --- 99
+     * R2: 0 --- 1
+     */
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> length(0.1, 2.0);
+    const auto transform = [&]() {
+      return EdgeTransform(Eigen::Matrix3d::Identity(),
+                           Eigen::Vector3d{length(gen), 0.0, 0.0});
+    };
+    // clang-format off
+    for (int run = 0; run < 2; ++run) {
+      graph_->addRun();
+      graph_->addVertex();
+      for (int i = 1; i < 100; ++i) {
+        graph_->addVertex();
+        graph_->addEdge(VertexId(run, i - 1), VertexId(run, i), EdgeType::Temporal, true, transform());
+      }
+    }
+    for (int i = 0; i < 100; ++i)
+      graph_->addEdge(VertexId(1, i), VertexId(0, i), EdgeType::Spatial, true, transform());
+    graph_->addRun();
+    graph_->addVertex();
+    graph_->addVertex();
+    graph_->addEdge(VertexId(2, 0), VertexId(2, 1), EdgeType::Temporal, true, transform());
+    // clang-format on
+  }
+
+  double length(const CSRGraph::PathType& path) const {
+    double length = 0.0;
+    for (size_t i = 1; i < path.size(); ++i)
+      length += graph_->at(EdgeId(path[i - 1], path[i]))->T().r_ab_inb().norm();
+    return length;
+  }
+
+  /** \brief Length of the shortest path from the pose graph dijkstra search */
+  double dijkstraLength(const VertexId& from, const VertexId& to) const {
+    using DistanceEval = eval::weight::distance::Eval<BasicGraph>;
+    const auto weights = std::make_shared<DistanceEval>(*graph_);
+    const auto path = graph_->dijkstraSearch(from, to, weights);
+    double length = 0.0;
+    for (auto it = path->beginEdge(); it != path->endEdge(); ++it)
+      length += it->T().r_ab_inb().norm();
+    return length;
+  }
+
+  BasicGraph::Ptr graph_ = std::make_shared<BasicGraph>();
+};
+
+TEST_F(CSRGraphTestFixture, shortest_paths) {
+  CSRGraph csr_graph(*graph_);
+  EXPECT_EQ(csr_graph.numberOfVertices(), (size_t)202);
+  EXPECT_EQ(csr_graph.numberOfEdges(), (size_t)299);
+
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int> run(0, 1), vertex(0, 99);
+  for (int i = 0; i < 50; ++i) {
+    const VertexId from(run(gen), vertex(gen)), to(run(gen), vertex(gen));
+    const auto path = csr_graph.path(from, to);
+    ASSERT_FALSE(path.empty());
+    EXPECT_EQ(path.front(), from);
+    EXPECT_EQ(path.back(), to);
+    // consecutive vertices are connected, and the path is the shortest
+    for (size_t j = 1; j < path.size(); ++j)
+      EXPECT_TRUE(graph_->contains(EdgeId(path[j - 1], path[j])));
+    EXPECT_NEAR(length(path), dijkstraLength(from, to), 1e-9);
+  }
+}
+
+TEST_F(CSRGraphTestFixture, number_of_landmarks) {
+  // landmarks only speed up the search, paths stay the same
+  CSRGraph no_landmarks(*graph_, 0), landmarks(*graph_, 16);
+  const VertexId from(0, 3), to(1, 97);
+  EXPECT_EQ(no_landmarks.path(from, to), landmarks.path(from, to));
+}
+
+TEST_F(CSRGraphTestFixture, invalid_paths) {
+  CSRGraph csr_graph(*graph_);
+  EXPECT_EQ(csr_graph.path(VertexId(0, 5), VertexId(0, 5)),
+            CSRGraph::PathType{VertexId(0, 5)});
+  EXPECT_THROW(csr_graph.path(VertexId(0, 0), VertexId(2, 1)),
+               std::runtime_error);
+  EXPECT_THROW(csr_graph.path(VertexId(0, 0), VertexId(3, 0)),
+               std::invalid_argument);
+}
+
+int main(int argc, char** argv) {
+  configureLogging("", true);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
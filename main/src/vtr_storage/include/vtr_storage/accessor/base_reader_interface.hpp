@@ -63,6 +63,8 @@ public:
   virtual std::shared_ptr<SerializedBagMessage> read_at_index(const Index & index) = 0;
   virtual std::vector<std::shared_ptr<SerializedBagMessage>> read_at_index_range(const Index & index_begin, const Index & index_end) = 0;
 
+  virtual std::vector<TopicMetadata> get_all_topics_and_types() = 0;
+
   virtual void set_filter(const StorageFilter & storage_filter) = 0;
   virtual void reset_filter() = 0;
 };
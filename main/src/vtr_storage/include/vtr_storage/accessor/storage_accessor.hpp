@@ -52,6 +52,9 @@ class StorageAccessor : public BaseReaderInterface, public BaseWriterInterface {
   std::shared_ptr<SerializedBagMessage> read_at_index(const Index & index) override;
   std::vector<std::shared_ptr<SerializedBagMessage>> read_at_index_range(const Index & index_begin, const Index & index_end) override;
 
+  /** \brief Topics as they were created, possibly by an earlier process */
+  std::vector<TopicMetadata> get_all_topics_and_types() override;
+
   /// Writer
   void write(const std::shared_ptr<SerializedBagMessage> & message) override;
   void write(const std::vector<std::shared_ptr<SerializedBagMessage>> & messages) override;
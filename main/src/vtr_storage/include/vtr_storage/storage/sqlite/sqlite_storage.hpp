@@ -111,6 +111,19 @@ private:
   void commit_transaction();
   void write_locked(const std::shared_ptr<SerializedBagMessage> & message);
 
+  /// \brief Reads messages satisfying condition (bound to params) and the
+  /// topic filter, with cached statements of topic ids instead of a join.
+  template<typename ... Params>
+  std::vector<std::shared_ptr<SerializedBagMessage>> read_messages(
+    const std::string & condition, const std::string & order, bool single,
+    Params ... params);
+  /// \brief Ids of the filtered topics, empty if no filter is set.
+  std::vector<int> get_filter_topic_ids();
+  /// \brief Name of a topic id, refreshed from the database (e.g. for topics
+  /// created by another connection) if refresh is true. Empty if unknown.
+  std::string get_topic_name(int topic_id, bool refresh);
+  void fill_topics_map_locked();
+
   using ReadQueryResult = SqliteStatementWrapper::QueryResult<
     std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, std::string, int>;
 
@@ -122,6 +135,7 @@ private:
   ReadQueryResult::Iterator current_message_row_ {
     nullptr, SqliteStatementWrapper::QueryResult<>::Iterator::POSITION_END};
   std::unordered_map<std::string, int> topics_;
+  std::unordered_map<int, std::string> topic_names_;
   std::vector<TopicMetadata> all_topics_and_types_;
   std::string relative_path_;
   std::atomic_bool active_transaction_ {false};
@@ -132,7 +146,7 @@ private:
 
   // This mutex is necessary to protect:
   // a) database access (this could also be done with FULLMUTEX), but see b)
-  // b) topics_ collection - since we could be writing and reading it at the same time
+  // b) topics_ and topic_names_ collections - since we could be writing and reading them at the same time
   std::mutex database_write_mutex_;
 };
 
@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "rcutils/types.h"
@@ -64,12 +65,21 @@ public:
 
   SqliteStatement prepare_statement(const std::string & query);
 
+  /// \brief Returns the statement of this query, prepared on first use and
+  /// reset on every later use, so that queries of the same shape with bound
+  /// parameters are only compiled once. The statement should be reset after
+  /// use to end its read transaction, and must not be used by two queries at
+  /// the same time.
+  SqliteStatement get_cached_statement(const std::string & query);
+
   size_t get_last_insert_id();
 
   operator bool();
 
 private:
   DBPtr db_ptr;
+  /// \note must be finalized before the database is closed
+  std::unordered_map<std::string, SqliteStatement> statement_cache_;
 };
 
 // clang-format on
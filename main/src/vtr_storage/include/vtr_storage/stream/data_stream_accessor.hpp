@@ -20,13 +20,22 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
-
-#include <boost/thread.hpp>  // std::lock that takes iterator input
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
 
 #include "rclcpp/serialization.hpp"
 #include "rclcpp/serialized_message.hpp"
+#include "rmw/rmw.h"
+#include "rosidl_runtime_cpp/traits.hpp"
+#include "rosidl_typesupport_cpp/message_type_support.hpp"
 
+#include "vtr_logging/logging.hpp"
 #include "vtr_storage/accessor/storage_accessor.hpp"
 #include "vtr_storage/stream/message.hpp"
 #include "vtr_storage/stream/type_traits.hpp"
@@ -34,21 +43,144 @@
 namespace vtr {
 namespace storage {
 
+template <typename DataType>
+class DataStreamAccessor;
+
 class DataStreamAccessorBase {
  public:
   using Index = int;
   using Timestamp = rcutils_time_point_value_t;
 
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * \brief Write-behind policy. Written messages are serialized right away but
+   * queued, and the queue is committed to the database in a single transaction
+   * once any of the limits is reached. Reads as well as destruction commit the
+   * queue first.
+   * \note the limits, including max_pending_time, are only checked on write:
+   * there is no timer, so callers that stop writing to a stream must call
+   * flush() to commit what is still queued (RCGraph::saveVertices does so).
+   * \note the default writes through: every write call is committed before it
+   * returns.
+   */
+  struct WriteConfig {
+    /** \brief commits once this many messages are queued */
+    size_t max_pending_messages = 1;
+    /** \brief commits once this many bytes are queued, 0 for no limit */
+    size_t max_pending_bytes = 0;
+    /** \brief commits once the oldest queued write is this old, 0 for no limit */
+    std::chrono::milliseconds max_pending_time{0};
+  };
+
+  struct WriteStats {
+    size_t messages_written = 0;
+    size_t bytes_written = 0;
+    size_t commits = 0;
+    /** \brief total and worst-case duration of committing the queue */
+    Clock::duration commit_time{0};
+    Clock::duration max_commit_time{0};
+    /** \brief messages currently queued and the most ever queued */
+    size_t queue_depth = 0;
+    size_t max_queue_depth = 0;
+  };
+
   DataStreamAccessorBase(const std::string &base_directory,
                          const std::string &stream_name,
                          const std::string &stream_type);
   virtual ~DataStreamAccessorBase() = default;
 
+  /** \brief Write policy of accessors constructed afterwards */
+  static void setDefaultWriteConfig(const WriteConfig &config);
+  static WriteConfig getDefaultWriteConfig();
+
+  /** \brief Takes effect from the next write */
+  void setWriteConfig(const WriteConfig &config);
+  WriteConfig getWriteConfig() const;
+
+  WriteStats getWriteStats() const;
+
+  /**
+   * \brief Commits all queued writes to the database.
+   * \note sets the index of queued messages that are not locked at the time,
+   * the others get it on their next write or at the next commit.
+   */
+  virtual void flush() = 0;
+
+  const std::string &streamName() const { return tm_.name; }
+  /** \brief Type the stream was created with, which it keeps */
+  const std::string &streamType() const { return tm_.type; }
+  /** \brief Directory of the streams, data of this one is in dataDirectory */
+  const std::filesystem::path &baseDirectory() const { return base_directory_; }
+  const std::filesystem::path &dataDirectory() const { return data_directory_; }
+
+  /**
+   * \brief Files kept next to the stream data by the message being serialized
+   * (see StorableScope): a written file is synced to disk once before the
+   * queue is committed, together with all others of the commit, and a file
+   * the message no longer refers to is removed once the message is committed.
+   * \note only valid from toStorable, while write_mutex_ is held.
+   */
+  void syncOnCommit(const std::filesystem::path &file);
+  void removeOnCommit(const std::filesystem::path &file);
+
+  /**
+   * \brief Stream of the storable the calling thread converts, set while the
+   * accessor calls toStorable or fromStorable, so that storables can keep files
+   * next to the stream data.
+   */
+  class StorableScope {
+   public:
+    /** \brief Scope of the calling thread, nullptr outside of any */
+    static const StorableScope *current();
+
+    DataStreamAccessorBase &accessor() const { return accessor_; }
+    /** \brief Whether in toStorable, otherwise in fromStorable */
+    bool serializing() const { return serializing_; }
+
+   private:
+    StorableScope(DataStreamAccessorBase &accessor, const bool serializing);
+    ~StorableScope();
+
+    StorableScope(const StorableScope &) = delete;
+    StorableScope &operator=(const StorableScope &) = delete;
+
+    DataStreamAccessorBase &accessor_;
+    const bool serializing_;
+    const StorableScope *previous_;
+
+    template <typename DataType>
+    friend class DataStreamAccessor;
+  };
+
  protected:
+  /** \brief Whether the queue must be committed, requires write_mutex_ */
+  bool flushRequired() const;
+
+  /**
+   * \brief Syncs the files written for the queue and their directories,
+   * requires write_mutex_. Throws if any of them fails to sync.
+   */
+  void syncFiles();
+  /** \brief Removes the files replaced by the committed queue */
+  void removeReplacedFiles();
+
   std::unique_ptr<StorageAccessor> storage_accessor_ =
       std::make_unique<StorageAccessor>();
   TopicMetadata tm_;
 
+  /** \brief protects the write queue, its config and stats */
+  mutable std::mutex write_mutex_;
+  WriteConfig write_config_;
+  WriteStats write_stats_;
+  size_t pending_bytes_ = 0;
+  Clock::time_point pending_since_;
+  /** \brief number of queued writes, readers skip locking the queue if 0 */
+  std::atomic<size_t> queue_depth_{0};
+  /** \brief see syncOnCommit and removeOnCommit */
+  std::set<std::filesystem::path> files_to_sync_;
+  std::set<std::filesystem::path> files_to_remove_;
+
  private:
   std::filesystem::path base_directory_;
   std::filesystem::path data_directory_;
@@ -57,32 +189,88 @@ class DataStreamAccessorBase {
 template <typename DataType>
 class DataStreamAccessor : public DataStreamAccessorBase {
  public:
+  using MessagePtr = std::shared_ptr<LockableMessage<DataType>>;
+
+  /**
+   * \note a storable with a LegacyStorable reads and writes it in streams
+   * created with the type of the legacy storable message, whatever
+   * stream_type is.
+   */
   DataStreamAccessor(const std::string &base_directory,
                      const std::string &stream_name = "",
                      const std::string &stream_type = "UnknownType")
-      : DataStreamAccessorBase(base_directory, stream_name, stream_type) {}
+      : DataStreamAccessorBase(base_directory, stream_name, stream_type),
+        legacy_(isLegacyStream()) {}
+  ~DataStreamAccessor() override;
 
   // returns a nullptr if no data exist at the specified index/timestamp
   std::shared_ptr<LockableMessage<DataType>> readAtIndex(Index index);
   std::shared_ptr<LockableMessage<DataType>> readAtTimestamp(Timestamp time);
-  // returns an empty vector if no data exist at the specified range
+  // returns an empty vector if no data exist at the specified range, messages
+  // are read with a single query and deserialized using num_threads threads
   std::vector<std::shared_ptr<LockableMessage<DataType>>> readAtIndexRange(
-      Index index_begin, Index index_end);
+      Index index_begin, Index index_end, const int num_threads = 1);
   std::vector<std::shared_ptr<LockableMessage<DataType>>> readAtTimestampRange(
       Timestamp timestamp_begin, Timestamp timestamp_end);
 
-  template <typename T = DataType>
-  typename std::enable_if<!is_storable<T>::value, void>::type write(
-      const std::shared_ptr<LockableMessage<DataType>> &message);
+  void write(const MessagePtr &message);
 
-  template <typename T = DataType>
-  typename std::enable_if<is_storable<T>::value, void>::type write(
-      const std::shared_ptr<LockableMessage<DataType>> &message);
+  void write(const std::vector<MessagePtr> &messages);
 
-  void write(
-      const std::vector<std::shared_ptr<LockableMessage<DataType>>> &messages);
+  void flush() override;
 
  private:
+  /** \brief A serialized message waiting to be committed */
+  struct PendingWrite {
+    std::weak_ptr<LockableMessage<DataType>> message;
+    std::shared_ptr<SerializedBagMessage> serialized;
+    std::unique_ptr<rclcpp::SerializedMessage> buffer;
+  };
+
+  /**
+   * \brief Serializes a message into the queue, requires write_mutex_ and the
+   * lock of the message.
+   */
+  void enqueue(const MessagePtr &message, Message<DataType> &message_ref);
+
+  /**
+   * \brief Commits the queue in one transaction, requires write_mutex_.
+   * \note messages are always locked before write_mutex_, so this only tries to
+   * lock them to set their index.
+   */
+  void flushLocked();
+
+  /** \brief Sets the committed index of a message, requires its lock */
+  static void applyIndex(Message<DataType> &message_ref, Index index);
+  /** \brief Returns false if the message is locked and its index not set */
+  static bool tryApplyIndex(
+      const std::weak_ptr<LockableMessage<DataType>> &message, Index index);
+
+  /** \brief Serialization buffers are kept across commits to reuse them */
+  std::unique_ptr<rclcpp::SerializedMessage> acquireBuffer();
+  static constexpr size_t max_pooled_buffers = 16;
+
+  template <typename T = DataType>
+  typename std::enable_if<!is_storable<T>::value, void>::type serializeData(
+      const DataType &data, rclcpp::SerializedMessage &serialized_data);
+
+  template <typename T = DataType>
+  typename std::enable_if<is_storable<T>::value, void>::type serializeData(
+      const DataType &data, rclcpp::SerializedMessage &serialized_data);
+
+  bool isLegacyStream() const {
+    if constexpr (has_legacy_storable<DataType>::value)
+      return streamType() == rosidl_generator_traits::name<
+                                 typename has_legacy_storable<DataType>::type>();
+    else
+      return false;
+  }
+
+  /** \brief Deserializes the buffer read from storage without copying it */
+  template <typename MessageType>
+  void deserializeData(const rcutils_uint8_array_t &serialized_data,
+                       MessageType *data);
+
   template <typename T = DataType>
   typename std::enable_if<!is_storable<T>::value,
                           std::shared_ptr<LockableMessage<DataType>>>::type
@@ -95,11 +283,35 @@ class DataStreamAccessor : public DataStreamAccessorBase {
 
   rclcpp::Serialization<typename has_to_storable<DataType>::type>
       serialization_;
+  /** \brief whether the stream stores the legacy storable of DataType */
+  const bool legacy_;
+
+  std::vector<PendingWrite> pending_;
+  /** \brief queued insertions by message, to rewrite them in place */
+  std::unordered_map<const LockableMessage<DataType> *, size_t>
+      pending_inserts_;
+  /** \brief committed indices not set yet because the message was locked */
+  std::unordered_map<const LockableMessage<DataType> *,
+                     std::pair<std::weak_ptr<LockableMessage<DataType>>, Index>>
+      unapplied_indices_;
+  std::vector<std::unique_ptr<rclcpp::SerializedMessage>> buffer_pool_;
 };
 
+template <typename DataType>
+DataStreamAccessor<DataType>::~DataStreamAccessor() {
+  try {
+    flush();
+  } catch (const std::exception &e) {
+    CLOG(ERROR, "storage") << "Data stream accessor destructor - failed to "
+                              "commit queued writes of stream "
+                           << tm_.name << ": " << e.what();
+  }
+}
+
 template <typename DataType>
 std::shared_ptr<LockableMessage<DataType>>
 DataStreamAccessor<DataType>::readAtIndex(Index index) {
+  flush();
   const auto serialized_message = storage_accessor_->read_at_index(index);
   return deserializeMessage(serialized_message);
 }
@@ -107,6 +319,7 @@ DataStreamAccessor<DataType>::readAtIndex(Index index) {
 template <typename DataType>
 std::shared_ptr<LockableMessage<DataType>>
 DataStreamAccessor<DataType>::readAtTimestamp(Timestamp timestamp) {
+  flush();
   const auto serialized_message =
       storage_accessor_->read_at_timestamp(timestamp);
   return deserializeMessage(serialized_message);
@@ -115,14 +328,17 @@ DataStreamAccessor<DataType>::readAtTimestamp(Timestamp timestamp) {
 template <typename DataType>
 std::vector<std::shared_ptr<LockableMessage<DataType>>>
 DataStreamAccessor<DataType>::readAtIndexRange(Index index_begin,
-                                               Index index_end) {
+                                               Index index_end,
+                                               const int num_threads) {
+  flush();
   const auto serialized_messages =
       storage_accessor_->read_at_index_range(index_begin, index_end);
 
-  std::vector<std::shared_ptr<LockableMessage<DataType>>> messages;
-  messages.reserve(serialized_messages.size());
-  for (const auto &serialized_message : serialized_messages)
-    messages.push_back(deserializeMessage(serialized_message));
+  std::vector<std::shared_ptr<LockableMessage<DataType>>> messages(
+      serialized_messages.size());
+#pragma omp parallel for schedule(static) num_threads(num_threads)
+  for (size_t i = 0; i < serialized_messages.size(); ++i)
+    messages[i] = deserializeMessage(serialized_messages[i]);
 
   return messages;
 }
@@ -131,6 +347,7 @@ template <typename DataType>
 std::vector<std::shared_ptr<LockableMessage<DataType>>>
 DataStreamAccessor<DataType>::readAtTimestampRange(Timestamp timestamp_begin,
                                                    Timestamp timestamp_end) {
+  flush();
   const auto serialized_messages = storage_accessor_->read_at_timestamp_range(
       timestamp_begin, timestamp_end);
 
@@ -143,83 +360,213 @@ DataStreamAccessor<DataType>::readAtTimestampRange(Timestamp timestamp_begin,
 }
 
 template <typename DataType>
-template <typename T>
-typename std::enable_if<!is_storable<T>::value, void>::type
-DataStreamAccessor<DataType>::write(
-    const std::shared_ptr<LockableMessage<DataType>> &message) {
-  const auto message_locked = message->locked();
-  auto &message_ref = message_locked.get();
+void DataStreamAccessor<DataType>::write(const MessagePtr &message) {
+  std::unique_lock<std::mutex> lock(write_mutex_, std::defer_lock);
+  {
+    // the message is locked first, as by callers that read while holding it
+    const auto message_locked = message->locked();
+    lock.lock();
+    enqueue(message, message_locked.get());
+  }
+  if (flushRequired()) flushLocked();
+}
+
+template <typename DataType>
+void DataStreamAccessor<DataType>::write(
+    const std::vector<MessagePtr> &messages) {
+  std::unique_lock<std::mutex> lock(write_mutex_, std::defer_lock);
+  for (const auto &message : messages) {
+    const auto message_locked = message->locked();
+    lock.lock();
+    enqueue(message, message_locked.get());
+    lock.unlock();
+  }
+  lock.lock();
+  if (flushRequired()) flushLocked();
+}
+
+template <typename DataType>
+void DataStreamAccessor<DataType>::flush() {
+  if (queue_depth_ == 0) return;
+  const std::lock_guard<std::mutex> lock(write_mutex_);
+  flushLocked();
+}
+
+template <typename DataType>
+void DataStreamAccessor<DataType>::enqueue(const MessagePtr &message,
+                                           Message<DataType> &message_ref) {
+  // an index committed while the message was locked is set first, otherwise
+  // the message would be inserted again
+  const auto unapplied = unapplied_indices_.find(message.get());
+  if (unapplied != unapplied_indices_.end()) {
+    if (unapplied->second.first.lock() == message)
+      applyIndex(message_ref, unapplied->second.second);
+    unapplied_indices_.erase(unapplied);
+  }
 
   if (message_ref.getSaved() == true) return;
 
-  const auto serialized = std::make_shared<SerializedBagMessage>();
+  // a message that is still waiting to be inserted is rewritten in place,
+  // otherwise it would be inserted twice
+  PendingWrite *pending = nullptr;
+  if (message_ref.getIndex() == NO_INDEX_VALUE) {
+    const auto itr = pending_inserts_.find(message.get());
+    if (itr != pending_inserts_.end() &&
+        pending_[itr->second].message.lock() == message) {
+      pending = &pending_[itr->second];
+      pending_bytes_ -= pending->buffer->size();
+    } else {
+      pending_inserts_[message.get()] = pending_.size();
+    }
+  }
+  if (pending == nullptr) {
+    if (pending_.empty()) pending_since_ = Clock::now();
+    pending = &pending_.emplace_back();
+    pending->message = message;
+    pending->serialized = std::make_shared<SerializedBagMessage>();
+    pending->buffer = acquireBuffer();
+    write_stats_.max_queue_depth =
+        std::max(write_stats_.max_queue_depth, pending_.size());
+    queue_depth_ = pending_.size();
+  }
+
+  const auto &serialized = pending->serialized;
   serialized->time_stamp = message_ref.getTimestamp();
   serialized->index = message_ref.getIndex();
   serialized->topic_name = tm_.name;
 
-  const auto &data = message_ref.getData();
-  rclcpp::SerializedMessage serialized_data;
-  serialization_.serialize_message(&data, &serialized_data);
-  // temporary store the payload in a shared_ptr.
-  // add custom no-op deleter to avoid deep copying data.
+  serializeData(message_ref.getData(), *pending->buffer);
+  pending_bytes_ += pending->buffer->size();
+  // the buffer is owned by the queue entry, add custom no-op deleter to avoid
+  // deep copying data.
   serialized->serialized_data = std::shared_ptr<rcutils_uint8_array_t>(
-      const_cast<rcutils_uint8_array_t *>(
-          &serialized_data.get_rcl_serialized_message()),
+      &pending->buffer->get_rcl_serialized_message(),
       [](rcutils_uint8_array_t * /* data */) {});
 
-  storage_accessor_->write(serialized);
+  // saved from the caller's point of view, the index is set once committed
+  message_ref.setSaved(true);
+}
 
-  // the index should be set after insertion
-  message_ref.setIndex(serialized->index);
+template <typename DataType>
+void DataStreamAccessor<DataType>::flushLocked() {
+  for (auto itr = unapplied_indices_.begin();
+       itr != unapplied_indices_.end();) {
+    if (tryApplyIndex(itr->second.first, itr->second.second))
+      itr = unapplied_indices_.erase(itr);
+    else
+      ++itr;
+  }
+
+  if (pending_.empty()) return;
+
+  std::vector<std::shared_ptr<SerializedBagMessage>> serialized_messages;
+  serialized_messages.reserve(pending_.size());
+  for (const auto &pending : pending_)
+    serialized_messages.push_back(pending.serialized);
+
+  // the queue is kept as is if the transaction fails
+  const auto start = Clock::now();
+  syncFiles();
+  storage_accessor_->write(serialized_messages);
+  removeReplacedFiles();
+  const auto commit_time = Clock::now() - start;
+
+  for (auto &pending : pending_) {
+    // the index should be set after insertion
+    const auto index = pending.serialized->index;
+    if (!tryApplyIndex(pending.message, index)) {
+      const auto message = pending.message.lock();
+      unapplied_indices_[message.get()] = {message, index};
+    }
+    if (buffer_pool_.size() < max_pooled_buffers)
+      buffer_pool_.emplace_back(std::move(pending.buffer));
+  }
+
+  write_stats_.messages_written += pending_.size();
+  write_stats_.bytes_written += pending_bytes_;
+  write_stats_.commits++;
+  write_stats_.commit_time += commit_time;
+  write_stats_.max_commit_time =
+      std::max(write_stats_.max_commit_time, commit_time);
+
+  pending_.clear();
+  pending_inserts_.clear();
+  pending_bytes_ = 0;
+  queue_depth_ = 0;
 }
 
 template <typename DataType>
-template <typename T>
-typename std::enable_if<is_storable<T>::value, void>::type
-DataStreamAccessor<DataType>::write(
-    const std::shared_ptr<LockableMessage<DataType>> &message) {
-  const auto message_locked = message->locked();
-  auto &message_ref = message_locked.get();
+void DataStreamAccessor<DataType>::applyIndex(Message<DataType> &message_ref,
+                                              Index index) {
+  if (message_ref.getIndex() != NO_INDEX_VALUE) return;
+  // without changing the saved flag since the message may have been modified
+  // in the meantime
+  const auto saved = message_ref.getSaved();
+  message_ref.setIndex(index);
+  message_ref.setSaved(saved);
+}
 
-  if (message_ref.getSaved() == true) return;
+template <typename DataType>
+bool DataStreamAccessor<DataType>::tryApplyIndex(
+    const std::weak_ptr<LockableMessage<DataType>> &message, Index index) {
+  const auto message_ptr = message.lock();
+  if (message_ptr == nullptr) return true;
+  std::unique_lock<typename LockableMessage<DataType>::MutexType> lock(
+      message_ptr->mutex(), std::try_to_lock);
+  if (!lock.owns_lock()) return false;
+  applyIndex(message_ptr->unlocked().get(), index);
+  return true;
+}
 
-  const auto serialized = std::make_shared<SerializedBagMessage>();
-  serialized->time_stamp = message_ref.getTimestamp();
-  serialized->index = message_ref.getIndex();
-  serialized->topic_name = tm_.name;
+template <typename DataType>
+std::unique_ptr<rclcpp::SerializedMessage>
+DataStreamAccessor<DataType>::acquireBuffer() {
+  if (buffer_pool_.empty())
+    return std::make_unique<rclcpp::SerializedMessage>();
+  auto buffer = std::move(buffer_pool_.back());
+  buffer_pool_.pop_back();
+  return buffer;
+}
+
+template <typename DataType>
+template <typename T>
+typename std::enable_if<!is_storable<T>::value, void>::type
+DataStreamAccessor<DataType>::serializeData(
+    const DataType &data, rclcpp::SerializedMessage &serialized_data) {
+  serialization_.serialize_message(&data, &serialized_data);
+}
 
-  const auto &data = message_ref.getData();
+template <typename DataType>
+template <typename T>
+typename std::enable_if<is_storable<T>::value, void>::type
+DataStreamAccessor<DataType>::serializeData(
+    const DataType &data, rclcpp::SerializedMessage &serialized_data) {
+  const StorableScope scope(*this, /* serializing */ true);
+  if constexpr (has_legacy_storable<T>::value) {
+    if (legacy_) {
+      using LegacyStorable = typename has_legacy_storable<T>::type;
+      const auto storable = data.toLegacyStorable();
+      rclcpp::Serialization<LegacyStorable>().serialize_message(
+          &storable, &serialized_data);
+      return;
+    }
+  }
   const auto storable = data.toStorable();
-  rclcpp::SerializedMessage serialized_data;
   serialization_.serialize_message(&storable, &serialized_data);
-  // temporary store the payload in a shared_ptr.
-  // add custom no-op deleter to avoid deep copying data.
-  serialized->serialized_data = std::shared_ptr<rcutils_uint8_array_t>(
-      const_cast<rcutils_uint8_array_t *>(
-          &serialized_data.get_rcl_serialized_message()),
-      [](rcutils_uint8_array_t * /* data */) {});
-
-  storage_accessor_->write(serialized);
-
-  // the index should be set after insertion
-  message_ref.setIndex(serialized->index);
 }
 
 template <typename DataType>
-void DataStreamAccessor<DataType>::write(
-    const std::vector<std::shared_ptr<LockableMessage<DataType>>> &messages) {
-  // do not make use of the vector write for simplicity
-  for (const auto &message : messages) write(message);
-#if false
-  // lock all messages - note: this block is prepared for writing a vector of
-  // messages with potentially better performance
-  using LockType = std::shared_lock<std::shared_mutex>;
-  std::vector<LockType> locks;
-  locks.reserve(messages.size());
-  for (const auto &message : messages)
-    locks.emplace_back(message->mutex(), std::defer_lock);
-  boost::lock(locks.begin(), locks.end());
-#endif
+template <typename MessageType>
+void DataStreamAccessor<DataType>::deserializeData(
+    const rcutils_uint8_array_t &serialized_data, MessageType *data) {
+  // same as rclcpp::Serialization::deserialize_message, which would need the
+  // data to be copied into a rclcpp::SerializedMessage first
+  const auto type_support =
+      rosidl_typesupport_cpp::get_message_type_support_handle<MessageType>();
+  const auto ret = rmw_deserialize(&serialized_data, type_support, data);
+  if (ret != RMW_RET_OK)
+    throw std::runtime_error("Failed to deserialize message of stream " +
+                             tm_.name);
 }
 
 template <typename DataType>
@@ -231,8 +578,7 @@ DataStreamAccessor<DataType>::deserializeMessage(
   if (!serialized) return nullptr;
 
   auto data = std::make_shared<DataType>();
-  rclcpp::SerializedMessage extracted_data(*serialized->serialized_data);
-  serialization_.deserialize_message(&extracted_data, data.get());
+  deserializeData(*serialized->serialized_data, data.get());
 
   auto deserialized = std::make_shared<LockableMessage<DataType>>(
       data, serialized->time_stamp, serialized->index);
@@ -248,12 +594,22 @@ DataStreamAccessor<DataType>::deserializeMessage(
     const std::shared_ptr<SerializedBagMessage> &serialized) {
   if (!serialized) return nullptr;
 
-  typename has_to_storable<DataType>::type data;
-  rclcpp::SerializedMessage extracted_data(*serialized->serialized_data);
-  serialization_.deserialize_message(&extracted_data, &data);
+  const StorableScope scope(*this, /* serializing */ false);
+  const auto data = [&] {
+    if constexpr (has_legacy_storable<T>::value) {
+      if (legacy_) {
+        typename has_legacy_storable<T>::type storable;
+        deserializeData(*serialized->serialized_data, &storable);
+        return DataType::fromLegacyStorable(storable);
+      }
+    }
+    typename has_to_storable<DataType>::type storable;
+    deserializeData(*serialized->serialized_data, &storable);
+    return DataType::fromStorable(storable);
+  }();
 
   auto deserialized = std::make_shared<LockableMessage<DataType>>(
-      DataType::fromStorable(data), serialized->time_stamp, serialized->index);
+      data, serialized->time_stamp, serialized->index);
 
   return deserialized;
 }
@@ -51,6 +51,22 @@ struct has_from_storable<
   static constexpr bool value = std::is_function_v<decltype(T::fromStorable)>;
 };
 
+/**
+ * \brief Storables whose storable message type replaced an older one define
+ * LegacyStorable, toLegacyStorable and fromLegacyStorable, so that streams
+ * created with the older type are still read and written with it.
+ */
+template <typename T, typename Enabled = void>
+struct has_legacy_storable {
+  static constexpr bool value = false;
+};
+
+template <typename T>
+struct has_legacy_storable<T, std::void_t<typename T::LegacyStorable>> {
+  static constexpr bool value = true;
+  typedef typename T::LegacyStorable type;
+};
+
 template <typename T>
 struct is_storable {
   static constexpr bool value =
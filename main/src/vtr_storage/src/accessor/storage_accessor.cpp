@@ -143,6 +143,13 @@ StorageAccessor::read_at_index_range(const Index& index_begin,
   return storage_->read_at_index_range(index_begin, index_end);
 }
 
+std::vector<TopicMetadata> StorageAccessor::get_all_topics_and_types() {
+  std::lock_guard<std::mutex> storage_lock(storage_mutex_);
+  if (!storage_)
+    throw std::runtime_error("Bag is not open. Call open() before reading.");
+  return storage_->get_all_topics_and_types();
+}
+
 void StorageAccessor::write(
     const std::shared_ptr<SerializedBagMessage>& message) {
   std::lock_guard<std::mutex> storage_lock(storage_mutex_);
@@ -162,13 +169,16 @@ void StorageAccessor::write(
   if (!storage_)
     throw std::runtime_error("Bag is not open. Call open() before writing.");
 
-  // Update the message count for the Topic.
+  // Update the message count for the Topic, once the batch has been committed.
+  std::vector<const std::string*> inserted;
   for (const auto& message : messages) {
-    if (message->index == 0)
-      ++topics_names_to_info_.at(message->topic_name).message_count;
+    if (message->index == 0) inserted.push_back(&message->topic_name);
   }
 
   storage_->write(messages);
+
+  for (const auto topic_name : inserted)
+    ++topics_names_to_info_.at(*topic_name).message_count;
 }
 
 void StorageAccessor::create_topic(const TopicMetadata& topic_with_type) {
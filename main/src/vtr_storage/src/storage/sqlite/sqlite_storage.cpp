@@ -179,7 +179,7 @@ void SqliteStorage::activate_transaction()
 #if false
   ROSBAG2_STORAGE_DEFAULT_PLUGINS_LOG_DEBUG_STREAM("begin transaction");
 #endif
-  database_->prepare_statement("BEGIN TRANSACTION;")->execute_and_reset();
+  database_->get_cached_statement("BEGIN TRANSACTION;")->execute_and_reset();
 
   active_transaction_ = true;
 }
@@ -193,7 +193,7 @@ void SqliteStorage::commit_transaction()
 #if false
   ROSBAG2_STORAGE_DEFAULT_PLUGINS_LOG_DEBUG_STREAM("commit transaction");
 #endif
-  database_->prepare_statement("COMMIT;")->execute_and_reset();
+  database_->get_cached_statement("COMMIT;")->execute_and_reset();
 
   active_transaction_ = false;
 }
@@ -210,17 +210,28 @@ void SqliteStorage::write(const std::vector<std::shared_ptr<SerializedBagMessage
   if (!insert_statement_ || !update_statement_) {
     prepare_for_writing();
   }
-  /// \note cannot use transaction here because we need the last insertion id,
-  /// which may not be correct if we use transaction.
-#if false
+  /// \note the last insertion id is per connection, so it stays correct inside
+  /// a transaction, and a single commit per batch avoids syncing the journal
+  /// for every message.
   activate_transaction();
-#endif
-  for (const auto & message : messages) {
-    write_locked(message);
+  std::vector<std::shared_ptr<SerializedBagMessage>> inserted;
+  try {
+    for (const auto & message : messages) {
+      if (message->index == 0) {
+        inserted.push_back(message);
+      }
+      write_locked(message);
+    }
+  } catch (...) {
+    // nothing of this batch has been stored, so undo the assigned indices
+    database_->get_cached_statement("ROLLBACK;")->execute_and_reset();
+    active_transaction_ = false;
+    for (const auto & message : inserted) {
+      message->index = 0;
+    }
+    throw;
   }
-#if false
   commit_transaction();
-#endif
 }
 
 void SqliteStorage::write_locked(const std::shared_ptr<SerializedBagMessage> & message)
@@ -278,47 +289,9 @@ std::shared_ptr<SerializedBagMessage> SqliteStorage::read_next()
 std::shared_ptr<SerializedBagMessage>
 SqliteStorage::read_at_timestamp(rcutils_time_point_value_t timestamp)
 {
-  /// prepare for reading
-  std::string statement_str = "SELECT data, timestamp, topics.name, messages.id "
-                              "FROM messages JOIN topics ON messages.topic_id = topics.id WHERE ";
-
-  // add topic filter
-  if (!storage_filter_.topics.empty()) {
-    // Construct string for selected topics
-    std::string topic_list{""};
-    for (auto & topic : storage_filter_.topics) {
-      topic_list += "'" + topic + "'";
-      if (&topic != &storage_filter_.topics.back()) {
-        topic_list += ",";
-      }
-    }
-    statement_str += "(topics.name IN (" + topic_list + ")) AND ";
-  }
-  // add time filter
-  statement_str += "(messages.timestamp = " + std::to_string(timestamp) + ") ";
-
-  // add order by time then id
-  statement_str += "ORDER BY messages.timestamp, messages.id;";
-
-  // query data
-  read_statement_ = database_->prepare_statement(statement_str);
-  message_result_ = read_statement_->execute_query<
-    std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, std::string, int>();
-  current_message_row_ = message_result_.begin();
-
-  // reset read statement
-  read_statement_ = nullptr;
-
-  // early return if no message found
-  if (current_message_row_ == message_result_.end()) return nullptr;
-
-  // return the first message in queue
-  const auto bag_message = std::make_shared<SerializedBagMessage>();
-  bag_message->serialized_data = std::get<0>(*current_message_row_);
-  bag_message->time_stamp = std::get<1>(*current_message_row_);
-  bag_message->topic_name = std::get<2>(*current_message_row_);
-  bag_message->index = std::get<3>(*current_message_row_);
-  return bag_message;
+  const auto bag_messages = read_messages(
+    "(timestamp = ?)", "timestamp, id", true, timestamp);
+  return bag_messages.empty() ? nullptr : bag_messages.front();
 }
 
 std::vector<std::shared_ptr<SerializedBagMessage>>
@@ -326,95 +299,16 @@ SqliteStorage::read_at_timestamp_range(
   rcutils_time_point_value_t timestamp_begin,
   rcutils_time_point_value_t timestamp_end)
 {
-  /// prepare for reading
-  std::string statement_str = "SELECT data, timestamp, topics.name, messages.id "
-                              "FROM messages JOIN topics ON messages.topic_id = topics.id WHERE ";
-
-  // add topic filter
-  if (!storage_filter_.topics.empty()) {
-    // Construct string for selected topics
-    std::string topic_list{""};
-    for (auto & topic : storage_filter_.topics) {
-      topic_list += "'" + topic + "'";
-      if (&topic != &storage_filter_.topics.back()) {
-        topic_list += ",";
-      }
-    }
-    statement_str += "(topics.name IN (" + topic_list + ")) AND ";
-  }
-  // add time filter
-  statement_str += "(messages.timestamp BETWEEN " +
-                   std::to_string(timestamp_begin) + " AND " +
-                   std::to_string(timestamp_end) + ") ";
-
-  // add order by time then id
-  statement_str += "ORDER BY messages.timestamp, messages.id;";
-
-  // query data
-  read_statement_ = database_->prepare_statement(statement_str);
-  message_result_ = read_statement_->execute_query<
-    std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, std::string, int>();
-  current_message_row_ = message_result_.begin();
-
-  // reset read statement
-  read_statement_ = nullptr;
-
-  // return query messages
-  std::vector<std::shared_ptr<SerializedBagMessage>> bag_messages;
-  for (; current_message_row_ != message_result_.end(); ++current_message_row_) {
-    bag_messages.push_back(std::make_shared<SerializedBagMessage>());
-    bag_messages.back()->serialized_data = std::get<0>(*current_message_row_);
-    bag_messages.back()->time_stamp = std::get<1>(*current_message_row_);
-    bag_messages.back()->topic_name = std::get<2>(*current_message_row_);
-    bag_messages.back()->index = std::get<3>(*current_message_row_);
-  }
-  return bag_messages;
+  return read_messages(
+    "(timestamp BETWEEN ? AND ?)", "timestamp, id", false, timestamp_begin, timestamp_end);
 }
 
 std::shared_ptr<SerializedBagMessage>
 SqliteStorage::read_at_index(int32_t index)
 {
-  /// prepare for reading
-  std::string statement_str = "SELECT data, timestamp, topics.name, messages.id "
-                              "FROM messages JOIN topics ON messages.topic_id = topics.id WHERE ";
-
-  // add topic filter
-  if (!storage_filter_.topics.empty()) {
-    // Construct string for selected topics
-    std::string topic_list{""};
-    for (auto & topic : storage_filter_.topics) {
-      topic_list += "'" + topic + "'";
-      if (&topic != &storage_filter_.topics.back()) {
-        topic_list += ",";
-      }
-    }
-    statement_str += "(topics.name IN (" + topic_list + ")) AND ";
-  }
-  // add time filter
-  statement_str += "(messages.id = " + std::to_string(index) + ") ";
-
-  // add order by time then id
-  statement_str += "ORDER BY messages.id, messages.timestamp;";
-
-  // query data
-  read_statement_ = database_->prepare_statement(statement_str);
-  message_result_ = read_statement_->execute_query<
-    std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, std::string, int>();
-  current_message_row_ = message_result_.begin();
-
-  // reset read statement
-  read_statement_ = nullptr;
-
-  // early return if no message found
-  if (current_message_row_ == message_result_.end()) return nullptr;
-
-  // return the first message in queue
-  const auto bag_message = std::make_shared<SerializedBagMessage>();
-  bag_message->serialized_data = std::get<0>(*current_message_row_);
-  bag_message->time_stamp = std::get<1>(*current_message_row_);
-  bag_message->topic_name = std::get<2>(*current_message_row_);
-  bag_message->index = std::get<3>(*current_message_row_);
-  return bag_message;
+  const auto bag_messages = read_messages(
+    "(id = ?)", "id, timestamp", true, static_cast<int>(index));
+  return bag_messages.empty() ? nullptr : bag_messages.front();
 }
 
 std::vector<std::shared_ptr<SerializedBagMessage>>
@@ -422,49 +316,108 @@ SqliteStorage::read_at_index_range(
   int32_t index_begin,
   int32_t index_end)
 {
-  /// prepare for reading
-  std::string statement_str = "SELECT data, timestamp, topics.name, messages.id "
-                              "FROM messages JOIN topics ON messages.topic_id = topics.id WHERE ";
+  return read_messages(
+    "(id BETWEEN ? AND ?)", "id, timestamp", false,
+    static_cast<int>(index_begin), static_cast<int>(index_end));
+}
+
+template<typename ... Params>
+std::vector<std::shared_ptr<SerializedBagMessage>>
+SqliteStorage::read_messages(
+  const std::string & condition, const std::string & order, bool single,
+  Params ... params)
+{
+  std::vector<std::shared_ptr<SerializedBagMessage>> bag_messages;
 
   // add topic filter
-  if (!storage_filter_.topics.empty()) {
-    // Construct string for selected topics
-    std::string topic_list{""};
-    for (auto & topic : storage_filter_.topics) {
-      topic_list += "'" + topic + "'";
-      if (&topic != &storage_filter_.topics.back()) {
-        topic_list += ",";
-      }
+  const auto topic_ids = get_filter_topic_ids();
+  if (!storage_filter_.topics.empty() && topic_ids.empty()) {
+    return bag_messages;
+  }
+  std::string statement_str = "SELECT data, timestamp, topic_id, id FROM messages WHERE ";
+  if (!topic_ids.empty()) {
+    statement_str += "(topic_id IN (?";
+    for (size_t i = 1; i < topic_ids.size(); ++i) {
+      statement_str += ",?";
     }
-    statement_str += "(topics.name IN (" + topic_list + ")) AND ";
+    statement_str += ")) AND ";
   }
-  // add time filter
-  statement_str += "(messages.id BETWEEN " +
-                   std::to_string(index_begin) + " AND " +
-                   std::to_string(index_end) + ") ";
+  statement_str += condition + " ORDER BY " + order + ";";
 
-  // add order by time then id
-  statement_str += "ORDER BY messages.id, messages.timestamp;";
+  // query data, the statement is prepared once per query shape
+  auto statement = database_->get_cached_statement(statement_str);
+  try {
+    for (const auto topic_id : topic_ids) {
+      statement->bind(topic_id);
+    }
+    statement->bind(params ...);
+
+    auto message_result = statement->execute_query<
+      std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, int, int>();
+    bool topics_refreshed = false;
+    for (auto row : message_result) {
+      auto topic_name = get_topic_name(std::get<2>(row), false);
+      if (topic_name.empty() && !topics_refreshed) {
+        topic_name = get_topic_name(std::get<2>(row), true);
+        topics_refreshed = true;
+      }
+      // messages of removed topics are skipped, as a join with topics would do
+      if (topic_name.empty()) {
+        continue;
+      }
+      // the blob has been copied once out of sqlite, hand out that buffer
+      auto bag_message = std::make_shared<SerializedBagMessage>();
+      bag_message->serialized_data = std::move(std::get<0>(row));
+      bag_message->time_stamp = std::get<1>(row);
+      bag_message->topic_name = std::move(topic_name);
+      bag_message->index = std::get<3>(row);
+      bag_messages.push_back(std::move(bag_message));
+      if (single) {
+        break;
+      }
+    }
+  } catch (...) {
+    statement->reset();
+    throw;
+  }
+  // reset the statement to end its read transaction
+  statement->reset();
 
-  // query data
-  read_statement_ = database_->prepare_statement(statement_str);
-  message_result_ = read_statement_->execute_query<
-    std::shared_ptr<rcutils_uint8_array_t>, rcutils_time_point_value_t, std::string, int>();
-  current_message_row_ = message_result_.begin();
+  return bag_messages;
+}
 
-  // reset read statement
-  read_statement_ = nullptr;
+std::vector<int> SqliteStorage::get_filter_topic_ids()
+{
+  std::vector<int> topic_ids;
+  if (storage_filter_.topics.empty()) {
+    return topic_ids;
+  }
+  std::lock_guard<std::mutex> db_lock(database_write_mutex_);
+  for (bool refreshed = false; ; refreshed = true) {
+    topic_ids.clear();
+    for (const auto & topic : storage_filter_.topics) {
+      const auto topic_entry = topics_.find(topic);
+      if (topic_entry != std::end(topics_)) {
+        topic_ids.push_back(topic_entry->second);
+      }
+    }
+    // topics may have been created by another connection
+    if (refreshed || topic_ids.size() == storage_filter_.topics.size()) {
+      break;
+    }
+    fill_topics_map_locked();
+  }
+  return topic_ids;
+}
 
-  // return query messages
-  std::vector<std::shared_ptr<SerializedBagMessage>> bag_messages;
-  for (; current_message_row_ != message_result_.end(); ++current_message_row_) {
-    bag_messages.push_back(std::make_shared<SerializedBagMessage>());
-    bag_messages.back()->serialized_data = std::get<0>(*current_message_row_);
-    bag_messages.back()->time_stamp = std::get<1>(*current_message_row_);
-    bag_messages.back()->topic_name = std::get<2>(*current_message_row_);
-    bag_messages.back()->index = std::get<3>(*current_message_row_);
+std::string SqliteStorage::get_topic_name(int topic_id, bool refresh)
+{
+  std::lock_guard<std::mutex> db_lock(database_write_mutex_);
+  if (refresh) {
+    fill_topics_map_locked();
   }
-  return bag_messages;
+  const auto topic_entry = topic_names_.find(topic_id);
+  return topic_entry == std::end(topic_names_) ? std::string() : topic_entry->second;
 }
 
 std::vector<TopicMetadata> SqliteStorage::get_all_topics_and_types()
@@ -513,30 +466,41 @@ void SqliteStorage::create_topic(const TopicMetadata & topic)
     insert_topic->bind(
       topic.name, topic.type, topic.serialization_format, topic.offered_qos_profiles);
     insert_topic->execute_and_reset();
-    topics_.emplace(topic.name, static_cast<int>(database_->get_last_insert_id()));
+    const auto topic_id = static_cast<int>(database_->get_last_insert_id());
+    topics_.emplace(topic.name, topic_id);
+    topic_names_.emplace(topic_id, topic.name);
   }
 }
 
 void SqliteStorage::remove_topic(const TopicMetadata & topic)
 {
   std::lock_guard<std::mutex> db_lock(database_write_mutex_);
-  if (topics_.find(topic.name) != std::end(topics_)) {
+  const auto topic_entry = topics_.find(topic.name);
+  if (topic_entry != std::end(topics_)) {
     auto delete_topic =
       database_->prepare_statement(
       "DELETE FROM topics where name = ? and type = ? and serialization_format = ?");
     delete_topic->bind(topic.name, topic.type, topic.serialization_format);
     delete_topic->execute_and_reset();
-    topics_.erase(topic.name);
+    topic_names_.erase(topic_entry->second);
+    topics_.erase(topic_entry);
   }
 }
 
 void SqliteStorage::fill_topics_map()
 {
   std::lock_guard<std::mutex> db_lock(database_write_mutex_);
+  fill_topics_map_locked();
+}
+
+void SqliteStorage::fill_topics_map_locked()
+{
   auto query_stmt = database_->prepare_statement("SELECT name, id FROM topics ORDER BY id;");
   auto query_results = query_stmt->execute_query<std::string, int>();
-  for (auto result : query_results)
+  for (auto result : query_results) {
     topics_.emplace(std::get<0>(result), std::get<1>(result));
+    topic_names_.emplace(std::get<1>(result), std::get<0>(result));
+  }
 }
 
 void SqliteStorage::prepare_for_writing()
@@ -92,6 +92,7 @@ SqliteWrapper::SqliteWrapper()
 
 SqliteWrapper::~SqliteWrapper()
 {
+  statement_cache_.clear();
   const int rc = sqlite3_close(db_ptr);
   if (rc != SQLITE_OK) {
     std::stringstream err;
@@ -105,6 +106,17 @@ SqliteStatement SqliteWrapper::prepare_statement(const std::string & query)
   return std::make_shared<SqliteStatementWrapper>(db_ptr, query);
 }
 
+SqliteStatement SqliteWrapper::get_cached_statement(const std::string & query)
+{
+  auto & statement = statement_cache_[query];
+  if (statement) {
+    statement->reset();
+  } else {
+    statement = prepare_statement(query);
+  }
+  return statement;
+}
+
 size_t SqliteWrapper::get_last_insert_id()
 {
   return sqlite3_last_insert_rowid(db_ptr);
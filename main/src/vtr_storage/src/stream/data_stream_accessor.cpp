@@ -20,6 +20,9 @@
  */
 #include <vtr_storage/stream/data_stream_accessor.hpp>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 namespace vtr {
 namespace storage {
 
@@ -34,7 +37,123 @@ DataStreamAccessorBase::DataStreamAccessorBase(
   tm_.type = stream_type;
   tm_.serialization_format = "cdr";
   storage_accessor_->create_topic(tm_);
+  // an existing stream keeps the type it was created with
+  for (const auto &topic : storage_accessor_->get_all_topics_and_types())
+    if (topic.name == tm_.name) tm_.type = topic.type;
+
+  write_config_ = getDefaultWriteConfig();
+}
+
+namespace {
+
+std::mutex default_write_config_mutex;
+DataStreamAccessorBase::WriteConfig default_write_config;
+
+}  // namespace
+
+void DataStreamAccessorBase::setDefaultWriteConfig(const WriteConfig &config) {
+  const std::lock_guard<std::mutex> lock(default_write_config_mutex);
+  default_write_config = config;
+}
+
+auto DataStreamAccessorBase::getDefaultWriteConfig() -> WriteConfig {
+  const std::lock_guard<std::mutex> lock(default_write_config_mutex);
+  return default_write_config;
+}
+
+void DataStreamAccessorBase::setWriteConfig(const WriteConfig &config) {
+  const std::lock_guard<std::mutex> lock(write_mutex_);
+  write_config_ = config;
+}
+
+auto DataStreamAccessorBase::getWriteConfig() const -> WriteConfig {
+  const std::lock_guard<std::mutex> lock(write_mutex_);
+  return write_config_;
+}
+
+auto DataStreamAccessorBase::getWriteStats() const -> WriteStats {
+  const std::lock_guard<std::mutex> lock(write_mutex_);
+  auto stats = write_stats_;
+  stats.queue_depth = queue_depth_;
+  return stats;
+}
+
+namespace {
+
+thread_local const DataStreamAccessorBase::StorableScope *storable_scope =
+    nullptr;
+
+}  // namespace
+
+auto DataStreamAccessorBase::StorableScope::current() -> const StorableScope * {
+  return storable_scope;
+}
+
+DataStreamAccessorBase::StorableScope::StorableScope(
+    DataStreamAccessorBase &accessor, const bool serializing)
+    : accessor_(accessor),
+      serializing_(serializing),
+      previous_(storable_scope) {
+  storable_scope = this;
+}
+
+DataStreamAccessorBase::StorableScope::~StorableScope() {
+  storable_scope = previous_;
+}
+
+bool DataStreamAccessorBase::flushRequired() const {
+  if (queue_depth_ == 0) return false;
+  if (queue_depth_ >= write_config_.max_pending_messages) return true;
+  if (write_config_.max_pending_bytes > 0 &&
+      pending_bytes_ >= write_config_.max_pending_bytes)
+    return true;
+  if (write_config_.max_pending_time.count() > 0 &&
+      Clock::now() - pending_since_ >= write_config_.max_pending_time)
+    return true;
+  return false;
+}
+
+void DataStreamAccessorBase::syncOnCommit(const std::filesystem::path &file) {
+  files_to_sync_.insert(file);
+}
+
+void DataStreamAccessorBase::removeOnCommit(const std::filesystem::path &file) {
+  files_to_remove_.insert(file);
+}
+
+void DataStreamAccessorBase::syncFiles() {
+  if (files_to_sync_.empty()) return;
+  const auto sync = [this](const std::filesystem::path &path, const int flags) {
+    const int fd = ::open(path.c_str(), flags);
+    const bool synced = fd >= 0 && ::fsync(fd) == 0;
+    if (fd >= 0) ::close(fd);
+    if (!synced) {
+      std::string err{"Failed to sync " + path.string() + " of stream " +
+                      tm_.name};
+      CLOG(ERROR, "storage") << err;
+      throw std::runtime_error{err};
+    }
+  };
+  std::set<std::filesystem::path> directories;
+  for (const auto &file : files_to_sync_) {
+    // replaced again before the commit, nothing refers to it
+    if (files_to_remove_.count(file)) continue;
+    sync(file, O_RDONLY);
+    directories.insert(file.parent_path());
+  }
+  // files are renamed into place, which is persisted by syncing the directory
+  for (const auto &directory : directories)
+    sync(directory, O_RDONLY | O_DIRECTORY);
+  files_to_sync_.clear();
+}
+
+void DataStreamAccessorBase::removeReplacedFiles() {
+  for (const auto &file : files_to_remove_) {
+    std::error_code ec;
+    std::filesystem::remove(file, ec);
+  }
+  files_to_remove_.clear();
 }
 
 }  // namespace storage
-}  // namespace vtr
\ No newline at end of file
+}  // namespace vtr
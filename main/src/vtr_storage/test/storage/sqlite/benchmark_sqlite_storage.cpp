@@ -0,0 +1,201 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file benchmark_sqlite_storage.cpp
+ * \brief SqliteStorage read latency of point lookups and range scans on a
+ * 100k-message database, compared to preparing a joined query per read.
+ */
+#include <chrono>
+#include <random>
+
+#include "rcpputils/filesystem_helper.hpp"
+
+#include "vtr_logging/logging_init.hpp"
+#include "vtr_storage/storage/ros_helper.hpp"
+#include "vtr_storage/storage/sqlite/sqlite_storage.hpp"
+
+using namespace vtr;
+using namespace vtr::logging;
+using namespace vtr::storage;
+
+namespace {
+
+constexpr int num_messages = 100000;
+constexpr int num_topics = 4;
+constexpr size_t message_size = 512;
+constexpr int num_point_lookups = 20000;
+constexpr int num_range_scans = 2000;
+constexpr int range_size = 50;
+
+rcutils_time_point_value_t timestamp(const int index) {
+  return rcutils_time_point_value_t(index) * 100000000;
+}
+
+/** \brief Reads the way SqliteStorage did before caching statements */
+std::vector<std::shared_ptr<SerializedBagMessage>> readPrevious(
+    sqlite::SqliteWrapper &database, const std::string &condition,
+    const std::string &order) {
+  const auto statement = database.prepare_statement(
+      "SELECT data, timestamp, topics.name, messages.id FROM messages JOIN "
+      "topics ON messages.topic_id = topics.id WHERE " +
+      condition + " ORDER BY " + order + ";");
+  auto result = statement->execute_query<std::shared_ptr<rcutils_uint8_array_t>,
+                                         rcutils_time_point_value_t,
+                                         std::string, int>();
+  std::vector<std::shared_ptr<SerializedBagMessage>> bag_messages;
+  for (auto row : result) {
+    bag_messages.push_back(std::make_shared<SerializedBagMessage>());
+    bag_messages.back()->serialized_data = std::get<0>(row);
+    bag_messages.back()->time_stamp = std::get<1>(row);
+    bag_messages.back()->topic_name = std::get<2>(row);
+    bag_messages.back()->index = std::get<3>(row);
+  }
+  return bag_messages;
+}
+
+}  // namespace
+
+int main(int, char **) {
+  configureLogging("", true);
+
+  const auto directory = rcpputils::fs::create_temp_directory("tmp_bench_");
+  const auto db_file = (directory / "benchmark").string();
+
+  const auto elapsed_us = [](const auto &start) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - start)
+               .count() /
+           1000.0;
+  };
+
+  sqlite::SqliteStorage storage;
+  storage.open(db_file);
+  {
+    for (int i = 0; i < num_topics; ++i)
+      storage.create_topic({"topic" + std::to_string(i), "type", "cdr", ""});
+
+    std::vector<std::shared_ptr<SerializedBagMessage>> bag_messages;
+    std::vector<uint8_t> data(message_size);
+    for (int i = 0; i < num_messages; ++i) {
+      for (size_t j = 0; j < message_size; ++j) data[j] = uint8_t(i + j);
+      auto bag_message = std::make_shared<SerializedBagMessage>();
+      bag_message->serialized_data =
+          make_serialized_message(data.data(), data.size());
+      bag_message->time_stamp = timestamp(i);
+      bag_message->topic_name = "topic" + std::to_string(i % num_topics);
+      bag_messages.push_back(bag_message);
+    }
+    const auto start = std::chrono::steady_clock::now();
+    storage.write(bag_messages);
+    CLOG(INFO, "test") << "Wrote " << num_messages << " messages of "
+                       << message_size << " bytes in "
+                       << elapsed_us(start) / 1000.0 << " ms";
+  }
+  sqlite::SqliteWrapper previous(storage.get_relative_file_path(),
+                                 IOFlag::READ_ONLY);
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> dist(0, num_messages - range_size);
+  std::vector<int> indices(num_point_lookups);
+  for (auto &index : indices) index = dist(gen);
+
+  /// point lookups
+  size_t num_read = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (const auto index : indices)
+    num_read += readPrevious(previous,
+                             "(messages.id = " + std::to_string(index + 1) +
+                                 ")",
+                             "messages.id, messages.timestamp")
+                    .size();
+  const auto index_previous = elapsed_us(start) / num_point_lookups;
+  start = std::chrono::steady_clock::now();
+  for (const auto index : indices)
+    num_read += storage.read_at_index(index + 1) != nullptr;
+  const auto index_current = elapsed_us(start) / num_point_lookups;
+  CLOG(INFO, "test") << "read_at_index: previous " << index_previous
+                     << " us, current " << index_current << " us per read";
+
+  start = std::chrono::steady_clock::now();
+  for (const auto index : indices)
+    num_read += readPrevious(previous,
+                             "(messages.timestamp = " +
+                                 std::to_string(timestamp(index)) + ")",
+                             "messages.timestamp, messages.id")
+                    .size();
+  const auto timestamp_previous = elapsed_us(start) / num_point_lookups;
+  start = std::chrono::steady_clock::now();
+  for (const auto index : indices)
+    num_read += storage.read_at_timestamp(timestamp(index)) != nullptr;
+  const auto timestamp_current = elapsed_us(start) / num_point_lookups;
+  CLOG(INFO, "test") << "read_at_timestamp: previous " << timestamp_previous
+                     << " us, current " << timestamp_current << " us per read";
+
+  /// range scans
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_range_scans; ++i)
+    num_read +=
+        readPrevious(previous,
+                     "(messages.id BETWEEN " + std::to_string(indices[i] + 1) +
+                         " AND " + std::to_string(indices[i] + range_size) +
+                         ")",
+                     "messages.id, messages.timestamp")
+            .size();
+  const auto index_range_previous = elapsed_us(start) / num_range_scans;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_range_scans; ++i)
+    num_read +=
+        storage.read_at_index_range(indices[i] + 1, indices[i] + range_size)
+            .size();
+  const auto index_range_current = elapsed_us(start) / num_range_scans;
+  CLOG(INFO, "test") << "read_at_index_range (" << range_size
+                     << " messages): previous " << index_range_previous
+                     << " us, current " << index_range_current
+                     << " us per read";
+
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_range_scans; ++i)
+    num_read +=
+        readPrevious(previous,
+                     "(messages.timestamp BETWEEN " +
+                         std::to_string(timestamp(indices[i])) + " AND " +
+                         std::to_string(
+                             timestamp(indices[i] + range_size - 1)) +
+                         ")",
+                     "messages.timestamp, messages.id")
+            .size();
+  const auto timestamp_range_previous = elapsed_us(start) / num_range_scans;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < num_range_scans; ++i)
+    num_read += storage
+                    .read_at_timestamp_range(
+                        timestamp(indices[i]),
+                        timestamp(indices[i] + range_size - 1))
+                    .size();
+  const auto timestamp_range_current = elapsed_us(start) / num_range_scans;
+  CLOG(INFO, "test") << "read_at_timestamp_range (" << range_size
+                     << " messages): previous " << timestamp_range_previous
+                     << " us, current " << timestamp_range_current
+                     << " us per read";
+
+  const size_t num_expected =
+      4 * num_point_lookups + 4 * num_range_scans * range_size;
+  if (num_read != num_expected)
+    CLOG(ERROR, "test") << "Read " << num_read << " messages, expected "
+                        << num_expected;
+
+  rcpputils::fs::remove_all(directory);
+  return 0;
+}
@@ -292,4 +292,71 @@ TEST_F(StorageTestFixture, randomly_reading_messages) {
     EXPECT_THAT(read_messages[1]->topic_name, Eq("topic1"));
   }
 
-}
\ No newline at end of file
+}
+
+TEST_F(StorageTestFixture, randomly_reading_filtered_messages) {
+  std::unique_ptr<ReadWriteInterface> storage_accessor = std::make_unique<sqlite::SqliteStorage>();
+  auto db_file = (rcpputils::fs::path(temporary_dir_path_) / "rosbag").string();
+  storage_accessor->open(db_file);
+
+  std::vector<std::tuple<std::string, int64_t, std::string, std::string, std::string>> messages =
+  {
+    std::make_tuple("message0", 0, "topic0", "type0", "rmw"),
+    std::make_tuple("message1", 0, "topic1", "type1", "rmw"),
+    std::make_tuple("message2", 1, "topic0", "type0", "rmw"),
+    std::make_tuple("message3", 1, "topic1", "type1", "rmw"),
+    std::make_tuple("message4", 1, "topic2", "type2", "rmw")
+  };
+
+  // insert messages
+  for (auto msg : messages) {
+    std::string topic_name = std::get<2>(msg);
+    std::string type_name = std::get<3>(msg);
+    std::string rmw_format = std::get<4>(msg);
+    storage_accessor->create_topic({topic_name, type_name, rmw_format, ""});
+    auto bag_message = std::make_shared<SerializedBagMessage>();
+    bag_message->serialized_data = make_serialized_message(std::get<0>(msg));
+    bag_message->time_stamp = std::get<1>(msg);
+    bag_message->topic_name = topic_name;
+    storage_accessor->write(bag_message);
+  }
+
+  StorageFilter storage_filter;
+  storage_filter.topics.push_back("topic1");
+  storage_filter.topics.push_back("topic2");
+  storage_accessor->set_filter(storage_filter);
+
+  // read at a timestamp, first message of the filtered topics
+  {
+    const auto read_message = storage_accessor->read_at_timestamp(1);
+    EXPECT_THAT(deserialize_message(read_message->serialized_data), StrEq("message3"));
+    EXPECT_THAT(read_message->topic_name, Eq("topic1"));
+  }
+
+  // read at an index of a topic that is filtered out
+  EXPECT_THAT(storage_accessor->read_at_index(3), IsNull());
+
+  // read at an index range
+  {
+    const auto read_messages = storage_accessor->read_at_index_range(1, 5);
+    ASSERT_THAT(read_messages.size(), Eq((unsigned)3));
+    EXPECT_THAT(deserialize_message(read_messages[0]->serialized_data), StrEq("message1"));
+    EXPECT_THAT(deserialize_message(read_messages[1]->serialized_data), StrEq("message3"));
+    EXPECT_THAT(deserialize_message(read_messages[2]->serialized_data), StrEq("message4"));
+    EXPECT_THAT(read_messages[2]->topic_name, Eq("topic2"));
+  }
+
+  // messages of removed topics are not read
+  storage_accessor->remove_topic({"topic2", "type2", "rmw", ""});
+  {
+    const auto read_messages = storage_accessor->read_at_timestamp_range(0, 1);
+    ASSERT_THAT(read_messages.size(), Eq((unsigned)2));
+    EXPECT_THAT(deserialize_message(read_messages[0]->serialized_data), StrEq("message1"));
+    EXPECT_THAT(deserialize_message(read_messages[1]->serialized_data), StrEq("message3"));
+  }
+
+  // topics unknown to the database match no message
+  storage_filter.topics = {"topic3"};
+  storage_accessor->set_filter(storage_filter);
+  EXPECT_THAT(storage_accessor->read_at_index_range(1, 5), IsEmpty());
+}
@@ -104,6 +104,21 @@ TEST_F(SqliteWrapperTestFixture, reuse_prepared_statement) {
   ASSERT_THAT(std::get<0>(*row_iter), Eq(2));
 }
 
+TEST_F(SqliteWrapperTestFixture, cached_statement_is_prepared_once_and_reset) {
+  db_.prepare_statement("CREATE TABLE test (col INTEGER);")->execute_and_reset();
+  db_.prepare_statement("INSERT INTO test (col) VALUES (1), (2), (3);")->execute_and_reset();
+
+  auto statement = db_.get_cached_statement("SELECT col FROM test WHERE col >= ? ORDER BY col;");
+  auto row_iter = statement->bind(2)->execute_query<int>().begin();
+  ASSERT_THAT(std::get<0>(*row_iter), Eq(2));
+
+  // returned again, reset even though its result has not been fully read
+  auto statement2 = db_.get_cached_statement("SELECT col FROM test WHERE col >= ? ORDER BY col;");
+  ASSERT_THAT(statement2, Eq(statement));
+  auto row_iter2 = statement2->bind(3)->execute_query<int>().begin();
+  ASSERT_THAT(std::get<0>(*row_iter2), Eq(3));
+}
+
 TEST_F(SqliteWrapperTestFixture, all_result_rows_are_available) {
   db_.prepare_statement("CREATE TABLE test (col INTEGER);")->execute_and_reset();
   db_.prepare_statement("INSERT INTO test (col) VALUES (1);")->execute_and_reset();
@@ -348,4 +348,87 @@ TEST_F(TemporaryDirectoryFixture, data_stream_writer_locks_message_correctly) {
   }
 
   th.join();
-}
\ No newline at end of file
+}
+TEST_F(TemporaryDirectoryFixture, write_behind) {
+  DataStreamAccessor<StringMsg> accessor(temp_dir_, "test_string");
+
+  DataStreamAccessorBase::WriteConfig config;
+  config.max_pending_messages = 3;
+  accessor.setWriteConfig(config);
+
+  const auto make_message = [](const std::string& str, const Timestamp& time) {
+    const auto data = std::make_shared<StringMsg>();
+    data->data = str;
+    return std::make_shared<LockableMessage<StringMsg>>(data, time);
+  };
+
+  // writes are queued, messages are saved but have no index yet
+  const auto message1 = make_message("data1", 1);
+  const auto message2 = make_message("data2", 2);
+  accessor.write(message1);
+  accessor.write(message2);
+  EXPECT_EQ(accessor.getWriteStats().queue_depth, (size_t)2);
+  EXPECT_EQ(accessor.getWriteStats().commits, (size_t)0);
+  EXPECT_EQ(message1->unlocked().get().getSaved(), true);
+  EXPECT_EQ(message1->unlocked().get().getIndex(), NO_INDEX_VALUE);
+
+  // rewriting a queued message does not insert it twice
+  StringMsg data1;
+  data1.data = "data1 updated";
+  message1->unlocked().get().setData(data1);
+  accessor.write(message1);
+  EXPECT_EQ(accessor.getWriteStats().queue_depth, (size_t)2);
+
+  // reads commit the queue first
+  {
+    const auto lockable_message = accessor.readAtTimestamp(1);
+    ASSERT_NE(lockable_message, nullptr);
+    const auto& message = lockable_message->unlocked().get();
+    EXPECT_EQ(message.getData().data, "data1 updated");
+    EXPECT_EQ(message.getIndex(), 1);
+  }
+  EXPECT_EQ(message1->unlocked().get().getIndex(), 1);
+  EXPECT_EQ(message2->unlocked().get().getIndex(), 2);
+  EXPECT_EQ(accessor.getWriteStats().queue_depth, (size_t)0);
+  EXPECT_EQ(accessor.getWriteStats().commits, (size_t)1);
+  EXPECT_EQ(accessor.getWriteStats().messages_written, (size_t)2);
+
+  // the queue is committed in one transaction once full, including messages
+  // destroyed in the meantime
+  accessor.write(make_message("data3", 3));
+  accessor.write(make_message("data4", 4));
+  EXPECT_EQ(accessor.getWriteStats().commits, (size_t)1);
+  accessor.write(make_message("data5", 5));
+  EXPECT_EQ(accessor.getWriteStats().commits, (size_t)2);
+  EXPECT_EQ(accessor.getWriteStats().max_queue_depth, (size_t)3);
+  EXPECT_EQ(accessor.readAtIndexRange(1, 5).size(), (size_t)5);
+}
+
+TEST_F(TemporaryDirectoryFixture, write_behind_commits_locked_message) {
+  DataStreamAccessor<StringMsg> accessor(temp_dir_, "test_string");
+
+  DataStreamAccessorBase::WriteConfig config;
+  config.max_pending_messages = 3;
+  accessor.setWriteConfig(config);
+
+  const auto data = std::make_shared<StringMsg>();
+  data->data = "data1";
+  const auto message = std::make_shared<LockableMessage<StringMsg>>(data, 1);
+  accessor.write(message);
+
+  // committing does not wait for a message locked by the caller
+  {
+    const auto message_locked = message->locked();
+    std::thread th([&] { accessor.flush(); });
+    th.join();
+    EXPECT_EQ(message_locked.get().getIndex(), NO_INDEX_VALUE);
+  }
+  EXPECT_EQ(accessor.getWriteStats().commits, (size_t)1);
+
+  // the index is set on the next write, without inserting the message again
+  accessor.write(message);
+  EXPECT_EQ(message->unlocked().get().getIndex(), 1);
+  EXPECT_EQ(message->unlocked().get().getSaved(), true);
+  EXPECT_EQ(accessor.getWriteStats().queue_depth, (size_t)0);
+  EXPECT_EQ(accessor.readAtIndexRange(1, 5).size(), (size_t)1);
+}
@@ -22,10 +22,9 @@
 
 #include "steam.hpp"
 
+#include "vtr_tactic/obstacle_grid.hpp"
 #include "vtr_tactic/types.hpp"
 
-#include "vtr_common/utils/hash.hpp" // For pair hash function in obstacle map
-
 namespace vtr {
 namespace tactic {
 
@@ -148,10 +147,10 @@ struct OutputCache : std::enable_shared_from_this<OutputCache> {
   Cache<rclcpp::Node> node;
   Cache<LocalizationChain> chain;
 
-  // Obstacle Costmap:
+  // Obstacle Costmap: a new grid is published every update by replacing the
+  // pointer under obsMapMutex, readers keep the pointer as their snapshot
   std::mutex obsMapMutex;
-  using XY2ValueMap = std::unordered_map<std::pair<float, float>, float>;
-  XY2ValueMap obs_map;
+  ObstacleGrid::ConstPtr obs_map;
   unsigned costmap_sid;
   float grid_resolution = 0.25;
 };
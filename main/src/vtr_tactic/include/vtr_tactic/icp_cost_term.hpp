@@ -0,0 +1,224 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file icp_cost_term.hpp
+ * \brief ICPCostTerm class definition
+ */
+#pragma once
+
+#include <omp.h>
+
+#include "steam.hpp"
+
+namespace vtr {
+namespace tactic {
+
+/**
+ * \brief All point matches of an ICP iteration as a single steam cost term.
+ * \details Equivalent to one WeightedLeastSqCostTerm<3> on p2p::p2pError per
+ * match, but the Gauss-Newton terms of consecutive matches sharing a pose
+ * evaluable are accumulated into a dense 6x6 system first, projected onto
+ * the state variables once per run, and reduced from thread-local dense
+ * accumulators. No evaluable, noise model or cost term is allocated per match
+ * and no critical section is entered per match, so the cost term can be kept
+ * in the same problem across ICP iterations and refilled every iteration.
+ * Priors are added to the problem through the usual steam interface.
+ */
+class ICPCostTerm : public steam::BaseCostTerm {
+ public:
+  using Ptr = std::shared_ptr<ICPCostTerm>;
+  using ConstPtr = std::shared_ptr<const ICPCostTerm>;
+
+  using PoseEvaluable = steam::Evaluable<lgmath::se3::Transformation>;
+
+  /** \brief Point match, error is ref - T_ref_qry[pose] * qry */
+  struct Match {
+    Eigen::Vector3d qry;
+    Eigen::Vector3d ref;
+    Eigen::Matrix3d W;  // information matrix
+    size_t pose;
+  };
+
+  static Ptr MakeShared(const std::vector<PoseEvaluable::ConstPtr> &T_ref_qry,
+                        const steam::BaseLossFunc::ConstPtr &loss_func,
+                        const int num_threads = 1) {
+    return std::make_shared<ICPCostTerm>(T_ref_qry, loss_func, num_threads);
+  }
+
+  /**
+   * \param T_ref_qry pose evaluables that matches refer to by index, e.g. a
+   * single rigid transform or one interpolated pose per query point
+   * \param loss_func loss function applied to the whitened error norm
+   * \param num_threads number of threads used to accumulate matches, the
+   * owning problem should then be single threaded to avoid nested regions
+   */
+  ICPCostTerm(const std::vector<PoseEvaluable::ConstPtr> &T_ref_qry,
+              const steam::BaseLossFunc::ConstPtr &loss_func,
+              const int num_threads = 1)
+      : T_ref_qry_(T_ref_qry), loss_func_(loss_func), num_threads_(num_threads) {
+    steam::KeySet keys;
+    for (const auto &T : T_ref_qry_) T->getRelatedVarKeys(keys);
+    keys_.assign(keys.begin(), keys.end());
+  }
+
+  /** \brief Removes all matches, keeping the allocated storage */
+  void clear() {
+    matches_.clear();
+    runs_.clear();
+  }
+
+  void reserve(const size_t size) { matches_.reserve(size); }
+
+  size_t size() const { return matches_.size(); }
+
+  /**
+   * \brief Adds a match. Matches of the same pose should be added one after
+   * another, each run of them is evaluated only once.
+   */
+  void add(const Eigen::Vector3d &qry, const Eigen::Vector3d &ref,
+           const Eigen::Matrix3d &W, const size_t pose = 0) {
+    if (runs_.empty() || runs_.back().pose != pose ||
+        matches_.size() - runs_.back().begin >= max_run_size)
+      runs_.emplace_back(Run{pose, matches_.size()});
+    matches_.emplace_back(Match{qry, ref, W, pose});
+  }
+
+  double cost() const override {
+    double cost = 0;
+#pragma omp parallel for schedule(dynamic, 1) num_threads(num_threads_) reduction(+ : cost)
+    for (size_t r = 0; r < runs_.size(); ++r) {
+      const Eigen::Matrix4d T = T_ref_qry_[runs_[r].pose]->evaluate().matrix();
+      for (size_t i = runs_[r].begin; i < runEnd(r); ++i) {
+        const auto &m = matches_[i];
+        const Eigen::Vector3d error = m.ref - T.block<3, 3>(0, 0) * m.qry - T.block<3, 1>(0, 3);
+        cost += loss_func_->cost(std::sqrt(error.dot(m.W * error)));
+      }
+    }
+    return cost;
+  }
+
+  void getRelatedVarKeys(steam::KeySet &keys) const override {
+    keys.insert(keys_.begin(), keys_.end());
+  }
+
+  void buildGaussNewtonTerms(
+      const steam::StateVector &state_vec,
+      steam::BlockSparseMatrix *approximate_hessian,
+      steam::BlockVector *gradient_vector) const override {
+    if (runs_.empty() || keys_.empty()) return;
+
+    // dense layout of the related state variables
+    const auto block_sizes = state_vec.getStateBlockSizes();
+    std::unordered_map<steam::StateKey, size_t, steam::StateKeyHash> key2var;
+    std::vector<unsigned int> blk_idx(keys_.size()), offset(keys_.size() + 1, 0);
+    for (size_t k = 0; k < keys_.size(); ++k) {
+      key2var.emplace(keys_[k], k);
+      blk_idx[k] = state_vec.getStateBlockIndex(keys_[k]);
+      offset[k + 1] = offset[k] + block_sizes[blk_idx[k]];
+    }
+    const auto dim = offset.back();
+
+    Eigen::MatrixXd H = Eigen::MatrixXd::Zero(dim, dim);
+    Eigen::VectorXd g = Eigen::VectorXd::Zero(dim);
+#pragma omp parallel num_threads(num_threads_)
+    {
+      Eigen::MatrixXd H_local = Eigen::MatrixXd::Zero(dim, dim);
+      Eigen::VectorXd g_local = Eigen::VectorXd::Zero(dim);
+#pragma omp for schedule(dynamic, 1) nowait
+      for (size_t r = 0; r < runs_.size(); ++r) {
+        const auto &T_eval = T_ref_qry_[runs_[r].pose];
+        const auto node = T_eval->forward();
+        const Eigen::Matrix4d T = node->value().matrix();
+
+        // normal equations w.r.t. perturbation of this pose
+        Eigen::Matrix<double, 6, 6> H_pose = Eigen::Matrix<double, 6, 6>::Zero();
+        Eigen::Matrix<double, 6, 1> g_pose = Eigen::Matrix<double, 6, 1>::Zero();
+        Eigen::Matrix<double, 3, 6> J;
+        J.block<3, 3>(0, 0) = -Eigen::Matrix3d::Identity();
+        for (size_t i = runs_[r].begin; i < runEnd(r); ++i) {
+          const auto &m = matches_[i];
+          const Eigen::Vector3d pt = T.block<3, 3>(0, 0) * m.qry + T.block<3, 1>(0, 3);
+          const Eigen::Vector3d error = m.ref - pt;
+          J.block<3, 3>(0, 3) = lgmath::so3::hat(pt);
+          const double weight = loss_func_->weight(std::sqrt(error.dot(m.W * error)));
+          const Eigen::Matrix<double, 6, 3> JtW = weight * J.transpose() * m.W;
+          H_pose.noalias() += JtW * J;
+          g_pose.noalias() -= JtW * error;
+        }
+
+        // chain rule onto the state variables related to this pose
+        steam::Jacobians jacobians;
+        T_eval->backward(Eigen::MatrixXd::Identity(6, 6), node, jacobians);
+        for (const auto &[key1, jac1] : jacobians.get()) {
+          const auto k1 = key2var.at(key1);
+          const Eigen::MatrixXd jac1tH = jac1.transpose() * H_pose;
+          g_local.segment(offset[k1], jac1.cols()) += jac1.transpose() * g_pose;
+          for (const auto &[key2, jac2] : jacobians.get()) {
+            const auto k2 = key2var.at(key2);
+            H_local.block(offset[k1], offset[k2], jac1.cols(), jac2.cols()) += jac1tH * jac2;
+          }
+        }
+      }
+#pragma omp critical(icp_cost_term_reduce)
+      {
+        H += H_local;
+        g += g_local;
+      }
+    }
+
+    // add the dense terms to the problem (other terms may run concurrently)
+    for (size_t k1 = 0; k1 < keys_.size(); ++k1) {
+      const auto size1 = offset[k1 + 1] - offset[k1];
+#pragma omp critical(b_update)
+      { gradient_vector->mapAt(blk_idx[k1]) += g.segment(offset[k1], size1); }
+      for (size_t k2 = 0; k2 < keys_.size(); ++k2) {
+        if (blk_idx[k1] > blk_idx[k2]) continue;
+        const auto size2 = offset[k2 + 1] - offset[k2];
+        const auto block = H.block(offset[k1], offset[k2], size1, size2);
+        if (block.isZero(0.0)) continue;  // variables not coupled by any match
+        auto &entry = approximate_hessian->rowEntryAt(blk_idx[k1], blk_idx[k2], true);
+        omp_set_lock(&entry.lock);
+        entry.data += block;
+        omp_unset_lock(&entry.lock);
+      }
+    }
+  }
+
+ private:
+  /** \brief Consecutive matches sharing a pose, ends where the next begins */
+  struct Run {
+    size_t pose;
+    size_t begin;
+  };
+
+  size_t runEnd(const size_t r) const {
+    return r + 1 < runs_.size() ? runs_[r + 1].begin : matches_.size();
+  }
+
+  /** \brief Splits long runs so that they can be accumulated in parallel */
+  static constexpr size_t max_run_size = 1024;
+
+  const std::vector<PoseEvaluable::ConstPtr> T_ref_qry_;
+  const steam::BaseLossFunc::ConstPtr loss_func_;
+  const int num_threads_;
+
+  std::vector<steam::StateKey> keys_;
+
+  std::vector<Match> matches_;
+  std::vector<Run> runs_;
+};
+
+}  // namespace tactic
+}  // namespace vtr
@@ -0,0 +1,189 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file instrumentation.hpp
+ * \brief LatencyHistogram, LatencyRegistry and TraceRecorder class definition
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace vtr {
+namespace tactic {
+
+/**
+ * \brief Lock free latency histogram with log-linear (HDR) buckets.
+ * \details Values [ns] below 64 have their own bucket, larger values are
+ * bucketed by power of two with 32 sub-buckets each, so percentiles have a
+ * relative error below 3%. Values above 2^41 ns (~36 min) go to the last
+ * bucket. Recording is a few relaxed atomic operations; readers may see a
+ * histogram that is being updated.
+ */
+class LatencyHistogram {
+ public:
+  using Ptr = std::shared_ptr<LatencyHistogram>;
+
+  struct Summary {
+    uint64_t count = 0;
+    double mean_ms = 0;
+    double p50_ms = 0;
+    double p90_ms = 0;
+    double p99_ms = 0;
+    double max_ms = 0;
+  };
+
+  /** \brief Records a latency [ns], negative values are recorded as 0 */
+  void record(const int64_t ns) {
+    const uint64_t value = ns > 0 ? ns : 0;
+    buckets_[index(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+    auto max = max_.load(std::memory_order_relaxed);
+    while (value > max &&
+           !max_.compare_exchange_weak(max, value, std::memory_order_relaxed))
+      ;
+  }
+
+  uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+  /** \brief Latency [ns] not exceeded by a fraction q in [0, 1] of records */
+  uint64_t percentile(const double q) const;
+
+  Summary summary() const;
+
+  void reset();
+
+ private:
+  static constexpr unsigned sub_bucket_bits = 5;
+  static constexpr unsigned max_exponent = 40;
+  static constexpr size_t linear_buckets = size_t(2) << sub_bucket_bits;
+  static constexpr size_t num_buckets =
+      linear_buckets + ((max_exponent - sub_bucket_bits) << sub_bucket_bits);
+
+  static size_t index(const uint64_t value) {
+    if (value < linear_buckets) return value;
+    const unsigned exponent = 63 - __builtin_clzll(value);
+    if (exponent > max_exponent) return num_buckets - 1;
+    const size_t sub_bucket = (value >> (exponent - sub_bucket_bits)) &
+                              ((size_t(1) << sub_bucket_bits) - 1);
+    return linear_buckets +
+           ((exponent - sub_bucket_bits - 1) << sub_bucket_bits) + sub_bucket;
+  }
+
+  /** \brief Middle of the range of values of a bucket */
+  static uint64_t value(const size_t index);
+
+  std::array<std::atomic<uint64_t>, num_buckets> buckets_{};
+  std::atomic<uint64_t> count_ = 0;
+  std::atomic<uint64_t> sum_ = 0;
+  std::atomic<uint64_t> max_ = 0;
+};
+
+/**
+ * \brief Named latency histograms of the pipeline (modules, query buffers and
+ * task queue), queried at runtime for tail latencies.
+ */
+class LatencyRegistry {
+ public:
+  static LatencyRegistry &instance();
+
+  /** \brief Returns the histogram of this name, created on first use */
+  LatencyHistogram::Ptr get(const std::string &name);
+
+  /** \brief Summaries of all histograms, sorted by name */
+  std::vector<std::pair<std::string, LatencyHistogram::Summary>> summaries()
+      const;
+
+  /** \brief Clears all histograms */
+  void reset();
+
+ private:
+  LatencyRegistry() = default;
+
+  mutable std::mutex mutex_;
+  std::map<std::string, LatencyHistogram::Ptr> histograms_;
+};
+
+/**
+ * \brief Records spans of the pipeline in the Chrome trace event format, which
+ * chrome://tracing and Perfetto can open. Disabled by default.
+ * \details When disabled, recording a span costs a relaxed atomic load. Spans
+ * carry the frame (query timestamp) they belong to as an argument.
+ */
+class TraceRecorder {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  static TraceRecorder &instance();
+
+  bool enabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /** \brief Clears previous spans and starts recording up to capacity spans */
+  void start(const size_t capacity = size_t(1) << 20);
+
+  /** \brief Stops recording, the recorded spans are kept until next start */
+  void stop();
+
+  /** \brief Records a span if enabled, name must outlive the recorder */
+  void record(const char *name, const char *category,
+              const Clock::time_point &begin, const Clock::time_point &end,
+              const int64_t frame = -1);
+  /** \brief Records a span if enabled, copying its name */
+  void record(const std::string &name, const char *category,
+              const Clock::time_point &begin, const Clock::time_point &end,
+              const int64_t frame = -1);
+
+  /** \brief Writes the recorded spans as a JSON trace */
+  void write(std::ostream &os) const;
+  /** \brief Writes the recorded spans as a JSON trace to a file */
+  void write(const std::string &path) const;
+
+ private:
+  TraceRecorder() = default;
+
+  struct Span {
+    const char *name;
+    const char *category;
+    int64_t begin_ns;
+    int64_t duration_ns;
+    int64_t frame;
+    uint32_t thread;
+  };
+
+  /** \brief Small sequential id of the calling thread */
+  static uint32_t threadId();
+
+  std::atomic<bool> enabled_ = false;
+
+  /** \brief Protects all members below */
+  mutable std::mutex mutex_;
+  size_t capacity_ = 0;
+  size_t dropped_ = 0;
+  std::vector<Span> spans_;
+  /** \brief Owns the names of spans recorded from strings */
+  std::set<std::string> names_;
+};
+
+}  // namespace tactic
+}  // namespace vtr
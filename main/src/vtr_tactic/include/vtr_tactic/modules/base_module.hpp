@@ -18,13 +18,12 @@
  */
 #pragma once
 
-#include <boost/uuid/uuid.hpp>
-
 #include "rclcpp/rclcpp.hpp"
 
 #include "vtr_common/timing/stopwatch.hpp"
 #include "vtr_logging/logging.hpp"
 #include "vtr_tactic/cache.hpp"
+#include "vtr_tactic/instrumentation.hpp"
 #include "vtr_tactic/types.hpp"
 
 namespace vtr {
@@ -67,7 +66,7 @@ class BaseModule : public std::enable_shared_from_this<BaseModule> {
   /** \brief Runs the module asynchronously with timing. */
   void runAsync(QueryCache &qdata, OutputCache &output, const Graph::Ptr &graph,
                 const std::shared_ptr<TaskExecutor> &executor,
-                const size_t &priority, const boost::uuids::uuid &dep_id);
+                const size_t &priority, const uint64_t &dep_id);
 
   /** \brief Resets the module's internal state. */
   virtual void reset() {}
@@ -83,7 +82,7 @@ class BaseModule : public std::enable_shared_from_this<BaseModule> {
   /** \brief Runs the module asynchronously. */
   virtual void runAsync_(QueryCache &, OutputCache &, const Graph::Ptr &,
                          const std::shared_ptr<TaskExecutor> &, const size_t &,
-                         const boost::uuids::uuid &) {}
+                         const uint64_t &) {}
 
  private:
   const std::weak_ptr<ModuleFactory> module_factory_;
@@ -91,10 +90,9 @@ class BaseModule : public std::enable_shared_from_this<BaseModule> {
   /** \brief Name of the module assigned at runtime. */
   const std::string name_;
 
-  /** \brief counter&timer that measures total runtime and average run time */
-  common::timing::Stopwatch<> timer_{false};
-  common::timing::Stopwatch<boost::chrono::thread_clock> thread_timer_{false};
-  std::atomic<int> count_{0};
+  /** \brief Wall and thread cpu time of run and runAsync */
+  const LatencyHistogram::Ptr wall_latency_;
+  const LatencyHistogram::Ptr cpu_latency_;
 
   /// factory handlers (note: local static variable constructed on first use)
  private:
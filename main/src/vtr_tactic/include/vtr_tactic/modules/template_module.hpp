@@ -68,8 +68,8 @@ class TemplateModule : public BaseModule {
     CLOG(INFO, "tactic.module")
         << "Running the template module with parameter: " << config_->parameter;
     /// You can use the executor to run some task later in a non-blocking way.
-    /// Task constructor accepts a priority, a dependency ID of this task (uuid)
-    /// and a set of dependencies (uuid) that this task depends on.
+    /// Task constructor accepts a priority, a set of dependencies that this
+    /// task depends on and a dependency ID of this task.
     /// The dependency ID is auto-generated by default, keep track of it in case
     /// your subsequent task depends on it.
     if (executor != nullptr)
@@ -0,0 +1,143 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file object_pool.hpp
+ * \brief ObjectPool class definition
+ */
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace vtr {
+namespace tactic {
+
+/**
+ * \brief A pool of recyclable objects handed out as shared pointers, used to
+ * avoid allocating query caches and point clouds for every frame.
+ * \details An object is reset and becomes free again as soon as its last
+ * shared pointer is released, i.e. once everything that used it (pipeline
+ * threads, async tasks) is done with it, so that a finished object does not
+ * keep holding other pooled objects (e.g. the point clouds of a query cache).
+ * The reset function should keep the memory of the object (e.g. clear a point
+ * cloud instead of freeing it). When all pooled objects are in use, acquire
+ * falls back to a new object that is not pooled. Objects in use keep the
+ * pooled objects alive after the pool is destroyed.
+ */
+template <class T>
+class ObjectPool {
+ public:
+  using Ptr = std::shared_ptr<ObjectPool<T>>;
+  using Create = std::function<std::unique_ptr<T>()>;
+  using Reset = std::function<void(T &)>;
+
+  struct Statistics {
+    /** \brief Number of acquired objects recycled from the pool */
+    size_t hits = 0;
+    /** \brief Number of acquired objects newly created */
+    size_t misses = 0;
+    /** \brief Number of objects kept by the pool */
+    size_t size = 0;
+    /** \brief Number of objects kept by the pool that are in use */
+    size_t in_use = 0;
+  };
+
+  /**
+   * \param[in] capacity maximum number of objects kept by the pool
+   * \param[in] reset called on an object once it is released
+   * \param[in] create creates a new object
+   */
+  ObjectPool(
+      const size_t capacity, const Reset &reset = [](T &) {},
+      const Create &create = []() { return std::make_unique<T>(); })
+      : state_(std::make_shared<State>(capacity, reset)), create_(create) {}
+
+  /** \brief Returns a free object of the pool, or a new one. Thread safe. */
+  std::shared_ptr<T> acquire() {
+    T *object = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      // first in first out so that all pooled objects stay warm
+      if (!state_->free.empty()) {
+        object = state_->free.front();
+        state_->free.pop_front();
+        ++hits_;
+      } else if (state_->objects.size() < state_->capacity) {
+        object = state_->objects.emplace_back(create_()).get();
+        ++misses_;
+      }
+    }
+    if (object == nullptr) {
+      ++misses_;
+      return create_();
+    }
+    return std::shared_ptr<T>(object, Recycle{state_});
+  }
+
+  Statistics statistics() const {
+    Statistics statistics;
+    statistics.hits = hits_;
+    statistics.misses = misses_;
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    statistics.size = state_->objects.size();
+    statistics.in_use = state_->objects.size() - state_->free.size();
+    return statistics;
+  }
+
+ private:
+  /** \brief Pooled objects, shared with the objects in use */
+  struct State {
+    State(const size_t capacity, const Reset &reset)
+        : capacity(capacity), reset(reset) {
+      objects.reserve(capacity);
+    }
+
+    const size_t capacity;
+    const Reset reset;
+
+    /** \brief Protects objects and free */
+    std::mutex mutex;
+    std::vector<std::unique_ptr<T>> objects;
+    std::deque<T *> free;
+  };
+
+  /** \brief Deleter of the handed out objects, returns them to the pool */
+  struct Recycle {
+    /**
+     * \note dropped when called, weak pointers to the object (e.g. of
+     * enable_shared_from_this) keep the deleter and would keep the pool alive
+     */
+    mutable std::shared_ptr<State> state;
+    void operator()(T *object) const {
+      const auto pool = std::move(state);
+      pool->reset(*object);
+      std::lock_guard<std::mutex> lock(pool->mutex);
+      pool->free.push_back(object);
+    }
+  };
+
+  const std::shared_ptr<State> state_;
+  const Create create_;
+
+  std::atomic<size_t> hits_ = 0;
+  std::atomic<size_t> misses_ = 0;
+};
+
+}  // namespace tactic
+}  // namespace vtr
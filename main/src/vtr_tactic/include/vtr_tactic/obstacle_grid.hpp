@@ -0,0 +1,161 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file obstacle_grid.hpp
+ * \brief ObstacleGrid class definition
+ */
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace vtr {
+namespace tactic {
+
+/**
+ * \brief Dense 2D obstacle cost grid in the costmap frame, handed from the
+ * obstacle detection pipeline to the path planner.
+ * \details Cell (ix, iy) covers [ix, ix + 1) x [iy, iy + 1) in units of the
+ * grid resolution, and the grid covers a width x height window of cells
+ * starting at its origin cell. Cells are stored in a ring buffer, so the
+ * window can be scrolled along with the robot by only resetting the cells
+ * that leave it. Cells outside the window have the default value.
+ *
+ * A grid is published by the producer as a ConstPtr and never modified
+ * afterwards, consumers keep the pointer as a snapshot instead of copying.
+ */
+class ObstacleGrid {
+ public:
+  using Ptr = std::shared_ptr<ObstacleGrid>;
+  using ConstPtr = std::shared_ptr<const ObstacleGrid>;
+
+  /**
+   * \param[in] resolution size of a cell [meter]
+   * \param[in] width number of cells in x direction
+   * \param[in] height number of cells in y direction
+   * \param[in] origin_x index of the first cell in x direction
+   * \param[in] origin_y index of the first cell in y direction
+   * \param[in] default_value value of cells that have not been set
+   */
+  ObstacleGrid(const float resolution, const int width, const int height,
+               const int origin_x = 0, const int origin_y = 0,
+               const float default_value = 0)
+      : resolution_(resolution),
+        width_(width),
+        height_(height),
+        origin_x_(origin_x),
+        origin_y_(origin_y),
+        default_value_(default_value),
+        values_((size_t)width * height, default_value) {}
+
+  float resolution() const { return resolution_; }
+  int width() const { return width_; }
+  int height() const { return height_; }
+  int origin_x() const { return origin_x_; }
+  int origin_y() const { return origin_y_; }
+  float default_value() const { return default_value_; }
+
+  /** \brief Number of cells not at the default value */
+  size_t size() const { return size_; }
+
+  /** \brief Index of the cell containing a coordinate [meter] */
+  int index(const float x) const { return (int)std::floor(x / resolution_); }
+
+  bool contains(const int ix, const int iy) const {
+    return (unsigned)(ix - origin_x_) < (unsigned)width_ &&
+           (unsigned)(iy - origin_y_) < (unsigned)height_;
+  }
+
+  float at(const int ix, const int iy) const {
+    if (!contains(ix, iy)) return default_value_;
+    return values_[storage(ix, iy)];
+  }
+
+  /** \brief Value of the cell containing point (x, y) [meter] */
+  float atPoint(const float x, const float y) const {
+    return at(index(x), index(y));
+  }
+
+  /** \brief Sets a cell, returns false if it is outside of the window */
+  bool set(const int ix, const int iy, const float value) {
+    if (!contains(ix, iy)) return false;
+    auto &cell = values_[storage(ix, iy)];
+    size_ += (value != default_value_) - (cell != default_value_);
+    cell = value;
+    return true;
+  }
+
+  /** \brief Resets all cells to the default value */
+  void clear() {
+    std::fill(values_.begin(), values_.end(), default_value_);
+    size_ = 0;
+  }
+
+  /**
+   * \brief Moves the window to start at (origin_x, origin_y). Cells that stay
+   * in the window keep their values, the others are reset.
+   */
+  void scroll(const int origin_x, const int origin_y) {
+    const int dx = origin_x - origin_x_, dy = origin_y - origin_y_;
+    if (std::abs(dx) >= width_ || std::abs(dy) >= height_) {
+      clear();
+    } else {
+      // columns then rows leaving the window, in the old window
+      const int x0 = dx > 0 ? origin_x_ : origin_x + width_;
+      for (int ix = x0; ix < x0 + std::abs(dx); ++ix)
+        for (int iy = origin_y_; iy < origin_y_ + height_; ++iy)
+          resetCell(ix, iy);
+      const int y0 = dy > 0 ? origin_y_ : origin_y + height_;
+      for (int iy = y0; iy < y0 + std::abs(dy); ++iy)
+        for (int ix = origin_x_; ix < origin_x_ + width_; ++ix)
+          resetCell(ix, iy);
+    }
+    origin_x_ = origin_x;
+    origin_y_ = origin_y;
+  }
+
+  /** \brief Scrolls the window to be centered at point (x, y) [meter] */
+  void recenter(const float x, const float y) {
+    scroll(index(x) - width_ / 2, index(y) - height_ / 2);
+  }
+
+ private:
+  static int wrap(const int i, const int n) {
+    const int r = i % n;
+    return r < 0 ? r + n : r;
+  }
+
+  size_t storage(const int ix, const int iy) const {
+    return (size_t)wrap(iy, height_) * width_ + wrap(ix, width_);
+  }
+
+  void resetCell(const int ix, const int iy) {
+    auto &cell = values_[storage(ix, iy)];
+    size_ -= (cell != default_value_);
+    cell = default_value_;
+  }
+
+  const float resolution_;
+  const int width_, height_;
+  int origin_x_, origin_y_;
+  const float default_value_;
+  std::vector<float> values_;
+  size_t size_ = 0;
+};
+
+}  // namespace tactic
+}  // namespace vtr
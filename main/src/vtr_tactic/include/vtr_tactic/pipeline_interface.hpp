@@ -18,9 +18,12 @@
  */
 #pragma once
 
+#include <queue>
+
 #include "rclcpp/rclcpp.hpp"
 
 #include "vtr_tactic/cache.hpp"
+#include "vtr_tactic/instrumentation.hpp"
 #include "vtr_tactic/task_queue.hpp"
 #include "vtr_tactic/types.hpp"
 
@@ -32,17 +35,21 @@ namespace tactic {
  * preprocessing, odometry&mapping and localization threads.
  * \details Data can be added as discardable and non-discardable. When the size
  * of the buffer is full, the oldest discardable data is removed when more data
- * are added. When no discardable data presents, push is blocked.
+ * are added. When no discardable data presents, push is blocked. The time
+ * data spend in the buffer is recorded to an optional latency histogram.
  */
 template <typename T>
 class QueryBuffer {
  public:
   using LockGuard = std::lock_guard<std::mutex>;
   using UniqueLock = std::unique_lock<std::mutex>;
+  using Clock = std::chrono::steady_clock;
 
-  QueryBuffer(const size_t size)
+  QueryBuffer(const size_t size,
+              const LatencyHistogram::Ptr& wait_latency = nullptr)
       : size_(size == 0 ? std::numeric_limits<size_t>::max() : size),
-        require_immediate_pop_(size == 0 ? true : false) {}
+        require_immediate_pop_(size == 0 ? true : false),
+        wait_latency_(wait_latency) {}
 
   bool push(const T& qdata, const bool discardable = true) {
     UniqueLock lock(mutex_);
@@ -56,11 +63,13 @@ class QueryBuffer {
     bool discarded = false;
 
     // move all non-discardable data to the nondiscardable queue
-    while ((!queries_.empty()) && queries_.front().second == false) {
-      nondiscardable_queries_.push(queries_.front().first);
+    while ((!queries_.empty()) && queries_.front().discardable == false) {
+      nondiscardable_queries_.push(queries_.front());
       queries_.pop();
     }
 
+    const Entry entry{qdata, discardable, Clock::now()};
+
     if (require_immediate_pop_) {
       if (waiting_count_ < 0)
         throw std::runtime_error("QueryBuffer: waiting count smaller than 0");
@@ -73,7 +82,7 @@ class QueryBuffer {
           /// query_buffer_require_immediate_pop_slow_pop_nondiscard
           /// it hanged twice in this test, not sure what the cause is
           cv_has_waiting_.wait(lock, [&] { return waiting_count_ > 0; });
-          queries_.push(std::make_pair(qdata, discardable));
+          queries_.push(entry);
           curr_size_++;
           waiting_count_--;
           CLOG(DEBUG, "tactic")
@@ -83,7 +92,7 @@ class QueryBuffer {
           cv_not_empty_.notify_one();
         }
       } else {
-        queries_.push(std::make_pair(qdata, discardable));
+        queries_.push(entry);
         curr_size_++;
         waiting_count_--;
         CLOG(DEBUG, "tactic")
@@ -100,7 +109,7 @@ class QueryBuffer {
             discarded = true;
           } else {
             while (curr_size_ == size_) cv_not_full_.wait(lock);
-            queries_.push(std::make_pair(qdata, discardable));
+            queries_.push(entry);
             curr_size_++;
             cv_size_changed_.notify_all();
             cv_not_empty_.notify_one();
@@ -108,14 +117,14 @@ class QueryBuffer {
         }
         // we can discard the oldest discardable data
         else {
-          queries_.push(std::make_pair(qdata, discardable));
+          queries_.push(entry);
           queries_.pop();
           discarded = true;
         }
       }
       // add directly since the buffer is not full
       else {
-        queries_.push(std::make_pair(qdata, discardable));
+        queries_.push(entry);
         curr_size_++;
         cv_size_changed_.notify_all();
         cv_not_empty_.notify_one();
@@ -138,21 +147,23 @@ class QueryBuffer {
       cv_not_empty_.wait(lock);
     }
     // if there are nondiscardable queries, pop from nondiscardable queries
-    auto query = [&]() {
+    auto entry = [&]() {
       if (!nondiscardable_queries_.empty()) {
-        auto query = nondiscardable_queries_.front();
+        auto entry = nondiscardable_queries_.front();
         nondiscardable_queries_.pop();
-        return query;
+        return entry;
       } else {
-        auto query = queries_.front().first;
+        auto entry = queries_.front();
         queries_.pop();
-        return query;
+        return entry;
       }
     }();
+    if (wait_latency_)
+      wait_latency_->record((Clock::now() - entry.pushed).count());
     --curr_size_;
     cv_not_full_.notify_one();
     cv_size_changed_.notify_all();
-    return query;
+    return entry.query;
   }
 
   void wait(const size_t size = 0) {
@@ -161,9 +172,18 @@ class QueryBuffer {
   }
 
  private:
+  struct Entry {
+    T query;
+    bool discardable;
+    /** \brief When the query was pushed, for the wait latency */
+    Clock::time_point pushed;
+  };
+
   /** \brief Buffer maximum size */
   const size_t size_;
   const bool require_immediate_pop_;
+  /** \brief Time from push to pop, not recorded if nullptr */
+  const LatencyHistogram::Ptr wait_latency_;
 
   /** \brief Protects all members below, cv should release this mutex */
   std::mutex mutex_;
@@ -181,9 +201,9 @@ class QueryBuffer {
   /** \brief Current number of threads waiting for data */
   int waiting_count_ = 0;
   /** \brief Queue of discardable + nondiscardable queries */
-  std::queue<std::pair<T, bool>> queries_;
+  std::queue<Entry> queries_;
   /** \brief Queue of nondiscardable queries */
-  std::queue<T> nondiscardable_queries_;
+  std::queue<Entry> nondiscardable_queries_;
 };
 
 /**
@@ -215,6 +235,14 @@ class PipelineInterface {
    */
   PipelineLock lockPipeline();
 
+  /**
+   * \brief Returns the query cache of a new frame. Subclasses may recycle the
+   * query caches of frames that have finished running through the pipeline.
+   */
+  virtual QueryCache::Ptr createQueryCache() {
+    return std::make_shared<QueryCache>();
+  }
+
   /** \brief Pipline entrypoint, gets query input from navigator */
   void input(const QueryCache::Ptr& qdata);
 
@@ -247,9 +275,16 @@ class PipelineInterface {
   PipelineMutex pipeline_mutex_;
   common::joinable_semaphore pipeline_semaphore_{0};
 
-  QueryBuffer<QueryCache::Ptr> preprocessing_buffer_{0};
-  QueryBuffer<QueryCache::Ptr> odometry_mapping_buffer_{0};
-  QueryBuffer<QueryCache::Ptr> localization_buffer_{0};
+  // clang-format off
+  QueryBuffer<QueryCache::Ptr> preprocessing_buffer_{0, LatencyRegistry::instance().get("pipeline.preprocessing.queue_wait")};
+  QueryBuffer<QueryCache::Ptr> odometry_mapping_buffer_{0, LatencyRegistry::instance().get("pipeline.odometry_mapping.queue_wait")};
+  QueryBuffer<QueryCache::Ptr> localization_buffer_{0, LatencyRegistry::instance().get("pipeline.localization.queue_wait")};
+
+  /** \brief Run time of each pipeline stage */
+  const LatencyHistogram::Ptr preprocessing_latency_ = LatencyRegistry::instance().get("pipeline.preprocessing");
+  const LatencyHistogram::Ptr odometry_mapping_latency_ = LatencyRegistry::instance().get("pipeline.odometry_mapping");
+  const LatencyHistogram::Ptr localization_latency_ = LatencyRegistry::instance().get("pipeline.localization");
+  // clang-format on
 
   std::thread preprocessing_thread_;
   std::thread odometry_mapping_thread_;
@@ -61,6 +61,12 @@ class BasePipeline {
 
   virtual OutputCache::Ptr createOutputCache() const;
 
+  /**
+   * \brief Returns the query cache of a new frame, pipelines may recycle the
+   * query caches of finished frames. Thread safe.
+   */
+  virtual QueryCache::Ptr createQueryCache();
+
   void initialize(const OutputCache::Ptr &output, const Graph::Ptr &graph);
   void preprocess(const QueryCache::Ptr &qdata, const OutputCache::Ptr &output,
                   const Graph::Ptr &graph,
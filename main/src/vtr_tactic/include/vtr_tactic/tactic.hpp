@@ -79,6 +79,11 @@ class Tactic : public PipelineInterface, public TacticInterface {
 
   ~Tactic() { join(); }
 
+  /** \brief Query caches are created (and recycled) by the pipeline */
+  QueryCache::Ptr createQueryCache() override {
+    return pipeline_->createQueryCache();
+  }
+
   /// tactic interface, interacts with the state machine
  public:
   TacticInterface::PipelineLock lockPipeline() override;
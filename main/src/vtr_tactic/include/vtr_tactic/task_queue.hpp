@@ -18,18 +18,19 @@
  */
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
 #include <limits>
 #include <list>
+#include <map>
 #include <mutex>
-#include <queue>
 #include <stdexcept>
-
-#include <boost/uuid/uuid.hpp>             // uuid class
-#include <boost/uuid/uuid_generators.hpp>  // generators
-#include <boost/uuid/uuid_io.hpp>          // streaming operators etc.
+#include <unordered_map>
+#include <vector>
 
 #include "vtr_common/utils/semaphore.hpp"
 #include "vtr_tactic/modules/base_module.hpp"
@@ -43,23 +44,27 @@ class Task {
  public:
   using Id = unsigned;
   using Priority = size_t;
-  using DepId = boost::uuids::uuid;
-  using DepIdHash = boost::hash<boost::uuids::uuid>;
-  using DepIdSet = std::unordered_set<DepId, DepIdHash>;
+  /** \brief DepId{} (0) is never generated, modules use it as a shared id */
+  using DepId = uint64_t;
+  using DepIdSet = std::vector<DepId>;
 
   using Ptr = std::shared_ptr<Task>;
 
   /** \brief Thread safe unique id generator */
   static Id getId() {
-    static Id id = 0;
-    static std::mutex mutex;
-    std::lock_guard<std::mutex> guard(mutex);
+    static std::atomic<Id> id{0};
     return ++id;
   }
 
+  /** \brief Thread safe unique dependency id generator */
+  static DepId getDepId() {
+    static std::atomic<DepId> dep_id{0};
+    return ++dep_id;
+  }
+
   Task(const BaseModule::Ptr& module, const QueryCache::Ptr& qdata,
        const unsigned& priority0 = 0, const DepIdSet& dependencies0 = {},
-       const DepId& dep_id0 = boost::uuids::random_generator()(),
+       const DepId& dep_id0 = getDepId(),
        const std::string& name0 = "anonymous",
        const VertexId& vid0 = VertexId::Invalid())
       : module_(module),
@@ -91,11 +96,13 @@ class Task {
   const Priority priority;
   /** \brief the dependency id of this task (no necessarily unique) */
   const DepId dep_id;
-  /** \brief the set of dependencies for this task, updated by the task queue */
-  std::unordered_set<DepId, DepIdHash> dependencies;
+  /** \brief unmet dependencies of this task, updated by the task queue */
+  DepIdSet dependencies;
   /** \brief for GUI visualization only */
   const std::string name;
   const VertexId vid;
+  /** \brief when the task is dispatched, updated by the task executor */
+  std::chrono::steady_clock::time_point dispatched;
 };
 
 class TaskQueue {
@@ -108,7 +115,8 @@ class TaskQueue {
 
   std::tuple<bool, Task::Id> push(const Task::Ptr& task);
   Task::Ptr pop();
-  void updateDeps(const Task::Ptr& task);
+  /** \brief Returns the number of tasks that become executable */
+  size_t updateDeps(const Task::Ptr& task);
 
   void clear();
 
@@ -117,9 +125,22 @@ class TaskQueue {
   size_t size() const;
 
  private:
+  /** \brief Task ids of one priority in ascending (launch) order */
+  using Lane = std::deque<Task::Id>;
+  using Lanes = std::map<Task::Priority, Lane>;
+
+  /** \brief Unfinished tasks with a dep id and the tasks depending on them */
+  struct DepInfo {
+    unsigned count = 0;
+    std::vector<Task::Id> dependents;
+  };
+
   /** \brief Remove task with this id or a task depends on it */
   Task::Id removeLeaf(const Task::Id id);
 
+  static void insert(Lanes& lanes, const Task::Ptr& task);
+  static bool erase(Lanes& lanes, const Task::Ptr& task);
+
  private:
   const size_t size_;
 
@@ -133,26 +154,22 @@ class TaskQueue {
    * \brief Ordered queue with all task ids, used for discarding tasks when this
    * TaskQueue if full
    */
-  std::map<Task::Priority, std::set<Task::Id>> complete_queue_;
+  Lanes complete_queue_;
 
   /**
-   * \brief Dep Id of unfinished tasks and their count
+   * \brief Dep Id of unfinished tasks, their count and dependent tasks
    * \note We allow multiple tasks with the same dep id, a dependency is
    * considered satisfied only when this count goes to zero - this is
    * essentially for an async task to relaunch itself if it has dependencies,
    * and after the dependencies are launched
    */
-  std::unordered_map<Task::DepId, unsigned, Task::DepIdHash> deps2count_map_;
-
-  /** \brief Keep track of the dependent tasks of each task */
-  std::unordered_map<Task::DepId, std::set<Task::Id>, Task::DepIdHash>
-      depid2ids_map_;
+  std::unordered_map<Task::DepId, DepInfo> depid2info_map_;
 
   /**
    * \brief Ordered queue with only dependency met task ids, used for sending
    * out the next executable task
    */
-  std::map<Task::Priority, std::set<Task::Id>> executable_queue_;
+  Lanes executable_queue_;
 };
 
 class TaskExecutorCallbackInterface {
@@ -249,6 +266,10 @@ class TaskExecutor : public std::enable_shared_from_this<TaskExecutor> {
 
   /** \brief callback on task queue/executor update */
   const Callback::Ptr callback_;
+
+  /** \brief time from dispatching a task to a worker picking it up */
+  const LatencyHistogram::Ptr wait_latency_ =
+      LatencyRegistry::instance().get("task_queue.wait");
 };
 
 }  // namespace tactic
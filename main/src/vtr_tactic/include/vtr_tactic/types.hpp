@@ -21,6 +21,7 @@
 #include <memory>
 
 #include "vtr_pose_graph/evaluator/evaluators.hpp"
+#include "vtr_pose_graph/index/privileged_graph.hpp"
 #include "vtr_pose_graph/path/localization_chain.hpp"
 #include "vtr_pose_graph/serializable/rc_graph.hpp"
 
@@ -50,6 +51,7 @@ template <class GraphT>
 using TemporalEvaluator = pose_graph::eval::mask::temporal::Eval<GraphT>;
 template <class GraphT>
 using DistanceEvaluator = pose_graph::eval::weight::distance::Eval<GraphT>;
+using PrivilegedGraph = pose_graph::PrivilegedGraph<Graph>;
 
 /// mission planning
 using PathType = VertexId::Vector;
@@ -0,0 +1,189 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file instrumentation.cpp
+ */
+#include "vtr_tactic/instrumentation.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+#include "vtr_logging/logging.hpp"
+
+namespace vtr {
+namespace tactic {
+
+uint64_t LatencyHistogram::percentile(const double q) const {
+  const auto count = this->count();
+  if (count == 0) return 0;
+  const auto target = std::max<uint64_t>(1, std::ceil(q * count));
+  const auto max = max_.load(std::memory_order_relaxed);
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < num_buckets; ++i) {
+    cumulative += buckets_[i].load(std::memory_order_relaxed);
+    if (cumulative < target) continue;
+    // the last bucket is unbounded, max is the best estimate
+    return i == num_buckets - 1 ? max : std::min(value(i), max);
+  }
+  return max;
+}
+
+auto LatencyHistogram::summary() const -> Summary {
+  Summary summary;
+  summary.count = count();
+  if (summary.count == 0) return summary;
+  summary.mean_ms = (double)sum_.load(std::memory_order_relaxed) /
+                    (double)summary.count / 1e6;
+  summary.p50_ms = (double)percentile(0.50) / 1e6;
+  summary.p90_ms = (double)percentile(0.90) / 1e6;
+  summary.p99_ms = (double)percentile(0.99) / 1e6;
+  summary.max_ms = (double)max_.load(std::memory_order_relaxed) / 1e6;
+  return summary;
+}
+
+void LatencyHistogram::reset() {
+  for (auto &bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::value(const size_t index) {
+  if (index < linear_buckets) return index;
+  const size_t offset = index - linear_buckets;
+  const unsigned shift = (offset >> sub_bucket_bits) + 1;
+  const uint64_t sub_bucket = offset & ((size_t(1) << sub_bucket_bits) - 1);
+  const uint64_t lower = ((size_t(1) << sub_bucket_bits) + sub_bucket) << shift;
+  return lower + (uint64_t(1) << shift) / 2;
+}
+
+LatencyRegistry &LatencyRegistry::instance() {
+  static LatencyRegistry registry;
+  return registry;
+}
+
+LatencyHistogram::Ptr LatencyRegistry::get(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto &histogram = histograms_[name];
+  if (histogram == nullptr) histogram = std::make_shared<LatencyHistogram>();
+  return histogram;
+}
+
+auto LatencyRegistry::summaries() const
+    -> std::vector<std::pair<std::string, LatencyHistogram::Summary>> {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<std::pair<std::string, LatencyHistogram::Summary>> summaries;
+  summaries.reserve(histograms_.size());
+  for (const auto &[name, histogram] : histograms_)
+    summaries.emplace_back(name, histogram->summary());
+  return summaries;
+}
+
+void LatencyRegistry::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (const auto &[name, histogram] : histograms_) histogram->reset();
+}
+
+TraceRecorder &TraceRecorder::instance() {
+  static TraceRecorder recorder;
+  return recorder;
+}
+
+void TraceRecorder::start(const size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  dropped_ = 0;
+  spans_.clear();
+  spans_.reserve(std::min<size_t>(capacity_, 1 << 16));
+  enabled_.store(true, std::memory_order_relaxed);
+  CLOG(INFO, "tactic") << "Started recording a trace of at most " << capacity_
+                       << " spans";
+}
+
+void TraceRecorder::stop() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  enabled_.store(false, std::memory_order_relaxed);
+  CLOG(INFO, "tactic") << "Stopped recording the trace, recorded "
+                       << spans_.size() << " spans, dropped " << dropped_;
+}
+
+void TraceRecorder::record(const char *name, const char *category,
+                           const Clock::time_point &begin,
+                           const Clock::time_point &end, const int64_t frame) {
+  if (!enabled()) return;
+  const auto begin_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            begin.time_since_epoch())
+                            .count();
+  const auto duration_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin)
+          .count();
+  const auto thread = threadId();
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (spans_.size() >= capacity_) {
+    ++dropped_;
+    return;
+  }
+  spans_.push_back(Span{name, category, begin_ns, duration_ns, frame, thread});
+}
+
+void TraceRecorder::record(const std::string &name, const char *category,
+                           const Clock::time_point &begin,
+                           const Clock::time_point &end, const int64_t frame) {
+  if (!enabled()) return;
+  const char *interned = [&]() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return names_.insert(name).first->c_str();
+  }();
+  record(interned, category, begin, end, frame);
+}
+
+void TraceRecorder::write(std::ostream &os) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // trace event format, complete events ("X") with microsecond timestamps
+  os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (size_t i = 0; i < spans_.size(); ++i) {
+    const auto &span = spans_[i];
+    os << (i == 0 ? "" : ",") << "\n{\"name\":\"" << span.name
+       << "\",\"cat\":\"" << span.category << "\",\"ph\":\"X\",\"ts\":"
+       << span.begin_ns / 1000 << "." << std::abs(span.begin_ns % 1000) / 100
+       << ",\"dur\":" << span.duration_ns / 1000 << "."
+       << std::abs(span.duration_ns % 1000) / 100
+       << ",\"pid\":0,\"tid\":" << span.thread;
+    if (span.frame >= 0) os << ",\"args\":{\"frame\":" << span.frame << "}";
+    os << "}";
+  }
+  os << "\n]}\n";
+}
+
+void TraceRecorder::write(const std::string &path) const {
+  std::ofstream file(path);
+  if (!file.is_open()) {
+    std::string err{"Failed to open trace file " + path};
+    CLOG(ERROR, "tactic") << err;
+    throw std::runtime_error(err);
+  }
+  write(file);
+  CLOG(INFO, "tactic") << "Wrote the trace to " << path;
+}
+
+uint32_t TraceRecorder::threadId() {
+  static std::atomic<uint32_t> next_id = 0;
+  thread_local const uint32_t id = next_id++;
+  return id;
+}
+
+}  // namespace tactic
+}  // namespace vtr
@@ -21,18 +21,30 @@
 namespace vtr {
 namespace tactic {
 
+namespace {
+
+using WallClock = TraceRecorder::Clock;
+using CpuClock = boost::chrono::thread_clock;
+
+int64_t frameOf(const QueryCache &qdata) {
+  return qdata.stamp ? (int64_t)*qdata.stamp : -1;
+}
+
+}  // namespace
+
 BaseModule::BaseModule(const std::shared_ptr<ModuleFactory> &module_factory,
                        const std::string &name)
-    : module_factory_{module_factory}, name_{name} {}
+    : module_factory_{module_factory},
+      name_{name},
+      wall_latency_{LatencyRegistry::instance().get("module." + name + ".wall")},
+      cpu_latency_{LatencyRegistry::instance().get("module." + name + ".cpu")} {}
 
 BaseModule::~BaseModule() {
+  const auto summary = wall_latency_->summary();
   CLOG(DEBUG, "tactic.module")
       << "\033[1;31mSummarizing module: " << name()
-      << ", count: " << count_.load() << ", time: " << timer_
-      << ", time(ms)/count: "
-      << (count_.load() > 0 ? (double)timer_.count() / (double)count_.load()
-                            : 0)
-      << "\033[0m";
+      << ", count: " << summary.count << ", time(ms)/count: " << summary.mean_ms
+      << ", p99(ms): " << summary.p99_ms << "\033[0m";
 }
 
 void BaseModule::run(QueryCache &qdata, OutputCache &output,
@@ -40,32 +52,41 @@ void BaseModule::run(QueryCache &qdata, OutputCache &output,
                      const std::shared_ptr<TaskExecutor> &executor) {
   CLOG(DEBUG, "tactic.module")
       << "\033[1;31mRunning module: " << name() << "\033[0m";
-  common::timing::Stopwatch timer;
-  common::timing::Stopwatch<boost::chrono::thread_clock> thread_timer;
-  ++count_;
-  timer_.start();
+  const auto cpu_begin = CpuClock::now();
+  const auto wall_begin = WallClock::now();
   run_(qdata, output, graph, executor);
-  timer_.stop();
+  const auto wall_end = WallClock::now();
+  const auto cpu_end = CpuClock::now();
+  wall_latency_->record((wall_end - wall_begin).count());
+  cpu_latency_->record((cpu_end - cpu_begin).count());
+  TraceRecorder::instance().record(name(), "module", wall_begin, wall_end,
+                                   frameOf(qdata));
   CLOG(DEBUG, "tactic.module")
       << "Finished running module: " << name() << ", which takes "
-      << thread_timer << " / " << timer;
+      << (double)(cpu_end - cpu_begin).count() / 1e6 << "ms / "
+      << (double)(wall_end - wall_begin).count() / 1e6 << "ms";
 }
 
 void BaseModule::runAsync(QueryCache &qdata, OutputCache &output,
                           const Graph::Ptr &graph,
                           const std::shared_ptr<TaskExecutor> &executor,
                           const size_t &priority,
-                          const boost::uuids::uuid &dep_id) {
+                          const uint64_t &dep_id) {
   CLOG(DEBUG, "tactic.module")
       << "\033[1;31mRunning module (async): " << name() << "\033[0m";
-  common::timing::Stopwatch timer;
-  common::timing::Stopwatch<boost::chrono::thread_clock> thread_timer;
-  timer_.start();
+  const auto cpu_begin = CpuClock::now();
+  const auto wall_begin = WallClock::now();
   runAsync_(qdata, output, graph, executor, priority, dep_id);
-  timer_.stop();
+  const auto wall_end = WallClock::now();
+  const auto cpu_end = CpuClock::now();
+  wall_latency_->record((wall_end - wall_begin).count());
+  cpu_latency_->record((cpu_end - cpu_begin).count());
+  TraceRecorder::instance().record(name(), "module.async", wall_begin,
+                                   wall_end, frameOf(qdata));
   CLOG(DEBUG, "tactic.module")
       << "Finished running module (async): " << name() << ", which takes "
-      << thread_timer << " / " << timer;
+      << (double)(cpu_end - cpu_begin).count() / 1e6 << "ms / "
+      << (double)(wall_end - wall_begin).count() / 1e6 << "ms";
 }
 
 std::shared_ptr<ModuleFactory> BaseModule::factory() const {
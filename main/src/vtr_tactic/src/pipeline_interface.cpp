@@ -23,6 +23,23 @@
 namespace vtr {
 namespace tactic {
 
+namespace {
+
+/** \brief Runs a pipeline stage, recording its run time and trace span */
+template <typename F>
+bool runStage(const char* name, LatencyHistogram& latency,
+              const QueryCache& qdata, F&& stage) {
+  const auto begin = TraceRecorder::Clock::now();
+  const bool discardable = stage();
+  const auto end = TraceRecorder::Clock::now();
+  latency.record((end - begin).count());
+  TraceRecorder::instance().record(name, "pipeline", begin, end,
+                                   (int64_t)*qdata.stamp);
+  return discardable;
+}
+
+}  // namespace
+
 PipelineInterface::PipelineInterface(
     const bool& enable_parallelization, const OutputCache::Ptr& output,
     const Graph::Ptr& graph, const size_t& num_async_threads,
@@ -87,18 +104,21 @@ void PipelineInterface::inputSequential(const QueryCache::Ptr& qdata) {
   input_(qdata);
 
   CLOG(DEBUG, "tactic") << "Start running preprocessing: " << *qdata->stamp;
-  preprocess_(qdata);
+  runStage("preprocessing", *preprocessing_latency_, *qdata,
+           [&] { return preprocess_(qdata); });
   CLOG(DEBUG, "tactic") << "Finish running preprocessing: " << *qdata->stamp;
 
   CLOG(DEBUG, "tactic") << "Start running odometry mapping, timestamp: "
                         << *qdata->stamp;
-  runOdometryMapping_(qdata);
+  runStage("odometry_mapping", *odometry_mapping_latency_, *qdata,
+           [&] { return runOdometryMapping_(qdata); });
   CLOG(DEBUG, "tactic") << "Finish running odometry mapping, timestamp: "
                         << *qdata->stamp;
 
   CLOG(DEBUG, "tactic") << "Start running localization, timestamp: "
                         << *qdata->stamp;
-  runLocalization_(qdata);
+  runStage("localization", *localization_latency_, *qdata,
+           [&] { return runLocalization_(qdata); });
   CLOG(DEBUG, "tactic") << "Finish running localization, timestamp: "
                         << *qdata->stamp;
 
@@ -122,7 +142,9 @@ void PipelineInterface::preprocess() {
     if (qdata == nullptr) return;
     CLOG(DEBUG, "tactic") << "Start running preprocessing, timestamp: "
                           << *qdata->stamp;
-    const bool discardable = preprocess_(qdata);
+    const bool discardable =
+        runStage("preprocessing", *preprocessing_latency_, *qdata,
+                 [&] { return preprocess_(qdata); });
     const bool discarded = odometry_mapping_buffer_.push(qdata, discardable);
     CLOG_IF(discarded, WARNING, "tactic")
         << "[preprocess] Buffer is full, one frame discarded.";
@@ -140,7 +162,9 @@ void PipelineInterface::runOdometryMapping() {
     if (qdata == nullptr) return;
     CLOG(DEBUG, "tactic") << "Start running odometry mapping, timestamp: "
                           << *qdata->stamp;
-    const bool discardable = runOdometryMapping_(qdata);
+    const bool discardable =
+        runStage("odometry_mapping", *odometry_mapping_latency_, *qdata,
+                 [&] { return runOdometryMapping_(qdata); });
     const bool discarded = localization_buffer_.push(qdata, discardable);
     CLOG_IF(discarded, WARNING, "tactic")
         << "[odometry_mapping] Buffer is full, one frame discarded.";
@@ -158,7 +182,8 @@ void PipelineInterface::runLocalization() {
     if (qdata == nullptr) return;
     CLOG(DEBUG, "tactic") << "Start running localization, timestamp: "
                           << *qdata->stamp;
-    runLocalization_(qdata);
+    runStage("localization", *localization_latency_, *qdata,
+             [&] { return runLocalization_(qdata); });
     CLOG(DEBUG, "tactic") << "Finish running localization, timestamp: "
                           << *qdata->stamp;
     pipeline_semaphore_.acquire();
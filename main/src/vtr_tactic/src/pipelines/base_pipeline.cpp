@@ -29,6 +29,10 @@ OutputCache::Ptr BasePipeline::createOutputCache() const {
   return std::make_shared<OutputCache>();
 }
 
+QueryCache::Ptr BasePipeline::createQueryCache() {
+  return std::make_shared<QueryCache>();
+}
+
 void BasePipeline::initialize(const OutputCache::Ptr &output,
                               const Graph::Ptr &graph) {
   CLOG(DEBUG, "tactic.pipeline")
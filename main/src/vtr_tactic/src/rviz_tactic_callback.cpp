@@ -84,7 +84,7 @@ void RvizTacticCallback::publishPathRviz(const LocalizationChain& chain) {
   auto& poses = path.poses;
   for (unsigned i = 0; i < chain.size(); ++i) {
     auto& pose = poses.emplace_back();
-    pose.pose = tf2::toMsg(Eigen::Affine3d(chain.pose(i).matrix()));
+    pose.pose = tf2::toMsg(Eigen::Affine3d(chain.T_start(i).matrix()));
   }
   loc_path_pub_->publish(path);
 }
@@ -19,6 +19,8 @@
  */
 #include "vtr_tactic/task_queue.hpp"
 
+#include <algorithm>
+
 namespace vtr {
 namespace tactic {
 
@@ -28,47 +30,37 @@ std::tuple<bool, Task::Id> TaskQueue::push(const Task::Ptr& task) {
   if (id2task_map_.size() > size_)
     throw std::runtime_error("TaskQueue: size exceeded");
 
-  {
-    auto success = id2task_map_.try_emplace(task->id, task).second;
-    auto iter = complete_queue_.try_emplace(task->priority);
-    success |= iter.first->second.emplace(task->id).second;
-    if (!success)
-      throw std::runtime_error(
-          "TaskQueue: inserting a task that already exists");
-  }
+  if (!id2task_map_.try_emplace(task->id, task).second)
+    throw std::runtime_error("TaskQueue: inserting a task that already exists");
+  insert(complete_queue_, task);
 
-  {
-    // insert the task into the dependency map for tasks that depend on it
-    auto iter = deps2count_map_.try_emplace(task->dep_id, 1);
-    if (!iter.second) ++deps2count_map_.at(task->dep_id);
-    //
-    depid2ids_map_.try_emplace(task->dep_id);
-  }
+  // insert the task into the dependency map for tasks that depend on it
+  ++depid2info_map_[task->dep_id].count;
 
   // keep track of the dependencies of this task
-  const auto deps = task->dependencies;
-  for (const auto& dep : deps) {
-    if (depid2ids_map_.count(dep) == 0) {
-      // dep not in the queue means it has already finished
-      // this is why dependencies must be added first!
-      task->dependencies.erase(dep);
-    } else {
-      depid2ids_map_.at(dep).emplace(task->id);
-    }
-  }
+  auto& deps = task->dependencies;
+  std::sort(deps.begin(), deps.end());
+  deps.erase(std::unique(deps.begin(), deps.end()), deps.end());
+  deps.erase(std::remove_if(deps.begin(), deps.end(),
+                            [&](const Task::DepId& dep) {
+                              const auto iter = depid2info_map_.find(dep);
+                              // dep not in the queue means it has already
+                              // finished, this is why dependencies must be
+                              // added first!
+                              if (iter == depid2info_map_.end()) return true;
+                              iter->second.dependents.push_back(task->id);
+                              return false;
+                            }),
+             deps.end());
 
   // add this task to the executable queue if it does not have any dependency
   // left
-  if (task->dependencies.empty()) {
+  if (deps.empty()) {
     CLOG(DEBUG, "tactic.async_task")
         << "Task of id: " << task->id << ", priority: " << task->priority
         << ", dep id: " << task->dep_id
         << " has all dependency met, added to executable queue.";
-    auto iter = executable_queue_.try_emplace(task->priority);
-    const auto success = iter.first->second.emplace(task->id).second;
-    if (!success)
-      throw std::runtime_error(
-          "TaskQueue: inserting a task that already exists");
+    insert(executable_queue_, task);
   }
 
   CLOG(DEBUG, "tactic.async_task")
@@ -80,7 +72,7 @@ std::tuple<bool, Task::Id> TaskQueue::push(const Task::Ptr& task) {
   if (id2task_map_.size() > size_) {
     // discard the task with the lowest priority and added earliest or the
     // task that recursively depends it if exists
-    discarded_id = removeLeaf(*(complete_queue_.begin()->second.begin()));
+    discarded_id = removeLeaf(complete_queue_.begin()->second.front());
     discarded = true;
   }
 
@@ -93,20 +85,18 @@ Task::Ptr TaskQueue::pop() {
   if (executable_queue_.empty())
     throw std::runtime_error("TaskQueue: executable queue is empty when pop");
 
-  const auto id = *(executable_queue_.rbegin()->second.begin());
-  const auto task = id2task_map_.at(id);
-  const auto priority = task->priority;
+  // highest priority and launched earliest
+  const auto lane = std::prev(executable_queue_.end());
+  const auto id = lane->second.front();
+  lane->second.pop_front();
+  if (lane->second.empty()) executable_queue_.erase(lane);
 
-  // remove this task from the executable queue
-  executable_queue_.at(priority).erase(id);
-  if (executable_queue_.at(priority).empty()) executable_queue_.erase(priority);
+  const auto iter = id2task_map_.find(id);
+  const auto task = iter->second;
+  id2task_map_.erase(iter);
 
   // remove this task from the complete queue
-  complete_queue_.at(priority).erase(id);
-  if (complete_queue_.at(priority).empty()) complete_queue_.erase(priority);
-
-  //
-  id2task_map_.erase(id);
+  erase(complete_queue_, task);
 
   CLOG(DEBUG, "tactic.async_task")
       << "Popped task of id: " << task->id << ", priority: " << task->priority
@@ -115,35 +105,35 @@ Task::Ptr TaskQueue::pop() {
   return task;
 }
 
-void TaskQueue::updateDeps(const Task::Ptr& task) {
-  if ((--deps2count_map_.at(task->dep_id)) != 0) return;
+size_t TaskQueue::updateDeps(const Task::Ptr& task) {
+  const auto info = depid2info_map_.find(task->dep_id);
+  if ((--info->second.count) != 0) return 0;
 
   // if count of this dep id goes to zero then add its dependent tasks back
-  for (const auto& id : depid2ids_map_.at(task->dep_id)) {
-    auto curr_task = id2task_map_.at(id);
-    curr_task->dependencies.erase(task->dep_id);
-    if (curr_task->dependencies.empty()) {
+  size_t num_executable = 0;
+  for (const auto& id : info->second.dependents) {
+    const auto& curr_task = id2task_map_.at(id);
+    auto& deps = curr_task->dependencies;
+    deps.erase(std::find(deps.begin(), deps.end(), task->dep_id));
+    if (deps.empty()) {
       CLOG(DEBUG, "tactic.async_task")
           << "Task of id: " << curr_task->id
           << ", priority: " << curr_task->priority
           << ", dep id: " << curr_task->dep_id
           << " has all dependency met, added to executable queue.";
-      auto iter = executable_queue_.try_emplace(curr_task->priority);
-      auto success = iter.first->second.emplace(curr_task->id).second;
-      if (!success)
-        throw std::runtime_error(
-            "TaskQueue: inserting a task that already exists");
+      insert(executable_queue_, curr_task);
+      ++num_executable;
     }
   }
-  deps2count_map_.erase(task->dep_id);
-  depid2ids_map_.erase(task->dep_id);
+  depid2info_map_.erase(info);
+  return num_executable;
 }
 
 void TaskQueue::clear() {
   LockGuard lock(mutex_);
   // remove all tasks in queue
   while (!complete_queue_.empty())
-    removeLeaf(*(complete_queue_.begin()->second.begin()));
+    removeLeaf(complete_queue_.begin()->second.front());
   if (!id2task_map_.empty() || !executable_queue_.empty())
     throw std::runtime_error(
         "TaskQueue: id2task_map_ is not empty, task queue inconsistent");
@@ -157,8 +147,8 @@ bool TaskQueue::hasNext() const {
 bool TaskQueue::empty() const {
   LockGuard lock(mutex_);
   if (id2task_map_.empty()) {
-    if (!(complete_queue_.empty() && deps2count_map_.empty() &&
-          depid2ids_map_.empty() && executable_queue_.empty()))
+    if (!(complete_queue_.empty() && depid2info_map_.empty() &&
+          executable_queue_.empty()))
       throw std::runtime_error("TaskQueue: inconsistent state");
     return true;
   }
@@ -171,47 +161,62 @@ size_t TaskQueue::size() const {
 }
 
 Task::Id TaskQueue::removeLeaf(const Task::Id id) {
-  if (!id2task_map_.count(id))
+  const auto iter = id2task_map_.find(id);
+  if (iter == id2task_map_.end())
     throw std::runtime_error("TaskQueue: id not found when removing leaf");
+  const auto task = iter->second;
 
-  const auto dep_id = id2task_map_.at(id)->dep_id;
-  // remove one of the task that depends on this task if exists
-  if (!depid2ids_map_.at(dep_id).empty())
-    return removeLeaf(*(depid2ids_map_.at(dep_id).begin()));
+  // remove one of the task that depends on this task if exists (the earliest
+  // launched one)
+  const auto info = depid2info_map_.find(task->dep_id);
+  const auto& dependents = info->second.dependents;
+  if (!dependents.empty())
+    return removeLeaf(*std::min_element(dependents.begin(), dependents.end()));
 
   // otherwise remove this task
 
   // remove this task from the executable queue (if it is in there)
-  const auto priority = id2task_map_.at(id)->priority;
-  const auto dependencies = id2task_map_.at(id)->dependencies;
-
-  if (executable_queue_.count(priority) &&
-      executable_queue_.at(priority).erase(id)) {
-    if (executable_queue_.at(priority).empty())
-      executable_queue_.erase(priority);
-  }
+  if (task->dependencies.empty()) erase(executable_queue_, task);
 
   // remove this task from the deps tracking maps
-  if ((--deps2count_map_.at(dep_id)) == 0) {
-    deps2count_map_.erase(dep_id);
-    depid2ids_map_.erase(dep_id);
-  }
+  if ((--info->second.count) == 0) depid2info_map_.erase(info);
 
-  for (const auto& dep : dependencies) depid2ids_map_.at(dep).erase(id);
+  for (const auto& dep : task->dependencies) {
+    auto& ids = depid2info_map_.at(dep).dependents;
+    ids.erase(std::find(ids.begin(), ids.end(), id));
+  }
 
   // remove this task from the complete queue
-  complete_queue_.at(priority).erase(id);
-  if (complete_queue_.at(priority).empty()) complete_queue_.erase(priority);
+  erase(complete_queue_, task);
 
   //
-  id2task_map_.erase(id);
+  id2task_map_.erase(iter);
 
   CLOG(DEBUG, "tactic.async_task")
-      << "Discarded task of id: " << id << ", priority: " << priority
-      << ", dep id: " << dep_id << " from queue.";
+      << "Discarded task of id: " << id << ", priority: " << task->priority
+      << ", dep id: " << task->dep_id << " from queue.";
   return id;
 }
 
+void TaskQueue::insert(Lanes& lanes, const Task::Ptr& task) {
+  auto& lane = lanes[task->priority];
+  // tasks are mostly added in launch order, so search from the back
+  auto pos = lane.end();
+  while (pos != lane.begin() && *std::prev(pos) > task->id) --pos;
+  lane.insert(pos, task->id);
+}
+
+bool TaskQueue::erase(Lanes& lanes, const Task::Ptr& task) {
+  const auto lane = lanes.find(task->priority);
+  if (lane == lanes.end()) return false;
+  const auto pos =
+      std::lower_bound(lane->second.begin(), lane->second.end(), task->id);
+  if (pos == lane->second.end() || *pos != task->id) return false;
+  lane->second.erase(pos);
+  if (lane->second.empty()) lanes.erase(lane);
+  return true;
+}
+
 TaskExecutor::TaskExecutor(const OutputCache::Ptr& output,
                            const Graph::Ptr& graph, const unsigned num_threads,
                            const size_t queue_length,
@@ -291,6 +296,7 @@ void TaskExecutor::dispatch(const Task::Ptr& task) {
   if (stop_) return;
   // The pool has been shut down
   if (threads_.size() == 0) return;
+  task->dispatched = std::chrono::steady_clock::now();
   // add the job to the queue (discard one job is the queue is full)
   const auto [discarded, discarded_id] = task_queue_.push(task);
   // update job count without blocking
@@ -341,6 +347,9 @@ void TaskExecutor::doWork(const size_t& thread_id) {
 
     lock.unlock();
 
+    wait_latency_->record(
+        (std::chrono::steady_clock::now() - task->dispatched).count());
+
     // do the task
     task->run(shared_from_this(), output_, graph_);
 
@@ -348,13 +357,14 @@ void TaskExecutor::doWork(const size_t& thread_id) {
     lock.lock();
 
     // remove the task from the dependency list
-    task_queue_.updateDeps(task);
+    const auto num_executable = task_queue_.updateDeps(task);
 
     job_count_.acquire();
-    // finishing a task make any other task depending on it available to run, so
-    // notify all
-    cv_stop_or_queue_has_next_.notify_all();
-    cv_job_maybe_empty_.notify_all();
+    // finishing a task makes the tasks depending on it available to run, this
+    // thread takes one of them so only wake up threads for the rest
+    for (size_t i = 1; i < num_executable; ++i)
+      cv_stop_or_queue_has_next_.notify_one();
+    if (job_count_.get_value() == 0) cv_job_maybe_empty_.notify_all();
 
     CLOG(DEBUG, "tactic.async_task")
         << "Removed task of id: " << task->id
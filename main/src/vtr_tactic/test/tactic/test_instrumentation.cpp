@@ -0,0 +1,116 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file test_instrumentation.cpp
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+#include "vtr_tactic/instrumentation.hpp"
+
+using namespace vtr;
+using namespace vtr::tactic;
+
+TEST(Instrumentation, histogram_percentiles) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(histogram.percentile(0.5), (uint64_t)0);
+
+  // 1us to 1000us
+  for (int64_t i = 1; i <= 1000; ++i) histogram.record(i * 1000);
+  EXPECT_EQ(histogram.count(), (uint64_t)1000);
+  // within the bucket resolution of 1/32
+  EXPECT_NEAR((double)histogram.percentile(0.5), 500e3, 500e3 / 32);
+  EXPECT_NEAR((double)histogram.percentile(0.9), 900e3, 900e3 / 32);
+  EXPECT_NEAR((double)histogram.percentile(0.99), 990e3, 990e3 / 32);
+  EXPECT_EQ(histogram.percentile(1.0), (uint64_t)1000000);
+
+  const auto summary = histogram.summary();
+  EXPECT_EQ(summary.count, (uint64_t)1000);
+  EXPECT_DOUBLE_EQ(summary.mean_ms, 0.5005);
+  EXPECT_DOUBLE_EQ(summary.max_ms, 1.0);
+
+  // small values are exact, negative values are 0
+  histogram.reset();
+  histogram.record(-5);
+  histogram.record(3);
+  EXPECT_EQ(histogram.percentile(0.5), (uint64_t)0);
+  EXPECT_EQ(histogram.percentile(1.0), (uint64_t)3);
+
+  // very large values saturate the last bucket but keep the max
+  histogram.record(int64_t(1) << 50);
+  EXPECT_EQ(histogram.percentile(1.0), uint64_t(1) << 50);
+}
+
+TEST(Instrumentation, histogram_concurrent_record) {
+  LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&histogram] {
+      for (int64_t i = 0; i < 10000; ++i) histogram.record(i);
+    });
+  for (auto &thread : threads) thread.join();
+  EXPECT_EQ(histogram.count(), (uint64_t)40000);
+  EXPECT_EQ(histogram.summary().max_ms, 9999 / 1e6);
+}
+
+TEST(Instrumentation, registry) {
+  auto &registry = LatencyRegistry::instance();
+  auto a = registry.get("test.b");
+  auto b = registry.get("test.a");
+  EXPECT_EQ(registry.get("test.b"), a);
+  a->record(1000);
+
+  const auto summaries = registry.summaries();
+  auto it = std::find_if(summaries.begin(), summaries.end(),
+                         [](const auto &s) { return s.first == "test.a"; });
+  ASSERT_NE(it, summaries.end());
+  ASSERT_NE(std::next(it), summaries.end());
+  EXPECT_EQ(std::next(it)->first, "test.b");
+  EXPECT_EQ(std::next(it)->second.count, (uint64_t)1);
+
+  registry.reset();
+  EXPECT_EQ(a->count(), (uint64_t)0);
+}
+
+TEST(Instrumentation, trace) {
+  auto &recorder = TraceRecorder::instance();
+  const auto begin = TraceRecorder::Clock::now();
+  const auto end = begin + std::chrono::microseconds(1500);
+
+  // disabled by default
+  EXPECT_FALSE(recorder.enabled());
+  recorder.record("ignored", "test", begin, end);
+
+  recorder.start(2);
+  EXPECT_TRUE(recorder.enabled());
+  recorder.record("stage", "test", begin, end, 42);
+  recorder.record(std::string("module"), "test", begin, end);
+  recorder.record("dropped", "test", begin, end);
+  recorder.stop();
+  recorder.record("ignored", "test", begin, end);
+
+  std::stringstream ss;
+  recorder.write(ss);
+  const auto json = ss.str();
+  EXPECT_EQ(json.find("ignored"), std::string::npos);
+  EXPECT_EQ(json.find("dropped"), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"stage\""), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"module\""), std::string::npos);
+  EXPECT_NE(json.find("\"dur\":1500.0"), std::string::npos);
+  EXPECT_NE(json.find("\"args\":{\"frame\":42}"), std::string::npos);
+}
@@ -0,0 +1,136 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file test_object_pool.cpp
+ */
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+
+#include "vtr_tactic/cache.hpp"
+#include "vtr_tactic/object_pool.hpp"
+
+using namespace vtr;
+using namespace vtr::tactic;
+
+TEST(ObjectPool, object_pool_recycle) {
+  ObjectPool<std::vector<int>> pool(2, [](std::vector<int> &v) { v.clear(); });
+
+  auto a = pool.acquire();
+  a->resize(100);
+  const auto a_data = a->data();
+  auto b = pool.acquire();
+  auto c = pool.acquire();  // pool is full, not pooled
+  auto stats = pool.statistics();
+  EXPECT_EQ(stats.hits, (size_t)0);
+  EXPECT_EQ(stats.misses, (size_t)3);
+  EXPECT_EQ(stats.size, (size_t)2);
+  EXPECT_EQ(stats.in_use, (size_t)2);
+
+  // an object in use is never handed out again
+  c.reset();
+  auto d = pool.acquire();
+  EXPECT_NE(d, a);
+  EXPECT_NE(d, b);
+
+  // a released object is reset and keeps its memory
+  a.reset();
+  auto e = pool.acquire();
+  EXPECT_TRUE(e->empty());
+  EXPECT_GE(e->capacity(), (size_t)100);
+  EXPECT_EQ(e->data(), a_data);
+  stats = pool.statistics();
+  EXPECT_EQ(stats.hits, (size_t)1);
+  EXPECT_EQ(stats.misses, (size_t)4);
+  EXPECT_EQ(stats.in_use, (size_t)2);
+
+  // all released
+  b.reset(), d.reset(), e.reset();
+  EXPECT_EQ(pool.statistics().in_use, (size_t)0);
+}
+
+TEST(ObjectPool, object_pool_reset_on_release) {
+  // objects holding objects of another pool, like query caches holding point
+  // clouds, return them as soon as they are released
+  using Held = std::vector<std::shared_ptr<std::vector<int>>>;
+  ObjectPool<std::vector<int>> inner(4);
+  ObjectPool<Held> outer(2, [](Held &held) { held.clear(); });
+
+  auto a = outer.acquire();
+  a->push_back(inner.acquire());
+  a->push_back(inner.acquire());
+  EXPECT_EQ(inner.statistics().in_use, (size_t)2);
+  a.reset();
+  EXPECT_EQ(outer.statistics().in_use, (size_t)0);
+  EXPECT_EQ(inner.statistics().in_use, (size_t)0);
+
+  // objects in use outlive the pool
+  std::shared_ptr<std::vector<int>> b;
+  {
+    ObjectPool<std::vector<int>> pool(1);
+    b = pool.acquire();
+  }
+  b->push_back(1);
+  b.reset();
+}
+
+TEST(ObjectPool, object_pool_zero_capacity) {
+  ObjectPool<int> pool(0);
+  auto a = pool.acquire();
+  a.reset();
+  auto b = pool.acquire();
+  const auto stats = pool.statistics();
+  EXPECT_EQ(stats.hits, (size_t)0);
+  EXPECT_EQ(stats.misses, (size_t)2);
+  EXPECT_EQ(stats.size, (size_t)0);
+}
+
+TEST(ObjectPool, object_pool_query_cache) {
+  ObjectPool<QueryCache> pool(1, [](QueryCache &qdata) {
+    static const QueryCache empty;
+    qdata = empty;
+  });
+  auto qdata = pool.acquire();
+  qdata->stamp.emplace(10);
+  const auto ptr = qdata.get();
+  qdata.reset();
+
+  qdata = pool.acquire();
+  EXPECT_EQ(qdata.get(), ptr);
+  EXPECT_FALSE(qdata->stamp.valid());
+  // still owned by the shared pointer handed out
+  EXPECT_EQ(qdata->shared_from_this(), qdata);
+}
+
+TEST(ObjectPool, object_pool_concurrent) {
+  ObjectPool<std::vector<int>> pool(4, [](std::vector<int> &v) {
+    EXPECT_TRUE(std::all_of(v.begin(), v.end(), [](int x) { return x == 1; }));
+    v.clear();
+  });
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+    threads.emplace_back([&pool]() {
+      for (int i = 0; i < 1000; ++i) {
+        auto v = pool.acquire();
+        EXPECT_TRUE(v->empty());  // never shared with another thread
+        v->assign(16, 1);
+      }
+    });
+  for (auto &thread : threads) thread.join();
+  const auto stats = pool.statistics();
+  EXPECT_EQ(stats.hits + stats.misses, (size_t)4000);
+  EXPECT_EQ(stats.in_use, (size_t)0);
+}
@@ -0,0 +1,88 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file test_obstacle_grid.cpp
+ */
+#include <gtest/gtest.h>
+
+#include "vtr_tactic/obstacle_grid.hpp"
+
+using namespace vtr;
+using namespace vtr::tactic;
+
+TEST(ObstacleGrid, obstacle_grid_lookup) {
+  // 10 x 6 cells of 0.25m, covering [-1.25, 1.25) x [-0.75, 0.75)
+  ObstacleGrid grid(0.25, 10, 6, -5, -3);
+  EXPECT_EQ(grid.size(), (size_t)0);
+  EXPECT_FLOAT_EQ(grid.at(0, 0), 0.0);
+
+  EXPECT_TRUE(grid.set(-5, -3, 1.0));
+  EXPECT_TRUE(grid.set(4, 2, 0.5));
+  EXPECT_FALSE(grid.set(5, 2, 1.0));   // outside of the window
+  EXPECT_FALSE(grid.set(-6, 0, 1.0));  // outside of the window
+  EXPECT_EQ(grid.size(), (size_t)2);
+
+  EXPECT_FLOAT_EQ(grid.at(-5, -3), 1.0);
+  EXPECT_FLOAT_EQ(grid.at(4, 2), 0.5);
+  EXPECT_FLOAT_EQ(grid.at(5, 2), 0.0);
+
+  // points are looked up in the cell containing them
+  EXPECT_FLOAT_EQ(grid.atPoint(-1.25, -0.75), 1.0);
+  EXPECT_FLOAT_EQ(grid.atPoint(-1.01, -0.51), 1.0);
+  EXPECT_FLOAT_EQ(grid.atPoint(-1.0, -0.5), 0.0);
+  EXPECT_FLOAT_EQ(grid.atPoint(1.1, 0.6), 0.5);
+  EXPECT_FLOAT_EQ(grid.atPoint(1.3, 0.6), 0.0);
+  EXPECT_FLOAT_EQ(grid.atPoint(-1.3, -0.8), 0.0);
+
+  // resetting a cell to the default value
+  EXPECT_TRUE(grid.set(4, 2, 0.0));
+  EXPECT_EQ(grid.size(), (size_t)1);
+  grid.clear();
+  EXPECT_EQ(grid.size(), (size_t)0);
+  EXPECT_FLOAT_EQ(grid.at(-5, -3), 0.0);
+}
+
+TEST(ObstacleGrid, obstacle_grid_scroll) {
+  ObstacleGrid grid(1.0, 4, 3);
+  for (int x = 0; x < 4; ++x)
+    for (int y = 0; y < 3; ++y) grid.set(x, y, 1 + x + 10 * y);
+  EXPECT_EQ(grid.size(), (size_t)12);
+
+  // scroll by (+1, -1): column 0 and row 2 leave the window
+  grid.scroll(1, -1);
+  EXPECT_EQ(grid.origin_x(), 1);
+  EXPECT_EQ(grid.origin_y(), -1);
+  EXPECT_EQ(grid.size(), (size_t)6);
+  for (int x = 1; x < 5; ++x)
+    for (int y = -1; y < 2; ++y) {
+      const float expected = (x < 4 && y >= 0) ? 1 + x + 10 * y : 0;
+      EXPECT_FLOAT_EQ(grid.at(x, y), expected) << x << ", " << y;
+    }
+  EXPECT_FLOAT_EQ(grid.at(0, 0), 0.0);  // left the window
+
+  // new cells can be set, and scrolling back keeps them
+  EXPECT_TRUE(grid.set(4, -1, 100));
+  grid.scroll(0, 0);
+  EXPECT_FLOAT_EQ(grid.at(4, -1), 0.0);
+  EXPECT_FLOAT_EQ(grid.at(0, 0), 0.0);
+  EXPECT_FLOAT_EQ(grid.at(3, 1), 14);
+  EXPECT_EQ(grid.size(), (size_t)6);
+
+  // recentering far away clears the grid
+  grid.recenter(100.0, -100.0);
+  EXPECT_EQ(grid.origin_x(), 98);
+  EXPECT_EQ(grid.origin_y(), -101);
+  EXPECT_EQ(grid.size(), (size_t)0);
+}
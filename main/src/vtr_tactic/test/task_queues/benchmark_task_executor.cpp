@@ -0,0 +1,126 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file benchmark_task_executor.cpp
+ * \brief TaskExecutor throughput for thousands of short tasks, independent
+ * and with dependencies, for different number of threads.
+ */
+#include <atomic>
+#include <limits>
+
+#include "vtr_common/timing/stopwatch.hpp"
+#include "vtr_logging/logging_init.hpp"
+#include "vtr_tactic/cache.hpp"
+#include "vtr_tactic/modules/base_module.hpp"
+#include "vtr_tactic/task_queue.hpp"
+
+using namespace vtr;
+using namespace vtr::logging;
+using namespace vtr::tactic;
+
+namespace {
+
+constexpr int num_tasks = 20000;
+constexpr int chain_length = 4;
+constexpr int num_work_iterations = 200;
+
+std::atomic<size_t> g_num_runs{0};
+
+/** \brief A module whose async part does a few hundred nanoseconds of work */
+class ShortTaskModule : public BaseModule {
+ public:
+  ShortTaskModule() : BaseModule{nullptr, "short_task"} {}
+
+ private:
+  void run_(QueryCache &, OutputCache &, const Graph::Ptr &,
+            const TaskExecutor::Ptr &) override {}
+
+  void runAsync_(QueryCache &, OutputCache &, const Graph::Ptr &,
+                 const TaskExecutor::Ptr &, const Task::Priority &,
+                 const Task::DepId &) override {
+    volatile double x = 1.0;
+    for (int i = 0; i < num_work_iterations; ++i) x = x * 1.000001 + 1e-9;
+    ++g_num_runs;
+  }
+};
+
+}  // namespace
+
+int main(int, char **) {
+  configureLogging("", false);
+
+  auto output = std::make_shared<OutputCache>();
+  auto qdata = std::make_shared<QueryCache>();
+  auto module = std::make_shared<ShortTaskModule>();
+
+  common::timing::Stopwatch<> timer(false);
+  const auto elapsed_ms = [&timer]() {
+    const auto ms = (double)timer.count<std::chrono::microseconds>() / 1000.0;
+    timer.reset();
+    return ms;
+  };
+
+  /// task creation (including dependency id generation)
+  std::vector<Task::Ptr> tasks;
+  tasks.reserve(num_tasks);
+  timer.start();
+  for (int i = 0; i < num_tasks; ++i)
+    tasks.emplace_back(std::make_shared<Task>(module, qdata));
+  timer.stop();
+  CLOG(INFO, "test") << "Task creation: " << elapsed_ms() * 1000.0 / num_tasks
+                     << " us per task";
+
+  for (const unsigned num_threads : {1, 2, 4, 8}) {
+    auto executor = std::make_shared<TaskExecutor>(
+        output, nullptr, num_threads, std::numeric_limits<size_t>::max());
+
+    /// independent tasks, all dispatched at once
+    g_num_runs = 0;
+    timer.start();
+    for (int i = 0; i < num_tasks; ++i)
+      executor->dispatch(std::make_shared<Task>(module, qdata, i % 4));
+    executor->wait();
+    timer.stop();
+    const auto independent_ms = elapsed_ms();
+    const auto independent_runs = g_num_runs.load();
+
+    /// chains of dependent tasks with increasing priority
+    g_num_runs = 0;
+    timer.start();
+    for (int i = 0; i < num_tasks / chain_length; ++i) {
+      auto task = std::make_shared<Task>(module, qdata);
+      executor->dispatch(task);
+      for (int j = 1; j < chain_length; ++j) {
+        task = std::make_shared<Task>(
+            module, qdata, j, std::initializer_list<Task::DepId>{task->dep_id});
+        executor->dispatch(task);
+      }
+    }
+    executor->wait();
+    timer.stop();
+    const auto chain_ms = elapsed_ms();
+    const auto chain_runs = g_num_runs.load();
+
+    executor->stop();
+
+    CLOG(INFO, "test") << num_threads << " threads, independent: "
+                       << independent_runs / independent_ms
+                       << " tasks/ms, chains of " << chain_length << ": "
+                       << chain_runs / chain_ms << " tasks/ms ("
+                       << independent_runs << " + " << chain_runs << " runs)";
+  }
+
+  return 0;
+}
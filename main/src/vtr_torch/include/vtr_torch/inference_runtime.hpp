@@ -0,0 +1,118 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file inference_runtime.hpp
+ */
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <torch/script.h>
+#include <torch/torch.h>
+
+#include "vtr_torch/types.hpp"
+
+namespace vtr {
+namespace nn {
+
+/**
+ * \brief Runs a TorchScript model on a dedicated inference thread.
+ * \details Inputs are copied into preallocated (pinned when running on gpu)
+ * staging tensors and evaluated in inference mode. The inference thread sets
+ * its own intra-op thread count, so it does not resize the OpenMP teams of the
+ * calling pipeline threads (e.g. ICP). Requests of the same input shape queued
+ * while the model is busy are concatenated along the first (batch) dimension
+ * into one forward pass of up to max_batch_size requests; this requires the
+ * model to treat the batch dimension independently.
+ */
+class InferenceRuntime {
+ public:
+  using Ptr = std::shared_ptr<InferenceRuntime>;
+
+  struct Config {
+    /** \brief Intra-op threads of the inference thread */
+    int num_threads = 1;
+    /** \brief Maximum number of requests evaluated in one forward pass */
+    size_t max_batch_size = 1;
+  };
+
+  struct Statistics {
+    size_t requests = 0;
+    size_t batches = 0;
+  };
+
+  InferenceRuntime(const Module &network, const torch::Device &device,
+                   const Config &config);
+  ~InferenceRuntime();
+
+  /**
+   * \brief Evaluates the model on shape-sized data, blocks until done.
+   * \return the (cpu) output of the model for this input
+   */
+  template <typename DataType>
+  torch::Tensor evaluate(const DataType *data,
+                         const std::vector<int64_t> &shape) {
+    return evaluate(data, c10::CppTypeToScalarType<DataType>::value, shape);
+  }
+  torch::Tensor evaluate(const void *data, const torch::ScalarType &dtype,
+                         const std::vector<int64_t> &shape);
+
+  Statistics statistics() const { return {requests_, batches_}; }
+
+ private:
+  struct Request {
+    const void *data;
+    torch::ScalarType dtype;
+    std::vector<int64_t> shape;
+    std::promise<torch::Tensor> result;
+  };
+
+  /** \brief Inference thread, takes batches of requests off the queue */
+  void run();
+  void evaluateBatch(const std::vector<Request *> &batch);
+  /** \brief Returns the reused staging tensor of this type and shape */
+  torch::Tensor &staging(const torch::ScalarType &dtype,
+                         const std::vector<int64_t> &shape);
+
+  Module network_;
+  const torch::Device device_;
+  const Config config_;
+
+  /** \brief Protects stop_ and queue_ */
+  std::mutex mutex_;
+  std::condition_variable cv_stop_or_queue_not_empty_;
+  bool stop_ = false;
+  /** \brief Pending requests, owned by the waiting callers */
+  std::deque<Request *> queue_;
+
+  /** \brief Staging tensors by type and shape, inference thread only */
+  std::map<std::pair<torch::ScalarType, std::vector<int64_t>>, torch::Tensor>
+      staging_;
+
+  std::atomic<size_t> requests_ = 0;
+  std::atomic<size_t> batches_ = 0;
+
+  std::thread thread_;
+};
+
+}  // namespace nn
+}  // namespace vtr
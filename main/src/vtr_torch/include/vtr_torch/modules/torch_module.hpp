@@ -25,6 +25,7 @@
 #include <torch/torch.h>
 #include <torch/script.h> 
 #include "vtr_torch/types.hpp"
+#include "vtr_torch/inference_runtime.hpp"
 #include <vector>
 
 namespace vtr {
@@ -44,6 +45,10 @@ class TorchModule : public tactic::BaseModule {
     std::string model_filepath = "default";
     bool use_gpu = false;
     bool abs_filepath = true;
+    /// intra-op threads of the inference thread, separate from ICP's OpenMP
+    int num_threads = 1;
+    /// queued frames evaluated in one forward pass, the model must be batched
+    int max_batch_size = 1;
 
     static ConstPtr fromROS(const rclcpp::Node::SharedPtr &node,
                             const std::string &param_prefix);
@@ -76,6 +81,11 @@ class TorchModule : public tactic::BaseModule {
           }
         }
         CLOG(INFO, "torch") << "Using device " << device << std::endl;
+
+        InferenceRuntime::Config runtime_config;
+        runtime_config.num_threads = config_->num_threads;
+        runtime_config.max_batch_size = std::max(config_->max_batch_size, 1);
+        runtime_ = std::make_shared<InferenceRuntime>(network, device, runtime_config);
       }
 
   
@@ -88,13 +98,19 @@ class TorchModule : public tactic::BaseModule {
 
   Config::ConstPtr config_;
   torch::Device device = torch::kCPU;
+  InferenceRuntime::Ptr runtime_;
 
 
  protected:
   Module network;
 
+  /**
+   * \brief Evaluates the model on inputs of the given shape, the first
+   * dimension being the batch dimension. Thread safe.
+   * \return the cpu output, may be a view of a batched output
+   */
   template <typename DataType>
-  torch::Tensor evaluateModel(std::vector<DataType> inputs, const Shape shape);
+  torch::Tensor evaluateModel(const std::vector<DataType> &inputs, const Shape shape);
 
 };
 
@@ -8,17 +8,15 @@ namespace vtr {
 namespace nn {
 
   template <typename DataType>
-  torch::Tensor TorchModule::evaluateModel(std::vector<DataType> inputs, const Shape shape){
-    torch::NoGradGuard no_grad;
-    std::vector<torch::jit::IValue> jit_inputs;
-
-    auto t_input = torch::from_blob(inputs.data(), shape).to(device);
-    jit_inputs.push_back(t_input);
-
-
-    auto output = network(jit_inputs);
-
-    return output.toTensor().cpu();
+  torch::Tensor TorchModule::evaluateModel(const std::vector<DataType> &inputs, const Shape shape){
+    int64_t numel = 1;
+    for (const auto &size : shape) numel *= size;
+    if ((int64_t)inputs.size() != numel) {
+      std::string err{"TorchModule: number of inputs does not match the shape"};
+      CLOG(ERROR, "torch") << err;
+      throw std::invalid_argument(err);
+    }
+    return runtime_->evaluate(inputs.data(), shape.vec());
   }
     
 } // namespace nn 
@@ -0,0 +1,172 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file inference_runtime.cpp
+ */
+#include "vtr_torch/inference_runtime.hpp"
+
+#include <cstring>
+
+#include "vtr_logging/logging.hpp"
+
+namespace vtr {
+namespace nn {
+
+namespace {
+
+/** \brief Whether two requests can be concatenated along the first dimension */
+bool batchable(const torch::ScalarType &dtype0,
+               const std::vector<int64_t> &shape0,
+               const torch::ScalarType &dtype1,
+               const std::vector<int64_t> &shape1) {
+  return dtype0 == dtype1 && !shape0.empty() && shape0.size() == shape1.size() &&
+         std::equal(shape0.begin() + 1, shape0.end(), shape1.begin() + 1);
+}
+
+int64_t numel(const std::vector<int64_t> &shape) {
+  int64_t numel = 1;
+  for (const auto &size : shape) numel *= size;
+  return numel;
+}
+
+}  // namespace
+
+InferenceRuntime::InferenceRuntime(const Module &network,
+                                   const torch::Device &device,
+                                   const Config &config)
+    : network_(network), device_(device), config_(config) {
+  thread_ = std::thread(&InferenceRuntime::run, this);
+}
+
+InferenceRuntime::~InferenceRuntime() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_stop_or_queue_not_empty_.notify_all();
+  if (thread_.joinable()) thread_.join();
+}
+
+torch::Tensor InferenceRuntime::evaluate(const void *data,
+                                         const torch::ScalarType &dtype,
+                                         const std::vector<int64_t> &shape) {
+  Request request{data, dtype, shape, {}};
+  auto result = request.result.get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stop_) throw std::runtime_error("InferenceRuntime has been stopped");
+    queue_.push_back(&request);
+  }
+  cv_stop_or_queue_not_empty_.notify_one();
+  return result.get();
+}
+
+void InferenceRuntime::run() {
+  el::Helpers::setThreadName("torch.inference");
+  torch::set_num_threads(config_.num_threads);
+  c10::InferenceMode guard;
+
+  std::vector<Request *> batch;
+  while (true) {
+    batch.clear();
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_stop_or_queue_not_empty_.wait(
+          lock, [this] { return stop_ || !queue_.empty(); });
+      // evaluate all pending requests before stopping, callers wait on them
+      if (stop_ && queue_.empty()) return;
+      batch.push_back(queue_.front());
+      queue_.pop_front();
+      // take the following requests that can share the forward pass
+      while (!queue_.empty() && batch.size() < config_.max_batch_size &&
+             batchable(batch.front()->dtype, batch.front()->shape,
+                       queue_.front()->dtype, queue_.front()->shape)) {
+        batch.push_back(queue_.front());
+        queue_.pop_front();
+      }
+    }
+    evaluateBatch(batch);
+  }
+}
+
+void InferenceRuntime::evaluateBatch(const std::vector<Request *> &batch) {
+  requests_ += batch.size();
+  ++batches_;
+  try {
+    auto shape = batch.front()->shape;
+    if (batch.size() > 1) {
+      shape[0] = 0;
+      for (const auto &request : batch) shape[0] += request->shape[0];
+    }
+    auto &input = staging(batch.front()->dtype, shape);
+    auto *dst = static_cast<char *>(input.data_ptr());
+    for (const auto &request : batch) {
+      const auto bytes =
+          numel(request->shape) * c10::elementSize(request->dtype);
+      std::memcpy(dst, request->data, bytes);
+      dst += bytes;
+    }
+
+    const auto device_input = input.to(device_, /* non_blocking */ true);
+    auto output = network_.forward({device_input}).toTensor();
+    if (!output.device().is_cpu())
+      output = output.cpu();
+    else if (output.is_alias_of(input))
+      output = output.clone();  // staging tensor is overwritten next time
+
+    if (batch.size() == 1) {
+      batch.front()->result.set_value(output);
+      return;
+    }
+    if (output.dim() == 0 || output.size(0) != shape[0])
+      throw std::runtime_error(
+          "InferenceRuntime: model output is not batched along the first "
+          "dimension, set max_batch_size to 1");
+    int64_t offset = 0;
+    for (const auto &request : batch) {
+      request->result.set_value(output.narrow(0, offset, request->shape[0]));
+      offset += request->shape[0];
+    }
+  } catch (...) {
+    CLOG(ERROR, "torch") << "Failed to evaluate a batch of " << batch.size()
+                         << " inputs";
+    for (const auto &request : batch) {
+      try {
+        request->result.set_exception(std::current_exception());
+      } catch (const std::future_error &) {
+        // already satisfied
+      }
+    }
+  }
+}
+
+torch::Tensor &InferenceRuntime::staging(const torch::ScalarType &dtype,
+                                         const std::vector<int64_t> &shape) {
+  auto &tensor = staging_[std::make_pair(dtype, shape)];
+  if (!tensor.defined()) {
+    // varying batch sizes create a few tensors per input shape at most
+    if (staging_.size() > 16) {
+      staging_.clear();
+      return staging(dtype, shape);
+    }
+    const auto options =
+        torch::TensorOptions().dtype(dtype).pinned_memory(device_.is_cuda());
+    tensor = torch::empty(shape, options);
+  }
+  return tensor;
+}
+
+}  // namespace nn
+}  // namespace vtr
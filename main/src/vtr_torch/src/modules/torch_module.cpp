@@ -32,6 +32,8 @@ auto TorchModule::Config::fromROS(const rclcpp::Node::SharedPtr &node,
 
   config->use_gpu = node->declare_parameter<bool>(param_prefix + ".use_gpu", config->use_gpu);
   config->abs_filepath = node->declare_parameter<bool>(param_prefix + ".abs_filepath", config->abs_filepath);
+  config->num_threads = node->declare_parameter<int>(param_prefix + ".num_threads", config->num_threads);
+  config->max_batch_size = node->declare_parameter<int>(param_prefix + ".max_batch_size", config->max_batch_size);
 
   auto model_dir = node->declare_parameter<std::string>("model_dir", "defalut2");
   model_dir = common::utils::expand_user(common::utils::expand_env(model_dir));
@@ -0,0 +1,135 @@
+// Copyright 2026, Autonomous Space Robotics Lab (ASRL)
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * \file benchmark_inference_runtime.cpp
+ * \brief Per-frame cpu latency of the inference runtime of TorchModule vs. the
+ * previous per-call evaluation, on a dummy TorchScript model.
+ */
+#include <random>
+
+#include "vtr_common/timing/stopwatch.hpp"
+#include "vtr_logging/logging_init.hpp"
+#include "vtr_torch/inference_runtime.hpp"
+
+using namespace vtr;
+using namespace vtr::logging;
+using namespace vtr::nn;
+
+namespace {
+
+constexpr int num_frames = 256;
+constexpr int num_producers = 4;
+constexpr int64_t input_size = 1024;
+constexpr int num_threads = 4;
+
+/** \brief A two layer perceptron, batched along the first dimension */
+Module dummyModel() {
+  Module model("dummy");
+  model.register_parameter("w1", torch::randn({input_size, 512}), false);
+  model.register_parameter("w2", torch::randn({512, 64}), false);
+  model.define(R"(
+    def forward(self, x):
+        return torch.matmul(torch.relu(torch.matmul(x, self.w1)), self.w2)
+  )");
+  return model;
+}
+
+/// Previous implementation of TorchModule::evaluateModel
+torch::Tensor legacyEvaluate(Module &network, std::vector<float> inputs,
+                             const Shape shape) {
+  torch::NoGradGuard no_grad;
+  std::vector<torch::jit::IValue> jit_inputs;
+  auto t_input = torch::from_blob(inputs.data(), shape).to(torch::kCPU);
+  jit_inputs.push_back(t_input);
+  auto output = network(jit_inputs);
+  return output.toTensor().cpu();
+}
+
+}  // namespace
+
+int main(int, char **) {
+  configureLogging("", true);
+
+  torch::manual_seed(42);
+  auto network = dummyModel();
+
+  std::mt19937 gen(42);
+  std::normal_distribution<float> dist;
+  std::vector<std::vector<float>> frames(num_frames);
+  for (auto &frame : frames) {
+    frame.resize(input_size);
+    for (auto &v : frame) v = dist(gen);
+  }
+
+  common::timing::Stopwatch<> timer(false);
+  const auto elapsed_ms = [&timer]() {
+    const auto ms = (double)timer.count<std::chrono::microseconds>() / 1000.0;
+    timer.reset();
+    return ms / num_frames;
+  };
+
+  std::vector<torch::Tensor> previous(num_frames), current(num_frames);
+
+  /// one frame at a time, as called by a pipeline thread
+  torch::set_num_threads(num_threads);
+  timer.start();
+  for (int i = 0; i < num_frames; ++i)
+    previous[i] = legacyEvaluate(network, frames[i], {1, input_size});
+  timer.stop();
+  const auto previous_ms = elapsed_ms();
+
+  InferenceRuntime::Config config;
+  config.num_threads = num_threads;
+  {
+    InferenceRuntime runtime(network, torch::kCPU, config);
+    timer.start();
+    for (int i = 0; i < num_frames; ++i)
+      current[i] = runtime.evaluate(frames[i].data(), {1, input_size});
+    timer.stop();
+  }
+  const auto current_ms = elapsed_ms();
+
+  /// frames queued by several threads, evaluated in micro-batches
+  config.max_batch_size = num_producers;
+  InferenceRuntime runtime(network, torch::kCPU, config);
+  std::vector<std::thread> producers;
+  timer.start();
+  for (int p = 0; p < num_producers; ++p)
+    producers.emplace_back([&, p] {
+      for (int i = p; i < num_frames; i += num_producers)
+        current[i] = runtime.evaluate(frames[i].data(), {1, input_size});
+    });
+  for (auto &producer : producers) producer.join();
+  timer.stop();
+  const auto batched_ms = elapsed_ms();
+  const auto statistics = runtime.statistics();
+
+  CLOG(INFO, "test") << "Frames of " << input_size << " inputs, "
+                     << num_threads << " threads - previous: " << previous_ms
+                     << " ms, current: " << current_ms
+                     << " ms, batched (" << num_producers
+                     << " producers): " << batched_ms << " ms per frame, "
+                     << (double)statistics.requests / statistics.batches
+                     << " frames per batch";
+
+  /// outputs should agree
+  float max_error = 0;
+  for (int i = 0; i < num_frames; ++i)
+    max_error = std::max(max_error,
+                         (current[i] - previous[i]).abs().max().item<float>());
+  CLOG(INFO, "test") << "Max output error: " << max_error;
+
+  return 0;
+}